@@ -0,0 +1,326 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	Arena.cpp
+// Date:	October 19th, 2026
+// Purpose: Arena files and the obstacle hierarchy, see Arena.h.
+//////////////////////////////////////////////////////////////////////////
+#include "Arena.h"
+#include "PongGame.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <algorithm>
+
+// Half the ball sprite's width, what obstacles are grown by
+#define ARENA_BALL_RADIUS 10
+
+namespace
+{
+	// Orders hit boxes along one axis by their centres, then by their
+	// place in the file so the order never depends on the sort
+	struct HitBoxOrder
+	{
+		bool				vertical;
+
+		explicit HitBoxOrder(bool vertical) : vertical(vertical)	{}
+
+		bool operator()(const ArenaHitBox& a, const ArenaHitBox& b) const
+		{
+			float ca = vertical ? a.top + a.bottom : a.left + a.right;
+			float cb = vertical ? b.top + b.bottom : b.left + b.right;
+			if(ca != cb)
+				return ca < cb;
+			return a.obstacle < b.obstacle;
+		}
+	};
+
+	bool StartsWith(const char* line, const char* key, const char** value)
+	{
+		size_t length = strlen(key);
+		for(size_t i = 0; i < length; ++i)
+		{
+			if(tolower((unsigned char)line[i]) != key[i])
+				return false;
+		}
+		const char* rest = line + length;
+		while(*rest == ' ' || *rest == '\t')
+			++rest;
+		if(*rest != '=')
+			return false;
+		*value = rest + 1;
+		return true;
+	}
+}
+
+CArena::CArena(void)
+{
+	Clear();
+}
+
+void CArena::Clear()
+{
+	m_Name.clear();
+	m_Obstacles.clear();
+	m_HitBoxes.clear();
+	m_Nodes.clear();
+	m_TileX.clear();
+	m_TileY.clear();
+	m_TileScale.clear();
+	m_TileColor.clear();
+	m_DrawX.clear();
+	m_DrawY.clear();
+	m_DrawScale.clear();
+	memset(&m_DrawView, 0, sizeof(m_DrawView));
+	m_nSkipped	= 0;
+	m_nDepth	= 0;
+	m_nLeafSize	= ARENA_LEAF_SIZE;
+}
+
+bool CArena::Load(const char* fileName)
+{
+	Clear();
+	FILE* file = fopen(fileName, "r");
+	if(!file)
+		return false;
+
+	std::string name;
+	std::vector<ArenaObstacle> obstacles;
+	int skipped = 0;
+	char line[512];
+	while(fgets(line, sizeof(line), file))
+	{
+		char* comment = strchr(line, ';');
+		if(comment)
+			*comment = 0;
+		char* start = line;
+		while(isspace((unsigned char)*start))
+			++start;
+		size_t length = strlen(start);
+		while(length > 0 && isspace((unsigned char)start[length - 1]))
+			start[--length] = 0;
+		if(length == 0)
+			continue;
+
+		const char* value = 0;
+		ArenaObstacle obstacle;
+		if(StartsWith(start, "name", &value))
+		{
+			while(*value == ' ' || *value == '\t')
+				++value;
+			name = value;
+			continue;
+		}
+		if(StartsWith(start, "block", &value))
+			obstacle.type = ARENA_BLOCK;
+		else if(StartsWith(start, "bumper", &value))
+			obstacle.type = ARENA_BUMPER;
+		else
+		{
+			++skipped;
+			continue;
+		}
+
+		if(sscanf(value, "%f %f %f %f", &obstacle.x, &obstacle.y, &obstacle.width, &obstacle.height) != 4)
+		{
+			++skipped;
+			continue;
+		}
+		obstacles.push_back(obstacle);
+	}
+	fclose(file);
+
+	Create(obstacles.empty() ? 0 : &obstacles[0], (int)obstacles.size());
+	m_Name = name;
+	m_nSkipped += skipped;
+	return true;
+}
+
+void CArena::Create(const ArenaObstacle* obstacles, int count, int leafSize)
+{
+	Clear();
+	m_nLeafSize = leafSize > 0 ? leafSize : 1;
+	for(int i = 0; i < count; ++i)
+	{
+		const ArenaObstacle& obstacle = obstacles[i];
+		float halfWidth		= obstacle.width * 0.5f;
+		float halfHeight	= obstacle.height * 0.5f;
+		bool onPlayfield = obstacle.width > 0.0f && obstacle.height > 0.0f
+			&& obstacle.x - halfWidth >= 0.0f && obstacle.x + halfWidth <= PLAYFIELD_WIDTH
+			&& obstacle.y - halfHeight >= 0.0f && obstacle.y + halfHeight <= PLAYFIELD_HEIGHT;
+
+		ArenaHitBox box;
+		box.left	= obstacle.x - halfWidth - ARENA_BALL_RADIUS;
+		box.top		= obstacle.y - halfHeight - ARENA_BALL_RADIUS;
+		box.right	= obstacle.x + halfWidth + ARENA_BALL_RADIUS;
+		box.bottom	= obstacle.y + halfHeight + ARENA_BALL_RADIUS;
+
+		// The ball is served from the middle, it could never get out
+		bool coversServe = box.left <= PLAYFIELD_WIDTH / 2 && box.right >= PLAYFIELD_WIDTH / 2
+			&& box.top <= PLAYFIELD_HEIGHT / 2 && box.bottom >= PLAYFIELD_HEIGHT / 2;
+		if(!onPlayfield || coversServe)
+		{
+			++m_nSkipped;
+			continue;
+		}
+
+		box.fixedLeft	= CFixed::FromFloat(box.left);
+		box.fixedTop	= CFixed::FromFloat(box.top);
+		box.fixedRight	= CFixed::FromFloat(box.right);
+		box.fixedBottom	= CFixed::FromFloat(box.bottom);
+		box.type		= obstacle.type;
+		box.obstacle	= (int)m_Obstacles.size();
+		m_HitBoxes.push_back(box);
+		m_Obstacles.push_back(obstacle);
+		AddTiles(obstacle);
+	}
+
+	if(!m_HitBoxes.empty())
+	{
+		m_Nodes.reserve(m_HitBoxes.size() * 2 / m_nLeafSize + 1);
+		m_nDepth = Build(0, (int)m_HitBoxes.size(), 1);
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Name:		Build
+// Parameters:	int first, int count - Hit boxes under the node
+//				int depth - The node's depth, 1 for the root
+// Return:		int - Depth of the deepest leaf under it
+// Description:	Appends the node then its children, splitting the boxes
+//				in order of their centres along one axis.  Appending in
+//				that order is what makes the array depth first.
+//////////////////////////////////////////////////////////////////////////
+int CArena::Build(int first, int count, int depth)
+{
+	int index = (int)m_Nodes.size();
+	ArenaNode node;
+	node.left	= m_HitBoxes[first].left;
+	node.top	= m_HitBoxes[first].top;
+	node.right	= m_HitBoxes[first].right;
+	node.bottom	= m_HitBoxes[first].bottom;
+	for(int i = first + 1; i < first + count; ++i)
+	{
+		const ArenaHitBox& box = m_HitBoxes[i];
+		node.left	= std::min(node.left, box.left);
+		node.top	= std::min(node.top, box.top);
+		node.right	= std::max(node.right, box.right);
+		node.bottom	= std::max(node.bottom, box.bottom);
+	}
+	node.left	-= ARENA_NODE_PADDING;
+	node.top	-= ARENA_NODE_PADDING;
+	node.right	+= ARENA_NODE_PADDING;
+	node.bottom	+= ARENA_NODE_PADDING;
+	node.skip	= index + 1;
+	node.first	= first;
+	node.count	= count;
+	node.pad	= 0;
+	m_Nodes.push_back(node);
+	if(count <= m_nLeafSize)
+		return depth;
+
+	// The split the ball is least likely to have to look on both sides
+	// of: a nearly still ball lands in a node about as often as its area
+	// says, so the cost of a split is each half's area times the boxes in
+	// it.  Tried along both axes, kept within the middle half so the
+	// depth stays logarithmic.
+	int lowest = std::max(1, count / 4);
+	int highest = std::min(count - 1, count - count / 4);
+	int split = count / 2;
+	bool vertical = false;
+	float bestCost = -1.0f;
+	std::vector<float> rightArea(count);
+	for(int axis = 0; axis < 2; ++axis)
+	{
+		bool sortVertical = axis == 1;
+		std::sort(m_HitBoxes.begin() + first, m_HitBoxes.begin() + first + count, HitBoxOrder(sortVertical));
+
+		ArenaHitBox bounds = m_HitBoxes[first + count - 1];
+		for(int i = count - 1; i >= lowest; --i)
+		{
+			const ArenaHitBox& box = m_HitBoxes[first + i];
+			bounds.left		= std::min(bounds.left, box.left);
+			bounds.top		= std::min(bounds.top, box.top);
+			bounds.right	= std::max(bounds.right, box.right);
+			bounds.bottom	= std::max(bounds.bottom, box.bottom);
+			rightArea[i] = (bounds.right - bounds.left) * (bounds.bottom - bounds.top);
+		}
+
+		bounds = m_HitBoxes[first];
+		for(int i = 1; i <= highest; ++i)
+		{
+			const ArenaHitBox& box = m_HitBoxes[first + i - 1];
+			bounds.left		= std::min(bounds.left, box.left);
+			bounds.top		= std::min(bounds.top, box.top);
+			bounds.right	= std::max(bounds.right, box.right);
+			bounds.bottom	= std::max(bounds.bottom, box.bottom);
+			if(i < lowest)
+				continue;
+
+			float cost = (bounds.right - bounds.left) * (bounds.bottom - bounds.top) * i + rightArea[i] * (count - i);
+			if(bestCost < 0.0f || cost < bestCost)
+			{
+				bestCost	= cost;
+				split		= i;
+				vertical	= sortVertical;
+			}
+		}
+	}
+	if(!vertical)
+		std::sort(m_HitBoxes.begin() + first, m_HitBoxes.begin() + first + count, HitBoxOrder(false));
+
+	int leftDepth = Build(first, split, depth + 1);
+	int rightDepth = Build(first + split, count - split, depth + 1);
+
+	// Missing an inner node skips all of its children
+	m_Nodes[index].skip		= (int)m_Nodes.size();
+	m_Nodes[index].first	= 0;
+	m_Nodes[index].count	= 0;
+	return std::max(leftDepth, rightDepth);
+}
+
+void CArena::AddTiles(const ArenaObstacle& obstacle)
+{
+	int across	= std::max(1, (int)(obstacle.width / ARENA_TILE_SIZE + 0.5f));
+	int down	= std::max(1, (int)(obstacle.height / ARENA_TILE_SIZE + 0.5f));
+	float stepX	= obstacle.width / across;
+	float stepY	= obstacle.height / down;
+	float scale	= std::min(stepX, stepY) / ARENA_TILE_SIZE;
+	unsigned int color = obstacle.type == ARENA_BUMPER ? 0xFFFF9040 : 0xFFA0A0B0;
+	float left	= obstacle.x - obstacle.width * 0.5f;
+	float top	= obstacle.y - obstacle.height * 0.5f;
+	for(int y = 0; y < down; ++y)
+	{
+		for(int x = 0; x < across; ++x)
+		{
+			m_TileX.push_back(left + (x + 0.5f) * stepX);
+			m_TileY.push_back(top + (y + 0.5f) * stepY);
+			m_TileScale.push_back(scale);
+			m_TileColor.push_back(color);
+		}
+	}
+}
+
+void CArena::GetBatch(const Viewport& view, SpriteBatch& batch) const
+{
+	size_t count = m_TileX.size();
+	bool moved = view.x != m_DrawView.x || view.y != m_DrawView.y || view.scale != m_DrawView.scale;
+	if(moved || m_DrawX.size() != count)
+	{
+		m_DrawX.resize(count);
+		m_DrawY.resize(count);
+		m_DrawScale.resize(count);
+		for(size_t i = 0; i < count; ++i)
+		{
+			m_DrawX[i]		= ViewportX(view, m_TileX[i]);
+			m_DrawY[i]		= ViewportY(view, m_TileY[i]);
+			m_DrawScale[i]	= m_TileScale[i] * view.scale;
+		}
+		m_DrawView = view;
+	}
+
+	batch.x		= count ? &m_DrawX[0] : 0;
+	batch.y		= count ? &m_DrawY[0] : 0;
+	batch.scale	= count ? &m_DrawScale[0] : 0;
+	batch.color	= count ? &m_TileColor[0] : 0;
+	batch.count	= (int)count;
+}
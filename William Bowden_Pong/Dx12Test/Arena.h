@@ -0,0 +1,167 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	Arena.h
+// Date:	October 19th, 2026
+// Purpose: Static obstacles on the playfield, loaded from an arena file
+//			and bounced off by the ball (see StepBall() in PongPhysics.h).
+//			The walls and goal lines stay where they always were, an
+//			arena only adds to them.  An arena file is one obstacle a
+//			line, centre and size in playfield pixels:
+//				; comment
+//				Name = Pillars
+//				Block = 400 150 40 80		; x y width height
+//				Bumper = 250 450 30 30
+//			A block bounces the ball off the side it hits, a bumper kicks
+//			it away from its centre whichever side it hits.
+//
+//			Obstacles are grown by the ball's size when the file is
+//			loaded, so the ball is a point against them, and a bounding
+//			volume hierarchy over them is built once.  Its nodes are one
+//			flat array in depth first order, each with the index to skip
+//			to when the ball misses it, so a query walks the array
+//			forwards with no stack and touches only the few nodes around
+//			the ball however many obstacles there are.
+//////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <string>
+#include <vector>
+#include "FixedPoint.h"
+#include "RenderTypes.h"
+#include "Viewport.h"
+
+// Most obstacles in one leaf of the hierarchy
+#define ARENA_LEAF_SIZE 4
+
+// Leaf bounds are grown by this many pixels, so a fixed point ball turned
+// into floats to walk the hierarchy can never miss an obstacle it touches
+#define ARENA_NODE_PADDING (1.0f / 64.0f)
+
+// Obstacles are drawn as tiles of the ball sprite, about this many pixels
+// across
+#define ARENA_TILE_SIZE 20
+
+enum ArenaObstacleType
+{
+	ARENA_BLOCK,						// Bounces off the side hit
+	ARENA_BUMPER						// Kicks the ball away from its centre
+};
+
+// As written in the file, for drawing
+struct ArenaObstacle
+{
+	ArenaObstacleType	type;
+	float				x, y;			// Centre, playfield pixels
+	float				width, height;
+};
+
+// An obstacle grown by the ball's size, what the ball's centre bounces off.
+// In the hierarchy's order, with both number types the match can be
+// played in.
+struct ArenaHitBox
+{
+	float				left, top, right, bottom;
+	CFixed				fixedLeft, fixedTop, fixedRight, fixedBottom;
+	ArenaObstacleType	type;
+	int					obstacle;		// Index in the file, breaks ties so every
+										// build of the hierarchy picks the same one
+};
+
+// 32 bytes, two to a cache line
+struct ArenaNode
+{
+	float				left, top, right, bottom;
+	int					skip;			// Next node to visit when this one is missed
+	int					first;			// First ArenaHitBox of a leaf
+	int					count;			// Hit boxes in a leaf, 0 for an inner node
+	int					pad;
+};
+
+class CArena
+{
+	std::string					m_Name;
+	std::vector<ArenaObstacle>	m_Obstacles;
+	std::vector<ArenaHitBox>	m_HitBoxes;
+	std::vector<ArenaNode>		m_Nodes;
+	int							m_nSkipped;		// Lines not loaded
+	int							m_nDepth;		// Deepest leaf, 1 for a lone root
+	int							m_nLeafSize;	// Most hit boxes in a leaf
+
+	// Tiles for DrawSprites(), in playfield pixels, and in screen pixels
+	// for the last Viewport
+	std::vector<float>			m_TileX, m_TileY, m_TileScale;
+	std::vector<unsigned int>	m_TileColor;
+	mutable std::vector<float>	m_DrawX, m_DrawY, m_DrawScale;
+	mutable Viewport			m_DrawView;
+
+	// Not copyable, it is large
+	CArena(const CArena&);
+	CArena& operator=(const CArena&);
+
+	int Build(int first, int count, int depth);
+	void AddTiles(const ArenaObstacle& obstacle);
+
+public:
+	CArena(void);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Load
+	// Parameters:	const char* fileName - Arena file to read
+	// Return:		bool - false if the file could not be opened
+	// Description:	Replaces any arena loaded before and builds its
+	//				hierarchy.  Lines that are not a name or an obstacle,
+	//				obstacles not wholly on the playfield and any covering
+	//				the serve in the middle are skipped and counted.
+	//////////////////////////////////////////////////////////////////////////
+	bool Load(const char* fileName);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Create
+	// Parameters:	const ArenaObstacle* obstacles - Obstacles to place
+	//				int count - How many
+	//				int leafSize - Most hit boxes in a leaf.  count or more
+	//					makes the root the only node, every box is tested
+	//					on every step, for timing against.
+	// Return:		void
+	// Description:	As Load() without a file, for the tools.
+	//////////////////////////////////////////////////////////////////////////
+	void Create(const ArenaObstacle* obstacles, int count, int leafSize = ARENA_LEAF_SIZE);
+
+	void Clear();
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		GetBatch
+	// Parameters:	const Viewport& view - Playfield to back buffer mapping
+	//				SpriteBatch& batch - Receives the tiles, drawn with the
+	//					ball texture
+	// Return:		void
+	// Description:	The tiles are only moved again when the viewport
+	//				changes.
+	//////////////////////////////////////////////////////////////////////////
+	void GetBatch(const Viewport& view, SpriteBatch& batch) const;
+
+	bool IsEmpty() const								{ return m_HitBoxes.empty(); }
+	const char* GetName() const							{ return m_Name.c_str(); }
+	int GetObstacleCount() const						{ return (int)m_Obstacles.size(); }
+	const ArenaObstacle& GetObstacle(int i) const		{ return m_Obstacles[i]; }
+	int GetSkippedCount() const							{ return m_nSkipped; }
+	int GetNodeCount() const							{ return (int)m_Nodes.size(); }
+	int GetDepth() const								{ return m_nDepth; }
+	const ArenaNode* GetNodes() const					{ return m_Nodes.empty() ? 0 : &m_Nodes[0]; }
+	const ArenaHitBox* GetHitBoxes() const				{ return m_HitBoxes.empty() ? 0 : &m_HitBoxes[0]; }
+};
+
+// A hit box's edges in the match's number type
+inline void GetArenaEdges(const ArenaHitBox& box, float& left, float& top, float& right, float& bottom)
+{
+	left	= box.left;
+	top		= box.top;
+	right	= box.right;
+	bottom	= box.bottom;
+}
+
+inline void GetArenaEdges(const ArenaHitBox& box, CFixed& left, CFixed& top, CFixed& right, CFixed& bottom)
+{
+	left	= box.fixedLeft;
+	top		= box.fixedTop;
+	right	= box.fixedRight;
+	bottom	= box.fixedBottom;
+}
@@ -0,0 +1,253 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	AssetReloader.cpp
+// Date:	October 19th, 2026
+// Purpose: Live reloading of the game's files, see AssetReloader.h.
+//////////////////////////////////////////////////////////////////////////
+#include "AssetReloader.h"
+#include "PongPlatform.h"
+#include <stdio.h>
+#include <ctype.h>
+#include <algorithm>
+
+namespace
+{
+	std::string Lower(const std::string& text)
+	{
+		std::string result(text);
+		for(size_t i = 0; i < result.size(); ++i)
+			result[i] = (char)tolower((unsigned char)result[i]);
+		return result;
+	}
+}
+
+CAssetReloader::CAssetReloader(void)
+{
+	m_bQuit		= false;
+	m_bRunning	= false;
+	m_nReloads	= 0;
+	m_nFailed	= 0;
+}
+
+CAssetReloader::~CAssetReloader(void)
+{
+	Shutdown();
+}
+
+bool CAssetReloader::Init(const char* directory)
+{
+	Shutdown();
+	m_Directory = directory;
+	m_bQuit = false;
+	m_Worker = std::thread(WorkerMain, this);
+	m_bRunning = true;
+
+	// Without a watcher Changed() still works
+	return m_Watcher.Init(directory);
+}
+
+void CAssetReloader::Shutdown()
+{
+	m_Watcher.Shutdown();
+	if(m_bRunning)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_bQuit = true;
+		}
+		m_Wake.notify_one();
+		m_Worker.join();
+		m_bRunning = false;
+	}
+
+	for(size_t i = 0; i < m_Queued.size(); ++i)
+		delete m_Queued[i];
+	for(size_t i = 0; i < m_Done.size(); ++i)
+		delete m_Done[i];
+	for(size_t i = 0; i < m_Spent.size(); ++i)
+		delete m_Spent[i];
+	m_Queued.clear();
+	m_Done.clear();
+	m_Spent.clear();
+	for(size_t i = 0; i < m_Assets.size(); ++i)
+	{
+		m_Assets[i].dirty	= false;
+		m_Assets[i].busy	= false;
+	}
+}
+
+void CAssetReloader::Watch(const char* fileName, AssetKind kind, int slot)
+{
+	WatchedAsset asset;
+	asset.name		= Lower(fileName);
+	asset.fileName	= fileName;
+	asset.kind		= kind;
+	asset.slot		= slot;
+	asset.changed	= 0.0;
+	asset.dirty		= false;
+	asset.busy		= false;
+	m_Assets.push_back(asset);
+}
+
+CAssetReloader::WatchedAsset* CAssetReloader::Find(const std::string& name)
+{
+	// Windows file names are not case sensitive and a handful of assets
+	// does not need more than a linear search
+	std::string lower = Lower(name);
+	for(size_t i = 0; i < m_Assets.size(); ++i)
+	{
+		if(m_Assets[i].name == lower)
+			return &m_Assets[i];
+	}
+	return 0;
+}
+
+bool CAssetReloader::Changed(const char* fileName, double now)
+{
+	WatchedAsset* asset = Find(fileName);
+	if(!asset)
+		return false;
+	asset->changed	= now;
+	asset->dirty	= true;
+	return true;
+}
+
+void CAssetReloader::Update(double now)
+{
+	m_Changed.clear();
+	m_Watcher.Poll(m_Changed);
+	for(size_t i = 0; i < m_Changed.size(); ++i)
+		Changed(m_Changed[i].c_str(), now);
+
+	if(!m_bRunning)
+		return;
+
+	// A file written again while it is being read waits for that read to
+	// be popped, so the reloads of one file arrive in order
+	bool queued = false;
+	for(size_t i = 0; i < m_Assets.size(); ++i)
+	{
+		WatchedAsset& asset = m_Assets[i];
+		if(!asset.dirty || asset.busy || now - asset.changed < ASSET_SETTLE_SECONDS)
+			continue;
+
+		AssetReload* reload = new AssetReload;
+		reload->kind		= asset.kind;
+		reload->slot		= asset.slot;
+		reload->fileName	= asset.fileName;
+		reload->ok			= false;
+		reload->readSeconds	= 0.0;
+		asset.dirty	= false;
+		asset.busy	= true;
+
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Queued.push_back(reload);
+		queued = true;
+	}
+	if(queued)
+		m_Wake.notify_one();
+}
+
+bool CAssetReloader::Pop(AssetReload& reload)
+{
+	AssetReload* done;
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		if(m_Done.empty())
+			return false;
+		done = m_Done.front();
+		m_Done.pop_front();
+	}
+
+	WatchedAsset* asset = Find(done->fileName);
+	if(asset)
+		asset->busy = false;
+
+	++m_nReloads;
+	if(!done->ok)
+		++m_nFailed;
+
+	// Swapped so the pixels are not copied on the game's thread
+	reload.kind			= done->kind;
+	reload.slot			= done->slot;
+	reload.fileName.swap(done->fileName);
+	reload.ok			= done->ok;
+	reload.readSeconds	= done->readSeconds;
+	reload.image.width	= done->image.width;
+	reload.image.height	= done->image.height;
+	reload.image.pixels.swap(done->image.pixels);
+	std::swap(reload.config, done->config);
+
+	// done now holds what reload held
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	m_Spent.push_back(done);
+	return true;
+}
+
+bool CAssetReloader::IsBusy() const
+{
+	for(size_t i = 0; i < m_Assets.size(); ++i)
+	{
+		if(m_Assets[i].busy)
+			return true;
+	}
+	return false;
+}
+
+void CAssetReloader::Read(AssetReload& reload) const
+{
+	double start = PlatformGetTime();
+	std::string path = m_Directory + "/" + reload.fileName;
+	switch(reload.kind)
+	{
+	case ASSET_TEXTURE:
+		reload.ok = LoadImageFile(path.c_str(), reload.image, IMAGE_COLORKEY_MAGENTA);
+		break;
+
+	case ASSET_CONFIG:
+		reload.ok = reload.config.Load(path.c_str());
+		break;
+
+	default:
+	{
+		// Only checks it can be opened, FMOD reads it
+		FILE* file = fopen(path.c_str(), "rb");
+		reload.ok = file != 0;
+		if(file)
+			fclose(file);
+		break;
+	}
+	}
+	reload.readSeconds = PlatformGetTime() - start;
+}
+
+void CAssetReloader::WorkerMain(CAssetReloader* reloader)
+{
+	// Decoding can wait, the frame cannot
+	PlatformLowerThreadPriority();
+
+	for(;;)
+	{
+		AssetReload* reload;
+		std::vector<AssetReload*> spent;
+		{
+			std::unique_lock<std::mutex> lock(reloader->m_Mutex);
+			while(!reloader->m_bQuit && reloader->m_Queued.empty())
+				reloader->m_Wake.wait(lock);
+			if(reloader->m_bQuit)
+				return;
+			reload = reloader->m_Queued.front();
+			reloader->m_Queued.pop_front();
+			spent.swap(reloader->m_Spent);
+		}
+
+		for(size_t i = 0; i < spent.size(); ++i)
+			delete spent[i];
+
+		// Outside the lock, so the game's Update() and Pop() never wait
+		// on the disk
+		reloader->Read(*reload);
+
+		std::lock_guard<std::mutex> lock(reloader->m_Mutex);
+		reloader->m_Done.push_back(reload);
+	}
+}
@@ -0,0 +1,153 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	AssetReloader.h
+// Date:	October 19th, 2026
+// Purpose: Reloads the game's files while it runs.  The files to reload
+//			are registered with Watch(), a CFileWatcher reports writes to
+//			them and once a file has been quiet for ASSET_SETTLE_SECONDS
+//			(editors save in several writes) a worker thread reads it:
+//			images are decoded and colour keyed, settings files parsed.
+//			The game calls Update() and Pop() between frames and swaps
+//			in what Pop() hands back, so the frame itself only ever sees
+//			the old or the new version and never waits on the disk.
+//			Sounds are only reported, FMOD loads them on its own thread
+//			(FMOD_NONBLOCKING).
+//////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "FileWatcher.h"
+#include "ImageFile.h"
+#include "ConfigFile.h"
+
+// Seconds a file must go unwritten before it is reloaded
+#define ASSET_SETTLE_SECONDS 0.1
+
+enum AssetKind
+{
+	ASSET_TEXTURE,						// Decoded into AssetReload::image
+	ASSET_SOUND,						// Only reported
+	ASSET_CONFIG						// Parsed into AssetReload::config
+};
+
+struct AssetReload
+{
+	AssetKind			kind;
+	int					slot;			// What Watch() was given
+	std::string			fileName;
+	bool				ok;				// false if the file could not be read
+	double				readSeconds;	// Time the worker spent on it
+	SpriteImage			image;
+	CConfigFile			config;
+};
+
+class CAssetReloader
+{
+	struct WatchedAsset
+	{
+		std::string		name;			// Lower case, for matching
+		std::string		fileName;		// As given to Watch()
+		AssetKind		kind;
+		int				slot;
+		double			changed;		// Last write seen
+		bool			dirty;			// Written since it was last read
+		bool			busy;			// With the worker or not popped yet
+	};
+
+	CFileWatcher				m_Watcher;
+	std::string					m_Directory;
+	std::vector<WatchedAsset>	m_Assets;
+	std::vector<std::string>	m_Changed;	// Reused by Update()
+
+	std::thread					m_Worker;
+	std::mutex					m_Mutex;
+	std::condition_variable		m_Wake;
+	std::deque<AssetReload*>	m_Queued;	// Waiting for the worker
+	std::deque<AssetReload*>	m_Done;		// Waiting for Pop()
+	std::vector<AssetReload*>	m_Spent;	// What Pop() swapped out, freed by the worker
+	bool						m_bQuit;
+	bool						m_bRunning;
+
+	int							m_nReloads;
+	int							m_nFailed;
+
+	CAssetReloader(const CAssetReloader&);
+	CAssetReloader& operator=(const CAssetReloader&);
+
+	static void WorkerMain(CAssetReloader* reloader);
+	void Read(AssetReload& reload) const;
+	WatchedAsset* Find(const std::string& name);
+
+public:
+	CAssetReloader(void);
+	~CAssetReloader(void);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Init
+	// Parameters:	const char* directory - Where the files are, "." for
+	//					the working directory
+	// Return:		bool - false if the directory cannot be watched, the
+	//				game then runs on without reloading
+	// Description:	Starts the watcher and the worker thread.
+	//////////////////////////////////////////////////////////////////////////
+	bool Init(const char* directory);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Shutdown
+	// Parameters:	void
+	// Return:		void
+	// Description:	Stops the worker and drops reloads not yet popped.
+	//////////////////////////////////////////////////////////////////////////
+	void Shutdown();
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Watch
+	// Parameters:	const char* fileName - File in the directory
+	//				AssetKind kind - How to read it
+	//				int slot - Handed back with the reload, e.g. which
+	//					texture it is
+	// Return:		void
+	// Description:	Reloads the file whenever it is written.
+	//////////////////////////////////////////////////////////////////////////
+	void Watch(const char* fileName, AssetKind kind, int slot);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Update
+	// Parameters:	double now - PlatformGetTime()
+	// Return:		void
+	// Description:	Collects writes from the watcher and hands settled
+	//				files to the worker.  Never waits.
+	//////////////////////////////////////////////////////////////////////////
+	void Update(double now);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Changed
+	// Parameters:	const char* fileName - File that was written
+	//				double now - PlatformGetTime()
+	// Return:		bool - false if the file is not watched
+	// Description:	What Update() does for each write it is told about,
+	//				for reloading without a watcher.
+	//////////////////////////////////////////////////////////////////////////
+	bool Changed(const char* fileName, double now);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Pop
+	// Parameters:	AssetReload& reload - Receives a finished reload, its
+	//					previous contents are swapped out, not copied
+	// Return:		bool - false if none has finished
+	// Description:	Oldest first.  Never waits, and the previous contents
+	//				are freed on the worker, a large image takes a
+	//				millisecond to hand back to the system.
+	//////////////////////////////////////////////////////////////////////////
+	bool Pop(AssetReload& reload);
+
+	// Reloads started but not popped yet
+	bool IsBusy() const;
+
+	bool IsWatching() const				{ return m_Watcher.IsWatching(); }
+	int GetReloadCount() const			{ return m_nReloads; }
+	int GetFailedCount() const			{ return m_nFailed; }
+};
@@ -0,0 +1,36 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	CaptureConfig.h
+// Date:	October 19th, 2026
+// Purpose: Fills a FrameCaptureDesc from the [Capture] section of the
+//			settings file (PONG_CONFIG_FILE):
+//				Enabled			1 to record every frame the game draws
+//				Format			PNG for a numbered image per frame, Raw
+//								for one raw video file
+//				Path			File name prefix for PNG, the file for Raw
+//				Buffers			Frames waiting to be written before more
+//								are dropped
+//				Threads			Encoder threads, PNG only
+//			Missing keys keep the value already in the FrameCaptureDesc.
+//			The path points into the config, Init() the capture before
+//			the config goes.
+//////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <string.h>
+#include "ConfigFile.h"
+#include "FrameCapture.h"
+
+// Returns [Capture] Enabled
+inline bool ReadCaptureConfig(const CConfigFile& config, FrameCaptureDesc& desc)
+{
+	desc.path		= config.GetString("Capture", "Path", desc.path);
+	desc.buffers	= config.GetInt("Capture", "Buffers", desc.buffers);
+	desc.threads	= config.GetInt("Capture", "Threads", desc.threads);
+
+	const char* format = config.GetString("Capture", "Format", "");
+	if(!strcmp(format, "PNG"))		desc.format = CAPTURE_PNG;
+	else if(!strcmp(format, "Raw"))	desc.format = CAPTURE_RAW;
+
+	if(desc.buffers < 1)	desc.buffers = 1;
+	if(desc.threads < 1)	desc.threads = 1;
+	return config.GetBool("Capture", "Enabled", false);
+}
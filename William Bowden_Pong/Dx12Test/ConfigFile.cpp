@@ -0,0 +1,119 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	ConfigFile.cpp
+// Date:	October 19th, 2026
+// Purpose: INI style settings files, see ConfigFile.h.
+//////////////////////////////////////////////////////////////////////////
+#include "ConfigFile.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+namespace
+{
+	std::string Trim(const std::string& text)
+	{
+		size_t first = 0;
+		size_t last = text.size();
+		while(first < last && isspace((unsigned char)text[first]))
+			++first;
+		while(last > first && isspace((unsigned char)text[last - 1]))
+			--last;
+		return text.substr(first, last - first);
+	}
+
+	std::string Lower(const std::string& text)
+	{
+		std::string result(text);
+		for(size_t i = 0; i < result.size(); ++i)
+			result[i] = (char)tolower((unsigned char)result[i]);
+		return result;
+	}
+}
+
+std::string CConfigFile::MakeKey(const char* section, const char* key)
+{
+	return Lower(Trim(section)) + "." + Lower(Trim(key));
+}
+
+bool CConfigFile::Load(const char* fileName)
+{
+	FILE* file = fopen(fileName, "r");
+	if(!file)
+		return false;
+
+	m_Values.clear();
+	std::string section;
+	char line[1024];
+	while(fgets(line, sizeof(line), file))
+	{
+		// Everything after ; or # is a comment
+		char* comment = strpbrk(line, ";#");
+		if(comment)
+			*comment = 0;
+
+		std::string text = Trim(line);
+		if(text.empty())
+			continue;
+
+		if(text[0] == '[')
+		{
+			size_t end = text.find(']');
+			if(end != std::string::npos)
+				section = text.substr(1, end - 1);
+			continue;
+		}
+
+		size_t equals = text.find('=');
+		if(equals == std::string::npos)
+			continue;
+		m_Values[MakeKey(section.c_str(), text.substr(0, equals).c_str())] = Trim(text.substr(equals + 1));
+	}
+
+	fclose(file);
+	return true;
+}
+
+bool CConfigFile::Has(const char* section, const char* key) const
+{
+	return m_Values.find(MakeKey(section, key)) != m_Values.end();
+}
+
+const char* CConfigFile::GetString(const char* section, const char* key, const char* def) const
+{
+	std::map<std::string, std::string>::const_iterator it = m_Values.find(MakeKey(section, key));
+	return it != m_Values.end() ? it->second.c_str() : def;
+}
+
+int CConfigFile::GetInt(const char* section, const char* key, int def) const
+{
+	const char* value = GetString(section, key, 0);
+	if(!value)
+		return def;
+	char* end;
+	long result = strtol(value, &end, 0);
+	return (end != value && *end == 0) ? (int)result : def;
+}
+
+float CConfigFile::GetFloat(const char* section, const char* key, float def) const
+{
+	const char* value = GetString(section, key, 0);
+	if(!value)
+		return def;
+	char* end;
+	double result = strtod(value, &end);
+	return (end != value && *end == 0) ? (float)result : def;
+}
+
+bool CConfigFile::GetBool(const char* section, const char* key, bool def) const
+{
+	const char* value = GetString(section, key, 0);
+	if(!value)
+		return def;
+	std::string text = Lower(value);
+	if(text == "1" || text == "true" || text == "yes" || text == "on")
+		return true;
+	if(text == "0" || text == "false" || text == "no" || text == "off")
+		return false;
+	return def;
+}
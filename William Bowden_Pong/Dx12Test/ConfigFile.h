@@ -0,0 +1,40 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	ConfigFile.h
+// Date:	October 19th, 2026
+// Purpose: Reads INI style settings files:
+//				[Section]
+//				Key = Value		; comment
+//			Section and key names are not case sensitive.  Portable, so
+//			the headless tools read the same files as the game.
+//////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <string>
+#include <map>
+
+// Game settings, read from the working directory
+#define PONG_CONFIG_FILE "Pong.ini"
+
+class CConfigFile
+{
+	std::map<std::string, std::string>	m_Values;	// "section.key" in lower case, to value
+
+	static std::string MakeKey(const char* section, const char* key);
+
+public:
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Load
+	// Parameters:	const char* fileName - File to read
+	// Return:		bool - false if the file could not be opened
+	// Description:	Replaces any settings read before.  Lines that are not
+	//				a section or a key = value pair are ignored.
+	//////////////////////////////////////////////////////////////////////////
+	bool Load(const char* fileName);
+
+	bool Has(const char* section, const char* key) const;
+
+	// Each returns def when the key is missing or not a number
+	const char* GetString(const char* section, const char* key, const char* def) const;
+	int GetInt(const char* section, const char* key, int def) const;
+	float GetFloat(const char* section, const char* key, float def) const;
+	bool GetBool(const char* section, const char* key, bool def) const;
+};
@@ -0,0 +1,695 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	CookedTexture.cpp
+// Date:	October 19th, 2026
+// Purpose: Mip generation, BC1/BC3 encoding and decoding and the .ptx
+//			file, see CookedTexture.h.
+//////////////////////////////////////////////////////////////////////////
+#include "CookedTexture.h"
+#include "ThreadPool.h"
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <sys/stat.h>
+
+namespace
+{
+	//////////////////////////////////////////////////////////////////////////
+	// Mip levels
+	//////////////////////////////////////////////////////////////////////////
+
+	// Level 0, the source with transparent texels out to a whole block
+	void PadToBlocks(const SpriteImage& image, SpriteImage& padded)
+	{
+		padded.width	= (image.width + 3) & ~3;
+		padded.height	= (image.height + 3) & ~3;
+		padded.pixels.assign((size_t)padded.width * padded.height, 0);
+		for(int y = 0; y < image.height; ++y)
+		{
+			memcpy(&padded.pixels[(size_t)y * padded.width], &image.pixels[(size_t)y * image.width],
+				image.width * sizeof(unsigned int));
+		}
+	}
+
+	// Averages 2x2 texels weighted by alpha, so a transparent texel adds
+	// no colour.  Odd sizes repeat the last row or column.
+	void Downsample(const SpriteImage& source, int width, int height, SpriteImage& target)
+	{
+		target.width	= width;
+		target.height	= height;
+		target.pixels.resize((size_t)width * height);
+		for(int y = 0; y < height; ++y)
+		{
+			int y0 = y * 2 < source.height ? y * 2 : source.height - 1;
+			int y1 = y0 + 1 < source.height ? y0 + 1 : y0;
+			for(int x = 0; x < width; ++x)
+			{
+				int x0 = x * 2 < source.width ? x * 2 : source.width - 1;
+				int x1 = x0 + 1 < source.width ? x0 + 1 : x0;
+				unsigned int texels[4] =
+				{
+					source.pixels[(size_t)y0 * source.width + x0], source.pixels[(size_t)y0 * source.width + x1],
+					source.pixels[(size_t)y1 * source.width + x0], source.pixels[(size_t)y1 * source.width + x1]
+				};
+
+				unsigned int alpha = 0, red = 0, green = 0, blue = 0;
+				for(int i = 0; i < 4; ++i)
+				{
+					unsigned int a = texels[i] >> 24;
+					alpha	+= a;
+					red		+= ((texels[i] >> 16) & 0xFF) * a;
+					green	+= ((texels[i] >> 8) & 0xFF) * a;
+					blue	+= (texels[i] & 0xFF) * a;
+				}
+				unsigned int pixel = 0;
+				if(alpha > 0)
+				{
+					pixel = ((alpha + 2) / 4) << 24 | ((red + alpha / 2) / alpha) << 16 |
+						((green + alpha / 2) / alpha) << 8 | (blue + alpha / 2) / alpha;
+				}
+				target.pixels[(size_t)y * width + x] = pixel;
+			}
+		}
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// Colour blocks
+	//////////////////////////////////////////////////////////////////////////
+	struct Color
+	{
+		float			r, g, b;
+	};
+
+	unsigned short To565(const Color& c)
+	{
+		int r = (int)floorf(c.r * (31.0f / 255.0f) + 0.5f);
+		int g = (int)floorf(c.g * (63.0f / 255.0f) + 0.5f);
+		int b = (int)floorf(c.b * (31.0f / 255.0f) + 0.5f);
+		r = r < 0 ? 0 : (r > 31 ? 31 : r);
+		g = g < 0 ? 0 : (g > 63 ? 63 : g);
+		b = b < 0 ? 0 : (b > 31 ? 31 : b);
+		return (unsigned short)(r << 11 | g << 5 | b);
+	}
+
+	// 565 to 888 the way the hardware expands it
+	void From565(unsigned short c, int rgb[3])
+	{
+		int r = c >> 11, g = (c >> 5) & 63, b = c & 31;
+		rgb[0] = r << 3 | r >> 2;
+		rgb[1] = g << 2 | g >> 4;
+		rgb[2] = b << 3 | b >> 2;
+	}
+
+	// The block's colours.  In three colour mode the last is transparent
+	// black.
+	void MakePalette(unsigned short c0, unsigned short c1, bool fourColors, int palette[4][3])
+	{
+		From565(c0, palette[0]);
+		From565(c1, palette[1]);
+		for(int i = 0; i < 3; ++i)
+		{
+			if(fourColors)
+			{
+				palette[2][i] = (2 * palette[0][i] + palette[1][i]) / 3;
+				palette[3][i] = (palette[0][i] + 2 * palette[1][i]) / 3;
+			}
+			else
+			{
+				palette[2][i] = (palette[0][i] + palette[1][i]) / 2;
+				palette[3][i] = 0;
+			}
+		}
+	}
+
+	// Picks the nearest colour for every texel in use and returns the
+	// squared error.  Texels not in use get index 3, transparent in three
+	// colour mode.
+	int PickIndices(const unsigned int* texels, const bool* used, unsigned short c0, unsigned short c1,
+					bool fourColors, unsigned int& indices)
+	{
+		int palette[4][3];
+		MakePalette(c0, c1, fourColors, palette);
+		int choices = fourColors ? 4 : 3;
+
+		int error = 0;
+		indices = 0;
+		for(int i = 0; i < 16; ++i)
+		{
+			int best = 3;
+			if(used[i])
+			{
+				int r = (texels[i] >> 16) & 0xFF, g = (texels[i] >> 8) & 0xFF, b = texels[i] & 0xFF;
+				int bestError = 0x7FFFFFFF;
+				for(int j = 0; j < choices; ++j)
+				{
+					int dr = r - palette[j][0], dg = g - palette[j][1], db = b - palette[j][2];
+					int e = dr * dr + dg * dg + db * db;
+					if(e < bestError)
+					{
+						bestError = e;
+						best = j;
+					}
+				}
+				error += bestError;
+			}
+			indices |= (unsigned int)best << (i * 2);
+		}
+		return error;
+	}
+
+	// Quantises the endpoints, orders them for the mode (four colours
+	// need c0 > c1, three colours c0 <= c1) and picks indices.  Returns
+	// the squared error.
+	int FinishColorBlock(const unsigned int* texels, const bool* used, const Color& e0, const Color& e1,
+						 bool fourColors, unsigned short& c0, unsigned short& c1, unsigned int& indices)
+	{
+		c0 = To565(e0);
+		c1 = To565(e1);
+		if((fourColors && c0 < c1) || (!fourColors && c0 > c1))
+		{
+			unsigned short swap = c0;
+			c0 = c1;
+			c1 = swap;
+		}
+
+		// Equal endpoints read as three colour mode, where index 3 would be
+		// transparent, so only the first three are used
+		if(c0 == c1)
+			fourColors = false;
+		return PickIndices(texels, used, c0, c1, fourColors, indices);
+	}
+
+	// Endpoints that best fit the texels given the indices they were
+	// picked, by least squares on where each index sits between the two.
+	// false if every texel has the same index.
+	bool RefitEndpoints(const unsigned int* texels, const bool* used, unsigned int indices, bool fourColors,
+						Color& e0, Color& e1)
+	{
+		static const float fourWeights[4] = { 1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f };
+		static const float threeWeights[4] = { 1.0f, 0.0f, 0.5f, 0.0f };
+		const float* weights = fourColors ? fourWeights : threeWeights;
+
+		float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+		Color ax = { 0.0f, 0.0f, 0.0f };
+		Color bx = { 0.0f, 0.0f, 0.0f };
+		for(int i = 0; i < 16; ++i)
+		{
+			if(!used[i])
+				continue;
+			float w = weights[(indices >> (i * 2)) & 3];
+			float r = (float)((texels[i] >> 16) & 0xFF);
+			float g = (float)((texels[i] >> 8) & 0xFF);
+			float b = (float)(texels[i] & 0xFF);
+			aa += w * w;
+			ab += w * (1.0f - w);
+			bb += (1.0f - w) * (1.0f - w);
+			ax.r += w * r;
+			ax.g += w * g;
+			ax.b += w * b;
+			bx.r += (1.0f - w) * r;
+			bx.g += (1.0f - w) * g;
+			bx.b += (1.0f - w) * b;
+		}
+		float det = aa * bb - ab * ab;
+		if(det < 1e-3f)
+			return false;
+		e0.r = (bb * ax.r - ab * bx.r) / det;
+		e0.g = (bb * ax.g - ab * bx.g) / det;
+		e0.b = (bb * ax.b - ab * bx.b) / det;
+		e1.r = (aa * bx.r - ab * ax.r) / det;
+		e1.g = (aa * bx.g - ab * ax.g) / det;
+		e1.b = (aa * bx.b - ab * ax.b) / det;
+		return true;
+	}
+
+	void WriteLE16(unsigned char* p, unsigned int v)
+	{
+		p[0] = (unsigned char)v;
+		p[1] = (unsigned char)(v >> 8);
+	}
+
+	void WriteLE32(unsigned char* p, unsigned int v)
+	{
+		p[0] = (unsigned char)v;
+		p[1] = (unsigned char)(v >> 8);
+		p[2] = (unsigned char)(v >> 16);
+		p[3] = (unsigned char)(v >> 24);
+	}
+
+	unsigned int ReadLE32(const unsigned char* p)
+	{
+		return (unsigned int)p[0] | (unsigned int)p[1] << 8 | (unsigned int)p[2] << 16 | (unsigned int)p[3] << 24;
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		EncodeColorBlock
+	// Parameters:	const unsigned int* texels - 16 ARGB texels, rows of 4
+	//				bool punchThrough - BC1: texels under half alpha are
+	//					made transparent with three colour mode.  BC3:
+	//					false, alpha is in its own block and only texels
+	//					with any alpha are fitted.
+	//				unsigned char* out - Receives 8 bytes
+	// Return:		void
+	// Description:	Endpoints at the ends of the texels' principal axis,
+	//				then refitted once to the indices they gave.
+	//////////////////////////////////////////////////////////////////////////
+	void EncodeColorBlock(const unsigned int* texels, bool punchThrough, unsigned char* out)
+	{
+		bool used[16];
+		int count = 0;
+		Color mean = { 0.0f, 0.0f, 0.0f };
+		for(int i = 0; i < 16; ++i)
+		{
+			unsigned int alpha = texels[i] >> 24;
+			used[i] = punchThrough ? alpha >= 128 : alpha > 0;
+			if(used[i])
+			{
+				++count;
+				mean.r += (float)((texels[i] >> 16) & 0xFF);
+				mean.g += (float)((texels[i] >> 8) & 0xFF);
+				mean.b += (float)(texels[i] & 0xFF);
+			}
+		}
+
+		// Nothing visible: equal endpoints and every index transparent
+		unsigned short c0 = 0, c1 = 0;
+		unsigned int indices = 0xFFFFFFFF;
+		if(count > 0)
+		{
+			bool fourColors = !punchThrough || count == 16;
+			mean.r /= count;
+			mean.g /= count;
+			mean.b /= count;
+
+			// Covariance, then its main axis by a few power iterations
+			// from the row with the most variance
+			float cov[3][3] = { { 0.0f } };
+			for(int i = 0; i < 16; ++i)
+			{
+				if(!used[i])
+					continue;
+				float d[3] =
+				{
+					(float)((texels[i] >> 16) & 0xFF) - mean.r,
+					(float)((texels[i] >> 8) & 0xFF) - mean.g,
+					(float)(texels[i] & 0xFF) - mean.b
+				};
+				for(int j = 0; j < 3; ++j)
+				{
+					for(int k = 0; k < 3; ++k)
+						cov[j][k] += d[j] * d[k];
+				}
+			}
+			int row = cov[1][1] > cov[0][0] ? 1 : 0;
+			row = cov[2][2] > cov[row][row] ? 2 : row;
+			float axis[3] = { cov[row][0], cov[row][1], cov[row][2] };
+			for(int iteration = 0; iteration < 4; ++iteration)
+			{
+				float next[3];
+				for(int j = 0; j < 3; ++j)
+					next[j] = cov[j][0] * axis[0] + cov[j][1] * axis[1] + cov[j][2] * axis[2];
+				float length = sqrtf(next[0] * next[0] + next[1] * next[1] + next[2] * next[2]);
+				if(length < 1e-6f)
+					break;
+				for(int j = 0; j < 3; ++j)
+					axis[j] = next[j] / length;
+			}
+			float length = sqrtf(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+			for(int j = 0; j < 3; ++j)
+				axis[j] = length > 1e-6f ? axis[j] / length : 0.0f;
+
+			// The texels' extent along the axis
+			float lowest = 0.0f, highest = 0.0f;
+			for(int i = 0; i < 16; ++i)
+			{
+				if(!used[i])
+					continue;
+				float t = ((float)((texels[i] >> 16) & 0xFF) - mean.r) * axis[0] +
+					((float)((texels[i] >> 8) & 0xFF) - mean.g) * axis[1] + ((float)(texels[i] & 0xFF) - mean.b) * axis[2];
+				lowest = t < lowest ? t : lowest;
+				highest = t > highest ? t : highest;
+			}
+			Color e0 = { mean.r + axis[0] * highest, mean.g + axis[1] * highest, mean.b + axis[2] * highest };
+			Color e1 = { mean.r + axis[0] * lowest, mean.g + axis[1] * lowest, mean.b + axis[2] * lowest };
+			int error = FinishColorBlock(texels, used, e0, e1, fourColors, c0, c1, indices);
+
+			// Refit to the indices that came out, keep it if it is better
+			unsigned short r0, r1;
+			unsigned int refitIndices;
+			if(c0 != c1 && RefitEndpoints(texels, used, indices, fourColors, e0, e1) &&
+				FinishColorBlock(texels, used, e0, e1, fourColors, r0, r1, refitIndices) < error)
+			{
+				c0		= r0;
+				c1		= r1;
+				indices	= refitIndices;
+			}
+		}
+
+		WriteLE16(out, c0);
+		WriteLE16(out + 2, c1);
+		WriteLE32(out + 4, indices);
+	}
+
+	// BC3 alpha: the block's lowest and highest alpha with six steps
+	// between
+	void EncodeAlphaBlock(const unsigned int* texels, unsigned char* out)
+	{
+		int lowest = 255, highest = 0;
+		for(int i = 0; i < 16; ++i)
+		{
+			int alpha = (int)(texels[i] >> 24);
+			lowest = alpha < lowest ? alpha : lowest;
+			highest = alpha > highest ? alpha : highest;
+		}
+
+		unsigned long long bits = 0;
+		if(highest > lowest)
+		{
+			int palette[8];
+			palette[0] = highest;
+			palette[1] = lowest;
+			for(int i = 2; i < 8; ++i)
+				palette[i] = ((8 - i) * highest + (i - 1) * lowest) / 7;
+			for(int i = 0; i < 16; ++i)
+			{
+				int alpha = (int)(texels[i] >> 24);
+				int best = 0;
+				for(int j = 1; j < 8; ++j)
+				{
+					int d = alpha - palette[j], bestD = alpha - palette[best];
+					if(d * d < bestD * bestD)
+						best = j;
+				}
+				bits |= (unsigned long long)best << (i * 3);
+			}
+		}
+
+		out[0] = (unsigned char)highest;
+		out[1] = (unsigned char)lowest;
+		for(int i = 0; i < 6; ++i)
+			out[2 + i] = (unsigned char)(bits >> (i * 8));
+	}
+
+	void DecodeColorBlock(const unsigned char* in, bool alwaysFour, unsigned int* texels)
+	{
+		unsigned short c0 = (unsigned short)(in[0] | in[1] << 8);
+		unsigned short c1 = (unsigned short)(in[2] | in[3] << 8);
+		unsigned int indices = ReadLE32(in + 4);
+		bool fourColors = alwaysFour || c0 > c1;
+		int palette[4][3];
+		MakePalette(c0, c1, fourColors, palette);
+		for(int i = 0; i < 16; ++i)
+		{
+			int index = (indices >> (i * 2)) & 3;
+			unsigned int alpha = (!fourColors && index == 3) ? 0 : 0xFF;
+			texels[i] = alpha << 24 | (unsigned int)palette[index][0] << 16 | (unsigned int)palette[index][1] << 8 |
+				(unsigned int)palette[index][2];
+		}
+	}
+
+	void DecodeAlphaBlock(const unsigned char* in, unsigned int* texels)
+	{
+		int a0 = in[0], a1 = in[1];
+		int palette[8];
+		palette[0] = a0;
+		palette[1] = a1;
+		if(a0 > a1)
+		{
+			for(int i = 2; i < 8; ++i)
+				palette[i] = ((8 - i) * a0 + (i - 1) * a1) / 7;
+		}
+		else
+		{
+			for(int i = 2; i < 6; ++i)
+				palette[i] = ((6 - i) * a0 + (i - 1) * a1) / 5;
+			palette[6] = 0;
+			palette[7] = 255;
+		}
+
+		unsigned long long bits = 0;
+		for(int i = 0; i < 6; ++i)
+			bits |= (unsigned long long)in[2 + i] << (i * 8);
+		for(int i = 0; i < 16; ++i)
+			texels[i] = (texels[i] & 0x00FFFFFF) | (unsigned int)palette[(bits >> (i * 3)) & 7] << 24;
+	}
+
+	// One level being encoded, a task per row of blocks
+	struct LevelJob
+	{
+		const SpriteImage*	image;
+		CookedFormat		format;
+		unsigned char*		out;
+		int					blocksWide;
+		int					pitch;
+	};
+
+	void EncodeRowTask(void* context, int row, int thread)
+	{
+		(void)thread;
+		const LevelJob& job = *(const LevelJob*)context;
+		const SpriteImage& image = *job.image;
+		int blockBytes = GetCookedBlockBytes(job.format);
+		for(int column = 0; column < job.blocksWide; ++column)
+		{
+			// Levels smaller than a block repeat their last texel
+			unsigned int texels[16];
+			for(int y = 0; y < 4; ++y)
+			{
+				int sy = row * 4 + y < image.height ? row * 4 + y : image.height - 1;
+				for(int x = 0; x < 4; ++x)
+				{
+					int sx = column * 4 + x < image.width ? column * 4 + x : image.width - 1;
+					texels[y * 4 + x] = image.pixels[(size_t)sy * image.width + sx];
+				}
+			}
+
+			unsigned char* block = job.out + (size_t)row * job.pitch + column * blockBytes;
+			if(job.format == COOKED_BC1)
+			{
+				EncodeColorBlock(texels, true, block);
+			}
+			else
+			{
+				EncodeAlphaBlock(texels, block);
+				EncodeColorBlock(texels, false, block + 8);
+			}
+		}
+	}
+
+	bool GetModifiedTime(const char* fileName, long long& time)
+	{
+#ifdef _WIN32
+		struct _stat info;
+		if(_stat(fileName, &info) != 0)
+			return false;
+#else
+		struct stat info;
+		if(stat(fileName, &info) != 0)
+			return false;
+#endif
+		time = (long long)info.st_mtime;
+		return true;
+	}
+}
+
+CookedFormat ChooseCookedFormat(const SpriteImage& image)
+{
+	for(size_t i = 0; i < image.pixels.size(); ++i)
+	{
+		unsigned int alpha = image.pixels[i] >> 24;
+		if(alpha != 0 && alpha != 0xFF)
+			return COOKED_BC3;
+	}
+	return COOKED_BC1;
+}
+
+bool CookTexture(const SpriteImage& image, CookedFormat format, CookedTexture& cooked, CThreadPool* pool)
+{
+	if(image.width <= 0 || image.height <= 0 || image.pixels.size() < (size_t)image.width * image.height)
+		return false;
+
+	SpriteImage level;
+	PadToBlocks(image, level);
+
+	// Every level down to 1x1, each half the size of level 0 again
+	cooked.format	= format;
+	cooked.width	= image.width;
+	cooked.height	= image.height;
+	cooked.levels.clear();
+	int blockBytes = GetCookedBlockBytes(format);
+	size_t offset = 0;
+	for(int i = 0; i < COOKED_TEXTURE_MAX_LEVELS; ++i)
+	{
+		CookedLevel info;
+		info.width	= level.width >> i > 0 ? level.width >> i : 1;
+		info.height	= level.height >> i > 0 ? level.height >> i : 1;
+		info.pitch	= (info.width + 3) / 4 * blockBytes;
+		info.size	= (size_t)info.pitch * ((info.height + 3) / 4);
+		info.offset	= offset;
+		offset += info.size;
+		cooked.levels.push_back(info);
+		if(info.width == 1 && info.height == 1)
+			break;
+	}
+	cooked.data.resize(offset);
+
+	SpriteImage next;
+	for(size_t i = 0; i < cooked.levels.size(); ++i)
+	{
+		const CookedLevel& info = cooked.levels[i];
+		if(i > 0)
+		{
+			Downsample(level, info.width, info.height, next);
+			level.pixels.swap(next.pixels);
+			level.width		= next.width;
+			level.height	= next.height;
+		}
+
+		LevelJob job;
+		job.image		= &level;
+		job.format		= format;
+		job.out			= &cooked.data[info.offset];
+		job.blocksWide	= (info.width + 3) / 4;
+		job.pitch		= info.pitch;
+		int rows = (info.height + 3) / 4;
+		if(pool)
+		{
+			pool->Run(rows, EncodeRowTask, &job);
+		}
+		else
+		{
+			for(int row = 0; row < rows; ++row)
+				EncodeRowTask(&job, row, 0);
+		}
+	}
+	return true;
+}
+
+void DecodeCookedLevel(const CookedTexture& cooked, int level, SpriteImage& image)
+{
+	const CookedLevel& info = cooked.levels[level];
+	int blockBytes = GetCookedBlockBytes(cooked.format);
+	image.width		= info.width;
+	image.height	= info.height;
+	image.pixels.resize((size_t)info.width * info.height);
+	for(int by = 0; by * 4 < info.height; ++by)
+	{
+		for(int bx = 0; bx * 4 < info.width; ++bx)
+		{
+			const unsigned char* block = &cooked.data[info.offset + (size_t)by * info.pitch + bx * blockBytes];
+			unsigned int texels[16];
+			if(cooked.format == COOKED_BC1)
+			{
+				DecodeColorBlock(block, false, texels);
+			}
+			else
+			{
+				DecodeColorBlock(block + 8, true, texels);
+				DecodeAlphaBlock(block, texels);
+			}
+			for(int y = 0; y < 4 && by * 4 + y < info.height; ++y)
+			{
+				for(int x = 0; x < 4 && bx * 4 + x < info.width; ++x)
+					image.pixels[(size_t)(by * 4 + y) * info.width + bx * 4 + x] = texels[y * 4 + x];
+			}
+		}
+	}
+}
+
+bool WriteCookedTexture(const char* fileName, const CookedTexture& cooked)
+{
+	std::vector<unsigned char> header(24 + cooked.levels.size() * 8);
+	memcpy(&header[0], "PTEX", 4);
+	WriteLE32(&header[4], COOKED_TEXTURE_VERSION);
+	WriteLE32(&header[8], (unsigned int)cooked.format);
+	WriteLE32(&header[12], (unsigned int)cooked.width);
+	WriteLE32(&header[16], (unsigned int)cooked.height);
+	WriteLE32(&header[20], (unsigned int)cooked.levels.size());
+	for(size_t i = 0; i < cooked.levels.size(); ++i)
+	{
+		WriteLE32(&header[24 + i * 8], (unsigned int)cooked.levels[i].width);
+		WriteLE32(&header[28 + i * 8], (unsigned int)cooked.levels[i].height);
+	}
+
+	FILE* file = fopen(fileName, "wb");
+	if(!file)
+		return false;
+	bool ok = fwrite(&header[0], 1, header.size(), file) == header.size() &&
+		(cooked.data.empty() || fwrite(&cooked.data[0], 1, cooked.data.size(), file) == cooked.data.size());
+	return fclose(file) == 0 && ok;
+}
+
+bool ReadCookedTexture(const char* fileName, CookedTexture& cooked)
+{
+	FILE* file = fopen(fileName, "rb");
+	if(!file)
+		return false;
+
+	unsigned char header[24];
+	unsigned int format = 0, levels = 0;
+	bool ok = fread(header, 1, sizeof(header), file) == sizeof(header) && memcmp(header, "PTEX", 4) == 0 &&
+		ReadLE32(header + 4) == COOKED_TEXTURE_VERSION;
+	if(ok)
+	{
+		format	= ReadLE32(header + 8);
+		levels	= ReadLE32(header + 20);
+		ok = (format == COOKED_BC1 || format == COOKED_BC3) && levels > 0 && levels <= COOKED_TEXTURE_MAX_LEVELS;
+	}
+
+	// The level table gives the size of the blocks that follow
+	size_t offset = 0;
+	cooked.levels.clear();
+	if(ok)
+	{
+		cooked.format	= (CookedFormat)format;
+		cooked.width	= (int)ReadLE32(header + 12);
+		cooked.height	= (int)ReadLE32(header + 16);
+		unsigned char table[COOKED_TEXTURE_MAX_LEVELS * 8];
+		ok = fread(table, 1, levels * 8, file) == levels * 8;
+		for(unsigned int i = 0; ok && i < levels; ++i)
+		{
+			CookedLevel info;
+			info.width	= (int)ReadLE32(table + i * 8);
+			info.height	= (int)ReadLE32(table + i * 8 + 4);
+			ok = info.width > 0 && info.height > 0 && info.width <= 32768 && info.height <= 32768;
+			info.pitch	= (info.width + 3) / 4 * GetCookedBlockBytes(cooked.format);
+			info.size	= (size_t)info.pitch * ((info.height + 3) / 4);
+			info.offset	= offset;
+			offset += info.size;
+			cooked.levels.push_back(info);
+		}
+	}
+
+	if(ok)
+	{
+		cooked.data.resize(offset);
+		ok = fread(&cooked.data[0], 1, offset, file) == offset;
+	}
+	fclose(file);
+	return ok;
+}
+
+bool GetCookedFileName(const char* source, char* cooked, size_t size)
+{
+	// The extension is after the last dot in the file's own name
+	const char* dot = strrchr(source, '.');
+	const char* slash = strrchr(source, '/');
+	const char* backslash = strrchr(source, '\\');
+	if(!dot || (slash && dot < slash) || (backslash && dot < backslash))
+		dot = source + strlen(source);
+
+	size_t length = (size_t)(dot - source);
+	if(length + 5 > size)
+		return false;
+	memcpy(cooked, source, length);
+	strcpy(cooked + length, ".ptx");
+	return true;
+}
+
+bool IsCookedTextureCurrent(const char* source, const char* cooked)
+{
+	long long sourceTime, cookedTime;
+	if(!GetModifiedTime(cooked, cookedTime))
+		return false;
+	// Shipping only the cooked file is fine too
+	return !GetModifiedTime(source, sourceTime) || cookedTime >= sourceTime;
+}
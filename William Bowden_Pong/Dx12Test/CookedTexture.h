@@ -0,0 +1,123 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	CookedTexture.h
+// Date:	October 19th, 2026
+// Purpose: Sprites cooked ahead of time into what the GPU samples: BC1
+//			(DXT1) or BC3 (DXT5) blocks with every mip level already
+//			built, so creating the texture at runtime is one copy per
+//			level instead of decoding, colour keying, filtering and
+//			converting.  Tools/TextureCook.cpp writes a .ptx file next
+//			to each source image; the D3D9 backend loads it instead of
+//			the source while it is newer than the source.
+//
+//			A .ptx file, every number a little endian 32 bit integer:
+//				"PTEX", version, CookedFormat, source width and height,
+//				level count, then the width and height of each level,
+//				then each level's blocks, largest first, a row of
+//				blocks after another.  Level 0 is the source rounded up
+//				to a multiple of 4 with transparent texels on the right
+//				and bottom, so the sprite is drawn in the same place;
+//				the smaller levels halve it the way Direct3D does.
+//////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <stddef.h>
+#include <vector>
+#include "ImageFile.h"
+
+class CThreadPool;
+
+#define COOKED_TEXTURE_VERSION 1
+
+// Levels a cooked texture can have, enough for 32768 texels across
+#define COOKED_TEXTURE_MAX_LEVELS 16
+
+enum CookedFormat
+{
+	COOKED_BC1 = 1,						// 8 bytes per 4x4 block, colour keyed texels transparent
+	COOKED_BC3 = 2						// 16 bytes per block, 8 bit interpolated alpha
+};
+
+struct CookedLevel
+{
+	int					width;
+	int					height;
+	size_t				offset;			// Into CookedTexture::data
+	size_t				size;
+	int					pitch;			// Bytes in a row of blocks
+};
+
+struct CookedTexture
+{
+	CookedFormat				format;
+	int							width;		// Source image size, what the sprite is drawn at
+	int							height;
+	std::vector<CookedLevel>	levels;
+	std::vector<unsigned char>	data;		// Every level's blocks
+};
+
+// Bytes in a 4x4 block of the format
+inline int GetCookedBlockBytes(CookedFormat format)
+{
+	return format == COOKED_BC1 ? 8 : 16;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Name:		ChooseCookedFormat
+// Parameters:	const SpriteImage& image - Decoded, colour keyed source
+// Return:		CookedFormat - BC1 if every texel is opaque or fully
+//				transparent, BC3 if there is any partial alpha
+// Description:	The colour key only ever makes texels fully
+//				transparent, so most sprites fit in BC1.
+//////////////////////////////////////////////////////////////////////////
+CookedFormat ChooseCookedFormat(const SpriteImage& image);
+
+//////////////////////////////////////////////////////////////////////////
+// Name:		CookTexture
+// Parameters:	const SpriteImage& image - Decoded, colour keyed source
+//				CookedFormat format - Block format to encode
+//				CookedTexture& cooked - Receives every level
+//				CThreadPool* pool - Encodes the rows of blocks of a level
+//					in parallel, NULL to encode on this thread
+// Return:		bool - false if the image is empty
+// Description:	Builds the mip chain with an alpha weighted box filter,
+//				so transparent texels do not darken the edges, and
+//				encodes each level.  Colour endpoints are fitted along
+//				the block's principal axis and refined once by least
+//				squares.
+//////////////////////////////////////////////////////////////////////////
+bool CookTexture(const SpriteImage& image, CookedFormat format, CookedTexture& cooked, CThreadPool* pool = 0);
+
+//////////////////////////////////////////////////////////////////////////
+// Name:		DecodeCookedLevel
+// Parameters:	const CookedTexture& cooked - Texture to read
+//				int level - Mip level
+//				SpriteImage& image - Receives the level's texels, ARGB
+// Return:		void
+// Description:	What the GPU samples, for checking the encoder.
+//////////////////////////////////////////////////////////////////////////
+void DecodeCookedLevel(const CookedTexture& cooked, int level, SpriteImage& image);
+
+bool WriteCookedTexture(const char* fileName, const CookedTexture& cooked);
+
+//////////////////////////////////////////////////////////////////////////
+// Name:		ReadCookedTexture
+// Parameters:	const char* fileName - .ptx file
+//				CookedTexture& cooked - Receives the texture
+// Return:		bool - false if the file is missing, from another
+//				version, or its levels do not add up
+// Description:	One read of the whole file, the blocks are then copied
+//				straight into the texture.
+//////////////////////////////////////////////////////////////////////////
+bool ReadCookedTexture(const char* fileName, CookedTexture& cooked);
+
+//////////////////////////////////////////////////////////////////////////
+// Name:		GetCookedFileName
+// Parameters:	const char* source - Source image, e.g. "wall.tga"
+//				char* cooked - Receives e.g. "wall.ptx"
+//				size_t size - Size of cooked
+// Return:		bool - false if the name does not fit
+// Description:	The cooked file sits next to its source.
+//////////////////////////////////////////////////////////////////////////
+bool GetCookedFileName(const char* source, char* cooked, size_t size);
+
+// The cooked file exists and was written after the source last changed
+bool IsCookedTextureCurrent(const char* source, const char* cooked);
@@ -0,0 +1,603 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	D3D9Renderer.cpp
+// Date:	October 19th, 2026
+// Purpose: Direct3D 9 renderer backend, see D3D9Renderer.h.  The device
+//			setup is the one CDirectXFramework::Init() used to do itself.
+//////////////////////////////////////////////////////////////////////////
+#include "D3D9Renderer.h"
+
+// Macro to release COM objects fast and safely
+#ifndef SAFE_RELEASE
+#define SAFE_RELEASE(x) if(x){x->Release(); x = 0;}
+#endif
+
+// Score font height at 800x600, scaled by RendererDesc::textScale
+#define FONT_HEIGHT 30
+
+// Printable ASCII, what the score text draws from
+#define FONT_GLYPHS 95
+
+static int GetBytesPerPixel(D3DFORMAT format)
+{
+	switch(format)
+	{
+	case D3DFMT_R5G6B5:
+	case D3DFMT_X1R5G5B5:		return 2;
+	default:					return 4;
+	}
+}
+
+// Bytes of every mip level
+static size_t GetTextureBytes(IDirect3DTexture9* pTexture)
+{
+	size_t bytes = 0;
+	DWORD levels = pTexture->GetLevelCount();
+	for(DWORD i = 0; i < levels; ++i)
+	{
+		D3DSURFACE_DESC desc;
+		if(FAILED(pTexture->GetLevelDesc(i, &desc)))
+			continue;
+		if(desc.Format == D3DFMT_DXT1 || desc.Format == D3DFMT_DXT5)
+		{
+			// 4x4 blocks of 8 or 16 bytes
+			size_t blocks = (size_t)((desc.Width + 3) / 4) * ((desc.Height + 3) / 4);
+			bytes += blocks * (desc.Format == D3DFMT_DXT1 ? 8 : 16);
+		}
+		else
+		{
+			bytes += (size_t)desc.Width * desc.Height * GetBytesPerPixel(desc.Format);
+		}
+	}
+	return bytes;
+}
+
+static D3DFORMAT ToD3DFormat(BackBufferFormat format)
+{
+	switch(format)
+	{
+	case BACKBUFFER_A8R8G8B8:	return D3DFMT_A8R8G8B8;
+	case BACKBUFFER_R5G6B5:		return D3DFMT_R5G6B5;
+	default:					return D3DFMT_X8R8G8B8;
+	}
+}
+
+CD3D9Renderer::CD3D9Renderer(void)
+{
+	// Init or NULL objects before use to avoid any undefined behavior
+	m_pResources	= &m_OwnResources;
+	m_bVsync		= false;
+	m_bSpriteBegun	= false;
+	m_MultiSampleType		= D3DMULTISAMPLE_NONE;
+	m_nMultiSampleQuality	= 0;
+	m_pCapture		= 0;
+	m_CaptureFormat	= D3DFMT_UNKNOWN;
+	m_nFrames		= 0;
+	for(int i = 0; i < D3D9_CAPTURE_LATENCY; ++i)
+		m_CaptureFrames[i] = -1;
+}
+
+CD3D9Renderer::~CD3D9Renderer(void)
+{
+	Shutdown();
+}
+
+bool CD3D9Renderer::Init(const RendererDesc& desc)
+{
+	HWND hWnd = (HWND)desc.window;
+	m_pResources = desc.resources ? desc.resources : &m_OwnResources;
+
+	//////////////////////////////////////////////////////////////////////////
+	// Direct3D Foundations - D3D Object, Present Parameters, and D3D Device
+	//////////////////////////////////////////////////////////////////////////
+
+	// Create the D3D Object, everything else is made from it
+	m_D3DObject.Reset(m_pResources, m_pResources->Add(RESOURCE_DEVICE, "Direct3D",
+		Direct3DCreate9(D3D_SDK_VERSION), ReleaseComObject<IDirect3D9>, 0));
+	if(!m_D3DObject.IsValid())
+		return false;
+
+	m_bVsync = desc.vsync;
+
+	//////////////////////////////////////////////////////////////////////////
+	// Back buffer format and multi-sampling, from what the adapter supports
+	//////////////////////////////////////////////////////////////////////////
+
+	// Windowed back buffers are converted to the desktop format, full-screen
+	// ones need a display format (X8R8G8B8 for A8R8G8B8)
+	D3DDISPLAYMODE displayMode;
+	m_D3DObject->GetAdapterDisplayMode(D3DADAPTER_DEFAULT, &displayMode);
+
+	D3DFORMAT backBufferFormat = ToD3DFormat(desc.format);
+	D3DFORMAT adapterFormat = desc.windowed ? displayMode.Format :
+		(backBufferFormat == D3DFMT_A8R8G8B8 ? D3DFMT_X8R8G8B8 : backBufferFormat);
+	if(FAILED(m_D3DObject->CheckDeviceType(D3DADAPTER_DEFAULT, D3DDEVTYPE_HAL,
+				adapterFormat, backBufferFormat, desc.windowed)))
+	{
+		// Every D3D9 adapter supports the original format
+		backBufferFormat = D3DFMT_X8R8G8B8;
+	}
+
+	// Most samples, up to the number asked for, that both the back buffer
+	// and the depth buffer support.  Highest quality level for that count.
+	m_MultiSampleType		= D3DMULTISAMPLE_NONE;
+	m_nMultiSampleQuality	= 0;
+	int samples = desc.multisample < 16 ? desc.multisample : 16;
+	for(; samples >= 2; --samples)
+	{
+		D3DMULTISAMPLE_TYPE type = (D3DMULTISAMPLE_TYPE)samples;
+		DWORD colorLevels = 0;
+		DWORD depthLevels = 0;
+		if(SUCCEEDED(m_D3DObject->CheckDeviceMultiSampleType(D3DADAPTER_DEFAULT, D3DDEVTYPE_HAL,
+						backBufferFormat, desc.windowed, type, &colorLevels)) &&
+		   SUCCEEDED(m_D3DObject->CheckDeviceMultiSampleType(D3DADAPTER_DEFAULT, D3DDEVTYPE_HAL,
+						D3DFMT_D24S8, desc.windowed, type, &depthLevels)))
+		{
+			DWORD levels = colorLevels < depthLevels ? colorLevels : depthLevels;
+			m_MultiSampleType		= type;
+			m_nMultiSampleQuality	= levels > 0 ? levels - 1 : 0;
+			break;
+		}
+	}
+
+	// Set D3D Device presentation parameters before creating the device
+	D3DPRESENT_PARAMETERS D3Dpp;
+	ZeroMemory(&D3Dpp, sizeof(D3Dpp));  // NULL the structure's memory
+
+	D3Dpp.hDeviceWindow					= hWnd;										// Handle to the focus window
+	D3Dpp.Windowed						= desc.windowed;							// Windowed or Full-screen boolean
+	D3Dpp.AutoDepthStencilFormat		= D3DFMT_D24S8;								// Format of depth/stencil buffer, 24 bit depth, 8 bit stencil
+	D3Dpp.EnableAutoDepthStencil		= TRUE;										// Enables Z-Buffer (Depth Buffer)
+	D3Dpp.BackBufferCount				= 1;										// Change if need of > 1 is required at a later date
+	D3Dpp.BackBufferFormat				= backBufferFormat;							// Back-buffer format, from the config if supported
+	D3Dpp.BackBufferHeight				= desc.height;								// Make sure resolution is supported, use adapter modes
+	D3Dpp.BackBufferWidth				= desc.width;								// (Same as above)
+	D3Dpp.SwapEffect					= D3DSWAPEFFECT_DISCARD;					// Discard back-buffer, must stay discard to support multi-sample
+	D3Dpp.PresentationInterval			= m_bVsync ? D3DPRESENT_INTERVAL_DEFAULT : D3DPRESENT_INTERVAL_IMMEDIATE; // Present back-buffer immediately, unless V-Sync is on
+	D3Dpp.Flags							= D3DPRESENTFLAG_DISCARD_DEPTHSTENCIL;		// This flag should improve performance, if not set to NULL.
+	D3Dpp.FullScreen_RefreshRateInHz	= desc.windowed ? 0 : D3DPRESENT_RATE_DEFAULT;	// Full-screen refresh rate, use adapter modes or default
+	D3Dpp.MultiSampleQuality			= m_nMultiSampleQuality;					// Highest quality level for the sample count
+	D3Dpp.MultiSampleType				= m_MultiSampleType;						// MSAA, picked above from adapter support
+
+	// Check device capabilities
+	DWORD deviceBehaviorFlags = 0;
+	m_D3DObject->GetDeviceCaps(D3DADAPTER_DEFAULT, D3DDEVTYPE_HAL, &m_D3DCaps);
+
+	// Determine vertex processing mode
+	if(m_D3DCaps.DevCaps & D3DCREATE_HARDWARE_VERTEXPROCESSING)
+	{
+		// Hardware vertex processing supported? (Video Card)
+		deviceBehaviorFlags |= D3DCREATE_HARDWARE_VERTEXPROCESSING;
+	}
+	else
+	{
+		// If not, use software (CPU)
+		deviceBehaviorFlags |= D3DCREATE_SOFTWARE_VERTEXPROCESSING;
+	}
+
+	// If hardware vertex processing is on, check pure device support
+	if(m_D3DCaps.DevCaps & D3DDEVCAPS_PUREDEVICE && deviceBehaviorFlags & D3DCREATE_HARDWARE_VERTEXPROCESSING)
+	{
+		deviceBehaviorFlags |= D3DCREATE_PUREDEVICE;
+	}
+
+	// Create the D3D Device with the present parameters and device flags above
+	IDirect3DDevice9* pDevice = 0;
+	if(FAILED(m_D3DObject->CreateDevice(
+		D3DADAPTER_DEFAULT,		// which adapter to use, set to primary
+		D3DDEVTYPE_HAL,			// device type to use, set to hardware rasterization
+		hWnd,					// handle to the focus window
+		deviceBehaviorFlags,	// behavior flags
+		&D3Dpp,					// presentation parameters
+		&pDevice)))				// returned device pointer
+	{
+		return false;
+	}
+	m_D3DDevice.Reset(m_pResources, m_pResources->Add(RESOURCE_DEVICE, "Device", pDevice,
+		ReleaseComObject<IDirect3DDevice9>, 0, m_D3DObject.GetHandle()));
+
+	//////////////////////////////////////////////////////////////////////////
+	// Create a Font Object
+	//////////////////////////////////////////////////////////////////////////
+
+	// Load D3DXFont, each font style you want to support will need an ID3DXFont
+	int fontHeight = (int)(FONT_HEIGHT * desc.textScale + 0.5f);
+	fontHeight = fontHeight > 8 ? fontHeight : 8;
+	ID3DXFont* pFont = 0;
+	D3DXCreateFont(pDevice, fontHeight, 0, FW_BOLD, 0, false,
+				  DEFAULT_CHARSET, OUT_DEFAULT_PRECIS, DEFAULT_QUALITY,
+				  DEFAULT_PITCH | FF_DONTCARE, TEXT("Times New Roman"),
+				  &pFont);
+
+	// D3DX does not say how big its glyph cache gets, count a 32 bit
+	// square cell for each glyph the score uses
+	m_D3DFont.Reset(m_pResources, m_pResources->Add(RESOURCE_FONT, "Times New Roman", pFont,
+		ReleaseComObject<ID3DXFont>, (size_t)fontHeight * fontHeight * 4 * FONT_GLYPHS, m_D3DDevice.GetHandle()));
+
+	//////////////////////////////////////////////////////////////////////////
+	// Create Sprite Object
+	//////////////////////////////////////////////////////////////////////////
+	// Create a sprite object, note you will only need one for all 2D sprites
+	ID3DXSprite* pSprite = 0;
+	D3DXCreateSprite(pDevice, &pSprite);
+	m_D3DSprite.Reset(m_pResources, m_pResources->Add(RESOURCE_DEVICE, "Sprite", pSprite,
+		ReleaseComObject<ID3DXSprite>, 0, m_D3DDevice.GetHandle()));
+
+	return true;
+}
+
+void CD3D9Renderer::Shutdown()
+{
+	// Each object holds its parent, so the device and D3D object go
+	// after the textures, sprite and font whatever order they are dropped
+
+	// Capture surfaces, frames not read back yet are lost
+	m_pCapture = 0;
+	for(int i = 0; i < D3D9_CAPTURE_LATENCY; ++i)
+	{
+		m_CaptureCopies[i].Reset();
+		m_CaptureReads[i].Reset();
+		m_CaptureFrames[i] = -1;
+	}
+	// Textures
+	m_Textures.clear();
+	// Sprite
+	m_D3DSprite.Reset();
+	// Font
+	m_D3DFont.Reset();
+	// 3DDevice
+	m_D3DDevice.Reset();
+	// 3DObject
+	m_D3DObject.Reset();
+}
+
+bool CD3D9Renderer::AddTexture(IDirect3DTexture9* pTexture, const char* name, int width, int height,
+							   SpriteTexture& texture)
+{
+	CResourceRef<IDirect3DTexture9> ref;
+	ref.Reset(m_pResources, m_pResources->Add(RESOURCE_TEXTURE, name, pTexture,
+		ReleaseComObject<IDirect3DTexture9>, GetTextureBytes(pTexture), m_D3DDevice.GetHandle()));
+	if(!ref.IsValid())
+		return false;
+
+	texture.id		= ref.GetHandle();
+	texture.width	= width;
+	texture.height	= height;
+	m_Textures.push_back(ref);
+	return true;
+}
+
+bool CD3D9Renderer::LoadCookedTexture(const char* source, SpriteTexture& texture)
+{
+	char cookedName[260];
+	CookedTexture cooked;
+	if(!GetCookedFileName(source, cookedName, sizeof(cookedName)) || !IsCookedTextureCurrent(source, cookedName) ||
+		!ReadCookedTexture(cookedName, cooked))
+	{
+		return false;
+	}
+
+	IDirect3DTexture9* pTexture = 0;
+	if(FAILED(m_D3DDevice->CreateTexture(cooked.levels[0].width, cooked.levels[0].height, (UINT)cooked.levels.size(),
+				  0, cooked.format == COOKED_BC1 ? D3DFMT_DXT1 : D3DFMT_DXT5, D3DPOOL_MANAGED, &pTexture, 0)))
+	{
+		return false;
+	}
+
+	// Rows of blocks, in one copy when the driver's pitch matches the file's
+	for(size_t i = 0; i < cooked.levels.size(); ++i)
+	{
+		const CookedLevel& level = cooked.levels[i];
+		D3DLOCKED_RECT locked;
+		if(FAILED(pTexture->LockRect((UINT)i, &locked, 0, 0)))
+		{
+			SAFE_RELEASE(pTexture);
+			return false;
+		}
+		const unsigned char* src = &cooked.data[level.offset];
+		if(locked.Pitch == level.pitch)
+		{
+			memcpy(locked.pBits, src, level.size);
+		}
+		else
+		{
+			for(size_t row = 0; row * level.pitch < level.size; ++row)
+				memcpy((unsigned char*)locked.pBits + row * locked.Pitch, src + row * level.pitch, level.pitch);
+		}
+		pTexture->UnlockRect((UINT)i);
+	}
+
+	return AddTexture(pTexture, cookedName, cooked.width, cooked.height, texture);
+}
+
+bool CD3D9Renderer::LoadTexture(const wchar_t* fileName, SpriteTexture& texture)
+{
+	texture.id = -1;
+	texture.width = texture.height = 0;
+
+	char name[260];
+	wcstombs(name, fileName, sizeof(name));
+	name[sizeof(name) - 1] = 0;
+
+	// Cooked by Tools/TextureCook.cpp
+	if(LoadCookedTexture(name, texture))
+		return true;
+
+	// Create a texture, each different 2D sprite to display to the screen
+	// will need a new texture object.  Magenta is the transparent colour key.
+	D3DXIMAGE_INFO imageInfo;
+	IDirect3DTexture9* pTexture = 0;
+	if(FAILED(D3DXCreateTextureFromFileEx(m_D3DDevice.Get(), fileName, 0, 0, 0, 0,
+				  D3DFMT_UNKNOWN, D3DPOOL_MANAGED, D3DX_DEFAULT,
+				  D3DX_DEFAULT, D3DCOLOR_XRGB(255, 0, 255),
+				  &imageInfo, 0, &pTexture)))
+	{
+		return false;
+	}
+
+	return AddTexture(pTexture, name, (int)imageInfo.Width, (int)imageInfo.Height, texture);
+}
+
+bool CD3D9Renderer::UpdateTexture(SpriteImage& image, SpriteTexture& texture)
+{
+	if(!FindTexture(texture.id) || image.width <= 0 || image.height <= 0)
+		return false;
+
+	// The same size rules and full mip chain D3DXCreateTextureFromFileEx
+	// gives LoadTexture(), so a reloaded sprite draws like a loaded one
+	IDirect3DTexture9* pTexture = 0;
+	if(FAILED(D3DXCreateTexture(m_D3DDevice.Get(), image.width, image.height, 0, 0,
+				  D3DFMT_A8R8G8B8, D3DPOOL_MANAGED, &pTexture)))
+	{
+		return false;
+	}
+
+	IDirect3DSurface9* pSurface = 0;
+	RECT source = { 0, 0, image.width, image.height };
+	HRESULT hr = pTexture->GetSurfaceLevel(0, &pSurface);
+	if(SUCCEEDED(hr))
+	{
+		hr = D3DXLoadSurfaceFromMemory(pSurface, 0, 0, &image.pixels[0], D3DFMT_A8R8G8B8,
+			image.width * 4, 0, &source, D3DX_DEFAULT, 0);
+		SAFE_RELEASE(pSurface);
+	}
+	if(SUCCEEDED(hr))
+		hr = D3DXFilterTexture(pTexture, 0, 0, D3DX_DEFAULT);
+	if(FAILED(hr))
+	{
+		SAFE_RELEASE(pTexture);
+		return false;
+	}
+
+	// The handle stays the same, so every copy of texture draws the new one
+	m_pResources->Replace(texture.id, pTexture, GetTextureBytes(pTexture));
+	texture.width			= image.width;
+	texture.height			= image.height;
+	return true;
+}
+
+void CD3D9Renderer::BeginFrame(unsigned int clearColor)
+{
+	// Clear the back buffer, call BeginScene()
+	m_D3DDevice->Clear(0, NULL, D3DCLEAR_TARGET, clearColor, 1.0f, 0);
+	m_D3DDevice->BeginScene();
+
+	// Note: You should only be calling the sprite object's begin and end once,
+	// with all draw calls of sprites between them
+	m_D3DSprite->Begin(NULL);
+	m_bSpriteBegun = true;
+}
+
+void CD3D9Renderer::DrawSprite(const SpriteTexture& texture, float x, float y, float scale, unsigned int color)
+{
+	IDirect3DTexture9* pTexture = FindTexture(texture.id);
+	if(!pTexture)
+		return;
+
+	// Sprites drawn after text start a new batch
+	if(!m_bSpriteBegun)
+	{
+		m_D3DSprite->Begin(NULL);
+		m_bSpriteBegun = true;
+	}
+
+	// Scaling, then translation to the sprite's position
+	D3DXMATRIX transMat, scaleMat, worldMat;
+	D3DXMatrixScaling(&scaleMat, scale, scale, 0.0f);
+	D3DXMatrixTranslation(&transMat, x, y, 0.0f);
+	D3DXMatrixMultiply(&worldMat, &scaleMat, &transMat);
+	m_D3DSprite->SetTransform(&worldMat);
+
+	D3DXVECTOR3 center(texture.width * 0.5f, texture.height * 0.5f, 0.0f);
+	m_D3DSprite->Draw(pTexture, 0, &center, 0, color);
+}
+
+void CD3D9Renderer::DrawSprites(const SpriteTexture& texture, const SpriteBatch& batch)
+{
+	IDirect3DTexture9* pTexture = FindTexture(texture.id);
+	if(!pTexture || batch.count <= 0)
+		return;
+
+	if(!m_bSpriteBegun)
+	{
+		m_D3DSprite->Begin(NULL);
+		m_bSpriteBegun = true;
+	}
+
+	// One texture for the whole batch, so ID3DXSprite queues every quad
+	// into the same draw call when it flushes
+	D3DXVECTOR3 center(texture.width * 0.5f, texture.height * 0.5f, 0.0f);
+	ID3DXSprite* pSprite = m_D3DSprite.Get();
+	D3DXMATRIX worldMat;
+	D3DXMatrixIdentity(&worldMat);
+	for(int i = 0; i < batch.count; ++i)
+	{
+		// Scale then translate, written out instead of two matrices and
+		// a multiply per sprite
+		worldMat._11 = batch.scale[i];
+		worldMat._22 = batch.scale[i];
+		worldMat._33 = 0.0f;
+		worldMat._41 = batch.x[i];
+		worldMat._42 = batch.y[i];
+		pSprite->SetTransform(&worldMat);
+		pSprite->Draw(pTexture, 0, &center, 0, batch.color[i]);
+	}
+}
+
+void CD3D9Renderer::DrawString(const wchar_t* text, int x, int y, unsigned int color)
+{
+	// Text is drawn after the sprites, outside of the sprite batch
+	if(m_bSpriteBegun)
+	{
+		m_D3DSprite->End();
+		m_bSpriteBegun = false;
+	}
+
+	RECT rect;
+	rect.left	= x;
+	rect.right	= x;
+	rect.top	= y;
+	rect.bottom	= y;
+	m_D3DFont->DrawText(0, text, -1, &rect, DT_TOP | DT_LEFT | DT_NOCLIP, color);
+}
+
+void CD3D9Renderer::EndFrame()
+{
+	if(m_bSpriteBegun)
+	{
+		m_D3DSprite->End();
+		m_bSpriteBegun = false;
+	}
+
+	// EndScene, and Present the back buffer to the display buffer
+	m_D3DDevice->EndScene();
+	if(m_pCapture)
+		CaptureBackBuffer();
+	m_D3DDevice->Present(NULL, NULL, NULL, NULL);
+	++m_nFrames;
+}
+
+bool CD3D9Renderer::SetCapture(CFrameCapture* capture)
+{
+	if(m_pCapture)
+		FlushCapture();
+	m_pCapture = 0;
+	for(int i = 0; i < D3D9_CAPTURE_LATENCY; ++i)
+	{
+		m_CaptureCopies[i].Reset();
+		m_CaptureReads[i].Reset();
+		m_CaptureFrames[i] = -1;
+	}
+	if(!capture)
+		return true;
+
+	IDirect3DSurface9* pBackBuffer = 0;
+	if(!m_D3DDevice.IsValid() || FAILED(m_D3DDevice->GetBackBuffer(0, 0, D3DBACKBUFFER_TYPE_MONO, &pBackBuffer)))
+		return false;
+	D3DSURFACE_DESC desc;
+	HRESULT hr = pBackBuffer->GetDesc(&desc);
+	SAFE_RELEASE(pBackBuffer);
+	if(FAILED(hr) || (int)desc.Width != capture->GetWidth() || (int)desc.Height != capture->GetHeight())
+		return false;
+
+	// Not multi-sampled, StretchRect resolves into the copy
+	size_t bytes = (size_t)desc.Width * desc.Height * GetBytesPerPixel(desc.Format);
+	for(int i = 0; i < D3D9_CAPTURE_LATENCY; ++i)
+	{
+		IDirect3DSurface9* pCopy = 0;
+		IDirect3DSurface9* pRead = 0;
+		m_D3DDevice->CreateRenderTarget(desc.Width, desc.Height, desc.Format, D3DMULTISAMPLE_NONE, 0, FALSE,
+			&pCopy, 0);
+		m_D3DDevice->CreateOffscreenPlainSurface(desc.Width, desc.Height, desc.Format, D3DPOOL_SYSTEMMEM,
+			&pRead, 0);
+		m_CaptureCopies[i].Reset(m_pResources, m_pResources->Add(RESOURCE_TEXTURE, "Capture copy", pCopy,
+			ReleaseComObject<IDirect3DSurface9>, bytes, m_D3DDevice.GetHandle()));
+		m_CaptureReads[i].Reset(m_pResources, m_pResources->Add(RESOURCE_TEXTURE, "Capture read back", pRead,
+			ReleaseComObject<IDirect3DSurface9>, bytes, m_D3DDevice.GetHandle()));
+		if(!m_CaptureCopies[i].IsValid() || !m_CaptureReads[i].IsValid())
+		{
+			SetCapture(0);
+			return false;
+		}
+	}
+
+	m_CaptureFormat	= desc.Format;
+	m_pCapture		= capture;
+	return true;
+}
+
+void CD3D9Renderer::CaptureBackBuffer()
+{
+	int slot = m_nFrames % D3D9_CAPTURE_LATENCY;
+	if(m_CaptureFrames[slot] >= 0)
+		ReadCapture(slot);
+
+	IDirect3DSurface9* pBackBuffer = 0;
+	if(FAILED(m_D3DDevice->GetBackBuffer(0, 0, D3DBACKBUFFER_TYPE_MONO, &pBackBuffer)))
+		return;
+	if(SUCCEEDED(m_D3DDevice->StretchRect(pBackBuffer, 0, m_CaptureCopies[slot].Get(), 0, D3DTEXF_NONE)))
+		m_CaptureFrames[slot] = m_nFrames;
+	SAFE_RELEASE(pBackBuffer);
+}
+
+void CD3D9Renderer::ReadCapture(int slot)
+{
+	int frame = m_CaptureFrames[slot];
+	m_CaptureFrames[slot] = -1;
+	CapturedFrame* captured = m_pCapture->Acquire(frame);
+	if(!captured)
+		return;
+
+	IDirect3DSurface9* pRead = m_CaptureReads[slot].Get();
+	D3DLOCKED_RECT locked;
+	if(FAILED(m_D3DDevice->GetRenderTargetData(m_CaptureCopies[slot].Get(), pRead)) ||
+		FAILED(pRead->LockRect(&locked, 0, D3DLOCK_READONLY)))
+	{
+		m_pCapture->Discard(captured);
+		return;
+	}
+
+	int width	= m_pCapture->GetWidth();
+	int height	= m_pCapture->GetHeight();
+	for(int y = 0; y < height; ++y)
+	{
+		const unsigned char* row = (const unsigned char*)locked.pBits + (size_t)y * locked.Pitch;
+		unsigned int* out = captured->pixels + (size_t)y * width;
+		if(m_CaptureFormat == D3DFMT_R5G6B5)
+		{
+			const unsigned short* in = (const unsigned short*)row;
+			for(int x = 0; x < width; ++x)
+			{
+				unsigned int r = (in[x] >> 11) & 31, g = (in[x] >> 5) & 63, b = in[x] & 31;
+				out[x] = 0xFF000000 | ((r << 3 | r >> 2) << 16) | ((g << 2 | g >> 4) << 8) | (b << 3 | b >> 2);
+			}
+		}
+		else if(m_CaptureFormat == D3DFMT_X1R5G5B5)
+		{
+			const unsigned short* in = (const unsigned short*)row;
+			for(int x = 0; x < width; ++x)
+			{
+				unsigned int r = (in[x] >> 10) & 31, g = (in[x] >> 5) & 31, b = in[x] & 31;
+				out[x] = 0xFF000000 | ((r << 3 | r >> 2) << 16) | ((g << 3 | g >> 2) << 8) | (b << 3 | b >> 2);
+			}
+		}
+		else
+		{
+			// X8R8G8B8 leaves the top byte undefined, the video is opaque
+			const unsigned int* in = (const unsigned int*)row;
+			for(int x = 0; x < width; ++x)
+				out[x] = in[x] | 0xFF000000;
+		}
+	}
+	pRead->UnlockRect();
+	m_pCapture->Submit(captured);
+}
+
+void CD3D9Renderer::FlushCapture()
+{
+	for(int frame = m_nFrames - D3D9_CAPTURE_LATENCY; frame < m_nFrames; ++frame)
+	{
+		int slot = (frame + D3D9_CAPTURE_LATENCY) % D3D9_CAPTURE_LATENCY;
+		if(frame >= 0 && m_CaptureFrames[slot] == frame)
+			ReadCapture(slot);
+	}
+}
@@ -0,0 +1,169 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	D3D9Renderer.h
+// Date:	October 19th, 2026
+// Purpose: Direct3D 9 renderer backend.  Owns the D3D object and device,
+//			the ID3DXSprite used for every 2D draw and the score font.
+//			They and the textures live in a CResourceRegistry, the one in
+//			RendererDesc::resources if given, and SpriteTexture::id is
+//			the texture's handle.  A sprite with a current .ptx file
+//			(CookedTexture.h) is loaded from it instead of its source.
+//			A frame being captured is copied on the GPU before Present
+//			and only read back D3D9_CAPTURE_LATENCY frames later, when
+//			the GPU has long finished it, so reading never waits on it.
+//			See Renderer.h for the backend interface.
+//////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <d3d9.h>
+#include <d3dx9.h>
+#include <vector>
+#include "RenderTypes.h"
+#include "ImageFile.h"
+#include "CookedTexture.h"
+#include "ResourceRegistry.h"
+#include "FrameCapture.h"
+
+#pragma comment(lib, "d3d9.lib")
+#pragma comment(lib, "d3dx9.lib")
+
+// Frames between copying the back buffer for a capture and reading the
+// copy back, more than the driver queues ahead
+#define D3D9_CAPTURE_LATENCY 3
+
+class CD3D9Renderer
+{
+	// Declared first so it is destroyed after the references into it
+	CResourceRegistry	m_OwnResources;	// Used when RendererDesc::resources is NULL
+	CResourceRegistry*	m_pResources;	// Owns everything below
+
+	//////////////////////////////////////////////////////////////////////////
+	// Direct3D Variables
+	//////////////////////////////////////////////////////////////////////////
+	CResourceRef<IDirect3D9>		m_D3DObject;	// Direct3D 9 Object
+	CResourceRef<IDirect3DDevice9>	m_D3DDevice;	// Direct3D 9 Device
+	D3DCAPS9			m_D3DCaps;		// Device Capabilities
+	bool				m_bVsync;		// Boolean for vertical syncing
+	D3DMULTISAMPLE_TYPE	m_MultiSampleType;		// MSAA samples in use
+	DWORD				m_nMultiSampleQuality;	// MSAA quality level in use
+
+	//////////////////////////////////////////////////////////////////////////
+	// Sprite and Font Variables
+	//////////////////////////////////////////////////////////////////////////
+	CResourceRef<ID3DXSprite>	m_D3DSprite;	// Sprite Object, one for all 2D sprites
+	CResourceRef<ID3DXFont>		m_D3DFont;		// Font Object
+	bool				m_bSpriteBegun;	// Between m_D3DSprite Begin and End
+
+	std::vector<CResourceRef<IDirect3DTexture9> >	m_Textures;	// Every texture loaded
+
+	//////////////////////////////////////////////////////////////////////////
+	// Frame Capture
+	//////////////////////////////////////////////////////////////////////////
+	CFrameCapture*		m_pCapture;		// NULL when not capturing
+	CResourceRef<IDirect3DSurface9>	m_CaptureCopies[D3D9_CAPTURE_LATENCY];	// Video memory, the back buffer copied
+	CResourceRef<IDirect3DSurface9>	m_CaptureReads[D3D9_CAPTURE_LATENCY];	// System memory, a copy read back
+	int					m_CaptureFrames[D3D9_CAPTURE_LATENCY];	// Frame in each copy, -1 for none
+	D3DFORMAT			m_CaptureFormat;	// The back buffer's
+	int					m_nFrames;		// Presented, numbers the captures
+
+	// Texture behind a SpriteTexture::id, NULL if it was released
+	IDirect3DTexture9* FindTexture(int id) const	{ return (IDirect3DTexture9*)m_pResources->Get(id); }
+
+	// Adds a texture to the registry and to m_Textures
+	bool AddTexture(IDirect3DTexture9* pTexture, const char* name, int width, int height, SpriteTexture& texture);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		LoadCookedTexture
+	// Parameters:	const char* source - Source image, e.g. "wall.tga"
+	//				SpriteTexture& texture - Receives the texture
+	// Return:		bool - false if there is no current .ptx for it or
+	//				the device cannot create it
+	// Description:	Creates a DXT1 or DXT5 texture with the file's levels
+	//				and copies each level's blocks straight in.
+	//////////////////////////////////////////////////////////////////////////
+	bool LoadCookedTexture(const char* source, SpriteTexture& texture);
+
+	// Reads back the frame copied D3D9_CAPTURE_LATENCY frames ago, then
+	// copies this one, before Present
+	void CaptureBackBuffer();
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		ReadCapture
+	// Parameters:	int slot - Copy to read back
+	// Return:		void
+	// Description:	Skips the read back if the capture has no buffer
+	//				free, so a dropped frame costs nothing.  Converts 16
+	//				bit back buffers to ARGB on the way.
+	//////////////////////////////////////////////////////////////////////////
+	void ReadCapture(int slot);
+
+	// Reads back every copy still waiting, oldest first
+	void FlushCapture();
+
+public:
+	CD3D9Renderer(void);
+	~CD3D9Renderer(void);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Init
+	// Parameters:	const RendererDesc& desc - Window, size and mode
+	// Return:		bool - false if the device could not be created
+	// Description:	Creates the D3D object, device, sprite and font.  Falls
+	//				back to X8R8G8B8 if the adapter cannot use desc.format,
+	//				and uses the most MSAA samples it supports up to
+	//				desc.multisample.
+	//////////////////////////////////////////////////////////////////////////
+	bool Init(const RendererDesc& desc);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Shutdown
+	// Parameters:	void
+	// Return:		void
+	// Description:	Drops every texture and COM object.  Objects in a
+	//				shared registry go once nothing else holds them, the
+	//				device after its textures, sprite and font.
+	//////////////////////////////////////////////////////////////////////////
+	void Shutdown();
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		LoadTexture
+	// Parameters:	const wchar_t* fileName - Source image
+	//				SpriteTexture& texture - Receives the texture
+	// Return:		bool - false if neither the cooked file nor the
+	//				source could be loaded
+	// Description:	Uses the cooked .ptx next to the source while it is
+	//				newer, otherwise decodes the source with D3DX.
+	//////////////////////////////////////////////////////////////////////////
+	bool LoadTexture(const wchar_t* fileName, SpriteTexture& texture);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		UpdateTexture
+	// Parameters:	SpriteImage& image - Decoded, colour keyed pixels, left
+	//					as they are
+	//				SpriteTexture& texture - Texture to replace, keeps its id
+	// Return:		bool - false if a new texture could not be created, the
+	//				old one is kept
+	// Description:	Creates a new texture sized the way LoadTexture() sizes
+	//				it and releases the old one, so nothing drawing with the
+	//				old one waits for a lock.
+	//////////////////////////////////////////////////////////////////////////
+	bool UpdateTexture(SpriteImage& image, SpriteTexture& texture);
+
+	void BeginFrame(unsigned int clearColor);
+	void DrawSprite(const SpriteTexture& texture, float x, float y, float scale, unsigned int color);
+	void DrawSprites(const SpriteTexture& texture, const SpriteBatch& batch);
+	void DrawString(const wchar_t* text, int x, int y, unsigned int color);
+	void EndFrame();
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		SetCapture
+	// Parameters:	CFrameCapture* capture - Receives every frame from now
+	//					on, NULL to stop
+	// Return:		bool - false if the capture is not the back buffer's
+	//				size or the surfaces cannot be created
+	// Description:	Frames still on their way to the last capture are
+	//				read back into it first, so it gets them all.
+	//////////////////////////////////////////////////////////////////////////
+	bool SetCapture(CFrameCapture* capture);
+
+	IDirect3DDevice9* GetDevice() const	{ return m_D3DDevice.Get(); }
+	int GetMultiSampleCount() const		{ return (int)m_MultiSampleType; }
+};
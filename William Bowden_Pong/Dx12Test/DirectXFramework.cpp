@@ -5,42 +5,35 @@
 // Purpose: This file is used to create a very simple framework for using
 //			DirectX 9 for the GSP 381 course for DeVry University.
 // Disclaimer:	
-//			Copyright  2010 by DeVry Educational Development Corporation.
+//			Copyright © 2010 by DeVry Educational Development Corporation.
 //			All rights reserved.  No part of this work may be reproduced 
-//			or used in any form or by any means  graphic, electronic, or 
+//			or used in any form or by any means – graphic, electronic, or 
 //			mechanical, including photocopying, recording, Web distribution 
-//			or information storage and retrieval systems  without the 
+//			or information storage and retrieval systems – without the 
 //			prior consent of DeVry Educational Development Corporation.
 //////////////////////////////////////////////////////////////////////////
 #include "DirectXFramework.h"
 
-//Key Flags
-#define W_UP 0x000000001
-#define S_DOWN 0x000000002
-#define ARROW_UP 0x000000004
-#define ARROW_DOWN 0x00000008
-#define ARROW_LEFT 0x00000010
-#define ENTER_KEY 0x00000020
-#define DISPLAY_SPRITE 0x00000040
-
-//Sound Flags
-#define SOUND1 0x00000080
-#define SOUND2 0x00000100
-
+// m_Beep[0] then m_Beep[1]
+static const char* const s_SoundFiles[SOUND_FILE_COUNT] = { "beep1.ogg", "beep2.ogg" };
 
+// ResourceReleaseFunc for FMOD objects, which release in lower case
+template<class T>
+static void ReleaseFmodObject(void* object)
+{
+	((T*)object)->release();
+}
 
+// Written by Shutdown() when [Debug] InputLatency is on
+#define INPUT_LATENCY_FILE "InputLatency.txt"
 
-ID3DXSprite*			m_pD3DSprite;
-IDirect3DTexture9*		m_pTexture;
-IDirect3DTexture9*		m_ballTexture;
-IDirect3DTexture9*		m_wallTexture;
-D3DXIMAGE_INFO			m_imageInfo;
-D3DXIMAGE_INFO			m_ballImage, m_wallImage;
-ID3DXFont*				m_pD3DFont;
-IGraphBuilder*			m_pGraphBuilder;
-IMediaControl*			m_pMediaControl;
-IMediaEvent*			m_pMediaEvent;
-IVideoWindow*			m_pVideoWindow;
+// Decoded size, FMOD_DEFAULT and the music decode the whole file to memory
+static size_t GetSoundBytes(FMOD::Sound* sound)
+{
+	unsigned int bytes = 0;
+	sound->getLength(&bytes, FMOD_TIMEUNIT_PCMBYTES);
+	return bytes;
+}
 
 
 
@@ -49,9 +42,23 @@ IVideoWindow*			m_pVideoWindow;
 CDirectXFramework::CDirectXFramework(void)
 {
 	// Init or NULL objects before use to avoid any undefined behavior
-	m_bVsync		= false;
-	m_pD3DObject	= 0;
-	m_pD3DDevice	= 0;
+	m_bTimerPeriod	= false;
+	m_nPressedUnticked = 0;
+	m_bComReady		= false;
+	m_nPresented	= 0;
+	m_bShowResources = false;
+	m_bRendererReady = false;
+	m_bAI[0] = m_bAI[1] = false;
+	m_bNet			= false;
+	m_nNetTicks		= 0;
+	m_bMeasureLatency = false;
+	m_fPollTime		= 0.0;
+	m_bMetrics		= false;
+	m_nCaptureDropped = 0;
+	for(int i = 0; i < SOUND_FILE_COUNT; ++i)
+	{
+		m_pLoadingSound[i] = 0;
+	}
 	
 }
 
@@ -63,692 +70,531 @@ CDirectXFramework::~CDirectXFramework(void)
 }
 
 
-void CDirectXFramework::Init(HWND& hWnd, HINSTANCE& hInst, bool bWindowed)
+void CDirectXFramework::Init(HWND& hWnd, HINSTANCE& hInst, const RendererDesc& video, const FramePacingDesc& pacing,
+							 CStartupTrace* trace)
 {
+	CTraceSpan initSpan(trace, "Init");
 	m_hWnd = hWnd;
-	CoInitialize(NULL);
-	
-	CoCreateInstance( CLSID_FilterGraph, NULL, CLSCTX_INPROC_SERVER, 
-                  IID_IGraphBuilder, (void**)&m_pGraphBuilder);
-
-	m_pGraphBuilder->QueryInterface(IID_IMediaControl,
-                                (void**)&m_pMediaControl);
-
-	m_pGraphBuilder->QueryInterface(IID_IMediaEvent,
-                                (void**)&m_pMediaEvent);
-
-	m_pGraphBuilder->RenderFile(L"intro.wmv", NULL);
-
-	m_pMediaControl->QueryInterface(IID_IVideoWindow,
-                                (void**)&m_pVideoWindow);
-	// Setup the window
-	m_pVideoWindow->put_Owner((OAHWND)m_hWnd);
-	// Set the style
-	m_pVideoWindow->put_WindowStyle(WS_CHILD | WS_CLIPSIBLINGS | WS_VISIBLE);
-	// Obtain the size of the window
-	RECT WinRect;
-	GetClientRect(m_hWnd, &WinRect);
-	// Set the video size to the size of the window
-	WinRect.top = 0;
-	WinRect.bottom = 600;
-	WinRect.left = 0;
-	WinRect.right = 800;
-	m_pVideoWindow->SetWindowPosition(WinRect.left, WinRect.top, 
-										WinRect.right, WinRect.bottom);
-
-	//////////////////////////////////////////////////////////////////////////
-	// Direct3D Foundations - D3D Object, Present Parameters, and D3D Device
-	//////////////////////////////////////////////////////////////////////////
 
-	// Create the D3D Object
-	m_pD3DObject = Direct3DCreate9(D3D_SDK_VERSION);
-
-	// Find the width and height of window using hWnd and GetWindowRect()
-	RECT rect;
-
-	GetWindowRect(hWnd, &rect);
-	int width = rect.right - rect.left;
-	int height = rect.bottom - rect.top;
-
-	// Set D3D Device presentation parameters before creating the device
-	D3DPRESENT_PARAMETERS D3Dpp;
-	ZeroMemory(&D3Dpp, sizeof(D3Dpp));  // NULL the structure's memory
-
-	D3Dpp.hDeviceWindow					= hWnd;										// Handle to the focus window
-	D3Dpp.Windowed						= bWindowed;								// Windowed or Full-screen boolean
-	D3Dpp.AutoDepthStencilFormat		= D3DFMT_D24S8;								// Format of depth/stencil buffer, 24 bit depth, 8 bit stencil
-	D3Dpp.EnableAutoDepthStencil		= TRUE;										// Enables Z-Buffer (Depth Buffer)
-	D3Dpp.BackBufferCount				= 1;										// Change if need of > 1 is required at a later date
-	D3Dpp.BackBufferFormat				= D3DFMT_X8R8G8B8;							// Back-buffer format, 8 bits for each pixel
-	D3Dpp.BackBufferHeight				= height;									// Make sure resolution is supported, use adapter modes
-	D3Dpp.BackBufferWidth				= width;									// (Same as above)
-	D3Dpp.SwapEffect					= D3DSWAPEFFECT_DISCARD;					// Discard back-buffer, must stay discard to support multi-sample
-	D3Dpp.PresentationInterval			= m_bVsync ? D3DPRESENT_INTERVAL_DEFAULT : D3DPRESENT_INTERVAL_IMMEDIATE; // Present back-buffer immediately, unless V-Sync is on								
-	D3Dpp.Flags							= D3DPRESENTFLAG_DISCARD_DEPTHSTENCIL;		// This flag should improve performance, if not set to NULL.
-	D3Dpp.FullScreen_RefreshRateInHz	= bWindowed ? 0 : D3DPRESENT_RATE_DEFAULT;	// Full-screen refresh rate, use adapter modes or default
-	D3Dpp.MultiSampleQuality			= 0;										// MSAA currently off, check documentation for support.
-	D3Dpp.MultiSampleType				= D3DMULTISAMPLE_NONE;						// MSAA currently off, check documentation for support.
-
-	// Check device capabilities
-	DWORD deviceBehaviorFlags = 0;
-	m_pD3DObject->GetDeviceCaps(D3DADAPTER_DEFAULT, D3DDEVTYPE_HAL, &m_D3DCaps);
-
-	// Determine vertex processing mode
-	if(m_D3DCaps.DevCaps & D3DCREATE_HARDWARE_VERTEXPROCESSING)
+	// The back buffer matches the client area, the playfield is scaled into
+	// it keeping its aspect ratio
+	RECT clientRect;
+	GetClientRect(hWnd, &clientRect);
+	RendererDesc desc = video;
+	desc.window		= hWnd;
+	desc.width		= clientRect.right - clientRect.left;
+	desc.height		= clientRect.bottom - clientRect.top;
+	m_Viewport = MakeViewport(desc.width, desc.height, PLAYFIELD_WIDTH, PLAYFIELD_HEIGHT);
+	desc.textScale	= m_Viewport.scale;
+	desc.resources	= &m_Resources;
+	desc.vsync		= pacing.mode == PACING_VSYNC;
+
+	CTraceSpan comSpan(trace, "COM");
+	m_bComReady = comSpan.Check(SUCCEEDED(CoInitialize(NULL)));
+	comSpan.End();
+	
+	// Every DirectShow interface holds the graph open until it is released
+	CTraceSpan videoSpan(trace, "DirectShow");
+	IGraphBuilder* pGraphBuilder = 0;
+	videoSpan.Check(SUCCEEDED(CoCreateInstance( CLSID_FilterGraph, NULL, CLSCTX_INPROC_SERVER, 
+                  IID_IGraphBuilder, (void**)&pGraphBuilder)));
+	m_GraphBuilder.Reset(&m_Resources, m_Resources.Add(RESOURCE_DEVICE, "Filter graph", pGraphBuilder,
+		ReleaseComObject<IGraphBuilder>, 0));
+
+	if(pGraphBuilder)
 	{
-		// Hardware vertex processing supported? (Video Card)
-		deviceBehaviorFlags |= D3DCREATE_HARDWARE_VERTEXPROCESSING;	
+		IMediaControl* pMediaControl = 0;
+		IMediaEvent* pMediaEvent = 0;
+		pGraphBuilder->QueryInterface(IID_IMediaControl,
+                                (void**)&pMediaControl);
+		m_MediaControl.Reset(&m_Resources, m_Resources.Add(RESOURCE_DEVICE, "Media control", pMediaControl,
+			ReleaseComObject<IMediaControl>, 0, m_GraphBuilder.GetHandle()));
+
+		pGraphBuilder->QueryInterface(IID_IMediaEvent,
+                                (void**)&pMediaEvent);
+		m_MediaEvent.Reset(&m_Resources, m_Resources.Add(RESOURCE_DEVICE, "Media event", pMediaEvent,
+			ReleaseComObject<IMediaEvent>, 0, m_GraphBuilder.GetHandle()));
+
+		videoSpan.Check(SUCCEEDED(pGraphBuilder->RenderFile(L"intro.wmv", NULL)));
 	}
-	else
+
+	if(m_MediaControl.IsValid())
 	{
-		// If not, use software (CPU)
-		deviceBehaviorFlags |= D3DCREATE_SOFTWARE_VERTEXPROCESSING; 
+		IVideoWindow* pVideoWindow = 0;
+		m_MediaControl->QueryInterface(IID_IVideoWindow,
+                                (void**)&pVideoWindow);
+		m_VideoWindow.Reset(&m_Resources, m_Resources.Add(RESOURCE_DEVICE, "Video window", pVideoWindow,
+			ReleaseComObject<IVideoWindow>, 0, m_GraphBuilder.GetHandle()));
 	}
-	
-	// If hardware vertex processing is on, check pure device support
-	if(m_D3DCaps.DevCaps & D3DDEVCAPS_PUREDEVICE && deviceBehaviorFlags & D3DCREATE_HARDWARE_VERTEXPROCESSING)
+	if(m_VideoWindow.IsValid())
 	{
-		deviceBehaviorFlags |= D3DCREATE_PUREDEVICE;	
+		// Setup the window
+		m_VideoWindow->put_Owner((OAHWND)m_hWnd);
+		// Set the style
+		m_VideoWindow->put_WindowStyle(WS_CHILD | WS_CLIPSIBLINGS | WS_VISIBLE);
+		// Set the video size to the playfield on screen
+		m_VideoWindow->SetWindowPosition(m_Viewport.x, m_Viewport.y, 
+											m_Viewport.width, m_Viewport.height);
 	}
-	
-	// Create the D3D Device with the present parameters and device flags above
-	m_pD3DObject->CreateDevice(
-		D3DADAPTER_DEFAULT,		// which adapter to use, set to primary
-		D3DDEVTYPE_HAL,			// device type to use, set to hardware rasterization
-		hWnd,					// handle to the focus window
-		deviceBehaviorFlags,	// behavior flags
-		&D3Dpp,					// presentation parameters
-		&m_pD3DDevice);			// returned device pointer
-
-	//*************************************************************************
+	videoSpan.Check(m_VideoWindow.IsValid());
+	videoSpan.End();
 
 	//////////////////////////////////////////////////////////////////////////
-	// Create a Font Object
+	// Renderer - device, sprite and font for the backend in Renderer.h
 	//////////////////////////////////////////////////////////////////////////
-	
-	// Load a font for private use for this process
-
-	// Load D3DXFont, each font style you want to support will need an ID3DXFont
-	D3DXCreateFont(m_pD3DDevice, 30, 0, FW_BOLD, 0, false, 
-                  DEFAULT_CHARSET, OUT_DEFAULT_PRECIS, DEFAULT_QUALITY,
-                  DEFAULT_PITCH | FF_DONTCARE, TEXT("Times New Roman"), 
-                  &m_pD3DFont);
-
-	
+	CTraceSpan rendererSpan(trace, "Renderer");
+	m_bRendererReady = rendererSpan.Check(m_Renderer.Init(desc));
+	rendererSpan.End();
 
 	//////////////////////////////////////////////////////////////////////////
-	// Create Sprite Object and Textures
+	// Create Textures
 	//////////////////////////////////////////////////////////////////////////
-	// Create a sprite object, note you will only need one for all 2D sprites
-
-	D3DXCreateSprite(m_pD3DDevice, &m_pD3DSprite);
-	D3DXCreateSprite(m_pD3DDevice, &m_Ball);
-	D3DXCreateSprite(m_pD3DDevice, &m_Wall);
-
-	// Create a texture, each different 2D sprite to display to the screen
-	// will need a new texture object.  If drawing the same sprite texture
-	D3DXCreateTextureFromFileEx(m_pD3DDevice, L"Paddle.tga", 0, 0, 0, 0,
-                  D3DFMT_UNKNOWN, D3DPOOL_MANAGED, D3DX_DEFAULT, 
-                  D3DX_DEFAULT, D3DCOLOR_XRGB(255, 0, 255), 
-                  &m_imageInfo, 0, &m_pTexture);
-
-	D3DXCreateTextureFromFileEx(m_pD3DDevice, L"Ball.tga", 0, 0, 0, 0,
-                  D3DFMT_UNKNOWN, D3DPOOL_MANAGED, D3DX_DEFAULT, 
-                  D3DX_DEFAULT, D3DCOLOR_XRGB(255, 0, 255), 
-				  &m_ballImage, 0, &m_ballTexture);
-
-	D3DXCreateTextureFromFileEx(m_pD3DDevice, L"wall.tga", 0, 0, 0, 0,
-                  D3DFMT_UNKNOWN, D3DPOOL_MANAGED, D3DX_DEFAULT, 
-                  D3DX_DEFAULT, D3DCOLOR_XRGB(255, 0, 255), 
-				  &m_wallImage, 0, &m_wallTexture);
-
-	D3DXCreateTextureFromFileEx(m_pD3DDevice, L"START.tga", 0, 0, 0, 0,
-                  D3DFMT_UNKNOWN, D3DPOOL_MANAGED, D3DX_DEFAULT, 
-                  D3DX_DEFAULT, D3DCOLOR_XRGB(255, 0, 255), 
-				  &m_StartImage, 0, &m_StartText);
-
-	D3DXCreateTextureFromFileEx(m_pD3DDevice, L"CREDITS.tga", 0, 0, 0, 0,
-                  D3DFMT_UNKNOWN, D3DPOOL_MANAGED, D3DX_DEFAULT, 
-                  D3DX_DEFAULT, D3DCOLOR_XRGB(255, 0, 255), 
-				  &m_CreditImage, 0, &m_CreditText);
-	D3DXCreateTextureFromFileEx(m_pD3DDevice, L"CREDIT2.tga", 0, 0, 0, 0,
-                  D3DFMT_UNKNOWN, D3DPOOL_MANAGED, D3DX_DEFAULT, 
-                  D3DX_DEFAULT, D3DCOLOR_XRGB(255, 0, 255), 
-				  &m_Credit2Image, 0, &m_Credit2Text);
-	D3DXCreateTextureFromFileEx(m_pD3DDevice, L"EXIT.tga", 0, 0, 0, 0,
-                  D3DFMT_UNKNOWN, D3DPOOL_MANAGED, D3DX_DEFAULT, 
-                  D3DX_DEFAULT, D3DCOLOR_XRGB(255, 0, 255), 
-				  &m_ExitImage, 0, &m_ExitText);
-
-	// multiple times, just call that sprite's Draw() with different 
-	// transformation values.
-
-
-	//Paddle 1
-	Paddle[0].xp = -12;
-	Paddle[0].yp = 300;
-
-	//Paddle 2
-	Paddle[1].xp = 800;
-	Paddle[1].yp = 300;
-
-	//Ball
-	Ball.xp = 400;
-	Ball.yp = 300;
-
-	//	Wall / Background
-	Wall.xp = 400;
-	Wall.yp = 300;
-
-	//	Menu
-	Menu.xp = 200;
-	Menu.yp = 200;
-	
+	// Each different 2D sprite to display to the screen needs a texture,
+	// drawing the same sprite multiple times reuses it with a new position.
+	CTraceSpan textureSpan(trace, "Textures");
+	textureSpan.Check(LoadPongTextures(m_Renderer, m_Textures, trace));
+	textureSpan.End();
+
+	// Sprites, beeps and Pong.ini are reloaded whenever they are saved,
+	// see AssetReloader.h and ApplyReloads()
+	CTraceSpan reloadSpan(trace, "Asset reloader");
+	reloadSpan.Check(m_Reloader.Init("."));
+	for(int i = 0; i < PONG_TEXTURE_COUNT; ++i)
+	{
+		m_Reloader.Watch(GetPongTextureFile(i), ASSET_TEXTURE, i);
+	}
+	for(int i = 0; i < SOUND_FILE_COUNT; ++i)
+	{
+		m_Reloader.Watch(s_SoundFiles[i], ASSET_SOUND, i);
+	}
+	m_Reloader.Watch(PONG_CONFIG_FILE, ASSET_CONFIG, 0);
+	reloadSpan.End();
+
+	// Paddles, ball, wall, menus and score
+	CTraceSpan gameSpan(trace, "Game");
+	m_Game.Init();
+	m_Particles.Init();
+	m_fParticleTime = PlatformGetTime();
+
+	// Computer players, from the [Game] section of Pong.ini
+	CConfigFile config;
+	gameSpan.Check(config.Load(PONG_CONFIG_FILE));
+	AISettings aiSettings = GetAISettings(ParseAIDifficulty(config.GetString("Game", "Difficulty", ""), AI_NORMAL));
+	m_bAI[0] = config.GetBool("Game", "Player1AI", false);
+	m_bAI[1] = config.GetBool("Game", "Player2AI", false);
+	for(int i = 0; i < 2; ++i)
+	{
+		m_AI[i].Init(i, aiSettings, (unsigned int)time(NULL) + i);
+	}
 
+	// Ball and paddle speeds, from the [Tuning] section
+	PongTuning tuning;
+	ReadTuningConfig(config, tuning);
+	m_Game.SetTuning(tuning);
 
+	// Obstacles, from the arena file named in the [Game] section.  Like
+	// the tuning, both sides of an online match need the same one.
+	const char* arenaFile = config.GetString("Game", "Arena", "");
+	if(*arenaFile)
+	{
+		gameSpan.Check(m_Arena.Load(arenaFile));
+		m_Game.SetArena(&m_Arena);
+	}
 
-	//Initial Direction
-	Ball.DIR_UP_RIGHT = true;
+	// Online versus, from the [Net] section.  Each side plays one paddle
+	// and both players can use either set of keys.
+	m_bNet = config.GetBool("Net", "Enabled", false);
+	if(m_bNet)
+	{
+		int paddle = config.GetInt("Net", "Player", 1) == 2 ? 1 : 0;
+		m_bNet = m_NetTransport.Open(config.GetInt("Net", "LocalPort", 27015),
+			config.GetString("Net", "PeerAddress", "127.0.0.1"), config.GetInt("Net", "PeerPort", 27016));
+		m_Net.Init(&m_NetTransport, paddle, config.GetInt("Net", "InputDelay", 2), (int)pacing.tickRate);
+		gameSpan.Check(m_bNet);
+	}
 
-	//MENU
-	Menu.onGAME = false;
-	Menu.onSTART = true;
-	
+	// Key press to Present timing, from the [Debug] section
+	m_bMeasureLatency = config.GetBool("Debug", "InputLatency", false);
+
+	// Recording, from the [Capture] section, frames the size of the
+	// back buffer
+	FrameCaptureDesc captureDesc;
+	captureDesc.width	= desc.width;
+	captureDesc.height	= desc.height;
+	if(ReadCaptureConfig(config, captureDesc) && m_bRendererReady)
+	{
+		bool capturing = m_Capture.Init(captureDesc) && m_Renderer.SetCapture(&m_Capture);
+		if(!capturing)
+			m_Capture.Shutdown();
+		gameSpan.Check(capturing);
+	}
+
+	// Counters for monitoring, from the [Metrics] section, published to
+	// shared memory for Tools/MetricsReader.cpp
+	MetricsDesc metricsDesc;
+	if(ReadMetricsConfig(config, metricsDesc))
+	{
+		RegisterPongMetrics(m_Metrics, m_MetricIds);
+		m_MetricsWriter = m_Metrics.GetWriter();
+		m_bMetrics = m_MetricsPublisher.Start(m_Metrics, metricsDesc);
+		gameSpan.Check(m_bMetrics);
+	}
+	gameSpan.End();
 
 	//*************************************************************************
 
 	// create direct input object
-	DirectInput8Create(hInst, DIRECTINPUT_VERSION, IID_IDirectInput8,(void **)&m_pDIObject, NULL);
+	CTraceSpan inputSpan(trace, "DirectInput");
+	IDirectInput8* pDIObject = 0;
+	inputSpan.Check(SUCCEEDED(DirectInput8Create(hInst, DIRECTINPUT_VERSION, IID_IDirectInput8,(void **)&pDIObject, NULL)));
+	m_DIObject.Reset(&m_Resources, m_Resources.Add(RESOURCE_DEVICE, "DirectInput", pDIObject,
+		ReleaseComObject<IDirectInput8>, 0));
 
 	// Create Keyboard
-	m_pDIObject->CreateDevice(GUID_SysKeyboard, &m_pDIKeyboard, NULL);
+	IDirectInputDevice8* pDIKeyboard = 0;
+	if(pDIObject)
+		pDIObject->CreateDevice(GUID_SysKeyboard, &pDIKeyboard, NULL);
+	m_DIKeyboard.Reset(&m_Resources, m_Resources.Add(RESOURCE_DEVICE, "Keyboard", pDIKeyboard,
+		ReleaseComObject<IDirectInputDevice8>, 0, m_DIObject.GetHandle()));
 
 	//Set Keyboard data format
-	m_pDIKeyboard->SetDataFormat(&c_dfDIKeyboard); 
+	m_DIKeyboard->SetDataFormat(&c_dfDIKeyboard); 
 
 	//Set Keyboard coop level
-	m_pDIKeyboard->SetCooperativeLevel(hWnd, DISCL_FOREGROUND | DISCL_NONEXCLUSIVE); 
+	m_DIKeyboard->SetCooperativeLevel(hWnd, DISCL_FOREGROUND | DISCL_NONEXCLUSIVE); 
 
 	// Create Mouse
-	m_pDIObject->CreateDevice(GUID_SysMouse, &m_pDIMouse, NULL);
+	IDirectInputDevice8* pDIMouse = 0;
+	if(pDIObject)
+		pDIObject->CreateDevice(GUID_SysMouse, &pDIMouse, NULL);
+	m_DIMouse.Reset(&m_Resources, m_Resources.Add(RESOURCE_DEVICE, "Mouse", pDIMouse,
+		ReleaseComObject<IDirectInputDevice8>, 0, m_DIObject.GetHandle()));
 
 	// Set Mouse Data Format
-	m_pDIMouse->SetDataFormat(&c_dfDIMouse2);
+	m_DIMouse->SetDataFormat(&c_dfDIMouse2);
 
 	// Set Mouse Coop Level
-	m_pDIMouse->SetCooperativeLevel(hWnd, DISCL_FOREGROUND | DISCL_NONEXCLUSIVE);
+	m_DIMouse->SetCooperativeLevel(hWnd, DISCL_FOREGROUND | DISCL_NONEXCLUSIVE);
+	inputSpan.Check(m_DIKeyboard.IsValid() && m_DIMouse.IsValid());
+	inputSpan.End();
 
 
 	//SOUND INITIALIZATION
+	CTraceSpan audioSpan(trace, "FMOD");
 	channel = 0;
-	result = FMOD::System_Create(&system);
+	FMOD::System* pAudio = 0;
+	result = FMOD::System_Create(&pAudio);
+	m_Audio.Reset(&m_Resources, m_Resources.Add(RESOURCE_DEVICE, "FMOD", pAudio,
+		ReleaseFmodObject<FMOD::System>, 0));
 	
-	result = system->init(100, FMOD_INIT_NORMAL, 0); // initialize fmod
+	result = m_Audio->init(100, FMOD_INIT_NORMAL, 0); // initialize fmod
+	audioSpan.Check(result == FMOD_OK);
+	audioSpan.End();
 
-	result = system->createSound("beep1.ogg", FMOD_DEFAULT, 0, &mySound1);
-	result = system->createSound("beep2.ogg", FMOD_DEFAULT, 0, &mySound2);
-	result = system->createSound("pongMusic.wav", FMOD_LOOP_NORMAL | FMOD_2D, 0, &myStream);
+	CTraceSpan soundSpan(trace, "Sounds");
+	for(int i = 0; i < SOUND_FILE_COUNT; ++i)
+	{
+		CTraceSpan fileSpan(trace, s_SoundFiles[i]);
+		FMOD::Sound* pBeep = 0;
+		result = m_Audio->createSound(s_SoundFiles[i], FMOD_DEFAULT, 0, &pBeep);
+		m_Beep[i].Reset(&m_Resources, AddSound(pBeep, s_SoundFiles[i]));
+		soundSpan.Check(fileSpan.Check(m_Beep[i].IsValid()));
+	}
+	CTraceSpan musicSpan(trace, "pongMusic.wav");
+	FMOD::Sound* pMusic = 0;
+	result = m_Audio->createSound("pongMusic.wav", FMOD_LOOP_NORMAL | FMOD_2D, 0, &pMusic);
+	m_Music.Reset(&m_Resources, AddSound(pMusic, "pongMusic.wav"));
+	soundSpan.Check(musicSpan.Check(m_Music.IsValid()));
+	musicSpan.End();
+	soundSpan.End();
 
 
 //BACKGROUND MUSIC---------------------------------------------
-		result = system->playSound(myStream, 0, true, &channel);
+	if(m_Music.IsValid())
+	{
+		result = m_Audio->playSound(m_Music.Get(), 0, true, &channel);
 		result = channel->setVolume(0.5f);
 		result = channel->setPaused(false);
+	}
 //-------------------------------------------------------------
+
+	// What the game holds once everything is loaded, F3 shows it while
+	// running
+	std::string usage;
+	m_Resources.FormatUsage(usage);
+	OutputDebugStringA(("Resources: " + usage + "\n").c_str());
+
+	// Frames are paced from here on and the first tick falls due now.
+	// Sleeps come in 15 ms steps unless the timer is asked for 1 ms.
+	FramePacingDesc framePacing = pacing;
+#ifdef PONG_RENDERER_D3D9
+	framePacing.presentWaits = desc.vsync;
+#endif
+	m_bTimerPeriod = timeBeginPeriod(1) == TIMERR_NOERROR;
+	m_Pacer.Init(framePacing, PlatformGetTime(), PlatformGetCpuTime());
 }
 
 void CDirectXFramework::Update()
 {
+	WaitForFrame();
+
+	// Reads the keyboard state polled at the end of the last Update()
 	Getinput();
+	if(m_bMeasureLatency)
+	{
+		m_Latency.Capture(controlDown, m_fPollTime);
+	}
 	Pollinput();
 
 	// get current keyboard
-	hr = m_pDIKeyboard->GetDeviceState(sizeof(keyboardBuffer), (LPVOID)&keyboardBuffer);
+	hr = m_DIKeyboard->GetDeviceState(sizeof(keyboardBuffer), (LPVOID)&keyboardBuffer);
+	m_fPollTime = PlatformGetTime();
 
 	// get current mouse
-//	hr = m_pDIMouse->GetDeviceState(sizeof(DIMOUSESTATE2), &mouseState);
+//	hr = m_DIMouse->GetDeviceState(sizeof(DIMOUSESTATE2), &mouseState);
 
 
 	
 }
 
-static int Player1Point = 0;
-static int Player2Point = 0;
-
 void CDirectXFramework::Render()
 {
-	timeGetTime();
-	RECT rect;
-	// If the device was not created successfully, return
-	if(!m_pD3DDevice)
+	// If the renderer was not created successfully, return
+	if(!m_bRendererReady)
 	{
 		return;
 	}
 
-	//*************************************************************************
+	m_Audio->update();
+	ApplyReloads();
 
-	//////////////////////////////////////////////////////////////////////////
-	// All draw calls between swap chain's functions, and pre-render and post- 
-	// render functions (Clear and Present, BeginScene and EndScene)
-	//////////////////////////////////////////////////////////////////////////
-	
-	// Clear the back buffer, call BeginScene()
-	m_pD3DDevice->Clear(0, NULL, D3DCLEAR_TARGET, D3DCOLOR_XRGB(0,0,0), 1.0f, 0);
-	m_pD3DDevice->BeginScene();
-	system->update();
-			//////////////////////////////////////////////////////////////////////////
-			// Draw 3D Objects (for future labs - not used in Week #1)
-			//////////////////////////////////////////////////////////////////////////
-
-			//////////////////////////////////////////////////////////////////////////
-			// Draw 2D sprites
-			//////////////////////////////////////////////////////////////////////////
-			// Note: You should only be calling the sprite object's begin and end once, 
-			// with all draw calls of sprites between them
-
-			// Call Sprite's Begin to start rendering 2D sprite objects
-				m_pD3DSprite->Begin(NULL);
-				//////////////////////////////////////////////////////////////////////////
-				// Matrix Transformations to control sprite position, scale, and rotate
-				// Set these matrices for each object you want to render to the screen
-				//////////////////////////////////////////////////////////////////////////
-				// Scaling
-				// Rotation on Z axis, value in radians, converting from degrees
-				// Translation
-				// Multiply scale and rotation, store in scale
-				// Multiply scale and translation, store in world
-				// Set Transform
-
-				D3DXMATRIX transMat, rotMat, scaleMat, worldMat;
-				D3DXMatrixIdentity(&transMat);
-				D3DXMatrixIdentity(&scaleMat);
-				D3DXMatrixIdentity(&rotMat);
-				D3DXMatrixIdentity(&worldMat);
-				D3DXMatrixRotationZ(&rotMat, D3DXToRadian(0));
-				D3DXMatrixRotationZ(&rotMat, D3DXToRadian(0));
-				D3DXMatrixTranslation(&transMat, Menu.xp, Menu.yp, 0.0f);
-				D3DXMatrixScaling(&scaleMat, 0.5f, 0.5f, 0.0f);
-				D3DXMatrixMultiply(&scaleMat, &scaleMat, &rotMat);
-				D3DXMatrixMultiply(&worldMat, &scaleMat, &transMat);
-				m_pD3DSprite->SetTransform(&worldMat);
-
-				if(Menu.onSTART == true)
-				{
-			    	m_pD3DSprite->Draw(m_StartText, 0, &D3DXVECTOR3(m_StartImage.Width * 0.5f, 
-					m_StartImage.Height * 0.5f, 0.0f), 0,
-					D3DCOLOR_ARGB(255, 255, 255, 255));
-
-					if(controlDown & ARROW_DOWN)
-					{
-						Menu.onSTART = false;
-						Menu.onCREDITS = true;
-						
-					}
-					if(controlDown & ENTER_KEY)
-					{
-						Menu.onSTART = false;
-						Menu.onMovie = true;
-						if(Menu.onMovie = true)
-							{
-							m_pMediaControl->Run();
-
-							long evCode;
-							m_pMediaEvent->WaitForCompletion(INFINITE, &evCode);
-
-							m_pMediaControl->Stop();
-							Menu.onMovie = false;
-							Menu.onGAME = true;
-							}
-						
-					}
-				}
-				else if(Menu.onCREDITS == true)
-				{
-					m_pD3DSprite->Draw(m_CreditText, 0, &D3DXVECTOR3(m_CreditImage.Width * 0.5f, 
-					m_CreditImage.Height * 0.5f, 0.0f), 0,
-					D3DCOLOR_ARGB(255, 255, 255, 255));
-
-					if(controlDown & ARROW_DOWN)
-					{
-						Menu.onEXIT = true;
-						Menu.onCREDITS = false;
-						
-					}
-					if(controlDown & ENTER_KEY)
-					{
-						Menu.onCREDITS = false;
-						Menu.onCREDITS2 = true;
-						
-					}
-					if(controlDown & ARROW_UP)
-					{
-						Menu.onCREDITS = false;
-						Menu.onSTART = true;
-					}
-
-				}
-				else if(Menu.onEXIT == true)
-				{
-					m_pD3DSprite->Draw(m_ExitText, 0, &D3DXVECTOR3(m_ExitImage.Width * 0.5f, 
-					m_ExitImage.Height * 0.5f, 0.0f), 0,
-					D3DCOLOR_ARGB(255, 255, 255, 255));
-
-					if(controlDown & ARROW_UP)
-					{
-						Menu.onEXIT = false;
-						Menu.onCREDITS = true;
-					}
-					if(controlDown & ENTER_KEY)
-					{
-						Menu.onCREDITS = false;
-						Menu.onCREDITS2 = true;
-						exit(0);	
-					}
-				}
-				if(Menu.onCREDITS2 == true)
-				{
-					
-					m_pD3DSprite->Draw(m_Credit2Text, 0, &D3DXVECTOR3(m_Credit2Image.Width * 0.5f, 
-					m_Credit2Image.Height * 0.5f, 0.0f), 0,
-					D3DCOLOR_ARGB(255, 255, 255, 255));
-
-					if(controlDown & ARROW_LEFT)
-					{
-						Menu.onCREDITS2 = false;
-						Menu.onCREDITS = true;
-					}
-				}
-if(Menu.onGAME == true)
-{
-	
+	if(controlDown & RESOURCES_KEY)
+	{
+		m_bShowResources = !m_bShowResources;
+		m_SceneTracker.Invalidate();
+	}
 
-//BACKGROUND IMAGE
-				D3DXMatrixRotationZ(&rotMat, D3DXToRadian(0));
-				D3DXMatrixTranslation(&transMat, Wall.xp, Wall.yp, 0.0f);
-				D3DXMatrixScaling(&scaleMat, 1, 1, 0.0f);
-				D3DXMatrixMultiply(&scaleMat, &scaleMat, &rotMat);
-				D3DXMatrixMultiply(&worldMat, &scaleMat, &transMat);
-				// Set Transform for the object m_pD3DSprite
-				m_pD3DSprite->SetTransform(&worldMat);
+	//*************************************************************************
 
-				m_pD3DSprite->Draw(m_wallTexture, 0, &D3DXVECTOR3(m_wallImage.Width * 0.5f, 
-									m_wallImage.Height * 0.5f, 0.0f), 0,
-								D3DCOLOR_ARGB(255, 255, 255, 255));
+	// Menus and match logic for each tick m_Pacer calls for, collecting
+	// what happened in m_Events.  Online, the rollback session runs the
+	// match from both players' inputs, a net frame at a time once the
+	// frame's ticks have come due.  Offline, holding REWIND_KEY
+	// undoes one frame's ticks per frame instead.  Keys that went down
+	// are seen by the first tick, or the next frame's if this one runs
+	// none.
+	double frameStart = PlatformGetTime();
+	int ticks = m_Pacer.BeginFrame(frameStart);
+	bool online = m_bNet && m_Game.Menu.onGAME;
+	m_Events.Clear();
+	if(!online && m_Game.Menu.onGAME && (controlActive & REWIND_KEY))
+	{
+		m_Rewind.Rewind(m_Game, 1);
+		ticks = 0;
+	}
+	else if(!online && ticks > 0)
+	{
+		// Only the match is recorded, rewinding stops where it started
+		if(m_Game.Menu.onGAME)
+			m_Rewind.Record(m_Game);
+		else
+			m_Rewind.Clear();
+	}
+	int pressed = controlDown | m_nPressedUnticked;
+	if(m_bMetrics)
+	{
+		// A key pressed again before a tick saw the first press
+		for(int merged = controlDown & m_nPressedUnticked; merged; merged &= merged - 1)
+		{
+			m_MetricsWriter.Add(m_MetricIds.droppedInput);
+		}
+	}
+	m_nPressedUnticked = ticks > 0 ? 0 : pressed;
+	if(m_bMeasureLatency && ticks > 0)
+	{
+		m_Latency.Tick(PlatformGetTime());
+	}
+	for(int tick = 0; tick < ticks; ++tick)
+	{
+		// Computer players press their paddle's keys instead of the keyboard
+		int controls = controlActive;
+		for(int i = 0; i < 2; ++i)
+		{
+			if(m_bAI[i])
+			{
+				controls = (controls & ~CPaddleAI::GetPaddleKeys(i)) | m_AI[i].Think(m_Game);
+			}
+		}
 
-				for(int i = 0; i < 2; ++i)
+		if(m_bNet && m_Game.Menu.onGAME)
+		{
+			// The session runs this tick and the ones before it with the
+			// next frame
+			if(++m_nNetTicks < m_Net.GetFrameTicks(m_Net.GetFrame()))
+			{
+				pressed = 0;
+				continue;
+			}
+
+			int paddle = m_Net.GetLocalPaddle();
+			int sounds;
+			int inputs = m_bAI[paddle] ? GetPaddleInputs(paddle, controls)
+				: GetPaddleInputs(0, controls) | GetPaddleInputs(1, controls);
+			if(!m_Net.Advance(m_Game, inputs, sounds, &m_Events))
+			{
+				// The peer is too far behind, nothing runs until it
+				// catches up and the frame is tried again on the next
+				// tick
+				if(m_bMetrics)
 				{
-					if(i == 0)
-					{
-						if(controlActive & S_DOWN) 
-						{
-							Paddle[0].yp = Paddle[0].yp + .1f;
-						}
-
-						if(controlActive & W_UP) 
-						{
-							Paddle[0].yp = Paddle[0].yp - .1f;
-						}
-
-						//Out of Bounds
-
-						if(Paddle[i].yp-60 <= 0)
-						{
-							Paddle[0].yp = 60;
-						}
-
-						if(Paddle[i].yp+60 >= 600)
-						{
-							Paddle[0].yp = 540;
-						}
-						D3DXMatrixTranslation(&transMat, Paddle[i].xp, Paddle[i].yp, 0.0f);
-
-
-					}
-					if(i == 1)
-					{
-						if(controlActive & ARROW_DOWN) 
-						{
-							Paddle[1].yp = Paddle[1].yp + .1f;
-						}
-
-						if(controlActive & ARROW_UP) 
-						{
-							Paddle[1].yp = Paddle[1].yp - .1f;
-						}
-
-						//Out of Bounds
-						if(Paddle[i].yp-60 <= 0)
-						{
-							Paddle[1].yp = 60;
-						}
-						if(Paddle[i].yp+60 >= 600)
-						{
-							Paddle[1].yp = 540;
-						}
-						D3DXMatrixTranslation(&transMat, Paddle[i].xp, Paddle[i].yp, 0.0f);
-					}
-			
-				D3DXMatrixScaling(&scaleMat, 1, 1, 0.0f);
-				D3DXMatrixMultiply(&scaleMat, &scaleMat, &rotMat);
-				D3DXMatrixMultiply(&worldMat, &scaleMat, &transMat);
-				// Set Transform for the object m_pD3DSprite
-				m_pD3DSprite->SetTransform(&worldMat);
-
-				// Draw the texture with the sprite object
-
-				m_pD3DSprite->Draw(m_pTexture, 0, &D3DXVECTOR3(m_imageInfo.Width * 0.5f, 
-									m_imageInfo.Height * 0.5f, 0.0f), 0,
-									D3DCOLOR_ARGB(255, 255, 255, 255));
-				
-
-				
-//WALL COLLISION
-					if(Ball.yp-20 <= 0)
-					{
-						if(Ball.DIR_UP_RIGHT == true)
-						{
-							Ball.DIR_UP_RIGHT	=false;
-							Ball.DIR_DOWN_RIGHT =true;
-							Ball.DIR_DOWN_LEFT	=false;
-							Ball.DIR_UP_LEFT	=false;
-						}
-						else if(Ball.DIR_UP_LEFT == true)
-						{
-							Ball.DIR_UP_RIGHT	=false;
-							Ball.DIR_DOWN_RIGHT =false;
-							Ball.DIR_DOWN_LEFT	=true;
-							Ball.DIR_UP_LEFT	=false;
-						}
-					}
-
-					if(Ball.yp+20 >= 600)
-					{
-						if(Ball.DIR_DOWN_RIGHT == true)
-						{
-							Ball.DIR_UP_RIGHT	=true;
-							Ball.DIR_DOWN_RIGHT =false;
-							Ball.DIR_DOWN_LEFT	=false;
-							Ball.DIR_UP_LEFT	=false;
-						}
-						else if(Ball.DIR_DOWN_LEFT == true)
-						{
-							Ball.DIR_UP_RIGHT	=false;
-							Ball.DIR_DOWN_RIGHT =false;
-							Ball.DIR_DOWN_LEFT	=false;
-							Ball.DIR_UP_LEFT	=true;
-						}
-					}
-
-//BALL OUT OF BOUNDS
-					if(Ball.xp >= 800)
-					{
-						result = system->playSound(mySound2, 0, false, 0);
-						Player1Point++;
-
-						Ball.xp = 400;
-						Ball.yp = 300;
-
-						Ball.DIR_UP_RIGHT	=true;
-						Ball.DIR_DOWN_RIGHT =false;
-						Ball.DIR_DOWN_LEFT	=false;
-						Ball.DIR_UP_LEFT	=false;
-					}
-					if(Ball.xp <= 0)
-					{
-						result = system->playSound(mySound2, 0, false, 0);
-
-						Player2Point++;
-
-						Ball.xp = 400;
-						Ball.yp = 300;
-
-						Ball.DIR_UP_RIGHT	=false;
-						Ball.DIR_DOWN_RIGHT =false;
-						Ball.DIR_DOWN_LEFT	=false;
-						Ball.DIR_UP_LEFT	=true;
-					}
-
-//PADDLE COLLISION
-					if(Ball.xp >= Paddle[1].xp - 30
-						&& Ball.yp >= Paddle[1].yp - 60
-						&& Ball.yp <= Paddle[1].yp + 60)
-					{
-						if(Ball.DIR_DOWN_RIGHT == true)
-						{
-							result = system->playSound(mySound1, 0, false, 0);
-							Ball.DIR_UP_RIGHT	=false;
-							Ball.DIR_DOWN_RIGHT =false;
-							Ball.DIR_DOWN_LEFT	=true;
-							Ball.DIR_UP_LEFT	=false;
-						}
-						else if(Ball.DIR_UP_RIGHT == true)
-						{
-							result = system->playSound(mySound1, 0, false, 0);
-							Ball.DIR_UP_RIGHT	=false;
-							Ball.DIR_DOWN_RIGHT =false;
-							Ball.DIR_DOWN_LEFT	=false;
-							Ball.DIR_UP_LEFT	=true;
-						}
-					}
-
-					if(Ball.xp <= Paddle[0].xp + 30
-						&& Ball.yp >= Paddle[0].yp - 60
-						&& Ball.yp <= Paddle[0].yp + 60)
-					{
-						if(Ball.DIR_DOWN_LEFT == true)
-						{
-							result = system->playSound(mySound1, 0, false, 0);
-							Ball.DIR_UP_RIGHT	=false;
-							Ball.DIR_DOWN_RIGHT =true;
-							Ball.DIR_DOWN_LEFT	=false;
-							Ball.DIR_UP_LEFT	=false;
-						}
-						else if(Ball.DIR_UP_LEFT == true)
-						{
-							result = system->playSound(mySound1, 0, false, 0);
-							Ball.DIR_UP_RIGHT	=true;
-							Ball.DIR_DOWN_RIGHT =false;
-							Ball.DIR_DOWN_LEFT	=false;
-							Ball.DIR_UP_LEFT	=false;
-						}
-					}
-
-
-//BALL DIRECTION
-					if(Ball.DIR_UP_RIGHT == true)
-					{
-						Ball.xp = Ball.xp + 0.03f;
-						Ball.yp = Ball.yp - 0.05f;
-					}
-					if(Ball.DIR_DOWN_RIGHT == true)
-					{
-						Ball.xp = Ball.xp + 0.03f;
-						Ball.yp = Ball.yp + 0.05f;
-					}
-					if(Ball.DIR_DOWN_LEFT == true)
-					{
-						Ball.xp = Ball.xp - 0.03f;
-						Ball.yp = Ball.yp + 0.05f;
-					}
-					if(Ball.DIR_UP_LEFT == true)
-					{
-						Ball.xp = Ball.xp - 0.03f;
-						Ball.yp = Ball.yp - 0.05f;
-					}
-				
+					m_MetricsWriter.Add(m_MetricIds.netStalls);
 				}
-				
-				D3DXMatrixRotationZ(&rotMat, D3DXToRadian(0));
-				D3DXMatrixTranslation(&transMat, Ball.xp, Ball.yp, 0.0f);
-				D3DXMatrixScaling(&scaleMat, 1, 1, 0.0f);
-				D3DXMatrixMultiply(&scaleMat, &scaleMat, &rotMat);
-				D3DXMatrixMultiply(&worldMat, &scaleMat, &transMat);
-				// Set Transform for the object m_pD3DSprite
-				m_pD3DSprite->SetTransform(&worldMat);
-
-				m_pD3DSprite->Draw(m_ballTexture, 0, &D3DXVECTOR3(m_ballImage.Width * 0.5f, 
-								m_ballImage.Height * 0.5f, 0.0f), 0,
-								D3DCOLOR_ARGB(255, 255, 255, 255));
-				
-				// End drawing 2D sprites
-}
-				m_pD3DSprite->End();
-
-
+				m_nNetTicks = m_Net.GetFrameTicks(m_Net.GetFrame()) - 1;
+				break;
+			}
+			m_nNetTicks = 0;
+		}
+		else
+		{
+			m_Game.Tick(controls, pressed, &m_Events);
+			m_nNetTicks = 0;
+		}
+		pressed = 0;
+	}
 
-			//////////////////////////////////////////////////////////////////////////
-			// Draw Text
-			//////////////////////////////////////////////////////////////////////////
-			
-			// Calculate RECT structure for text drawing placement, using whole screen
-if(Menu.onGAME == true)
-{
-			rect.left = 10;
-			rect.right = 10;
-			rect.bottom = 10;
-			rect.top = 10;
+	// Hand the events out in one pass.  Audio plays each sound once
+	// however many of its events there were.
+	int heard = 0;
+	for(int i = 0; i < m_Events.GetCount(); ++i)
+	{
+		heard |= 1 << m_Events.Get(i).type;
+	}
+	if(heard & (1 << GAME_EVENT_PADDLE_HIT))
+	{
+		result = m_Audio->playSound(m_Beep[0].Get(), 0, false, 0);
+	}
+	if(heard & (1 << GAME_EVENT_POINT_SCORED))
+	{
+		result = m_Audio->playSound(m_Beep[1].Get(), 0, false, 0);
+	}
 
-			wchar_t Player1Text[256];
-			swprintf(Player1Text, 256, L"Point(s): %i", Player1Point);
+	// Effects for the same events.  Particles move by the real time
+	// since the last frame, however many ticks it ran.
+	double now = PlatformGetTime();
+	float dt = (float)(now - m_fParticleTime);
+	m_fParticleTime = now;
+	m_Particles.EmitForEvents(m_Events);
+	m_Particles.EmitTrail(m_Game);
+	m_Particles.Update(dt < 0.1f ? dt : 0.1f);
 
-			m_pD3DFont->DrawText(0, Player1Text, -1, &rect, 
-                 DT_TOP | DT_LEFT | DT_NOCLIP, 
-                 D3DCOLOR_ARGB(255, 255, 255, 255));
+	if(m_Game.Menu.onMovie == true)
+	{
+		// Skipped if intro.wmv could not be opened
+		if(m_MediaControl.IsValid() && m_MediaEvent.IsValid())
+		{
+			m_MediaControl->Run();
 
-			rect.left = 670;
-			rect.right = 10;
-			rect.bottom = 10;
-			rect.top = 10;
+			long evCode;
+			m_MediaEvent->WaitForCompletion(INFINITE, &evCode);
 
-			wchar_t Player2Text[256];
-			swprintf(Player2Text, 256, L"Point(s): %i", Player2Point);
+			m_MediaControl->Stop();
+		}
+		m_Game.FinishMovie();
+	}
 
-			m_pD3DFont->DrawText(0, Player2Text, -1, &rect, 
-                 DT_TOP | DT_LEFT | DT_NOCLIP, 
-                 D3DCOLOR_ARGB(255, 255, 255, 255));
-			
-			// to be drawn outside of the rect specified to draw text in.
+	if(m_Game.Menu.onQuit == true)
+	{
+		exit(0);
+	}
 
-			// EndScene, and Present the back buffer to the display buffer
+	//////////////////////////////////////////////////////////////////////////
+	// Draw the menu or the match, see PongScene.h.  Frames that look the
+	// same as the one on screen are not drawn or presented, unless
+	// particles are still moving.
+	//////////////////////////////////////////////////////////////////////////
+	bool presented = false;
+	if(m_SceneTracker.NeedsRedraw(m_Game) || m_Particles.GetCount() > 0)
+	{
+		wchar_t status[256] = L"";
+		if(m_bShowResources)
+		{
+			std::string usage;
+			m_Resources.FormatUsage(usage);
+			mbstowcs(status, usage.c_str(), 255);
+			status[255] = 0;
+		}
+		if(m_bMeasureLatency)
+		{
+			m_Latency.Draw(PlatformGetTime());
+		}
+		DrawPongScene(m_Renderer, m_Game, m_Textures, m_Viewport, &m_Particles, m_bShowResources ? status : 0);
+		if(m_bMeasureLatency)
+		{
+			m_Latency.Present(PlatformGetTime());
+		}
+		++m_nPresented;
+		presented = true;
+	}
+	m_Pacer.EndFrame(PlatformGetTime(), PlatformGetCpuTime(), presented);
+	if(m_bMetrics)
+	{
+		CountFrame(ticks, presented, frameStart);
+	}
 }
-			m_pD3DDevice->EndScene();
-			m_pD3DDevice->Present(NULL, NULL, NULL, NULL);
 
+void CDirectXFramework::CountFrame(int ticks, bool presented, double start)
+{
+	m_MetricsWriter.Record(m_MetricIds.frameWork, PlatformGetTime() - start);
+	m_MetricsWriter.Add(m_MetricIds.frames);
+	m_MetricsWriter.Add(m_MetricIds.ticks, ticks);
+	if(presented)
+	{
+		m_MetricsWriter.Add(m_MetricIds.presented);
+	}
+	CountPongEvents(m_MetricsWriter, m_MetricIds, m_Events);
 
-	//*************************************************************************
+	int captureDropped = m_Capture.GetDroppedCount();
+	m_MetricsWriter.Add(m_MetricIds.droppedCapture, captureDropped - m_nCaptureDropped);
+	m_nCaptureDropped = captureDropped;
 
-	//Sound System Update
-	if(controlDown & SOUND1)
+	if(m_Pacer.GetFrameCount() % METRICS_GAUGE_FRAMES == 1)
 	{
-		
-
+		int voices = 0;
+		if(m_Audio.IsValid())
+		{
+			m_Audio->getChannelsPlaying(&voices);
+		}
+		m_MetricsWriter.Set(m_MetricIds.voices, voices);
+		m_MetricsWriter.Set(m_MetricIds.assetBytes, m_Resources.GetTotalBytes());
 	}
+}
 
-	if(controlDown & SOUND2)
+void CDirectXFramework::WaitForFrame()
+{
+	// Nothing moves on the menus until a key is pressed, so they run at
+	// the idle rate and input cuts the wait short
+	bool idle = CSceneTracker::IsStatic(m_Game);
+	for(;;)
 	{
-		
+		double wait = m_Pacer.GetWait(PlatformGetTime(), idle);
+		if(wait <= 0.0)
+			break;
+		if(idle)
+		{
+			DWORD ms = (DWORD)(wait * 1000.0) + 1;
+			if(MsgWaitForMultipleObjectsEx(0, NULL, ms, QS_ALLINPUT, MWMO_INPUTAVAILABLE) == WAIT_OBJECT_0)
+				break;
+		}
+		else
+		{
+			PlatformSleep(wait);
+		}
 	}
-	
+}
+
+void CDirectXFramework::Invalidate()
+{
+	m_SceneTracker.Invalidate();
 }
 
 void CDirectXFramework::Shutdown()
@@ -756,31 +602,187 @@ void CDirectXFramework::Shutdown()
 	
 	
 	//*************************************************************************
-	// Release COM objects in the opposite order they were created in
-
-	// Texture
-	m_pTexture->Release();
-	// Sprite
-	m_pD3DSprite->Release();
-	// Font
-	m_pD3DFont->Release();
-	// 3DDevice	
-		
-	// 3DObject
+	// Release COM objects in the opposite order they were created in.
+	// Everything in m_Resources holds what it was made from, so a device
+	// or system goes after the last object made from it.
+
+	// Recording: the frames the GPU still holds, then everything queued
+	if(m_Capture.IsCapturing())
+	{
+		m_Renderer.SetCapture(0);
+		m_Capture.Shutdown();
+		std::string report;
+		m_Capture.Format(report);
+		OutputDebugStringA(report.c_str());
+	}
+
+	// Metrics, the last publish goes with the segment
+	m_MetricsPublisher.Shutdown();
+	m_bMetrics = false;
+
+	// Frame pacing, once however many times this is called
+	if(m_bTimerPeriod)
+	{
+		timeEndPeriod(1);
+		m_bTimerPeriod = false;
+		std::string report;
+		m_Pacer.Format(report);
+		OutputDebugStringA(report.c_str());
+	}
+
+	// Textures, Sprite, Font, 3DDevice and 3DObject
+	m_Renderer.Shutdown();
+	m_bRendererReady = false;
+
+	// Reloading, before the sounds it may still be opening
+	m_Reloader.Shutdown();
+	for(int i = 0; i < SOUND_FILE_COUNT; ++i)
+	{
+		if(m_pLoadingSound[i])
+		{
+			m_pLoadingSound[i]->release();
+			m_pLoadingSound[i] = 0;
+		}
+	}
 
 	// Sound
-	system->release();
+	m_Music.Reset();
+	for(int i = 0; i < SOUND_FILE_COUNT; ++i)
+	{
+		m_Beep[i].Reset();
+	}
+	m_Audio.Reset();
+
+	// Input
+	if(m_DIKeyboard.IsValid())
+		m_DIKeyboard->Unacquire();
+	if(m_DIMouse.IsValid())
+		m_DIMouse->Unacquire();
+	m_DIMouse.Reset();
+	m_DIKeyboard.Reset();
+	m_DIObject.Reset();
+
+	// Network
+	if(m_bNet)
+	{
+		std::string report;
+		m_Net.Format(report);
+		OutputDebugStringA(report.c_str());
+		m_bNet = false;
+	}
+	m_NetTransport.Close();
+
+	// Input latency, once however many times this is called
+	if(m_bMeasureLatency && m_Latency.GetStage(LATENCY_TOTAL).GetCount() > 0)
+	{
+		std::string report;
+		m_Latency.Format(report);
+		OutputDebugStringA(("Input latency:\n" + report).c_str());
+		FILE* file = fopen(INPUT_LATENCY_FILE, "w");
+		if(file)
+		{
+			fputs(report.c_str(), file);
+			fclose(file);
+		}
+		m_Latency.Clear();
+	}
 
 	//*************************************************************************
-	m_pVideoWindow->put_Visible(OAFALSE);
-	m_pVideoWindow->put_Owner((OAHWND)m_hWnd);
-	m_pMediaControl->Release();
-	m_pMediaEvent->Release();
-	m_pGraphBuilder->Release(); // Should be AFTER the other calls!
-	CoUninitialize();
+	// The video window has to let go of the game's window first
+	if(m_VideoWindow.IsValid())
+	{
+		m_VideoWindow->put_Visible(OAFALSE);
+		m_VideoWindow->put_Owner(NULL);
+	}
+	m_VideoWindow.Reset();
+	m_MediaControl.Reset();
+	m_MediaEvent.Reset();
+	m_GraphBuilder.Reset(); // Should be AFTER the other calls!
+
+	// Anything left was added and never released
+	std::string leaks;
+	if(m_Resources.ReleaseAll(&leaks) > 0)
+	{
+		OutputDebugStringA(("Resources still held at shutdown:\n" + leaks).c_str());
+	}
+
+	if(m_bComReady)
+	{
+		CoUninitialize();
+		m_bComReady = false;
+	}
 	
 }
 
+void CDirectXFramework::ApplyReloads()
+{
+	m_Reloader.Update(PlatformGetTime());
+
+	// Beeps FMOD has finished opening replace the ones in use, keeping
+	// their handles
+	for(int i = 0; i < SOUND_FILE_COUNT; ++i)
+	{
+		if(!m_pLoadingSound[i])
+			continue;
+
+		FMOD_OPENSTATE state = FMOD_OPENSTATE_LOADING;
+		m_pLoadingSound[i]->getOpenState(&state, 0, 0, 0);
+		if(state == FMOD_OPENSTATE_READY)
+		{
+			if(!m_Resources.Replace(m_Beep[i].GetHandle(), m_pLoadingSound[i], GetSoundBytes(m_pLoadingSound[i])))
+				m_Beep[i].Reset(&m_Resources, AddSound(m_pLoadingSound[i], s_SoundFiles[i]));
+			m_pLoadingSound[i] = 0;
+		}
+		else if(state == FMOD_OPENSTATE_ERROR)
+		{
+			// Keeps the old beep
+			m_pLoadingSound[i]->release();
+			m_pLoadingSound[i] = 0;
+		}
+	}
+
+	// One finished reload a frame, saving several files at once spreads
+	// the texture uploads over several frames
+	if(!m_Reloader.Pop(m_Reload) || !m_Reload.ok)
+		return;
+
+	switch(m_Reload.kind)
+	{
+	case ASSET_TEXTURE:
+		if(m_Renderer.UpdateTexture(m_Reload.image, GetPongTexture(m_Textures, m_Reload.slot)))
+			m_SceneTracker.Invalidate();
+		break;
+
+	case ASSET_SOUND:
+		// FMOD decodes it on its own thread, the old one plays until then
+		if(m_pLoadingSound[m_Reload.slot])
+			m_pLoadingSound[m_Reload.slot]->release();
+		m_pLoadingSound[m_Reload.slot] = 0;
+		result = m_Audio->createSound(m_Reload.fileName.c_str(), FMOD_DEFAULT | FMOD_NONBLOCKING, 0,
+			&m_pLoadingSound[m_Reload.slot]);
+		break;
+
+	case ASSET_CONFIG:
+		// Both sides of an online match must run the same speeds, so it
+		// keeps the ones it started with
+		if(!m_bNet)
+		{
+			PongTuning tuning = m_Game.GetTuning();
+			ReadTuningConfig(m_Reload.config, tuning);
+			m_Game.SetTuning(tuning);
+		}
+		break;
+	}
+}
+
+ResourceHandle CDirectXFramework::AddSound(FMOD::Sound* sound, const char* fileName)
+{
+	if(!sound)
+		return INVALID_RESOURCE;
+	return m_Resources.Add(RESOURCE_SOUND, fileName, sound, ReleaseFmodObject<FMOD::Sound>,
+		GetSoundBytes(sound), m_Audio.GetHandle());
+}
+
 void CDirectXFramework::Getinput()
 {
 	controlCurrent = 0;
@@ -792,6 +794,8 @@ void CDirectXFramework::Getinput()
 
 	if(keyboardBuffer[DIK_LEFT] & 0x80) controlCurrent |= ARROW_LEFT;
 	if(keyboardBuffer[DIK_RETURN] & 0x80) controlCurrent |= ENTER_KEY;
+	if(keyboardBuffer[DIK_BACK] & 0x80) controlCurrent |= REWIND_KEY;
+	if(keyboardBuffer[DIK_F3] & 0x80) controlCurrent |= RESOURCES_KEY;
 
 	//Mouse Keys
 //	if(mouseState.rgbButtons[0] & 0x80)controlCurrent |= SHRINK;
@@ -814,24 +818,24 @@ void CDirectXFramework::Getinput()
 void CDirectXFramework::Pollinput()
 {
 		// Poll keyboard
-		hr = m_pDIKeyboard->GetDeviceState(sizeof(keyboardBuffer), (void**)&keyboardBuffer);
+		hr = m_DIKeyboard->GetDeviceState(sizeof(keyboardBuffer), (void**)&keyboardBuffer);
 
 		if( FAILED(hr) )
 		{
 			//Keyboard lost, zero out keyboard data stucture.
 			ZeroMemory(keyboardBuffer, sizeof(keyboardBuffer));
 			// Try to acquire for next time we poll
-			hr = m_pDIKeyboard->Acquire();
+			hr = m_DIKeyboard->Acquire();
 		}
 
 		// Poll Mouse
-		hr = m_pDIMouse->GetDeviceState(sizeof(mouseState), (void**)&mouseState);
+		hr = m_DIMouse->GetDeviceState(sizeof(mouseState), (void**)&mouseState);
 
 		if( FAILED(hr) )
 		{
 			//Keyboard lost, zero out keyboard data stucture.
 			ZeroMemory(&mouseState, sizeof(mouseState));
 			// Try to acquire for next time we poll
-			hr = m_pDIMouse->Acquire();
+			hr = m_DIMouse->Acquire();
 		}
 }
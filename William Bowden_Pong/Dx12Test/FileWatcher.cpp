@@ -0,0 +1,221 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	FileWatcher.cpp
+// Date:	October 19th, 2026
+// Purpose: Directory change notification, see FileWatcher.h.
+//////////////////////////////////////////////////////////////////////////
+#include "FileWatcher.h"
+
+#ifdef _WIN32
+
+CFileWatcher::CFileWatcher(void)
+{
+	m_hDirectory	= INVALID_HANDLE_VALUE;
+	m_bPending		= false;
+	ZeroMemory(&m_Overlapped, sizeof(m_Overlapped));
+}
+
+CFileWatcher::~CFileWatcher(void)
+{
+	Shutdown();
+}
+
+bool CFileWatcher::Init(const char* directory)
+{
+	Shutdown();
+
+	// Opened for overlapped reads, so Poll() can check for a result
+	// without waiting for one
+	m_hDirectory = CreateFileA(directory, FILE_LIST_DIRECTORY,
+		FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL, OPEN_EXISTING,
+		FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, NULL);
+	if(m_hDirectory == INVALID_HANDLE_VALUE)
+		return false;
+
+	m_Overlapped.hEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
+	if(!m_Overlapped.hEvent || !Issue())
+	{
+		Shutdown();
+		return false;
+	}
+	return true;
+}
+
+void CFileWatcher::Shutdown()
+{
+	if(m_hDirectory != INVALID_HANDLE_VALUE)
+	{
+		if(m_bPending)
+		{
+			// The read writes into m_Buffer, wait for the cancel to land
+			DWORD bytes;
+			CancelIo(m_hDirectory);
+			GetOverlappedResult(m_hDirectory, &m_Overlapped, &bytes, TRUE);
+		}
+		CloseHandle(m_hDirectory);
+	}
+	if(m_Overlapped.hEvent)
+		CloseHandle(m_Overlapped.hEvent);
+
+	m_hDirectory	= INVALID_HANDLE_VALUE;
+	m_bPending		= false;
+	ZeroMemory(&m_Overlapped, sizeof(m_Overlapped));
+}
+
+bool CFileWatcher::Issue()
+{
+	ResetEvent(m_Overlapped.hEvent);
+	m_bPending = ReadDirectoryChangesW(m_hDirectory, m_Buffer, sizeof(m_Buffer), FALSE,
+		FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME, NULL, &m_Overlapped, NULL) != FALSE;
+	return m_bPending;
+}
+
+bool CFileWatcher::Poll(std::vector<std::string>& changed)
+{
+	if(!m_bPending)
+		return false;
+
+	DWORD bytes = 0;
+	if(!GetOverlappedResult(m_hDirectory, &m_Overlapped, &bytes, FALSE))
+	{
+		// Still waiting, or the directory went away
+		if(GetLastError() != ERROR_IO_INCOMPLETE)
+			m_bPending = false;
+		return false;
+	}
+
+	size_t before = changed.size();
+	const BYTE* record = (const BYTE*)m_Buffer;
+	while(bytes > 0)
+	{
+		const FILE_NOTIFY_INFORMATION* info = (const FILE_NOTIFY_INFORMATION*)record;
+		if(info->Action == FILE_ACTION_MODIFIED || info->Action == FILE_ACTION_ADDED ||
+			info->Action == FILE_ACTION_RENAMED_NEW_NAME)
+		{
+			char name[MAX_PATH];
+			int length = WideCharToMultiByte(CP_ACP, 0, info->FileName, info->FileNameLength / sizeof(WCHAR),
+				name, sizeof(name) - 1, NULL, NULL);
+			if(length > 0)
+				changed.push_back(std::string(name, length));
+		}
+		if(info->NextEntryOffset == 0)
+			break;
+		record += info->NextEntryOffset;
+	}
+
+	// Zero bytes means the buffer overflowed, those changes are lost
+	Issue();
+	return changed.size() > before;
+}
+
+bool CFileWatcher::IsWatching() const
+{
+	return m_bPending;
+}
+
+#elif defined(__linux__)
+
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <errno.h>
+
+CFileWatcher::CFileWatcher(void)
+{
+	m_nNotify	= -1;
+	m_nWatch	= -1;
+}
+
+CFileWatcher::~CFileWatcher(void)
+{
+	Shutdown();
+}
+
+bool CFileWatcher::Init(const char* directory)
+{
+	Shutdown();
+
+	m_nNotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if(m_nNotify < 0)
+		return false;
+
+	// Closing after a write catches editors that write in place, moving in
+	// catches the ones that save to a temporary file and rename it
+	m_nWatch = inotify_add_watch(m_nNotify, directory, IN_CLOSE_WRITE | IN_MOVED_TO);
+	if(m_nWatch < 0)
+	{
+		Shutdown();
+		return false;
+	}
+	return true;
+}
+
+void CFileWatcher::Shutdown()
+{
+	if(m_nNotify >= 0)
+		close(m_nNotify);
+	m_nNotify	= -1;
+	m_nWatch	= -1;
+}
+
+bool CFileWatcher::Poll(std::vector<std::string>& changed)
+{
+	if(m_nNotify < 0)
+		return false;
+
+	size_t before = changed.size();
+	char buffer[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+	for(;;)
+	{
+		ssize_t bytes = read(m_nNotify, buffer, sizeof(buffer));
+		if(bytes <= 0)
+			break;
+
+		for(char* record = buffer; record < buffer + bytes; )
+		{
+			const struct inotify_event* event = (const struct inotify_event*)record;
+			if(event->len > 0 && !(event->mask & IN_ISDIR))
+				changed.push_back(event->name);
+			record += sizeof(struct inotify_event) + event->len;
+		}
+	}
+	return changed.size() > before;
+}
+
+bool CFileWatcher::IsWatching() const
+{
+	return m_nWatch >= 0;
+}
+
+#else
+
+CFileWatcher::CFileWatcher(void)
+{
+	m_nNotify	= -1;
+	m_nWatch	= -1;
+}
+
+CFileWatcher::~CFileWatcher(void)
+{
+}
+
+bool CFileWatcher::Init(const char* directory)
+{
+	(void)directory;
+	return false;
+}
+
+void CFileWatcher::Shutdown()
+{
+}
+
+bool CFileWatcher::Poll(std::vector<std::string>& changed)
+{
+	(void)changed;
+	return false;
+}
+
+bool CFileWatcher::IsWatching() const
+{
+	return false;
+}
+
+#endif
@@ -0,0 +1,62 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	FileWatcher.h
+// Date:	October 19th, 2026
+// Purpose: Reports files written in one directory, without blocking and
+//			without reading the files.  ReadDirectoryChangesW on Windows,
+//			inotify on Linux; elsewhere Init() fails and nothing is
+//			reported.  Editors often save in several writes or through a
+//			temporary file, so one save can be reported more than once,
+//			see CAssetReloader for settling them.
+//////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+	#include <windows.h>
+#endif
+
+class CFileWatcher
+{
+#ifdef _WIN32
+	HANDLE				m_hDirectory;
+	OVERLAPPED			m_Overlapped;
+	DWORD				m_Buffer[4096];	// FILE_NOTIFY_INFORMATION records, DWORD aligned
+	bool				m_bPending;		// A ReadDirectoryChangesW() is outstanding
+
+	bool Issue();
+#else
+	int					m_nNotify;		// inotify descriptor
+	int					m_nWatch;
+#endif
+
+	CFileWatcher(const CFileWatcher&);
+	CFileWatcher& operator=(const CFileWatcher&);
+
+public:
+	CFileWatcher(void);
+	~CFileWatcher(void);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Init
+	// Parameters:	const char* directory - Directory to watch, not its
+	//					subdirectories
+	// Return:		bool - false if it cannot be watched
+	// Description:	Stops watching any previous directory.
+	//////////////////////////////////////////////////////////////////////////
+	bool Init(const char* directory);
+	void Shutdown();
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Poll
+	// Parameters:	std::vector<std::string>& changed - Names of the files
+	//					written or moved in since the last call are
+	//					appended, without the directory
+	// Return:		bool - true if anything was appended
+	// Description:	Returns straight away.  Changes that did not fit the
+	//				system's buffer are lost.
+	//////////////////////////////////////////////////////////////////////////
+	bool Poll(std::vector<std::string>& changed);
+
+	bool IsWatching() const;
+};
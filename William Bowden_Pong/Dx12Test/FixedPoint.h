@@ -0,0 +1,77 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	FixedPoint.h
+// Date:	October 19th, 2026
+// Purpose: 16.16 fixed point number for the deterministic physics mode
+//			(PongPhysics.h).  Every operation is integer maths, so a match
+//			played on the same keys ends in the same bits whatever the
+//			compiler, its floating point flags or the CPU.  Floats may
+//			be turned into fixed point and back, the conversion rounds
+//			the same way everywhere, but nothing in between uses them.
+//			Holds -32768 to 32767 in steps of 1/65536, far more than the
+//			playfield needs.
+//////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#define FIXED_FRACTION_BITS 16
+#define FIXED_ONE (1 << FIXED_FRACTION_BITS)
+
+class CFixed
+{
+	int					m_nRaw;			// Value * FIXED_ONE
+
+public:
+	// No constructors, so the match state stays plain data
+	static CFixed FromInt(int value)
+	{
+		CFixed fixed;
+		fixed.m_nRaw = value * FIXED_ONE;
+		return fixed;
+	}
+
+	static CFixed FromRaw(int raw)
+	{
+		CFixed fixed;
+		fixed.m_nRaw = raw;
+		return fixed;
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		FromFloat
+	// Parameters:	float value - e.g. a speed read from Pong.ini
+	// Return:		CFixed - Nearest fixed point value, halves rounded up
+	// Description:	Done in double, where scaling a float by FIXED_ONE
+	//				and adding a half are exact, so every machine rounds
+	//				the same float to the same value.
+	//////////////////////////////////////////////////////////////////////////
+	static CFixed FromFloat(float value)
+	{
+		double scaled = (double)value * FIXED_ONE + 0.5;
+		int raw = (int)scaled;
+		if(raw > scaled)
+			--raw;
+		return FromRaw(raw);
+	}
+
+	// Nearest float, for drawing and events, never fed back in
+	float ToFloat() const		{ return (float)m_nRaw * (1.0f / FIXED_ONE); }
+	int GetRaw() const			{ return m_nRaw; }
+
+	CFixed operator+(CFixed other) const	{ return FromRaw(m_nRaw + other.m_nRaw); }
+	CFixed operator-(CFixed other) const	{ return FromRaw(m_nRaw - other.m_nRaw); }
+	CFixed operator-() const				{ return FromRaw(-m_nRaw); }
+	CFixed& operator+=(CFixed other)		{ m_nRaw += other.m_nRaw; return *this; }
+	CFixed& operator-=(CFixed other)		{ m_nRaw -= other.m_nRaw; return *this; }
+
+	// Rounds toward minus infinity, the 64 bit product cannot overflow
+	CFixed operator*(CFixed other) const
+	{
+		return FromRaw((int)(((long long)m_nRaw * other.m_nRaw) >> FIXED_FRACTION_BITS));
+	}
+
+	bool operator==(CFixed other) const		{ return m_nRaw == other.m_nRaw; }
+	bool operator!=(CFixed other) const		{ return m_nRaw != other.m_nRaw; }
+	bool operator<(CFixed other) const		{ return m_nRaw < other.m_nRaw; }
+	bool operator<=(CFixed other) const		{ return m_nRaw <= other.m_nRaw; }
+	bool operator>(CFixed other) const		{ return m_nRaw > other.m_nRaw; }
+	bool operator>=(CFixed other) const		{ return m_nRaw >= other.m_nRaw; }
+};
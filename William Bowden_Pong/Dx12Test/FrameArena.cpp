@@ -0,0 +1,129 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	FrameArena.cpp
+// Date:	October 19th, 2026
+// Purpose: Per-frame linear allocator, see FrameArena.h.
+//////////////////////////////////////////////////////////////////////////
+#include "FrameArena.h"
+#include <stdlib.h>
+
+CFrameArena::CFrameArena(void)
+{
+	m_pBuffer			= 0;
+	m_nCapacity			= 0;
+	m_nUsed				= 0;
+	m_nOverflowBytes	= 0;
+	m_nGrows			= 0;
+#ifdef PONG_MEMORY_STATS
+	m_nPeak				= 0;
+	m_nAllocations		= 0;
+	m_nOverflows		= 0;
+	m_nFrames			= 0;
+#endif
+}
+
+CFrameArena::~CFrameArena(void)
+{
+	Shutdown();
+}
+
+bool CFrameArena::Init(size_t bytes)
+{
+	Shutdown();
+
+	m_pBuffer = (unsigned char*)malloc(bytes);
+	if(!m_pBuffer)
+		return false;
+	m_nCapacity = bytes;
+	m_Overflow.reserve(16);
+	return true;
+}
+
+void CFrameArena::Shutdown()
+{
+	for(size_t i = 0; i < m_Overflow.size(); ++i)
+		free(m_Overflow[i]);
+	m_Overflow.clear();
+
+	free(m_pBuffer);
+	m_pBuffer			= 0;
+	m_nCapacity			= 0;
+	m_nUsed				= 0;
+	m_nOverflowBytes	= 0;
+}
+
+void* CFrameArena::Allocate(size_t bytes, size_t align)
+{
+#ifdef PONG_MEMORY_STATS
+	++m_nAllocations;
+#endif
+
+	size_t offset = (m_nUsed + align - 1) & ~(align - 1);
+	if(offset + bytes <= m_nCapacity)
+	{
+		m_nUsed = offset + bytes;
+		return m_pBuffer + offset;
+	}
+
+	// Does not fit, this frame gets a block of its own
+	unsigned char* block = (unsigned char*)malloc(bytes + align);
+	if(!block)
+		return 0;
+	m_Overflow.push_back(block);
+	m_nOverflowBytes += bytes + align;
+#ifdef PONG_MEMORY_STATS
+	++m_nOverflows;
+#endif
+
+	size_t address = ((size_t)block + align - 1) & ~(align - 1);
+	return (void*)address;
+}
+
+void CFrameArena::Reset()
+{
+	size_t frameBytes = m_nUsed + m_nOverflowBytes;
+#ifdef PONG_MEMORY_STATS
+	if(frameBytes > m_nPeak)
+		m_nPeak = frameBytes;
+	++m_nFrames;
+#endif
+
+	if(!m_Overflow.empty())
+	{
+		for(size_t i = 0; i < m_Overflow.size(); ++i)
+			free(m_Overflow[i]);
+		m_Overflow.clear();
+
+		// Room for the frame that overflowed plus a quarter, so slowly
+		// growing scenes do not reallocate every frame
+		size_t capacity = frameBytes + frameBytes / 4;
+		unsigned char* buffer = (unsigned char*)malloc(capacity);
+		if(buffer)
+		{
+			free(m_pBuffer);
+			m_pBuffer = buffer;
+			m_nCapacity = capacity;
+			++m_nGrows;
+		}
+	}
+
+	m_nUsed = 0;
+	m_nOverflowBytes = 0;
+}
+
+void CFrameArena::GetStats(FrameArenaStats& stats) const
+{
+	stats.capacity		= m_nCapacity;
+	stats.used			= m_nUsed + m_nOverflowBytes;
+	stats.grows			= m_nGrows;
+#ifdef PONG_MEMORY_STATS
+	stats.peak			= m_nPeak > stats.used ? m_nPeak : stats.used;
+	stats.allocations	= m_nAllocations;
+	stats.overflows		= m_nOverflows;
+	stats.frames		= m_nFrames;
+#else
+	stats.peak			= 0;
+	stats.allocations	= 0;
+	stats.overflows		= 0;
+	stats.frames		= 0;
+#endif
+}
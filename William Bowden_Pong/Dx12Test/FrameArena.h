@@ -0,0 +1,89 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	FrameArena.h
+// Date:	October 19th, 2026
+// Purpose: Linear allocator for data that only lives for one frame.  An
+//			allocation is a pointer bump and Reset() frees everything at
+//			once.  A frame that needs more than the buffer holds gets
+//			extra heap blocks, and the next Reset() grows the buffer to
+//			that frame's total.  Once the game reaches its busiest frame
+//			the arena stops touching the heap.
+//////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <stddef.h>
+#include <vector>
+#include "PongPlatform.h"
+
+struct FrameArenaStats
+{
+	size_t				capacity;		// Bytes in the main buffer
+	size_t				used;			// Bytes used so far this frame
+	size_t				peak;			// Most bytes any frame used
+	size_t				allocations;	// Allocations since Init
+	size_t				overflows;		// Allocations that did not fit the buffer
+	size_t				grows;			// Times Reset() grew the buffer
+	size_t				frames;			// Reset() calls since Init
+};
+
+class CFrameArena
+{
+	unsigned char*		m_pBuffer;
+	size_t				m_nCapacity;
+	size_t				m_nUsed;			// Bytes handed out from m_pBuffer this frame
+	size_t				m_nOverflowBytes;	// Bytes handed out from heap blocks this frame
+	std::vector<void*>	m_Overflow;			// Heap blocks to free on Reset()
+	size_t				m_nGrows;
+
+#ifdef PONG_MEMORY_STATS
+	size_t				m_nPeak;
+	size_t				m_nAllocations;
+	size_t				m_nOverflows;
+	size_t				m_nFrames;
+#endif
+
+	// Not copyable, it owns its buffer
+	CFrameArena(const CFrameArena&);
+	CFrameArena& operator=(const CFrameArena&);
+
+public:
+	CFrameArena(void);
+	~CFrameArena(void);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Init
+	// Parameters:	size_t bytes - Starting buffer size
+	// Return:		bool - false if the buffer could not be allocated
+	// Description:	Allocates the buffer, freeing any earlier one.
+	//////////////////////////////////////////////////////////////////////////
+	bool Init(size_t bytes);
+	void Shutdown();
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Allocate
+	// Parameters:	size_t bytes - Size of the allocation
+	//				size_t align - Alignment, a power of two
+	// Return:		void* - Memory valid until the next Reset(), or NULL if
+	//				the heap is out of memory
+	// Description:	Bumps the frame pointer.  The memory is not cleared.
+	//////////////////////////////////////////////////////////////////////////
+	void* Allocate(size_t bytes, size_t align);
+
+	// Uninitialised array of count T, for plain data types only
+	template<class T>
+	T* AllocateArray(size_t count)	{ return (T*)Allocate(sizeof(T) * count, __alignof(T)); }
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Reset
+	// Parameters:	void
+	// Return:		void
+	// Description:	Releases every allocation, call once per frame.  Grows
+	//				the buffer if the frame overflowed it.
+	//////////////////////////////////////////////////////////////////////////
+	void Reset();
+
+	size_t GetUsed() const		{ return m_nUsed + m_nOverflowBytes; }
+	size_t GetCapacity() const	{ return m_nCapacity; }
+
+	// Usage so far.  peak, allocations, overflows and frames are only
+	// counted with PONG_MEMORY_STATS and are 0 otherwise.
+	void GetStats(FrameArenaStats& stats) const;
+};
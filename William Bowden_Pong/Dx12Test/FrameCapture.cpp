@@ -0,0 +1,258 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	FrameCapture.cpp
+// Date:	October 19th, 2026
+// Purpose: Frame recording on encoder threads, see FrameCapture.h.
+//////////////////////////////////////////////////////////////////////////
+#include "FrameCapture.h"
+#include "ImageFile.h"
+#include "PongPlatform.h"
+#include <string.h>
+
+CFrameCapture::CFrameCapture(void)
+{
+	m_nWidth			= 0;
+	m_nHeight			= 0;
+	m_Format			= CAPTURE_PNG;
+	m_Path[0]			= 0;
+	m_pRawFile			= 0;
+	m_bQuit				= false;
+	m_nBuffers			= 0;
+	m_nSubmitted		= 0;
+	m_nDropped			= 0;
+	m_nLongestDrop		= 0;
+	m_nDropRun			= 0;
+	m_nMostQueued		= 0;
+	m_nWritten			= 0;
+	m_nFailed			= 0;
+	m_fEncodeSeconds	= 0.0;
+}
+
+CFrameCapture::~CFrameCapture(void)
+{
+	Shutdown();
+}
+
+bool CFrameCapture::Init(const FrameCaptureDesc& desc)
+{
+	Shutdown();
+	if(desc.width <= 0 || desc.height <= 0 || !desc.path || strlen(desc.path) >= sizeof(m_Path))
+		return false;
+
+	m_nWidth	= desc.width;
+	m_nHeight	= desc.height;
+	m_Format	= desc.format;
+	strcpy(m_Path, desc.path);
+	if(m_Format == CAPTURE_RAW)
+	{
+		m_pRawFile = fopen(m_Path, "wb");
+		if(!m_pRawFile)
+			return false;
+	}
+
+	int buffers = desc.buffers > 1 ? desc.buffers : 1;
+	size_t pixels = (size_t)m_nWidth * m_nHeight;
+	m_Pixels.resize(pixels * buffers);
+	m_Frames.resize(buffers);
+	m_Free.reserve(buffers);
+	m_Written.reserve(buffers);
+	for(int i = 0; i < buffers; ++i)
+	{
+		m_Frames[i].pixels	= &m_Pixels[pixels * i];
+		m_Frames[i].frame	= -1;
+		m_Free.push_back(&m_Frames[i]);
+	}
+
+	m_nBuffers			= buffers;
+	m_nSubmitted		= 0;
+	m_nDropped			= 0;
+	m_nLongestDrop		= 0;
+	m_nDropRun			= 0;
+	m_nMostQueued		= 0;
+	m_nWritten			= 0;
+	m_nFailed			= 0;
+	m_fEncodeSeconds	= 0.0;
+	m_bQuit				= false;
+
+	int threads = m_Format == CAPTURE_RAW ? 1 : (desc.threads > 1 ? desc.threads : 1);
+	for(int i = 0; i < threads; ++i)
+		m_Encoders.push_back(std::thread(EncoderMain, this));
+	return true;
+}
+
+void CFrameCapture::Shutdown()
+{
+	if(!m_Encoders.empty())
+	{
+		// The encoders only stop once the queue is empty
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_bQuit = true;
+		}
+		m_Wake.notify_all();
+		for(size_t i = 0; i < m_Encoders.size(); ++i)
+			m_Encoders[i].join();
+		m_Encoders.clear();
+	}
+
+	if(m_pRawFile)
+	{
+		fclose(m_pRawFile);
+		m_pRawFile = 0;
+	}
+	m_Queued.clear();
+	m_Written.clear();
+	m_Free.clear();
+	m_Frames.clear();
+	std::vector<unsigned int>().swap(m_Pixels);
+}
+
+CapturedFrame* CFrameCapture::Acquire(int frame)
+{
+	if(m_Encoders.empty())
+		return 0;
+
+	if(m_Free.empty())
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Free.swap(m_Written);
+	}
+	if(m_Free.empty())
+	{
+		++m_nDropped;
+		if(++m_nDropRun > m_nLongestDrop)
+			m_nLongestDrop = m_nDropRun;
+		return 0;
+	}
+
+	m_nDropRun = 0;
+	CapturedFrame* captured = m_Free.back();
+	m_Free.pop_back();
+	captured->frame = frame;
+	return captured;
+}
+
+void CFrameCapture::Submit(CapturedFrame* frame)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Queued.push_back(frame);
+		if((int)m_Queued.size() > m_nMostQueued)
+			m_nMostQueued = (int)m_Queued.size();
+	}
+	++m_nSubmitted;
+	m_Wake.notify_one();
+}
+
+void CFrameCapture::Discard(CapturedFrame* frame)
+{
+	m_Free.push_back(frame);
+	++m_nDropped;
+}
+
+bool CFrameCapture::Capture(const unsigned int* pixels, int pitch, int frame)
+{
+	CapturedFrame* captured = Acquire(frame);
+	if(!captured)
+		return false;
+
+	if(pitch == m_nWidth)
+	{
+		memcpy(captured->pixels, pixels, (size_t)m_nWidth * m_nHeight * sizeof(unsigned int));
+	}
+	else
+	{
+		for(int y = 0; y < m_nHeight; ++y)
+		{
+			memcpy(captured->pixels + (size_t)y * m_nWidth, pixels + (size_t)y * pitch,
+				m_nWidth * sizeof(unsigned int));
+		}
+	}
+	Submit(captured);
+	return true;
+}
+
+void CFrameCapture::EncoderMain(CFrameCapture* capture)
+{
+	// Encoding must not take time from a frame, dropping is cheaper
+	PlatformLowerThreadPriority();
+
+	std::unique_lock<std::mutex> lock(capture->m_Mutex);
+	for(;;)
+	{
+		while(capture->m_Queued.empty() && !capture->m_bQuit)
+			capture->m_Wake.wait(lock);
+		if(capture->m_Queued.empty())
+			return;
+
+		CapturedFrame* frame = capture->m_Queued.front();
+		capture->m_Queued.pop_front();
+		lock.unlock();
+
+		double start = PlatformGetTime();
+		bool written = capture->Write(*frame);
+		double seconds = PlatformGetTime() - start;
+
+		lock.lock();
+		capture->m_Written.push_back(frame);
+		capture->m_fEncodeSeconds += seconds;
+		if(written)
+			++capture->m_nWritten;
+		else
+			++capture->m_nFailed;
+	}
+}
+
+bool CFrameCapture::Write(const CapturedFrame& frame)
+{
+	if(m_Format == CAPTURE_RAW)
+	{
+		// ARGB words are B, G, R, A bytes on every CPU the game runs on.
+		// Only one encoder writes a raw file.
+		size_t pixels = (size_t)m_nWidth * m_nHeight;
+		return fwrite(frame.pixels, sizeof(unsigned int), pixels, m_pRawFile) == pixels;
+	}
+
+	char fileName[300];
+	sprintf(fileName, "%s_%06d.png", m_Path, frame.frame);
+	return WritePNG(fileName, frame.pixels, m_nWidth, m_nHeight, m_nWidth);
+}
+
+int CFrameCapture::GetWrittenCount()
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	return m_nWritten;
+}
+
+int CFrameCapture::GetFailedCount()
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	return m_nFailed;
+}
+
+double CFrameCapture::GetEncodeSeconds()
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	return m_fEncodeSeconds;
+}
+
+void CFrameCapture::Format(std::string& text)
+{
+	int written, failed;
+	double seconds;
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		written	= m_nWritten;
+		failed	= m_nFailed;
+		seconds	= m_fEncodeSeconds;
+	}
+	int attempts = m_nSubmitted + m_nDropped;
+	char line[256];
+	sprintf(line, "Capture %dx%d: %d frames written, %d failed\n", m_nWidth, m_nHeight, written, failed);
+	text = line;
+	sprintf(line, "%d dropped of %d (%.1f%%), at most %d in a row, queue peaked at %d of %d\n", m_nDropped,
+		attempts, attempts ? 100.0 * m_nDropped / attempts : 0.0, m_nLongestDrop, m_nMostQueued, m_nBuffers);
+	text += line;
+	sprintf(line, "%.2f ms to encode a frame on one thread\n",
+		written + failed ? seconds * 1e3 / (written + failed) : 0.0);
+	text += line;
+}
@@ -0,0 +1,170 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	FrameCapture.h
+// Date:	October 19th, 2026
+// Purpose: Records the frames the game draws without holding up the
+//			loop that draws them.  A renderer backend with a capture set
+//			(see Renderer.h) copies each finished frame into a buffer
+//			from a fixed pool and queues it; encoder threads write the
+//			queued frames out as a PNG sequence or as one raw video file
+//			and hand the buffers back.  Nothing is allocated once Init()
+//			returns.  The pool is the bound on the queue: when every
+//			buffer is queued or being written the frame is dropped and
+//			counted, so slow encoding costs frames, never frame time.
+//
+//			A raw file is the frames back to back, 4 bytes a pixel in
+//			B, G, R, A order, top row first, e.g. for
+//				ffmpeg -f rawvideo -pixel_format bgra -video_size WxH
+//					-framerate 60 -i capture.raw capture.mp4
+//////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+enum CaptureFormat
+{
+	CAPTURE_PNG,						// <path>_<frame>.png for each frame
+	CAPTURE_RAW							// Every frame appended to <path>
+};
+
+struct FrameCaptureDesc
+{
+	int					width;			// Frame size, the back buffer's
+	int					height;
+	CaptureFormat		format;
+	const char*			path;			// File name prefix for PNG, the file for raw
+	int					buffers;		// Frames queued or being written at most
+	int					threads;		// Encoder threads, raw always uses one so
+										// the frames stay in order
+
+	FrameCaptureDesc(void)
+	{
+		width	= 800;
+		height	= 600;
+		format	= CAPTURE_PNG;
+		path	= "capture";
+		buffers	= 8;
+		threads	= 2;
+	}
+};
+
+// A frame on its way to the encoders
+struct CapturedFrame
+{
+	unsigned int*		pixels;			// width * height ARGB, top row first
+	int					frame;			// Number the backend gave Acquire()
+};
+
+class CFrameCapture
+{
+	int							m_nWidth;
+	int							m_nHeight;
+	CaptureFormat				m_Format;
+	char						m_Path[260];
+	FILE*						m_pRawFile;
+
+	std::vector<unsigned int>	m_Pixels;		// Every buffer's pixels, one allocation
+	std::vector<CapturedFrame>	m_Frames;
+	std::vector<CapturedFrame*>	m_Free;			// Game thread only
+	std::vector<std::thread>	m_Encoders;
+	std::mutex					m_Mutex;
+	std::condition_variable		m_Wake;
+	std::deque<CapturedFrame*>	m_Queued;		// Waiting for an encoder
+	std::vector<CapturedFrame*>	m_Written;		// Back from the encoders, for Acquire()
+	bool						m_bQuit;
+
+	// Game thread
+	int							m_nBuffers;
+	int							m_nSubmitted;
+	int							m_nDropped;
+	int							m_nLongestDrop;	// Most frames dropped in a row
+	int							m_nDropRun;
+	int							m_nMostQueued;
+
+	// Encoder threads, under m_Mutex
+	int							m_nWritten;
+	int							m_nFailed;
+	double						m_fEncodeSeconds;	// Summed over the threads
+
+	CFrameCapture(const CFrameCapture&);
+	CFrameCapture& operator=(const CFrameCapture&);
+
+	static void EncoderMain(CFrameCapture* capture);
+	bool Write(const CapturedFrame& frame);
+
+public:
+	CFrameCapture(void);
+	~CFrameCapture(void);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Init
+	// Parameters:	const FrameCaptureDesc& desc - Size, format and pool
+	// Return:		bool - false if the size is empty or a raw file cannot
+	//				be created
+	// Description:	Allocates every buffer and starts the encoders.
+	//////////////////////////////////////////////////////////////////////////
+	bool Init(const FrameCaptureDesc& desc);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Shutdown
+	// Parameters:	void
+	// Return:		void
+	// Description:	Waits for the queued frames to be written, then stops
+	//				the encoders and closes the raw file.
+	//////////////////////////////////////////////////////////////////////////
+	void Shutdown();
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Acquire
+	// Parameters:	int frame - Number to write the frame under
+	// Return:		CapturedFrame* - Buffer to fill and pass to Submit(),
+	//				NULL if every buffer is busy and the frame is dropped
+	// Description:	Never waits.  A backend that gets NULL should skip its
+	//				copy as well, so a dropped frame costs nothing.
+	//////////////////////////////////////////////////////////////////////////
+	CapturedFrame* Acquire(int frame);
+
+	// Queues a filled buffer for the encoders
+	void Submit(CapturedFrame* frame);
+
+	// Hands back a buffer that could not be filled, the frame is dropped
+	void Discard(CapturedFrame* frame);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Capture
+	// Parameters:	const unsigned int* pixels - ARGB, top row first
+	//				int pitch - Distance between rows, in pixels, 0 to
+	//					repeat one row
+	//				int frame - Number to write the frame under
+	// Return:		bool - false if the frame was dropped
+	// Description:	Acquire(), one copy and Submit().
+	//////////////////////////////////////////////////////////////////////////
+	bool Capture(const unsigned int* pixels, int pitch, int frame);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Format
+	// Parameters:	std::string& text - Receives a line with the counts
+	// Return:		void
+	// Description:	For the log at shutdown and the tools.  The counts
+	//				are kept after Shutdown().
+	//////////////////////////////////////////////////////////////////////////
+	void Format(std::string& text);
+
+	bool IsCapturing() const		{ return !m_Encoders.empty(); }
+	int GetWidth() const			{ return m_nWidth; }
+	int GetHeight() const			{ return m_nHeight; }
+	int GetBufferCount() const		{ return m_nBuffers; }
+	int GetSubmittedCount() const	{ return m_nSubmitted; }
+	int GetDroppedCount() const		{ return m_nDropped; }
+	int GetLongestDrop() const		{ return m_nLongestDrop; }
+	int GetMostQueued() const		{ return m_nMostQueued; }
+
+	// Finished by the encoders so far
+	int GetWrittenCount();
+	int GetFailedCount();
+	double GetEncodeSeconds();
+};
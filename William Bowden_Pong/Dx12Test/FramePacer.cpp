@@ -0,0 +1,209 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	FramePacer.cpp
+// Date:	October 19th, 2026
+// Purpose: Frame pacing and fixed match ticks, see FramePacer.h.
+//////////////////////////////////////////////////////////////////////////
+#include "FramePacer.h"
+#include <stdio.h>
+#include <math.h>
+#include <ctype.h>
+
+const char* GetPacingModeName(PacingMode mode)
+{
+	switch(mode)
+	{
+	case PACING_VSYNC:		return "VSync";
+	case PACING_CAPPED:		return "Capped";
+	case PACING_ADAPTIVE:	return "Adaptive";
+	default:				return "Uncapped";
+	}
+}
+
+PacingMode ParsePacingMode(const char* name, PacingMode def)
+{
+	static const PacingMode modes[] = { PACING_UNCAPPED, PACING_VSYNC, PACING_CAPPED, PACING_ADAPTIVE };
+	for(int i = 0; i < 4; ++i)
+	{
+		const char* a = name;
+		const char* b = GetPacingModeName(modes[i]);
+		while(*a && tolower((unsigned char)*a) == tolower((unsigned char)*b))
+		{
+			++a;
+			++b;
+		}
+		if(*a == 0 && *b == 0)
+			return modes[i];
+	}
+	return def;
+}
+
+CFramePacer::CFramePacer(void)
+{
+	Init(FramePacingDesc(), 0.0, 0.0);
+}
+
+void CFramePacer::Init(const FramePacingDesc& desc, double now, double cpu)
+{
+	m_Desc			= desc;
+	if(m_Desc.maxTicks < 1)
+		m_Desc.maxTicks = 1;
+	m_fTarget		= now;
+	m_fInterval		= 0.0;
+	m_fPrevious		= now;
+	m_fFrameStart	= now;
+	m_bPresented	= false;
+
+	m_bFitted		= true;
+
+	m_fTickStart	= now;
+	m_nTicks		= 0;
+
+	m_fStartTime	= now;
+	m_fStartCpu		= cpu;
+	m_fLastEnd		= now;
+	m_fLastCpu		= cpu;
+	m_fLastBegin	= -1.0;
+	m_nFrames		= 0;
+	m_nPresented	= 0;
+	m_nFittedFrames	= 0;
+	m_nTicksRun		= 0;
+	m_nTicksSkipped	= 0;
+	m_fIntervalSquares = 0.0;
+	m_Intervals.Clear();
+}
+
+double CFramePacer::GetInterval(bool idle) const
+{
+	double interval = 0.0;
+	switch(m_Desc.mode)
+	{
+	case PACING_VSYNC:
+		// Present already waited, unless there was nothing to present
+		if(m_Desc.refreshRate > 0.0 && !(m_Desc.presentWaits && m_bPresented))
+			interval = 1.0 / m_Desc.refreshRate;
+		break;
+	case PACING_CAPPED:
+		if(m_Desc.maxFps > 0.0)
+			interval = 1.0 / m_Desc.maxFps;
+		break;
+	case PACING_ADAPTIVE:
+		// Unlike VSync a frame that misses its refresh is not held for
+		// the next one, BeginFrame() starts it at once on the same
+		// schedule, so heavy frames run as fast as they go instead of at
+		// half the refresh
+		if(m_Desc.refreshRate > 0.0)
+			interval = 1.0 / m_Desc.refreshRate;
+		break;
+	default:
+		break;
+	}
+
+	if(idle && m_Desc.idleFps > 0.0 && 1.0 / m_Desc.idleFps > interval)
+		interval = 1.0 / m_Desc.idleFps;
+	return interval;
+}
+
+double CFramePacer::GetWait(double now, bool idle)
+{
+	m_fInterval = GetInterval(idle);
+	if(m_fInterval <= 0.0)
+		return 0.0;
+
+	m_fTarget = m_fPrevious + m_fInterval;
+	return m_fTarget > now ? m_fTarget - now : 0.0;
+}
+
+int CFramePacer::BeginFrame(double now)
+{
+	// Keep to the schedule unless the frame is early, an idle wait cut
+	// short, or too late to catch up
+	if(m_fInterval > 0.0 && now >= m_fTarget && now - m_fTarget < m_fInterval)
+		m_fPrevious = m_fTarget;
+	else
+		m_fPrevious = now;
+	m_fInterval = 0.0;
+
+	if(m_fLastBegin >= 0.0)
+	{
+		double interval = now - m_fLastBegin;
+		m_Intervals.Add(interval);
+		m_fIntervalSquares += interval * interval;
+	}
+	m_fLastBegin	= now;
+	m_fFrameStart	= now;
+
+	if(m_Desc.tickRate <= 0.0)
+	{
+		++m_nTicksRun;
+		return 1;
+	}
+
+	// Counted from m_fTickStart rather than added up a frame at a time,
+	// so rounding never gains or loses a tick
+	long long due = (long long)((now - m_fTickStart) * m_Desc.tickRate);
+	long long ticks = due > m_nTicks ? due - m_nTicks : 0;
+	if(ticks > m_Desc.maxTicks)
+	{
+		m_nTicksSkipped += ticks - m_Desc.maxTicks;
+		ticks			= m_Desc.maxTicks;
+		m_fTickStart	= now;
+		m_nTicks		= 0;
+	}
+	else
+	{
+		m_nTicks += ticks;
+	}
+	m_nTicksRun += ticks;
+	return (int)ticks;
+}
+
+void CFramePacer::EndFrame(double now, double cpu, bool presented)
+{
+	m_bPresented	= presented;
+	m_bFitted		= m_Desc.refreshRate <= 0.0 || now - m_fFrameStart <= 1.0 / m_Desc.refreshRate;
+	if(m_bFitted)
+		++m_nFittedFrames;
+
+	++m_nFrames;
+	if(presented)
+		++m_nPresented;
+	m_fLastEnd	= now;
+	m_fLastCpu	= cpu;
+}
+
+double CFramePacer::GetFrameRate() const
+{
+	double seconds = m_fLastEnd - m_fStartTime;
+	return seconds > 0.0 ? m_nFrames / seconds : 0.0;
+}
+
+double CFramePacer::GetIntervalDeviation() const
+{
+	long long count = m_Intervals.GetCount();
+	if(count == 0)
+		return 0.0;
+	double mean = m_Intervals.GetMean();
+	double variance = m_fIntervalSquares / count - mean * mean;
+	return variance > 0.0 ? sqrt(variance) : 0.0;
+}
+
+double CFramePacer::GetCpuUsage() const
+{
+	double seconds = m_fLastEnd - m_fStartTime;
+	return seconds > 0.0 ? (m_fLastCpu - m_fStartCpu) / seconds : 0.0;
+}
+
+void CFramePacer::Format(std::string& text) const
+{
+	char line[256];
+	sprintf(line, "Pacing %s, refresh %.0f Hz: %d frames, %.1f a second, %d presented, %d fitted in a refresh\n",
+		GetPacingModeName(m_Desc.mode), m_Desc.refreshRate, m_nFrames, GetFrameRate(), m_nPresented, m_nFittedFrames);
+	text = line;
+	sprintf(line, "Frame time mean %.2f ms, deviation %.2f ms, p99 %.2f ms, worst %.2f ms\n",
+		m_Intervals.GetMean() * 1e3, GetIntervalDeviation() * 1e3, m_Intervals.GetPercentile(99.0) * 1e3,
+		m_Intervals.GetMax() * 1e3);
+	text += line;
+	sprintf(line, "CPU %.1f%% of a core, %lld ticks run, %lld skipped\n", GetCpuUsage() * 100.0, m_nTicksRun,
+		m_nTicksSkipped);
+	text += line;
+}
@@ -0,0 +1,172 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	FramePacer.h
+// Date:	October 19th, 2026
+// Purpose: Decides when each frame starts and how many match ticks it
+//			runs.  Without pacing the loop draws as many frames as the
+//			machine can, a whole core and the GPU for a scene that
+//			changes a few pixels a frame.  The pacer holds frames to the
+//			display's refresh, a cap or a slow idle rate on the menus,
+//			and runs the match at a fixed number of ticks a second
+//			whatever the frame rate, since every PongTuning speed is a
+//			distance per tick.
+//
+//			Nothing reads a clock or sleeps here: the caller passes the
+//			time of every step and does the waiting, PlatformGetTime()
+//			and PlatformSleep() in the game and a simulated clock in
+//			Tools/PacingBench.cpp.  A frame is
+//				wait = GetWait(now, idle), sleep, repeat until 0
+//				ticks = BeginFrame(now), tick, draw, Present
+//				EndFrame(now, cpu, presented)
+//////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <string>
+#include "LatencyHistogram.h"
+
+enum PacingMode
+{
+	PACING_UNCAPPED,					// As many frames as the machine can
+	PACING_VSYNC,						// One frame a refresh, Present waits
+	PACING_CAPPED,						// At most maxFps, the pacer waits
+	PACING_ADAPTIVE						// One a refresh while frames fit in one, a
+										// frame that does not is presented at once
+};
+
+struct FramePacingDesc
+{
+	PacingMode			mode;
+	double				refreshRate;	// Display refreshes a second
+	double				maxFps;			// PACING_CAPPED
+	double				idleFps;		// On the menus, 0 to pace them as the mode does
+	double				tickRate;		// Match ticks a second, 0 for one a frame
+	int					maxTicks;		// Most ticks in one frame, the rest of a stall is skipped
+	bool				presentWaits;	// PACING_VSYNC: Present blocks until the refresh,
+										// false to wait in the pacer instead
+
+	FramePacingDesc(void)
+	{
+		mode			= PACING_UNCAPPED;
+		refreshRate		= 60.0;
+		maxFps			= 60.0;
+		idleFps			= 60.0;
+		tickRate		= 0.0;
+		maxTicks		= 1000;
+		presentWaits	= false;
+	}
+};
+
+class CFramePacer
+{
+	FramePacingDesc		m_Desc;
+	double				m_fTarget;		// When the next frame is due, valid while m_fInterval > 0
+	double				m_fInterval;	// Between frames when GetWait() set m_fTarget
+	double				m_fPrevious;	// Last frame's due time, or its start if it was not paced
+	double				m_fFrameStart;	// BeginFrame() of the frame being drawn
+	bool				m_bPresented;	// Last frame was presented
+
+	bool				m_bFitted;		// Last frame's work fitted in a refresh
+
+	// Fixed ticks
+	double				m_fTickStart;	// Time tick 0 was due
+	long long			m_nTicks;		// Run since m_fTickStart
+
+	// Statistics since Init()
+	double				m_fStartTime;
+	double				m_fStartCpu;
+	double				m_fLastEnd;
+	double				m_fLastCpu;
+	double				m_fLastBegin;	// -1 before the first frame
+	int					m_nFrames;
+	int					m_nPresented;
+	int					m_nFittedFrames;
+	long long			m_nTicksRun;
+	long long			m_nTicksSkipped;
+	double				m_fIntervalSquares;	// For the variance of the frame time
+	CLatencyHistogram	m_Intervals;	// BeginFrame() to BeginFrame()
+
+	// Not copyable, it is large
+	CFramePacer(const CFramePacer&);
+	CFramePacer& operator=(const CFramePacer&);
+
+	// Between this frame and the next, 0 to start at once
+	double GetInterval(bool idle) const;
+
+public:
+	CFramePacer(void);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Init
+	// Parameters:	const FramePacingDesc& desc - Mode and rates
+	//				double now - Current time, ticks are counted from it
+	//				double cpu - Process CPU seconds so far, for the usage
+	// Return:		void
+	// Description:	Starts pacing and clears the statistics.  Rates of 0
+	//				or less leave frames unpaced.
+	//////////////////////////////////////////////////////////////////////////
+	void Init(const FramePacingDesc& desc, double now, double cpu);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		GetWait
+	// Parameters:	double now - Current time
+	//				bool idle - Nothing on screen moves by itself, see
+	//					CSceneTracker::IsStatic()
+	// Return:		double - Seconds to wait before the next frame, 0 to
+	//				start it now
+	// Description:	Call again after waiting, a sleep can come back early.
+	//				An idle wait may end early on input, frames start when
+	//				they are called for.  A frame that starts late keeps
+	//				the schedule, one more than an interval late starts a
+	//				new one from now rather than hurrying to catch up.
+	//////////////////////////////////////////////////////////////////////////
+	double GetWait(double now, bool idle);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		BeginFrame
+	// Parameters:	double now - When the frame started
+	// Return:		int - Match ticks to run this frame, 1 with no tick rate
+	// Description:	Ticks fall due tickRate a second from Init().  More
+	//				than maxTicks due at once, after the intro movie or a
+	//				breakpoint, are skipped instead of run in one frame.
+	//////////////////////////////////////////////////////////////////////////
+	int BeginFrame(double now);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		EndFrame
+	// Parameters:	double now - When Present returned, or when the frame
+	//					finished if it was not presented
+	//				double cpu - Process CPU seconds so far
+	//				bool presented - The frame was presented
+	// Return:		void
+	// Description:	Counts the frame for the statistics.
+	//////////////////////////////////////////////////////////////////////////
+	void EndFrame(double now, double cpu, bool presented);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Format
+	// Parameters:	std::string& text - Receives the mode, frame rate, the
+	//					spread of the frame time and the CPU used
+	// Return:		void
+	// Description:	For the log at shutdown and the tools.
+	//////////////////////////////////////////////////////////////////////////
+	void Format(std::string& text) const;
+
+	const FramePacingDesc& GetDesc() const		{ return m_Desc; }
+	bool IsFitted() const						{ return m_bFitted; }
+	int GetFrameCount() const					{ return m_nFrames; }
+	int GetPresentedCount() const				{ return m_nPresented; }
+	int GetFittedCount() const					{ return m_nFittedFrames; }
+	long long GetTicksRun() const				{ return m_nTicksRun; }
+	long long GetTicksSkipped() const			{ return m_nTicksSkipped; }
+	const CLatencyHistogram& GetIntervals() const	{ return m_Intervals; }
+
+	// Frames a second, the standard deviation of the frame time in
+	// seconds and the share of one core used, since Init()
+	double GetFrameRate() const;
+	double GetIntervalDeviation() const;
+	double GetCpuUsage() const;
+};
+
+// "Uncapped", "VSync", "Capped" or "Adaptive"
+const char* GetPacingModeName(PacingMode mode);
+
+// One of those names in any case, def for anything else
+PacingMode ParsePacingMode(const char* name, PacingMode def);
@@ -0,0 +1,137 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	GameEvents.h
+// Date:	October 19th, 2026
+// Purpose: What happened during a tick, as typed events.  CPongGame::Tick()
+//			appends them to a CGameEventBuffer and the caller hands the
+//			buffer to audio, effects and statistics in one pass once the
+//			tick is done, so the simulation itself never calls into any
+//			of them.  The buffer is a fixed array inside the object, so
+//			emitting an event is a few stores and never allocates.
+//			Tick() still returns SOUND1 / SOUND2 / WALL_HIT for callers
+//			that only need to know whether something happened.
+//////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "PongGame.h"
+
+// Events one buffer holds.  A tick emits at most a handful, the rest is
+// room for buffers that collect several ticks.
+#define GAME_EVENT_CAPACITY 32
+
+enum GameEventType
+{
+	GAME_EVENT_PADDLE_HIT,
+	GAME_EVENT_WALL_BOUNCE,
+	GAME_EVENT_POINT_SCORED,
+	GAME_EVENT_MENU_CHANGED,
+	GAME_EVENT_OBSTACLE_HIT,
+	GAME_EVENT_TYPES
+};
+
+// The screen the menus are showing, for GAME_EVENT_MENU_CHANGED
+enum MenuScreen
+{
+	MENU_SCREEN_NONE,
+	MENU_SCREEN_START,
+	MENU_SCREEN_CREDITS,
+	MENU_SCREEN_CREDITS2,
+	MENU_SCREEN_EXIT,
+	MENU_SCREEN_MOVIE,
+	MENU_SCREEN_GAME,
+	MENU_SCREEN_QUIT
+};
+
+struct PaddleHitEvent
+{
+	int					paddle;			// 0 left, 1 right
+	float				x, y;			// Ball position
+};
+
+struct WallBounceEvent
+{
+	int					wall;			// 0 top, 1 bottom
+	float				x, y;
+};
+
+struct PointScoredEvent
+{
+	int					player;			// 0 for Player1Point, scored on the right
+	int					points;			// The player's points now
+	float				y;				// Height the ball left the playfield at
+};
+
+struct MenuChangedEvent
+{
+	MenuScreen			from;
+	MenuScreen			to;
+};
+
+// The ball bounced off one of the arena's obstacles, see Arena.h
+struct ObstacleHitEvent
+{
+	int					obstacle;		// CArena::GetObstacle() index
+	bool				bumper;			// A bumper, kicked away from its centre
+	float				x, y;			// Ball position
+	float				normalX;		// Away from the side hit, -1, 0 or 1
+	float				normalY;
+};
+
+struct GameEvent
+{
+	GameEventType		type;
+	union
+	{
+		PaddleHitEvent		paddleHit;
+		WallBounceEvent		wallBounce;
+		PointScoredEvent	pointScored;
+		MenuChangedEvent	menuChanged;
+		ObstacleHitEvent	obstacleHit;
+	};
+};
+
+//////////////////////////////////////////////////////////////////////////
+// Name:		GetMenuScreen
+// Parameters:	const myStartMenu& menu - The menu flags
+// Return:		MenuScreen - The screen they show
+// Description:	The flags overlap while the credits are up, this picks the
+//				one that decides what is drawn.
+//////////////////////////////////////////////////////////////////////////
+MenuScreen GetMenuScreen(const myStartMenu& menu);
+
+class CGameEventBuffer
+{
+	GameEvent			m_Events[GAME_EVENT_CAPACITY];
+	int					m_nCount;
+	int					m_nDropped;		// Pushed while full, since the last Clear()
+
+public:
+	CGameEventBuffer(void) : m_nCount(0), m_nDropped(0)	{}
+
+	void Clear()
+	{
+		m_nCount = 0;
+		m_nDropped = 0;
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Push
+	// Parameters:	GameEventType type - Kind of event
+	// Return:		GameEvent* - Slot to fill in the type's fields of, NULL
+	//				when the buffer is full
+	// Description:	Appends an event.
+	//////////////////////////////////////////////////////////////////////////
+	GameEvent* Push(GameEventType type)
+	{
+		if(m_nCount == GAME_EVENT_CAPACITY)
+		{
+			++m_nDropped;
+			return 0;
+		}
+		GameEvent* event = &m_Events[m_nCount++];
+		event->type = type;
+		return event;
+	}
+
+	const GameEvent& Get(int i) const	{ return m_Events[i]; }
+	int GetCount() const				{ return m_nCount; }
+	int GetDropped() const				{ return m_nDropped; }
+};
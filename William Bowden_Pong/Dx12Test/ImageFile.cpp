@@ -0,0 +1,686 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	ImageFile.cpp
+// Date:	October 19th, 2026
+// Purpose: Portable image loading and saving, see ImageFile.h.  The
+//			inflate routine follows the layout of zlib's puff.c reference
+//			decoder; it only has to cope with a handful of small sprites.
+//////////////////////////////////////////////////////////////////////////
+#include "ImageFile.h"
+#include <stdio.h>
+#include <string.h>
+
+namespace
+{
+	//////////////////////////////////////////////////////////////////////////
+	// File helpers
+	//////////////////////////////////////////////////////////////////////////
+	bool ReadWholeFile(const char* fileName, std::vector<unsigned char>& data)
+	{
+		FILE* file = fopen(fileName, "rb");
+		if(!file)
+			return false;
+
+		fseek(file, 0, SEEK_END);
+		long size = ftell(file);
+		fseek(file, 0, SEEK_SET);
+
+		if(size <= 0)
+		{
+			fclose(file);
+			return false;
+		}
+
+		data.resize((size_t)size);
+		size_t read = fread(&data[0], 1, data.size(), file);
+		fclose(file);
+		return read == data.size();
+	}
+
+	unsigned int ReadBE32(const unsigned char* p)
+	{
+		return ((unsigned int)p[0] << 24) | ((unsigned int)p[1] << 16) | ((unsigned int)p[2] << 8) | p[3];
+	}
+
+	void WriteBE32(unsigned char* p, unsigned int v)
+	{
+		p[0] = (unsigned char)(v >> 24);
+		p[1] = (unsigned char)(v >> 16);
+		p[2] = (unsigned char)(v >> 8);
+		p[3] = (unsigned char)v;
+	}
+
+	const unsigned char PNG_SIGNATURE[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+
+	//////////////////////////////////////////////////////////////////////////
+	// Inflate (RFC 1951)
+	//////////////////////////////////////////////////////////////////////////
+	struct InflateState
+	{
+		const unsigned char*		in;
+		size_t						inLength;
+		size_t						inPos;
+		unsigned int				bitBuffer;
+		int							bitCount;
+		bool						error;
+		std::vector<unsigned char>*	out;
+	};
+
+	struct Huffman
+	{
+		short						count[16];		// Number of codes of each length
+		short						symbol[288];	// Symbols ordered by code
+	};
+
+	int Bits(InflateState& s, int need)
+	{
+		unsigned int value = s.bitBuffer;
+		while(s.bitCount < need)
+		{
+			if(s.inPos >= s.inLength)
+			{
+				s.error = true;
+				return 0;
+			}
+			value |= (unsigned int)s.in[s.inPos++] << s.bitCount;
+			s.bitCount += 8;
+		}
+		s.bitBuffer = value >> need;
+		s.bitCount -= need;
+		return (int)(value & ((1u << need) - 1));
+	}
+
+	int Decode(InflateState& s, const Huffman& h)
+	{
+		int code = 0, first = 0, index = 0;
+		for(int len = 1; len <= 15; ++len)
+		{
+			code |= Bits(s, 1);
+			int count = h.count[len];
+			if(code - count < first)
+				return h.symbol[index + (code - first)];
+			index += count;
+			first += count;
+			first <<= 1;
+			code <<= 1;
+		}
+		s.error = true;
+		return -1;
+	}
+
+	// Returns 0 for a complete code, > 0 for an incomplete one, < 0 if over subscribed
+	int Construct(Huffman& h, const short* length, int n)
+	{
+		for(int len = 0; len <= 15; ++len)
+			h.count[len] = 0;
+		for(int symbol = 0; symbol < n; ++symbol)
+			h.count[length[symbol]]++;
+		if(h.count[0] == n)
+			return 0;
+
+		int left = 1;
+		for(int len = 1; len <= 15; ++len)
+		{
+			left <<= 1;
+			left -= h.count[len];
+			if(left < 0)
+				return left;
+		}
+
+		short offs[16];
+		offs[1] = 0;
+		for(int len = 1; len < 15; ++len)
+			offs[len + 1] = offs[len] + h.count[len];
+		for(int symbol = 0; symbol < n; ++symbol)
+		{
+			if(length[symbol] != 0)
+				h.symbol[offs[length[symbol]]++] = (short)symbol;
+		}
+		return left;
+	}
+
+	bool Codes(InflateState& s, const Huffman& lencode, const Huffman& distcode)
+	{
+		static const short lengthBase[29] = {
+			3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+			35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+		static const short lengthExtra[29] = {
+			0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+			3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+		static const short distBase[30] = {
+			1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+			257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+			8193, 12289, 16385, 24577 };
+		static const short distExtra[30] = {
+			0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+			7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+		std::vector<unsigned char>& out = *s.out;
+		for(;;)
+		{
+			int symbol = Decode(s, lencode);
+			if(s.error || symbol < 0)
+				return false;
+
+			if(symbol < 256)
+			{
+				out.push_back((unsigned char)symbol);
+			}
+			else if(symbol == 256)
+			{
+				return true;
+			}
+			else
+			{
+				symbol -= 257;
+				if(symbol >= 29)
+					return false;
+				int len = lengthBase[symbol] + Bits(s, lengthExtra[symbol]);
+
+				int distSymbol = Decode(s, distcode);
+				if(s.error || distSymbol < 0 || distSymbol >= 30)
+					return false;
+				size_t dist = (size_t)(distBase[distSymbol] + Bits(s, distExtra[distSymbol]));
+				if(s.error || dist > out.size())
+					return false;
+
+				size_t from = out.size() - dist;
+				for(int i = 0; i < len; ++i)
+				{
+					unsigned char c = out[from + i];
+					out.push_back(c);
+				}
+			}
+		}
+	}
+
+	bool Stored(InflateState& s)
+	{
+		// Discard the rest of the current byte
+		s.bitBuffer = 0;
+		s.bitCount = 0;
+
+		if(s.inPos + 4 > s.inLength)
+			return false;
+		unsigned int len = s.in[s.inPos] | (s.in[s.inPos + 1] << 8);
+		unsigned int nlen = s.in[s.inPos + 2] | (s.in[s.inPos + 3] << 8);
+		s.inPos += 4;
+		if(len != (~nlen & 0xFFFF) || s.inPos + len > s.inLength)
+			return false;
+
+		s.out->insert(s.out->end(), s.in + s.inPos, s.in + s.inPos + len);
+		s.inPos += len;
+		return true;
+	}
+
+	bool Fixed(InflateState& s)
+	{
+		static bool built = false;
+		static Huffman lencode, distcode;
+		if(!built)
+		{
+			short lengths[288];
+			int symbol = 0;
+			for(; symbol < 144; ++symbol) lengths[symbol] = 8;
+			for(; symbol < 256; ++symbol) lengths[symbol] = 9;
+			for(; symbol < 280; ++symbol) lengths[symbol] = 7;
+			for(; symbol < 288; ++symbol) lengths[symbol] = 8;
+			Construct(lencode, lengths, 288);
+
+			for(symbol = 0; symbol < 30; ++symbol) lengths[symbol] = 5;
+			Construct(distcode, lengths, 30);
+			built = true;
+		}
+		return Codes(s, lencode, distcode);
+	}
+
+	bool Dynamic(InflateState& s)
+	{
+		static const short order[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+		int nlen = Bits(s, 5) + 257;
+		int ndist = Bits(s, 5) + 1;
+		int ncode = Bits(s, 4) + 4;
+		if(s.error || nlen > 286 || ndist > 30)
+			return false;
+
+		short lengths[320];
+		int index;
+		for(index = 0; index < ncode; ++index)
+			lengths[order[index]] = (short)Bits(s, 3);
+		for(; index < 19; ++index)
+			lengths[order[index]] = 0;
+
+		Huffman lencode, distcode;
+		if(Construct(lencode, lengths, 19) != 0)
+			return false;
+
+		index = 0;
+		while(index < nlen + ndist)
+		{
+			int symbol = Decode(s, lencode);
+			if(s.error || symbol < 0)
+				return false;
+			if(symbol < 16)
+			{
+				lengths[index++] = (short)symbol;
+			}
+			else
+			{
+				short len = 0;
+				if(symbol == 16)
+				{
+					if(index == 0)
+						return false;
+					len = lengths[index - 1];
+					symbol = 3 + Bits(s, 2);
+				}
+				else if(symbol == 17)
+				{
+					symbol = 3 + Bits(s, 3);
+				}
+				else
+				{
+					symbol = 11 + Bits(s, 7);
+				}
+				if(index + symbol > nlen + ndist)
+					return false;
+				while(symbol--)
+					lengths[index++] = len;
+			}
+		}
+
+		if(lengths[256] == 0)
+			return false;
+
+		int err = Construct(lencode, lengths, nlen);
+		if(err < 0 || (err > 0 && nlen - lencode.count[0] != 1))
+			return false;
+		err = Construct(distcode, lengths + nlen, ndist);
+		if(err < 0 || (err > 0 && ndist - distcode.count[0] != 1))
+			return false;
+
+		return Codes(s, lencode, distcode);
+	}
+
+	bool Inflate(const unsigned char* in, size_t inLength, std::vector<unsigned char>& out)
+	{
+		InflateState s;
+		s.in		= in;
+		s.inLength	= inLength;
+		s.inPos		= 0;
+		s.bitBuffer	= 0;
+		s.bitCount	= 0;
+		s.error		= false;
+		s.out		= &out;
+
+		int last;
+		do
+		{
+			last = Bits(s, 1);
+			int type = Bits(s, 2);
+			if(s.error)
+				return false;
+
+			bool ok;
+			switch(type)
+			{
+			case 0:		ok = Stored(s);		break;
+			case 1:		ok = Fixed(s);		break;
+			case 2:		ok = Dynamic(s);	break;
+			default:	ok = false;			break;
+			}
+			if(!ok)
+				return false;
+		} while(!last);
+
+		return true;
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// PNG
+	//////////////////////////////////////////////////////////////////////////
+	int Paeth(int a, int b, int c)
+	{
+		int p = a + b - c;
+		int pa = p > a ? p - a : a - p;
+		int pb = p > b ? p - b : b - p;
+		int pc = p > c ? p - c : c - p;
+		if(pa <= pb && pa <= pc)
+			return a;
+		return pb <= pc ? b : c;
+	}
+
+	bool ParsePNGHeader(const std::vector<unsigned char>& data, int& width, int& height, int& colorType, int& bitDepth, int& interlace)
+	{
+		if(data.size() < 33 || memcmp(&data[0], PNG_SIGNATURE, 8) != 0 || memcmp(&data[12], "IHDR", 4) != 0)
+			return false;
+
+		width		= (int)ReadBE32(&data[16]);
+		height		= (int)ReadBE32(&data[20]);
+		bitDepth	= data[24];
+		colorType	= data[25];
+		interlace	= data[28];
+		return width > 0 && height > 0;
+	}
+
+	bool DecodePNG(const std::vector<unsigned char>& data, SpriteImage& image)
+	{
+		int colorType, bitDepth, interlace;
+		if(!ParsePNGHeader(data, image.width, image.height, colorType, bitDepth, interlace))
+			return false;
+
+		int channels;
+		switch(colorType)
+		{
+		case 0:		channels = 1;	break;	// Grey
+		case 2:		channels = 3;	break;	// RGB
+		case 4:		channels = 2;	break;	// Grey + alpha
+		case 6:		channels = 4;	break;	// RGBA
+		default:	return false;			// Palettes are not used by the game
+		}
+		if(bitDepth != 8 || interlace != 0)
+			return false;
+
+		// Gather the IDAT chunks into one zlib stream
+		std::vector<unsigned char> compressed;
+		size_t pos = 8;
+		while(pos + 12 <= data.size())
+		{
+			size_t length = ReadBE32(&data[pos]);
+			const unsigned char* type = &data[pos + 4];
+			if(pos + 12 + length > data.size())
+				return false;
+			if(memcmp(type, "IDAT", 4) == 0)
+				compressed.insert(compressed.end(), data.begin() + pos + 8, data.begin() + pos + 8 + length);
+			else if(memcmp(type, "IEND", 4) == 0)
+				break;
+			pos += 12 + length;
+		}
+		if(compressed.size() < 2)
+			return false;
+
+		size_t stride = (size_t)image.width * channels;
+		std::vector<unsigned char> raw;
+		raw.reserve((stride + 1) * image.height);
+		// Skip the two byte zlib header, the adler32 trailer is not checked
+		if(!Inflate(&compressed[2], compressed.size() - 2, raw) || raw.size() < (stride + 1) * image.height)
+			return false;
+
+		// Undo the per row filters in place
+		for(int y = 0; y < image.height; ++y)
+		{
+			unsigned char* row = &raw[y * (stride + 1)];
+			unsigned char filter = row[0];
+			unsigned char* cur = row + 1;
+			const unsigned char* prev = y > 0 ? cur - (stride + 1) : 0;
+
+			for(size_t x = 0; x < stride; ++x)
+			{
+				int a = x >= (size_t)channels ? cur[x - channels] : 0;
+				int b = prev ? prev[x] : 0;
+				int c = (prev && x >= (size_t)channels) ? prev[x - channels] : 0;
+				switch(filter)
+				{
+				case 0:		break;
+				case 1:		cur[x] = (unsigned char)(cur[x] + a);				break;
+				case 2:		cur[x] = (unsigned char)(cur[x] + b);				break;
+				case 3:		cur[x] = (unsigned char)(cur[x] + ((a + b) >> 1));	break;
+				case 4:		cur[x] = (unsigned char)(cur[x] + Paeth(a, b, c));	break;
+				default:	return false;
+				}
+			}
+		}
+
+		image.pixels.resize((size_t)image.width * image.height);
+		for(int y = 0; y < image.height; ++y)
+		{
+			const unsigned char* src = &raw[y * (stride + 1) + 1];
+			unsigned int* dst = &image.pixels[(size_t)y * image.width];
+			for(int x = 0; x < image.width; ++x, src += channels)
+			{
+				unsigned int r, g, b, a;
+				switch(channels)
+				{
+				case 1:		r = g = b = src[0];	a = 255;						break;
+				case 2:		r = g = b = src[0];	a = src[1];						break;
+				case 3:		r = src[0];	g = src[1];	b = src[2];	a = 255;		break;
+				default:	r = src[0];	g = src[1];	b = src[2];	a = src[3];		break;
+				}
+				dst[x] = (a << 24) | (r << 16) | (g << 8) | b;
+			}
+		}
+		return true;
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// TGA
+	//////////////////////////////////////////////////////////////////////////
+	bool ParseTGAHeader(const std::vector<unsigned char>& data, int& width, int& height, int& type, int& bpp, bool& topDown)
+	{
+		if(data.size() < 18 || data[1] != 0)
+			return false;
+
+		type	= data[2];
+		width	= data[12] | (data[13] << 8);
+		height	= data[14] | (data[15] << 8);
+		bpp		= data[16];
+		topDown	= (data[17] & 0x20) != 0;
+		return (type == 2 || type == 10) && (bpp == 24 || bpp == 32) && width > 0 && height > 0;
+	}
+
+	bool DecodeTGA(const std::vector<unsigned char>& data, SpriteImage& image)
+	{
+		int type, bpp;
+		bool topDown;
+		if(!ParseTGAHeader(data, image.width, image.height, type, bpp, topDown))
+			return false;
+
+		int bytes = bpp / 8;
+		size_t pos = 18 + data[0];
+		size_t count = (size_t)image.width * image.height;
+		image.pixels.resize(count);
+
+		size_t written = 0;
+		while(written < count)
+		{
+			size_t run = 1;
+			bool repeat = false;
+			if(type == 10)
+			{
+				if(pos >= data.size())
+					return false;
+				unsigned char header = data[pos++];
+				run = (header & 0x7F) + 1;
+				repeat = (header & 0x80) != 0;
+			}
+			else
+			{
+				run = count;
+			}
+
+			for(size_t i = 0; i < run && written < count; ++i)
+			{
+				if(i == 0 || !repeat)
+				{
+					if(pos + bytes > data.size())
+						return false;
+				}
+				const unsigned char* p = &data[pos];
+				unsigned int a = bytes == 4 ? p[3] : 255;
+				image.pixels[written++] = (a << 24) | (p[2] << 16) | (p[1] << 8) | p[0];
+				if(!repeat || i + 1 == run)
+					pos += bytes;
+			}
+		}
+
+		if(!topDown)
+		{
+			for(int y = 0; y < image.height / 2; ++y)
+			{
+				unsigned int* a = &image.pixels[(size_t)y * image.width];
+				unsigned int* b = &image.pixels[(size_t)(image.height - 1 - y) * image.width];
+				for(int x = 0; x < image.width; ++x)
+				{
+					unsigned int t = a[x];
+					a[x] = b[x];
+					b[x] = t;
+				}
+			}
+		}
+		return true;
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// PNG writing helpers
+	//////////////////////////////////////////////////////////////////////////
+	unsigned int Crc32(unsigned int crc, const unsigned char* data, size_t length)
+	{
+		static unsigned int table[256];
+		static bool built = false;
+		if(!built)
+		{
+			for(unsigned int n = 0; n < 256; ++n)
+			{
+				unsigned int c = n;
+				for(int k = 0; k < 8; ++k)
+					c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+				table[n] = c;
+			}
+			built = true;
+		}
+
+		crc = ~crc;
+		for(size_t i = 0; i < length; ++i)
+			crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+		return ~crc;
+	}
+
+	void WriteChunk(FILE* file, const char* type, const unsigned char* data, size_t length)
+	{
+		unsigned char header[8];
+		WriteBE32(header, (unsigned int)length);
+		memcpy(header + 4, type, 4);
+		fwrite(header, 1, 8, file);
+		if(length)
+			fwrite(data, 1, length, file);
+
+		unsigned int crc = Crc32(0, header + 4, 4);
+		crc = Crc32(crc, data, length);
+		unsigned char trailer[4];
+		WriteBE32(trailer, crc);
+		fwrite(trailer, 1, 4, file);
+	}
+}
+
+bool LoadImageFile(const char* fileName, SpriteImage& image, unsigned int colorKey)
+{
+	std::vector<unsigned char> data;
+	if(!ReadWholeFile(fileName, data))
+		return false;
+
+	bool loaded = (data.size() >= 8 && memcmp(&data[0], PNG_SIGNATURE, 8) == 0) ? DecodePNG(data, image) : DecodeTGA(data, image);
+	if(!loaded)
+		return false;
+
+	if(colorKey)
+	{
+		for(size_t i = 0; i < image.pixels.size(); ++i)
+		{
+			if(image.pixels[i] == colorKey)
+				image.pixels[i] = 0;
+		}
+	}
+	return true;
+}
+
+bool ReadImageSize(const char* fileName, int& width, int& height)
+{
+	FILE* file = fopen(fileName, "rb");
+	if(!file)
+		return false;
+
+	std::vector<unsigned char> data(33);
+	size_t read = fread(&data[0], 1, data.size(), file);
+	fclose(file);
+	data.resize(read);
+
+	int a, b, c;
+	if(ParsePNGHeader(data, width, height, a, b, c))
+		return true;
+	bool topDown;
+	return ParseTGAHeader(data, width, height, a, b, topDown);
+}
+
+bool WritePNG(const char* fileName, const unsigned int* pixels, int width, int height, int pitch)
+{
+	FILE* file = fopen(fileName, "wb");
+	if(!file)
+		return false;
+
+	fwrite(PNG_SIGNATURE, 1, 8, file);
+
+	unsigned char ihdr[13];
+	WriteBE32(ihdr, (unsigned int)width);
+	WriteBE32(ihdr + 4, (unsigned int)height);
+	ihdr[8]		= 8;	// Bit depth
+	ihdr[9]		= 2;	// RGB
+	ihdr[10]	= 0;	// Deflate
+	ihdr[11]	= 0;	// Adaptive filtering
+	ihdr[12]	= 0;	// Not interlaced
+	WriteChunk(file, "IHDR", ihdr, sizeof(ihdr));
+
+	// Filter type 0 rows of RGB
+	size_t stride = (size_t)width * 3 + 1;
+	std::vector<unsigned char> raw(stride * height);
+	for(int y = 0; y < height; ++y)
+	{
+		unsigned char* dst = &raw[y * stride];
+		const unsigned int* src = pixels + (size_t)y * pitch;
+		*dst++ = 0;
+		for(int x = 0; x < width; ++x)
+		{
+			*dst++ = (unsigned char)(src[x] >> 16);
+			*dst++ = (unsigned char)(src[x] >> 8);
+			*dst++ = (unsigned char)src[x];
+		}
+	}
+
+	// zlib stream made of stored blocks
+	std::vector<unsigned char> zlib;
+	zlib.reserve(raw.size() + raw.size() / 65535 * 5 + 16);
+	zlib.push_back(0x78);
+	zlib.push_back(0x01);
+
+	size_t pos = 0;
+	do
+	{
+		size_t block = raw.size() - pos;
+		if(block > 65535)
+			block = 65535;
+		bool last = pos + block == raw.size();
+		zlib.push_back(last ? 1 : 0);
+		zlib.push_back((unsigned char)block);
+		zlib.push_back((unsigned char)(block >> 8));
+		zlib.push_back((unsigned char)~block);
+		zlib.push_back((unsigned char)(~block >> 8));
+		zlib.insert(zlib.end(), raw.begin() + pos, raw.begin() + pos + block);
+		pos += block;
+	} while(pos < raw.size());
+
+	unsigned int s1 = 1, s2 = 0;
+	for(size_t i = 0; i < raw.size(); ++i)
+	{
+		s1 = (s1 + raw[i]) % 65521;
+		s2 = (s2 + s1) % 65521;
+	}
+	unsigned char adler[4];
+	WriteBE32(adler, (s2 << 16) | s1);
+	zlib.insert(zlib.end(), adler, adler + 4);
+
+	WriteChunk(file, "IDAT", &zlib[0], zlib.size());
+	WriteChunk(file, "IEND", 0, 0);
+
+	bool ok = ferror(file) == 0;
+	fclose(file);
+	return ok;
+}
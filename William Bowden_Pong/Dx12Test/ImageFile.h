@@ -0,0 +1,53 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	ImageFile.h
+// Date:	October 19th, 2026
+// Purpose: Portable image loading and saving for the renderers that do
+//			not have D3DX.  Reads the game's sprite files (PNG or TGA,
+//			whatever the extension says) into 32 bit ARGB and writes
+//			frames back out as PNG.
+//////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <vector>
+
+// Same colour key D3DXCreateTextureFromFileEx is given in Init()
+#define IMAGE_COLORKEY_MAGENTA 0xFFFF00FF
+
+struct SpriteImage
+{
+	int							width;
+	int							height;
+	std::vector<unsigned int>	pixels;		// ARGB, width * height, top row first
+};
+
+//////////////////////////////////////////////////////////////////////////
+// Name:		LoadImageFile
+// Parameters:	const char* fileName - PNG or TGA file to read
+//				SpriteImage& image - Receives the decoded pixels
+//				unsigned int colorKey - Opaque ARGB colour to replace with
+//					transparent black, 0 to disable
+// Return:		bool - false if the file is missing or not supported
+// Description:	Decodes 8 bit RGB/RGBA PNGs and 24/32 bit TGAs.
+//////////////////////////////////////////////////////////////////////////
+bool LoadImageFile(const char* fileName, SpriteImage& image, unsigned int colorKey);
+
+//////////////////////////////////////////////////////////////////////////
+// Name:		ReadImageSize
+// Parameters:	const char* fileName - PNG or TGA file to read
+//				int& width, int& height - Receives the image size
+// Return:		bool - false if the file is missing or not supported
+// Description:	Reads only the header, for renderers that never touch
+//				the pixels.
+//////////////////////////////////////////////////////////////////////////
+bool ReadImageSize(const char* fileName, int& width, int& height);
+
+//////////////////////////////////////////////////////////////////////////
+// Name:		WritePNG
+// Parameters:	const char* fileName - File to create
+//				const unsigned int* pixels - ARGB pixels, top row first
+//				int width, int height - Image size
+//				int pitch - Distance between rows, in pixels
+// Return:		bool - false if the file could not be written
+// Description:	Writes an uncompressed (stored deflate) RGB PNG.  Used for
+//				golden image tests, so speed matters more than size.
+//////////////////////////////////////////////////////////////////////////
+bool WritePNG(const char* fileName, const unsigned int* pixels, int width, int height, int pitch);
@@ -0,0 +1,103 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	InputLatency.cpp
+// Date:	October 19th, 2026
+// Purpose: Key press to Present latency by stage, see InputLatency.h.
+//////////////////////////////////////////////////////////////////////////
+#include "InputLatency.h"
+#include <stdio.h>
+
+CInputLatency::CInputLatency(void)
+{
+	Clear();
+}
+
+void CInputLatency::Clear()
+{
+	m_nPresses	= 0;
+	m_nDropped	= 0;
+	m_nTimedOut	= 0;
+	for(int i = 0; i < LATENCY_STAGE_COUNT; ++i)
+		m_Stages[i].Clear();
+}
+
+void CInputLatency::Capture(int keys, double now)
+{
+	for(int bit = 0; bit < 32; ++bit)
+	{
+		if(!(keys & (1 << bit)))
+			continue;
+		if(m_nPresses == INPUT_LATENCY_MAX_EVENTS)
+		{
+			++m_nDropped;
+			continue;
+		}
+		Press& press = m_Presses[m_nPresses++];
+		press.captured	= now;
+		press.ticked	= -1.0;
+		press.drawn		= -1.0;
+	}
+}
+
+void CInputLatency::Tick(double now)
+{
+	// Newest first, everything before the first one already ticked has
+	// been ticked too
+	for(int i = m_nPresses - 1; i >= 0 && m_Presses[i].ticked < 0.0; --i)
+		m_Presses[i].ticked = now;
+}
+
+void CInputLatency::Draw(double now)
+{
+	for(int i = m_nPresses - 1; i >= 0 && m_Presses[i].drawn < 0.0; --i)
+	{
+		if(m_Presses[i].ticked >= 0.0)
+			m_Presses[i].drawn = now;
+	}
+}
+
+void CInputLatency::Present(double now)
+{
+	int kept = 0;
+	for(int i = 0; i < m_nPresses; ++i)
+	{
+		const Press& press = m_Presses[i];
+		if(press.drawn >= 0.0)
+		{
+			m_Stages[LATENCY_QUEUED].Add(press.ticked - press.captured);
+			m_Stages[LATENCY_SIMULATED].Add(press.drawn - press.ticked);
+			m_Stages[LATENCY_DRAWN].Add(now - press.drawn);
+			m_Stages[LATENCY_TOTAL].Add(now - press.captured);
+		}
+		else if(press.ticked >= 0.0 && now - press.ticked > INPUT_LATENCY_TIMEOUT)
+		{
+			++m_nTimedOut;
+		}
+		else
+		{
+			m_Presses[kept++] = press;
+		}
+	}
+	m_nPresses = kept;
+}
+
+void CInputLatency::Format(std::string& text) const
+{
+	static const char* const names[LATENCY_STAGE_COUNT] =
+	{
+		"Poll to tick", "Tick to draw", "Draw to present", "Poll to present"
+	};
+
+	text.clear();
+	for(int i = 0; i < LATENCY_STAGE_COUNT; ++i)
+	{
+		char line[128];
+		sprintf(line, "%-16s p50 %6.2f ms  p99 %6.2f ms  max %6.2f ms\n", names[i],
+			m_Stages[i].GetPercentile(50.0) * 1e3, m_Stages[i].GetPercentile(99.0) * 1e3, m_Stages[i].GetMax() * 1e3);
+		text += line;
+	}
+
+	char line[128];
+	sprintf(line, "%lld presses, %d dropped, %d never drawn\n", m_Stages[LATENCY_TOTAL].GetCount(), m_nDropped,
+		m_nTimedOut);
+	text += line;
+}
@@ -0,0 +1,98 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	InputLatency.h
+// Date:	October 19th, 2026
+// Purpose: Follows each key press from the poll that first saw it,
+//			through the tick that used it and the frame drawn after that
+//			tick, to Present returning, and counts the time spent in each
+//			stage in a CLatencyHistogram.  Nothing reads a clock here:
+//			the caller passes the time of every step, PlatformGetTime()
+//			in the game and a simulated clock in Tools/LatencyBench.cpp.
+//			A press is only as early as the poll that saw it, DirectInput
+//			state has no time stamp, so the time from the key going down
+//			to the poll is not included.
+//////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <string>
+#include "LatencyHistogram.h"
+
+// Presses followed at once, later ones are dropped and counted
+#define INPUT_LATENCY_MAX_EVENTS 64
+
+// A press whose tick is followed by no drawn frame for this long, e.g.
+// on a menu that did not change, is given up on
+#define INPUT_LATENCY_TIMEOUT 1.0
+
+enum LatencyStage
+{
+	LATENCY_QUEUED,						// Poll to the tick that used the press
+	LATENCY_SIMULATED,					// That tick to drawing the next frame
+	LATENCY_DRAWN,						// Drawing to Present returning
+	LATENCY_TOTAL,						// Poll to Present returning
+	LATENCY_STAGE_COUNT
+};
+
+class CInputLatency
+{
+	struct Press
+	{
+		double				captured;
+		double				ticked;			// -1 until a tick has used it
+		double				drawn;			// -1 until a frame has been drawn after the tick
+	};
+
+	Press				m_Presses[INPUT_LATENCY_MAX_EVENTS];	// Oldest first
+	int					m_nPresses;
+	int					m_nDropped;		// Full when pressed
+	int					m_nTimedOut;	// No frame drawn in INPUT_LATENCY_TIMEOUT
+	CLatencyHistogram	m_Stages[LATENCY_STAGE_COUNT];
+
+	// Not copyable, it is large
+	CInputLatency(const CInputLatency&);
+	CInputLatency& operator=(const CInputLatency&);
+
+public:
+	CInputLatency(void);
+
+	void Clear();
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Capture
+	// Parameters:	int keys - Control bits that went down since the last
+	//					poll, i.e. controlDown
+	//				double now - When the poll returned
+	// Return:		void
+	// Description:	Starts following one press for each bit, so keys
+	//				pressed together are counted separately.
+	//////////////////////////////////////////////////////////////////////////
+	void Capture(int keys, double now);
+
+	// The simulation ticked with the input polled so far
+	void Tick(double now);
+
+	// A frame started drawing the state the last tick left
+	void Draw(double now);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Present
+	// Parameters:	double now - When Present returned
+	// Return:		void
+	// Description:	Counts every press drawn since the last Present in
+	//				the stage histograms and stops following it.  Presses
+	//				ticked long ago with no frame drawn are given up on.
+	//////////////////////////////////////////////////////////////////////////
+	void Present(double now);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Format
+	// Parameters:	std::string& text - Receives a line per stage with the
+	//					median, 99th percentile and worst in ms
+	// Return:		void
+	// Description:	For the log at shutdown and the bench.
+	//////////////////////////////////////////////////////////////////////////
+	void Format(std::string& text) const;
+
+	const CLatencyHistogram& GetStage(LatencyStage stage) const	{ return m_Stages[stage]; }
+	int GetPendingCount() const		{ return m_nPresses; }
+	int GetDroppedCount() const		{ return m_nDropped; }
+	int GetTimedOutCount() const	{ return m_nTimedOut; }
+};
@@ -0,0 +1,96 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	LatencyHistogram.h
+// Date:	October 19th, 2026
+// Purpose: Counts latencies in fixed buckets so percentiles can be read
+//			from millions of samples without keeping them.  Buckets are
+//			LATENCY_BUCKET_US wide up to LATENCY_RANGE_US, anything
+//			longer is counted in the last one and only the maximum is
+//			exact.  Adding a sample is an add and a divide, and two
+//			histograms merge by adding their buckets, so each thread can
+//			keep its own.
+//////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <string.h>
+
+#define LATENCY_BUCKET_US 10
+#define LATENCY_RANGE_US 200000
+#define LATENCY_BUCKETS (LATENCY_RANGE_US / LATENCY_BUCKET_US + 1)
+
+class CLatencyHistogram
+{
+	unsigned int		m_Buckets[LATENCY_BUCKETS];
+	long long			m_nCount;
+	double				m_fTotal;			// Seconds, for the mean
+	double				m_fMax;
+
+public:
+	CLatencyHistogram(void)
+	{
+		Clear();
+	}
+
+	void Clear()
+	{
+		memset(m_Buckets, 0, sizeof(m_Buckets));
+		m_nCount = 0;
+		m_fTotal = 0.0;
+		m_fMax = 0.0;
+	}
+
+	// Counts one latency, in seconds
+	void Add(double seconds)
+	{
+		if(seconds < 0.0)
+			seconds = 0.0;
+		int bucket = (int)(seconds * (1e6 / LATENCY_BUCKET_US));
+		if(bucket >= LATENCY_BUCKETS)
+			bucket = LATENCY_BUCKETS - 1;
+		++m_Buckets[bucket];
+		++m_nCount;
+		m_fTotal += seconds;
+		if(seconds > m_fMax)
+			m_fMax = seconds;
+	}
+
+	void Merge(const CLatencyHistogram& other)
+	{
+		for(int i = 0; i < LATENCY_BUCKETS; ++i)
+			m_Buckets[i] += other.m_Buckets[i];
+		m_nCount += other.m_nCount;
+		m_fTotal += other.m_fTotal;
+		if(other.m_fMax > m_fMax)
+			m_fMax = other.m_fMax;
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		GetPercentile
+	// Parameters:	double percent - 0 to 100
+	// Return:		double - Seconds, the top of the bucket the percentile
+	//				falls in, or the maximum if that is lower
+	// Description:	0 when nothing has been counted.
+	//////////////////////////////////////////////////////////////////////////
+	double GetPercentile(double percent) const
+	{
+		if(m_nCount == 0)
+			return 0.0;
+		long long rank = (long long)(m_nCount * percent * 0.01);
+		if(rank >= m_nCount)
+			rank = m_nCount - 1;
+
+		long long seen = 0;
+		for(int i = 0; i < LATENCY_BUCKETS; ++i)
+		{
+			seen += m_Buckets[i];
+			if(seen > rank)
+			{
+				double top = (i + 1) * LATENCY_BUCKET_US * 1e-6;
+				return top < m_fMax ? top : m_fMax;
+			}
+		}
+		return m_fMax;
+	}
+
+	long long GetCount() const	{ return m_nCount; }
+	double GetMean() const		{ return m_nCount > 0 ? m_fTotal / m_nCount : 0.0; }
+	double GetMax() const		{ return m_fMax; }
+};
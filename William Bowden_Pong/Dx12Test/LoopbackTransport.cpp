@@ -0,0 +1,81 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	LoopbackTransport.cpp
+// Date:	October 19th, 2026
+// Purpose: In process transport, see LoopbackTransport.h.
+//////////////////////////////////////////////////////////////////////////
+#include "LoopbackTransport.h"
+#include <string.h>
+
+CLoopbackLink::CLoopbackLink(void)
+{
+	for(int i = 0; i < 2; ++i)
+	{
+		m_Endpoints[i].m_pLink = this;
+		m_Endpoints[i].m_nSide = i;
+	}
+	Init(LoopbackSettings());
+}
+
+void CLoopbackLink::Init(const LoopbackSettings& settings)
+{
+	m_Settings = settings;
+	if(m_Settings.seed == 0)
+		m_Settings.seed = 1;
+	m_InFlight.clear();
+	m_InFlight.reserve(256);
+	m_fTime = 0.0;
+	memset(&m_Stats, 0, sizeof(m_Stats));
+}
+
+float CLoopbackLink::Random()
+{
+	// 0 to 1, the same LCG the paddle AI uses
+	m_Settings.seed = m_Settings.seed * 1664525u + 1013904223u;
+	return (float)(m_Settings.seed >> 8) / (float)(1 << 24);
+}
+
+bool CLoopbackLink::Post(int from, const void* data, int size)
+{
+	if(size > NET_MAX_PACKET)
+		return false;
+
+	++m_Stats.sent;
+	if(Random() < m_Settings.loss)
+	{
+		++m_Stats.dropped;
+		return true;
+	}
+
+	Packet packet;
+	packet.arrival	= m_fTime + m_Settings.latency + m_Settings.jitter * Random();
+	packet.to		= 1 - from;
+	packet.size		= size;
+	memcpy(packet.data, data, size);
+	m_InFlight.push_back(packet);
+	return true;
+}
+
+int CLoopbackLink::Take(int to, void* buffer, int size)
+{
+	// The packet that arrived first, a handful are in flight at once
+	int first = -1;
+	for(size_t i = 0; i < m_InFlight.size(); ++i)
+	{
+		const Packet& packet = m_InFlight[i];
+		if(packet.to == to && packet.arrival <= m_fTime
+			&& (first < 0 || packet.arrival < m_InFlight[first].arrival))
+		{
+			first = (int)i;
+		}
+	}
+	if(first < 0)
+		return 0;
+
+	Packet& packet = m_InFlight[first];
+	int received = packet.size < size ? packet.size : size;
+	memcpy(buffer, packet.data, received);
+	packet = m_InFlight.back();
+	m_InFlight.pop_back();
+	++m_Stats.delivered;
+	return received;
+}
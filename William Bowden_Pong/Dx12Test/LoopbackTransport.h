@@ -0,0 +1,78 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	LoopbackTransport.h
+// Date:	October 19th, 2026
+// Purpose: Two connected CNetTransport endpoints in one process, for
+//			testing netcode without a network.  Every packet is held for
+//			the latency plus a random share of the jitter, so jitter also
+//			reorders packets, and a set share of packets is dropped.
+//			Time is whatever the caller sets, so a test can run minutes
+//			of simulated play in well under a second and get the same
+//			result every time.
+//////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <vector>
+#include "NetTransport.h"
+
+struct LoopbackSettings
+{
+	double				latency;		// One way, seconds
+	double				jitter;			// Up to this much extra, seconds
+	float				loss;			// Share of packets dropped, 0 to 1
+	unsigned int		seed;			// Random state for jitter and loss
+
+	LoopbackSettings(void) : latency(0.0), jitter(0.0), loss(0.0f), seed(1) {}
+};
+
+struct LoopbackStats
+{
+	int					sent;
+	int					dropped;
+	int					delivered;
+};
+
+class CLoopbackLink
+{
+	class CEndpoint : public CNetTransport
+	{
+	public:
+		CLoopbackLink*	m_pLink;
+		int				m_nSide;
+
+		virtual bool Send(const void* data, int size)	{ return m_pLink->Post(m_nSide, data, size); }
+		virtual int Receive(void* buffer, int size)		{ return m_pLink->Take(m_nSide, buffer, size); }
+	};
+
+	struct Packet
+	{
+		double			arrival;
+		int				to;				// Endpoint it is heading for
+		int				size;
+		unsigned char	data[NET_MAX_PACKET];
+	};
+
+	CEndpoint				m_Endpoints[2];
+	std::vector<Packet>		m_InFlight;
+	LoopbackSettings		m_Settings;
+	double					m_fTime;
+	LoopbackStats			m_Stats;
+
+	CLoopbackLink(const CLoopbackLink&);
+	CLoopbackLink& operator=(const CLoopbackLink&);
+
+	float Random();
+	bool Post(int from, const void* data, int size);
+	int Take(int to, void* buffer, int size);
+
+public:
+	CLoopbackLink(void);
+
+	// Drops anything in flight
+	void Init(const LoopbackSettings& settings);
+
+	// The clock packets are timed against, only ever moved forward
+	void SetTime(double seconds)					{ m_fTime = seconds; }
+	double GetTime() const							{ return m_fTime; }
+
+	CNetTransport& GetEndpoint(int side)			{ return m_Endpoints[side]; }
+	const LoopbackStats& GetStats() const			{ return m_Stats; }
+};
@@ -0,0 +1,276 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	MatchRoom.cpp
+// Date:	October 19th, 2026
+// Purpose: Server authoritative match, see MatchRoom.h.
+//////////////////////////////////////////////////////////////////////////
+#include "MatchRoom.h"
+#include "PaddleController.h"
+#include <string.h>
+
+#define ROOM_PACKET_HEADER 6
+#define ROOM_JOIN_SIZE 10
+#define ROOM_INPUT_SIZE 19
+#define ROOM_STATE_SIZE 40
+
+namespace
+{
+	unsigned char* WriteU32(unsigned char* p, unsigned int value)
+	{
+		p[0] = (unsigned char)value;
+		p[1] = (unsigned char)(value >> 8);
+		p[2] = (unsigned char)(value >> 16);
+		p[3] = (unsigned char)(value >> 24);
+		return p + 4;
+	}
+
+	unsigned char* WriteU64(unsigned char* p, unsigned long long value)
+	{
+		p = WriteU32(p, (unsigned int)value);
+		return WriteU32(p, (unsigned int)(value >> 32));
+	}
+
+	unsigned char* WriteF32(unsigned char* p, float value)
+	{
+		unsigned int bits;
+		memcpy(&bits, &value, sizeof(bits));
+		return WriteU32(p, bits);
+	}
+
+	unsigned int ReadU32(const unsigned char* p)
+	{
+		return p[0] | (p[1] << 8) | (p[2] << 16) | ((unsigned int)p[3] << 24);
+	}
+
+	unsigned long long ReadU64(const unsigned char* p)
+	{
+		return ReadU32(p) | ((unsigned long long)ReadU32(p + 4) << 32);
+	}
+
+	float ReadF32(const unsigned char* p)
+	{
+		unsigned int bits = ReadU32(p);
+		float value;
+		memcpy(&value, &bits, sizeof(value));
+		return value;
+	}
+}
+
+int WriteRoomPacket(const RoomPacket& packet, unsigned char* buffer)
+{
+	unsigned char* p = buffer;
+	*p++ = (unsigned char)packet.type;
+	p = WriteU32(p, packet.room);
+	*p++ = (unsigned char)packet.paddle;
+
+	switch(packet.type)
+	{
+	case ROOM_PACKET_JOIN:
+	case ROOM_PACKET_REJECT:
+		p = WriteU32(p, packet.tickRate);
+		break;
+
+	case ROOM_PACKET_LEAVE:
+		break;
+
+	case ROOM_PACKET_INPUT:
+		p = WriteU32(p, packet.sequence);
+		*p++ = (unsigned char)packet.inputs;
+		p = WriteU64(p, packet.stamp);
+		break;
+
+	case ROOM_PACKET_STATE:
+		p = WriteU32(p, packet.sequence);
+		p = WriteU64(p, packet.stamp);
+		p = WriteU32(p, packet.tick);
+		p = WriteF32(p, packet.ballX);
+		p = WriteF32(p, packet.ballY);
+		p = WriteF32(p, packet.paddleY[0]);
+		p = WriteF32(p, packet.paddleY[1]);
+		*p++ = (unsigned char)packet.points[0];
+		*p++ = (unsigned char)packet.points[1];
+		break;
+
+	default:
+		return 0;
+	}
+	return (int)(p - buffer);
+}
+
+bool ReadRoomPacket(const unsigned char* data, int size, RoomPacket& packet)
+{
+	if(size < ROOM_PACKET_HEADER)
+		return false;
+
+	memset(&packet, 0, sizeof(packet));
+	packet.type		= data[0];
+	packet.room		= ReadU32(data + 1);
+	packet.paddle	= data[5];
+	if(packet.paddle > 1)
+		return false;
+
+	const unsigned char* p = data + ROOM_PACKET_HEADER;
+	switch(packet.type)
+	{
+	case ROOM_PACKET_JOIN:
+	case ROOM_PACKET_REJECT:
+		if(size < ROOM_JOIN_SIZE)
+			return false;
+		packet.tickRate	= ReadU32(p);
+		return true;
+
+	case ROOM_PACKET_LEAVE:
+		return true;
+
+	case ROOM_PACKET_INPUT:
+		if(size < ROOM_INPUT_SIZE)
+			return false;
+		packet.sequence	= ReadU32(p);
+		packet.inputs	= p[4] & (INPUT_UP | INPUT_DOWN);
+		packet.stamp	= ReadU64(p + 5);
+		return true;
+
+	case ROOM_PACKET_STATE:
+		if(size < ROOM_STATE_SIZE)
+			return false;
+		packet.sequence		= ReadU32(p);
+		packet.stamp		= ReadU64(p + 4);
+		packet.tick			= ReadU32(p + 12);
+		packet.ballX		= ReadF32(p + 16);
+		packet.ballY		= ReadF32(p + 20);
+		packet.paddleY[0]	= ReadF32(p + 24);
+		packet.paddleY[1]	= ReadF32(p + 28);
+		packet.points[0]	= p[32];
+		packet.points[1]	= p[33];
+		return true;
+	}
+	return false;
+}
+
+CMatchRoom::CMatchRoom(void)
+{
+	m_fTicksPerStep	= 1.0;
+	m_fTickCarry	= 0.0;
+	m_nTickRate		= 0;
+	Init(0);
+}
+
+void CMatchRoom::Configure(const PongTuning& tuning, double tickRate, double stepRate)
+{
+	m_Game.SetTuning(tuning);
+	m_fTicksPerStep	= tickRate > 0.0 && stepRate > 0.0 ? tickRate / stepRate : 1.0;
+	m_fTickCarry	= 0.0;
+	m_nTickRate		= tickRate > 0.0 ? (unsigned int)(tickRate + 0.5) : 0;
+}
+
+void CMatchRoom::Init(unsigned int id)
+{
+	m_nId = id;
+	m_nTick = 0;
+	for(int i = 0; i < 2; ++i)
+	{
+		m_bJoined[i]	= false;
+		m_fLastHeard[i]	= 0.0;
+		m_Inputs[i]		= 0;
+		m_Sequence[i]	= 0;
+		m_Stamp[i]		= 0;
+	}
+	m_Game.Init();
+}
+
+bool CMatchRoom::Join(int paddle, double now)
+{
+	m_fLastHeard[paddle] = now;
+	if(m_bJoined[paddle])
+		return false;
+
+	m_bJoined[paddle]	= true;
+	m_Inputs[paddle]	= 0;
+	m_Sequence[paddle]	= 0;
+	m_Stamp[paddle]		= 0;
+	if(!IsPlaying())
+		return false;
+
+	// Straight into the match, a server has no menus or intro
+	m_Game.Init();
+	m_Game.Menu.onSTART = false;
+	m_Game.FinishMovie();
+	m_nTick = 0;
+	return true;
+}
+
+void CMatchRoom::Leave(int paddle)
+{
+	m_bJoined[paddle] = false;
+}
+
+bool CMatchRoom::ApplyInput(const RoomPacket& packet, double now)
+{
+	int paddle = packet.paddle;
+	if(!m_bJoined[paddle])
+		return false;
+	m_fLastHeard[paddle] = now;
+
+	// Inputs can arrive out of order, an older one must not win.  The
+	// difference is signed so the sequence can wrap.
+	if(m_Sequence[paddle] != 0 && (int)(packet.sequence - m_Sequence[paddle]) <= 0)
+		return false;
+
+	m_Inputs[paddle]	= packet.inputs;
+	m_Sequence[paddle]	= packet.sequence;
+	m_Stamp[paddle]		= packet.stamp;
+	return true;
+}
+
+int CMatchRoom::Step()
+{
+	int keys = GetInputKeys(0, m_Inputs[0]) | GetInputKeys(1, m_Inputs[1]);
+	++m_nTick;
+
+	m_fTickCarry += m_fTicksPerStep;
+	int ticks = (int)m_fTickCarry;
+	m_fTickCarry -= ticks;
+	int sounds = 0;
+	for(int i = 0; i < ticks; ++i)
+		sounds |= m_Game.Tick(keys, 0);
+	return sounds;
+}
+
+bool CMatchRoom::Expire(double now)
+{
+	bool expired = false;
+	for(int i = 0; i < 2; ++i)
+	{
+		if(m_bJoined[i] && now - m_fLastHeard[i] > ROOM_TIMEOUT)
+		{
+			m_bJoined[i] = false;
+			expired = true;
+		}
+	}
+	return expired;
+}
+
+void CMatchRoom::GetState(int paddle, RoomPacket& packet) const
+{
+	packet.type			= ROOM_PACKET_STATE;
+	packet.room			= m_nId;
+	packet.paddle		= paddle;
+	packet.sequence		= m_Sequence[paddle];
+	packet.stamp		= m_Stamp[paddle];
+	packet.inputs		= m_Inputs[paddle];
+	packet.tick			= m_nTick;
+	packet.ballX		= m_Game.Ball.xp;
+	packet.ballY		= m_Game.Ball.yp;
+	packet.paddleY[0]	= m_Game.Paddle[0].yp;
+	packet.paddleY[1]	= m_Game.Paddle[1].yp;
+	packet.points[0]	= m_Game.Player1Point;
+	packet.points[1]	= m_Game.Player2Point;
+}
+
+void CMatchRoom::GetReject(const RoomPacket& join, RoomPacket& packet) const
+{
+	memset(&packet, 0, sizeof(packet));
+	packet.type			= ROOM_PACKET_REJECT;
+	packet.room			= join.room;
+	packet.paddle		= join.paddle;
+	packet.tickRate		= m_nTickRate;
+}
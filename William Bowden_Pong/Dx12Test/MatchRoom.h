@@ -0,0 +1,177 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	MatchRoom.h
+// Date:	October 19th, 2026
+// Purpose: One server authoritative match and the packets its players
+//			exchange with the server.  Players send the up / down inputs
+//			of their paddle, the server steps the match at a fixed rate
+//			and sends both players the result of every step.  A step
+//			runs as many match ticks as the game would in that time
+//			(see Configure()), since the PongTuning speeds are per tick.
+//			The room knows nothing about sockets or threads, the server
+//			decides when it steps and where its packets go.
+//
+//			Every packet starts with a type byte, then the room and the
+//			paddle.  Numbers are little endian.
+//				ROOM_PACKET_JOIN	u8 type, u32 room, u8 paddle,
+//									u32 tick rate
+//				ROOM_PACKET_REJECT	the same, with the room's tick rate
+//				ROOM_PACKET_LEAVE	u8 type, u32 room, u8 paddle
+//				ROOM_PACKET_INPUT	+ u32 sequence, u8 inputs, u64 stamp
+//				ROOM_PACKET_STATE	+ u32 sequence, u64 stamp, u32 step,
+//									f32 ball x, y, f32 paddle y * 2,
+//									u8 points * 2
+//			A state carries back the sequence and stamp of the newest
+//			input from that player the step ran with, so a client can
+//			time its inputs from sending to seeing them applied.
+//
+//			A join carries the match ticks a second the client plays at.
+//			The same speeds at another rate are another game, so a room
+//			only seats players at its own rate and answers anyone else
+//			with a ROOM_PACKET_REJECT saying what its rate is.
+//////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "PongGame.h"
+
+#define ROOM_PACKET_JOIN	1
+#define ROOM_PACKET_LEAVE	2
+#define ROOM_PACKET_INPUT	3
+#define ROOM_PACKET_STATE	4
+#define ROOM_PACKET_REJECT	5
+
+// Largest packet, a state
+#define ROOM_MAX_PACKET 40
+
+// Seconds without a packet before a player is dropped
+#define ROOM_TIMEOUT 5.0
+
+struct RoomPacket
+{
+	int					type;			// ROOM_PACKET_*
+	unsigned int		room;
+	int					paddle;			// 0 left, 1 right
+
+	// Joins and rejects
+	unsigned int		tickRate;		// Match ticks a second, 0 for one a step
+
+	// Inputs and states
+	unsigned int		sequence;		// Counts up with every input sent
+	unsigned long long	stamp;			// Client's send time, echoed back
+	int					inputs;			// INPUT_UP / INPUT_DOWN
+
+	// States
+	unsigned int		tick;			// Steps run, see CMatchRoom::Step()
+	float				ballX, ballY;
+	float				paddleY[2];
+	int					points[2];
+};
+
+//////////////////////////////////////////////////////////////////////////
+// Name:		WriteRoomPacket
+// Parameters:	const RoomPacket& packet - Packet to encode, only the
+//					fields its type uses
+//				unsigned char* buffer - At least ROOM_MAX_PACKET bytes
+// Return:		int - Bytes written, 0 for an unknown type
+// Description:	Encodes a packet for sending.
+//////////////////////////////////////////////////////////////////////////
+int WriteRoomPacket(const RoomPacket& packet, unsigned char* buffer);
+
+//////////////////////////////////////////////////////////////////////////
+// Name:		ReadRoomPacket
+// Parameters:	const unsigned char* data - Packet as received
+//				int size - Its length
+//				RoomPacket& packet - Receives the fields
+// Return:		bool - false if it is not a whole packet of a known type
+// Description:	Decodes a received packet.
+//////////////////////////////////////////////////////////////////////////
+bool ReadRoomPacket(const unsigned char* data, int size, RoomPacket& packet);
+
+class CMatchRoom
+{
+	CPongGame			m_Game;
+	unsigned int		m_nId;
+	unsigned int		m_nTick;			// Steps run
+	double				m_fTicksPerStep;	// Match ticks, may be fractional
+	double				m_fTickCarry;		// Part of a tick owed to the next step
+	unsigned int		m_nTickRate;		// Joins must be at this rate
+	bool				m_bJoined[2];
+	double				m_fLastHeard[2];	// When each player last sent anything
+	int					m_Inputs[2];		// Held by each paddle
+	unsigned int		m_Sequence[2];		// Newest input applied
+	unsigned long long	m_Stamp[2];
+
+public:
+	CMatchRoom(void);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Init
+	// Parameters:	unsigned int id - Room number players join by
+	// Return:		void
+	// Description:	Empties the room.
+	//////////////////////////////////////////////////////////////////////////
+	void Init(unsigned int id);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Configure
+	// Parameters:	const PongTuning& tuning - Speeds, the clients' [Tuning]
+	//				double tickRate - Match ticks a second, the clients'
+	//					[Video] TickRate, 0 for one a step
+	//				double stepRate - Step() calls a second
+	// Return:		void
+	// Description:	Kept by Init(), set once when the server starts.  The
+	//				ticks a step runs are spread so the match runs exactly
+	//				tickRate a second, e.g. 4000 at 60 steps runs 66 or 67.
+	//				Rounded to whole ticks it is the rate joins must have.
+	//////////////////////////////////////////////////////////////////////////
+	void Configure(const PongTuning& tuning, double tickRate, double stepRate);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Join
+	// Parameters:	int paddle - Paddle the player wants
+	//				double now - Seconds, the server's clock
+	// Return:		bool - true if the match starts with this player
+	// Description:	A join for a paddle already taken counts as that
+	//				player being alive, so clients can repeat it until the
+	//				first state arrives.  Check the join's tick rate with
+	//				AcceptsTickRate() first.
+	//////////////////////////////////////////////////////////////////////////
+	bool Join(int paddle, double now);
+
+	void Leave(int paddle);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		ApplyInput
+	// Parameters:	const RoomPacket& packet - A ROOM_PACKET_INPUT
+	//				double now - Seconds, the server's clock
+	// Return:		bool - false if the paddle is not in the room or the
+	//				input is older than one already applied
+	// Description:	Sets what the paddle holds from the next tick on.
+	//////////////////////////////////////////////////////////////////////////
+	bool ApplyInput(const RoomPacket& packet, double now);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Step
+	// Parameters:	void
+	// Return:		int - SOUND1 / SOUND2 flags of its ticks
+	// Description:	Runs the step's match ticks on the held inputs.
+	//////////////////////////////////////////////////////////////////////////
+	int Step();
+
+	// Drops players not heard from for ROOM_TIMEOUT, true if any were
+	bool Expire(double now);
+
+	// The state of the last tick as it is sent to the paddle's player
+	void GetState(int paddle, RoomPacket& packet) const;
+
+	// The answer to a join at another tick rate
+	void GetReject(const RoomPacket& join, RoomPacket& packet) const;
+
+	bool AcceptsTickRate(unsigned int tickRate) const	{ return tickRate == m_nTickRate; }
+
+	bool IsJoined(int paddle) const		{ return m_bJoined[paddle]; }
+	bool IsPlaying() const				{ return m_bJoined[0] && m_bJoined[1]; }
+	bool IsEmpty() const				{ return !m_bJoined[0] && !m_bJoined[1]; }
+	unsigned int GetId() const			{ return m_nId; }
+	unsigned int GetTick() const		{ return m_nTick; }
+	unsigned int GetTickRate() const	{ return m_nTickRate; }
+	const CPongGame& GetGame() const	{ return m_Game; }
+};
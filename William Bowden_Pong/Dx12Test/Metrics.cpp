@@ -0,0 +1,300 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	Metrics.cpp
+// Date:	October 19th, 2026
+// Purpose: The metrics registry, publisher and reader, see Metrics.h.
+//////////////////////////////////////////////////////////////////////////
+#include "Metrics.h"
+#include <string.h>
+#include <chrono>
+
+// Reads that find the publisher writing try this many times
+#define METRICS_READ_TRIES 100
+
+namespace
+{
+	void CopyName(char* to, const char* name)
+	{
+		strncpy(to, name, METRICS_NAME_LENGTH - 1);
+		to[METRICS_NAME_LENGTH - 1] = 0;
+	}
+
+	bool SameName(const char* stored, const char* name)
+	{
+		return strncmp(stored, name, METRICS_NAME_LENGTH - 1) == 0;
+	}
+}
+
+double GetMetricsPercentile(const MetricsHistogramEntry& histogram, double percent)
+{
+	if(histogram.count == 0)
+		return 0.0;
+	double wanted = histogram.count * percent / 100.0;
+	unsigned long long seen = 0;
+	for(int i = 0; i < METRICS_BUCKETS; ++i)
+	{
+		seen += histogram.buckets[i];
+		if(seen >= wanted && seen > 0)
+			return i == 0 ? 1.0 : (double)(1ULL << i);
+	}
+	return (double)(1ULL << (METRICS_BUCKETS - 1));
+}
+
+//////////////////////////////////////////////////////////////////////////
+// CMetricsRegistry
+//////////////////////////////////////////////////////////////////////////
+
+CMetricsRegistry::CMetricsRegistry(void)
+	: m_nCounters(0), m_nHistograms(0), m_nWriters(0)
+{
+	memset(m_CounterNames, 0, sizeof(m_CounterNames));
+	memset(m_HistogramNames, 0, sizeof(m_HistogramNames));
+	for(int i = 0; i < METRICS_MAX_COUNTERS; ++i)
+		m_CounterKinds[i] = METRIC_COUNTER;
+
+	// Atomics start out undefined
+	for(int slot = 0; slot < METRICS_MAX_WRITERS; ++slot)
+	{
+		for(int i = 0; i < METRICS_MAX_COUNTERS; ++i)
+			m_Slots[slot].counters[i].store(0, std::memory_order_relaxed);
+		for(int i = 0; i < METRICS_MAX_HISTOGRAMS; ++i)
+		{
+			for(int j = 0; j < METRICS_BUCKETS + 2; ++j)
+				m_Slots[slot].histograms[i][j].store(0, std::memory_order_relaxed);
+		}
+	}
+}
+
+int CMetricsRegistry::Add(const char* name, MetricKind kind)
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	int count = m_nCounters.load(std::memory_order_relaxed);
+	for(int i = 0; i < count; ++i)
+	{
+		if(SameName(m_CounterNames[i], name))
+			return i;
+	}
+	if(count == METRICS_MAX_COUNTERS)
+		return -1;
+	CopyName(m_CounterNames[count], name);
+	m_CounterKinds[count] = kind;
+	m_nCounters.store(count + 1, std::memory_order_release);
+	return count;
+}
+
+int CMetricsRegistry::AddHistogram(const char* name)
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	int count = m_nHistograms.load(std::memory_order_relaxed);
+	for(int i = 0; i < count; ++i)
+	{
+		if(SameName(m_HistogramNames[i], name))
+			return i;
+	}
+	if(count == METRICS_MAX_HISTOGRAMS)
+		return -1;
+	CopyName(m_HistogramNames[count], name);
+	m_nHistograms.store(count + 1, std::memory_order_release);
+	return count;
+}
+
+CMetricsWriter CMetricsRegistry::GetWriter()
+{
+	int slot = m_nWriters.fetch_add(1);
+	if(slot >= METRICS_MAX_WRITERS)
+	{
+		m_nWriters.store(METRICS_MAX_WRITERS);
+		return CMetricsWriter();
+	}
+	return CMetricsWriter(&m_Slots[slot]);
+}
+
+void CMetricsRegistry::Collect(MetricsSegment& segment) const
+{
+	int counters	= GetCounterCount();
+	int histograms	= GetHistogramCount();
+	int writers		= GetWriterCount();
+	memset(&segment, 0, sizeof(segment));
+	segment.header.counterCount		= counters;
+	segment.header.histogramCount	= histograms;
+	segment.header.bucketCount		= METRICS_BUCKETS;
+	segment.header.writerCount		= writers;
+
+	for(int i = 0; i < counters; ++i)
+	{
+		MetricsCounterEntry& entry = segment.counters[i];
+		memcpy(entry.name, m_CounterNames[i], METRICS_NAME_LENGTH);
+		entry.kind = m_CounterKinds[i];
+		for(int slot = 0; slot < writers; ++slot)
+			entry.value += m_Slots[slot].counters[i].load(std::memory_order_relaxed);
+	}
+
+	for(int i = 0; i < histograms; ++i)
+	{
+		MetricsHistogramEntry& entry = segment.histograms[i];
+		memcpy(entry.name, m_HistogramNames[i], METRICS_NAME_LENGTH);
+		for(int slot = 0; slot < writers; ++slot)
+		{
+			const std::atomic<unsigned long long>* values = m_Slots[slot].histograms[i];
+			entry.count += values[0].load(std::memory_order_relaxed);
+			entry.total += values[1].load(std::memory_order_relaxed);
+			for(int j = 0; j < METRICS_BUCKETS; ++j)
+				entry.buckets[j] += values[2 + j].load(std::memory_order_relaxed);
+		}
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+// CMetricsPublisher
+//////////////////////////////////////////////////////////////////////////
+
+CMetricsPublisher::CMetricsPublisher(void)
+{
+	m_pRegistry		= 0;
+	m_pSegment		= 0;
+	m_fInterval		= 1.0;
+	m_fStart		= 0.0;
+	m_nPublished	= 0;
+	m_nPublishTime	= -1;
+	m_bQuit			= false;
+	m_bRunning		= false;
+}
+
+CMetricsPublisher::~CMetricsPublisher(void)
+{
+	Shutdown();
+}
+
+bool CMetricsPublisher::Start(CMetricsRegistry& registry, const MetricsDesc& desc)
+{
+	Shutdown();
+	if(!PlatformCreateSharedMemory(desc.name, sizeof(MetricsSegment), m_Memory))
+		return false;
+
+	m_pRegistry		= &registry;
+	m_pSegment		= (MetricsSegment*)m_Memory.data;
+	m_fInterval		= desc.interval > 0.01 ? desc.interval : 0.01;
+	m_fStart		= PlatformGetTime();
+	m_nPublished	= 0;
+	m_nPublishTime	= registry.AddHistogram("metrics.publish");
+
+	// A segment left by a game that crashed may be odd, readers wait
+	// for it to be even
+	m_pSegment->header.sequence = 0;
+	Publish();
+
+	m_bQuit = false;
+	m_Thread = std::thread(PublisherMain, this);
+	m_bRunning = true;
+	return true;
+}
+
+void CMetricsPublisher::Shutdown()
+{
+	if(m_bRunning)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_bQuit = true;
+		}
+		m_Wake.notify_one();
+		m_Thread.join();
+		m_bRunning = false;
+	}
+	if(m_pSegment)
+	{
+		PlatformCloseSharedMemory(m_Memory);
+		m_pSegment = 0;
+	}
+}
+
+void CMetricsPublisher::PublisherMain(CMetricsPublisher* publisher)
+{
+	// Publishing must never take a core from a frame
+	PlatformLowerThreadPriority();
+	CMetricsWriter writer = publisher->m_pRegistry->GetWriter();
+
+	std::unique_lock<std::mutex> lock(publisher->m_Mutex);
+	std::chrono::microseconds interval((long long)(publisher->m_fInterval * 1e6));
+	while(!publisher->m_bQuit)
+	{
+		publisher->m_Wake.wait_for(lock, interval);
+		if(publisher->m_bQuit)
+			break;
+		lock.unlock();
+		double start = PlatformGetTime();
+		publisher->Publish();
+		writer.Record(publisher->m_nPublishTime, PlatformGetTime() - start);
+		lock.lock();
+	}
+}
+
+void CMetricsPublisher::Publish()
+{
+	if(!m_pSegment)
+		return;
+	m_pRegistry->Collect(m_Collected);
+	MetricsHeader& header = m_Collected.header;
+	header.magic		= METRICS_MAGIC;
+	header.version		= METRICS_VERSION;
+	header.size			= sizeof(MetricsSegment);
+	header.processId	= PlatformGetProcessId();
+	header.publishCount	= ++m_nPublished;
+	header.uptime		= PlatformGetTime() - m_fStart;
+	header.interval		= m_fInterval;
+
+	// Odd while the entries are written.  Only the used part of the
+	// tables is copied, the rest stays zero.
+	unsigned int sequence = m_pSegment->header.sequence;
+	m_pSegment->header.sequence = sequence + 1;
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	header.sequence = sequence + 1;
+	memcpy(&m_pSegment->header, &header, sizeof(header));
+	memcpy(m_pSegment->counters, m_Collected.counters, header.counterCount * sizeof(MetricsCounterEntry));
+	memcpy(m_pSegment->histograms, m_Collected.histograms, header.histogramCount * sizeof(MetricsHistogramEntry));
+
+	std::atomic_thread_fence(std::memory_order_release);
+	m_pSegment->header.sequence = sequence + 2;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// CMetricsReader
+//////////////////////////////////////////////////////////////////////////
+
+bool CMetricsReader::Open(const char* name)
+{
+	Close();
+	return PlatformOpenSharedMemory(name, sizeof(MetricsSegment), m_Memory);
+}
+
+void CMetricsReader::Close()
+{
+	PlatformCloseSharedMemory(m_Memory);
+}
+
+bool CMetricsReader::Read(MetricsSegment& segment)
+{
+	const MetricsSegment* shared = (const MetricsSegment*)m_Memory.data;
+	if(!shared)
+		return false;
+
+	for(int i = 0; i < METRICS_READ_TRIES; ++i)
+	{
+		unsigned int before = shared->header.sequence;
+		std::atomic_thread_fence(std::memory_order_acquire);
+		memcpy(&segment, shared, sizeof(segment));
+		std::atomic_thread_fence(std::memory_order_acquire);
+		unsigned int after = shared->header.sequence;
+		if(before % 2 != 0 || before != after)
+		{
+			std::this_thread::yield();
+			continue;
+		}
+
+		const MetricsHeader& header = segment.header;
+		return header.magic == METRICS_MAGIC && header.version == METRICS_VERSION
+			&& header.size == sizeof(MetricsSegment) && header.bucketCount == METRICS_BUCKETS
+			&& header.counterCount <= METRICS_MAX_COUNTERS && header.histogramCount <= METRICS_MAX_HISTOGRAMS;
+	}
+	return false;
+}
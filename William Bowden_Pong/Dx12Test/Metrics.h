@@ -0,0 +1,333 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	Metrics.h
+// Date:	October 19th, 2026
+// Purpose: Counters and histograms the game keeps while it runs, and
+//			publishes to shared memory so a tool on the same machine can
+//			watch a kiosk without touching the game (Tools/MetricsReader.cpp).
+//
+//			Each thread that counts claims a writer, its own slot of
+//			every counter and histogram on cache lines no other thread
+//			writes.  Only that thread writes the slot, so adding is a
+//			load and a store with no lock and no locked instruction, a
+//			few nanoseconds on the frame path.  A publisher thread adds
+//			the slots up every interval and writes the totals into the
+//			shared segment.
+//
+//			The segment is a fixed layout, MetricsSegment below, that
+//			starts with METRICS_MAGIC and METRICS_VERSION.  The version
+//			goes up whenever the layout changes.  The publisher makes
+//			header.sequence odd while it writes and even again after,
+//			readers copy the segment and try again if the sequence was
+//			odd or changed under them.
+//////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "PongPlatform.h"
+
+#define METRICS_MAGIC		0x4D474E50		// "PNGM"
+#define METRICS_VERSION		1
+
+// Limits, fixed so the segment never changes size
+#define METRICS_MAX_COUNTERS	64
+#define METRICS_MAX_HISTOGRAMS	16
+#define METRICS_MAX_WRITERS		8			// Threads that count
+#define METRICS_NAME_LENGTH		48			// With the terminating 0
+
+// Bucket 0 counts times under 1 us, bucket i times from 2^(i-1) up to
+// 2^i us, the last one everything longer
+#define METRICS_BUCKETS			32
+
+// Shared memory name the game publishes under by default
+#define METRICS_DEFAULT_NAME	"PongMetrics"
+
+enum MetricKind
+{
+	METRIC_COUNTER,						// Only goes up, readers show a rate
+	METRIC_GAUGE						// A level set now and then, e.g. memory held
+};
+
+//////////////////////////////////////////////////////////////////////////
+// The shared segment.  Only fixed size types, laid out with no padding
+// the compiler could add, so 32 and 64 bit builds of the game and the
+// reader agree.
+//////////////////////////////////////////////////////////////////////////
+
+// 64 bytes
+struct MetricsHeader
+{
+	unsigned int		magic;			// METRICS_MAGIC
+	unsigned int		version;		// METRICS_VERSION
+	unsigned int		size;			// sizeof(MetricsSegment)
+	volatile unsigned int	sequence;	// Odd while a publish is being written
+	unsigned int		counterCount;
+	unsigned int		histogramCount;
+	unsigned int		bucketCount;	// METRICS_BUCKETS
+	unsigned int		processId;
+	unsigned long long	publishCount;
+	double				uptime;			// Seconds from Start() to this publish
+	double				interval;		// Seconds between publishes
+	unsigned int		writerCount;	// Threads counting
+	unsigned int		reserved;
+};
+
+// 64 bytes
+struct MetricsCounterEntry
+{
+	char				name[METRICS_NAME_LENGTH];
+	unsigned int		kind;			// MetricKind
+	unsigned int		reserved;
+	unsigned long long	value;
+};
+
+// 320 bytes, times in microseconds
+struct MetricsHistogramEntry
+{
+	char				name[METRICS_NAME_LENGTH];
+	unsigned long long	count;
+	unsigned long long	total;			// Sum of every time recorded
+	unsigned long long	buckets[METRICS_BUCKETS];
+};
+
+struct MetricsSegment
+{
+	MetricsHeader			header;
+	MetricsCounterEntry		counters[METRICS_MAX_COUNTERS];
+	MetricsHistogramEntry	histograms[METRICS_MAX_HISTOGRAMS];
+};
+
+static_assert(sizeof(MetricsHeader) == 64, "MetricsHeader is part of the published layout");
+static_assert(sizeof(MetricsCounterEntry) == 64, "MetricsCounterEntry is part of the published layout");
+static_assert(sizeof(MetricsHistogramEntry) == 320, "MetricsHistogramEntry is part of the published layout");
+
+//////////////////////////////////////////////////////////////////////////
+// Name:		GetMetricsPercentile
+// Parameters:	const MetricsHistogramEntry& histogram - Published times
+//				double percent - 0 to 100
+// Return:		double - Microseconds, the top of the bucket the
+//				percentile falls in, so at most twice the true value
+// Description:	0 for an empty histogram.
+//////////////////////////////////////////////////////////////////////////
+double GetMetricsPercentile(const MetricsHistogramEntry& histogram, double percent);
+
+//////////////////////////////////////////////////////////////////////////
+// One thread's slot, see CMetricsRegistry::GetWriter()
+//////////////////////////////////////////////////////////////////////////
+struct MetricsSlot
+{
+	std::atomic<unsigned long long>	counters[METRICS_MAX_COUNTERS];
+
+	// Count, total then METRICS_BUCKETS buckets for each histogram
+	std::atomic<unsigned long long>	histograms[METRICS_MAX_HISTOGRAMS][METRICS_BUCKETS + 2];
+
+	// Whole cache lines above, this keeps the next slot off the last one
+	char							padding[64];
+};
+
+class CMetricsWriter
+{
+	MetricsSlot*		m_pSlot;		// NULL when every slot was taken, counting does nothing
+
+	static void Add(std::atomic<unsigned long long>& value, unsigned long long amount)
+	{
+		// Nothing else writes the slot, no read-modify-write is needed
+		value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+	}
+
+public:
+	explicit CMetricsWriter(MetricsSlot* slot = 0) : m_pSlot(slot)	{}
+
+	// Adds to a counter from CMetricsRegistry::AddCounter()
+	void Add(int counter, unsigned long long amount = 1)
+	{
+		if(m_pSlot && counter >= 0)
+			Add(m_pSlot->counters[counter], amount);
+	}
+
+	// Sets a gauge from CMetricsRegistry::AddGauge().  The slots are added
+	// up, so only one thread should set each gauge.
+	void Set(int gauge, unsigned long long value)
+	{
+		if(m_pSlot && gauge >= 0)
+			m_pSlot->counters[gauge].store(value, std::memory_order_relaxed);
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Record
+	// Parameters:	int histogram - From CMetricsRegistry::AddHistogram()
+	//				double seconds - Time to count
+	// Return:		void
+	// Description:	Counts the time in its power of two bucket.
+	//////////////////////////////////////////////////////////////////////////
+	void Record(int histogram, double seconds)
+	{
+		if(!m_pSlot || histogram < 0)
+			return;
+		unsigned long long us = seconds > 0.0 ? (unsigned long long)(seconds * 1e6) : 0;
+		int bucket = 0;
+		for(unsigned long long rest = us; rest && bucket < METRICS_BUCKETS - 1; rest >>= 1)
+			++bucket;
+		std::atomic<unsigned long long>* values = m_pSlot->histograms[histogram];
+		Add(values[0], 1);
+		Add(values[1], us);
+		Add(values[2 + bucket], 1);
+	}
+
+	bool IsValid() const	{ return m_pSlot != 0; }
+};
+
+class CMetricsRegistry
+{
+	char						m_CounterNames[METRICS_MAX_COUNTERS][METRICS_NAME_LENGTH];
+	MetricKind					m_CounterKinds[METRICS_MAX_COUNTERS];
+	char						m_HistogramNames[METRICS_MAX_HISTOGRAMS][METRICS_NAME_LENGTH];
+	MetricsSlot					m_Slots[METRICS_MAX_WRITERS];
+
+	// Names are added under the mutex, the counts are stored after the
+	// name so the publisher can read them without it
+	std::mutex					m_Mutex;
+	std::atomic<int>			m_nCounters;
+	std::atomic<int>			m_nHistograms;
+	std::atomic<int>			m_nWriters;
+
+	CMetricsRegistry(const CMetricsRegistry&);
+	CMetricsRegistry& operator=(const CMetricsRegistry&);
+
+	int Add(const char* name, MetricKind kind);
+
+public:
+	CMetricsRegistry(void);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		AddCounter, AddGauge, AddHistogram
+	// Parameters:	const char* name - Shown by the reader, e.g. "game.frames",
+	//					cut to METRICS_NAME_LENGTH - 1 characters
+	// Return:		int - Id to pass to a CMetricsWriter, the same one again
+	//				for a name already added, -1 when the table is full
+	// Description:	Best done once at startup, though adding while the
+	//				publisher runs is safe.
+	//////////////////////////////////////////////////////////////////////////
+	int AddCounter(const char* name)	{ return Add(name, METRIC_COUNTER); }
+	int AddGauge(const char* name)		{ return Add(name, METRIC_GAUGE); }
+	int AddHistogram(const char* name);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		GetWriter
+	// Parameters:	void
+	// Return:		CMetricsWriter - For the calling thread alone
+	// Description:	Claims a slot, once per thread, kept until the registry
+	//				goes.  Past METRICS_MAX_WRITERS the writer counts
+	//				nothing.
+	//////////////////////////////////////////////////////////////////////////
+	CMetricsWriter GetWriter();
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Collect
+	// Parameters:	MetricsSegment& segment - Receives every total, the
+	//					header's counts and names but not its sequence,
+	//					times or publish count
+	// Return:		void
+	// Description:	Adds the slots up.  Writers are not stopped, a total
+	//				is a moment in each slot rather than one moment.
+	//////////////////////////////////////////////////////////////////////////
+	void Collect(MetricsSegment& segment) const;
+
+	int GetCounterCount() const		{ return m_nCounters.load(std::memory_order_acquire); }
+	int GetHistogramCount() const	{ return m_nHistograms.load(std::memory_order_acquire); }
+	int GetWriterCount() const		{ return m_nWriters.load(std::memory_order_acquire); }
+};
+
+struct MetricsDesc
+{
+	const char*			name;			// Shared memory name
+	double				interval;		// Seconds between publishes
+
+	MetricsDesc(void)
+	{
+		name		= METRICS_DEFAULT_NAME;
+		interval	= 1.0;
+	}
+};
+
+class CMetricsPublisher
+{
+	CMetricsRegistry*		m_pRegistry;
+	PlatformSharedMemory	m_Memory;
+	MetricsSegment*			m_pSegment;		// In m_Memory
+	MetricsSegment			m_Collected;	// Added up here, then copied in
+	double					m_fInterval;
+	double					m_fStart;
+	unsigned long long		m_nPublished;
+	int						m_nPublishTime;	// Histogram of Publish() itself
+
+	std::thread				m_Thread;
+	std::mutex				m_Mutex;
+	std::condition_variable	m_Wake;
+	bool					m_bQuit;
+	bool					m_bRunning;
+
+	CMetricsPublisher(const CMetricsPublisher&);
+	CMetricsPublisher& operator=(const CMetricsPublisher&);
+
+	static void PublisherMain(CMetricsPublisher* publisher);
+
+public:
+	CMetricsPublisher(void);
+	~CMetricsPublisher(void);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Start
+	// Parameters:	CMetricsRegistry& registry - Counted into, outlives the
+	//					publisher
+	//				const MetricsDesc& desc - Segment name and interval
+	// Return:		bool - false if the segment could not be created
+	// Description:	Creates the segment, publishes once and starts the
+	//				publisher thread at a low priority.
+	//////////////////////////////////////////////////////////////////////////
+	bool Start(CMetricsRegistry& registry, const MetricsDesc& desc);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Shutdown
+	// Parameters:	void
+	// Return:		void
+	// Description:	Stops the thread and removes the segment.
+	//////////////////////////////////////////////////////////////////////////
+	void Shutdown();
+
+	// Adds the registry up and writes it to the segment now, as the
+	// thread does every interval
+	void Publish();
+
+	bool IsPublishing() const					{ return m_pSegment != 0; }
+	unsigned long long GetPublishCount() const	{ return m_nPublished; }
+};
+
+class CMetricsReader
+{
+	PlatformSharedMemory	m_Memory;
+
+	CMetricsReader(const CMetricsReader&);
+	CMetricsReader& operator=(const CMetricsReader&);
+
+public:
+	CMetricsReader(void)	{}
+	~CMetricsReader(void)	{ Close(); }
+
+	// false if no game is publishing under the name
+	bool Open(const char* name);
+	void Close();
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Read
+	// Parameters:	MetricsSegment& segment - Receives a copy of one whole
+	//					publish
+	// Return:		bool - false if the segment is not this layout or no
+	//				whole publish could be copied after a few tries
+	// Description:	Never waits for the publisher.
+	//////////////////////////////////////////////////////////////////////////
+	bool Read(MetricsSegment& segment);
+
+	bool IsOpen() const		{ return m_Memory.data != 0; }
+};
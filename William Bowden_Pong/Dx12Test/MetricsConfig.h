@@ -0,0 +1,27 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	MetricsConfig.h
+// Date:	October 19th, 2026
+// Purpose: Fills a MetricsDesc from the [Metrics] section of the
+//			settings file (PONG_CONFIG_FILE):
+//				Enabled			1 to publish the game's metrics for
+//								Tools/MetricsReader.cpp
+//				Name			Shared memory name, letters and digits
+//				Interval		Seconds between publishes
+//			Missing keys keep the value already in the MetricsDesc.  The
+//			name points into the config, Start() the publisher before
+//			the config goes.
+//////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "ConfigFile.h"
+#include "Metrics.h"
+
+// Returns [Metrics] Enabled
+inline bool ReadMetricsConfig(const CConfigFile& config, MetricsDesc& desc)
+{
+	desc.name		= config.GetString("Metrics", "Name", desc.name);
+	desc.interval	= config.GetFloat("Metrics", "Interval", (float)desc.interval);
+
+	if(!*desc.name)				desc.name = METRICS_DEFAULT_NAME;
+	if(desc.interval < 0.01)	desc.interval = 0.01;
+	return config.GetBool("Metrics", "Enabled", false);
+}
@@ -0,0 +1,136 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	NetTransport.cpp
+// Date:	October 19th, 2026
+// Purpose: UDP transport, see NetTransport.h.
+//////////////////////////////////////////////////////////////////////////
+#include "NetTransport.h"
+#include <string.h>
+
+#ifdef _WIN32
+	#include <winsock2.h>
+	#include <ws2tcpip.h>
+	#pragma comment(lib, "ws2_32.lib")
+	typedef int socklen_t;
+	#define CloseSocket closesocket
+#else
+	#include <sys/socket.h>
+	#include <netinet/in.h>
+	#include <netdb.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+	typedef int SOCKET;
+	#define INVALID_SOCKET (-1)
+	#define CloseSocket close
+#endif
+
+CUdpTransport::CUdpTransport(void)
+{
+	m_Socket	= (long long)INVALID_SOCKET;
+	m_bStarted	= false;
+	memset(m_PeerAddress, 0, sizeof(m_PeerAddress));
+}
+
+CUdpTransport::~CUdpTransport(void)
+{
+	Close();
+}
+
+bool CUdpTransport::Open(int localPort, const char* peerHost, int peerPort)
+{
+	Close();
+
+#ifdef _WIN32
+	WSADATA data;
+	if(WSAStartup(MAKEWORD(2, 2), &data) != 0)
+		return false;
+	m_bStarted = true;
+#endif
+
+	// The peer, IPv4 only
+	addrinfo hints;
+	memset(&hints, 0, sizeof(hints));
+	hints.ai_family		= AF_INET;
+	hints.ai_socktype	= SOCK_DGRAM;
+	addrinfo* found = 0;
+	if(getaddrinfo(peerHost, 0, &hints, &found) != 0 || !found)
+	{
+		Close();
+		return false;
+	}
+	sockaddr_in peer;
+	memcpy(&peer, found->ai_addr, sizeof(peer));
+	peer.sin_port = htons((unsigned short)peerPort);
+	memcpy(m_PeerAddress, &peer, sizeof(peer));
+	freeaddrinfo(found);
+
+	SOCKET s = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	if(s == INVALID_SOCKET)
+	{
+		Close();
+		return false;
+	}
+	m_Socket = (long long)s;
+
+	sockaddr_in local;
+	memset(&local, 0, sizeof(local));
+	local.sin_family		= AF_INET;
+	local.sin_addr.s_addr	= htonl(INADDR_ANY);
+	local.sin_port			= htons((unsigned short)localPort);
+	if(bind(s, (sockaddr*)&local, sizeof(local)) != 0)
+	{
+		Close();
+		return false;
+	}
+
+	// Send and Receive must never block the frame
+#ifdef _WIN32
+	u_long nonBlocking = 1;
+	ioctlsocket(s, FIONBIO, &nonBlocking);
+#else
+	fcntl(s, F_SETFL, fcntl(s, F_GETFL, 0) | O_NONBLOCK);
+#endif
+	return true;
+}
+
+void CUdpTransport::Close()
+{
+	if(IsOpen())
+		CloseSocket((SOCKET)m_Socket);
+	m_Socket = (long long)INVALID_SOCKET;
+
+#ifdef _WIN32
+	if(m_bStarted)
+		WSACleanup();
+#endif
+	m_bStarted = false;
+}
+
+bool CUdpTransport::IsOpen() const
+{
+	return m_Socket != (long long)INVALID_SOCKET;
+}
+
+bool CUdpTransport::Send(const void* data, int size)
+{
+	if(!IsOpen() || size > NET_MAX_PACKET)
+		return false;
+	return sendto((SOCKET)m_Socket, (const char*)data, size, 0, (const sockaddr*)m_PeerAddress, sizeof(sockaddr_in)) == size;
+}
+
+int CUdpTransport::Receive(void* buffer, int size)
+{
+	if(!IsOpen())
+		return 0;
+
+	const sockaddr_in& peer = *(const sockaddr_in*)m_PeerAddress;
+	for(;;)
+	{
+		sockaddr_in from;
+		socklen_t fromSize = sizeof(from);
+		int received = (int)recvfrom((SOCKET)m_Socket, (char*)buffer, size, 0, (sockaddr*)&from, &fromSize);
+		if(received <= 0)
+			return 0;
+		if(from.sin_addr.s_addr == peer.sin_addr.s_addr && from.sin_port == peer.sin_port)
+			return received;
+	}
+}
@@ -0,0 +1,71 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	NetTransport.h
+// Date:	October 19th, 2026
+// Purpose: Unreliable datagrams between two peers, the only thing the
+//			rollback netcode (Rollback.h) needs from a network.  Packets
+//			may be lost, duplicated or arrive out of order.  CUdpTransport
+//			sends them over UDP with Winsock or BSD sockets, and
+//			CLoopbackLink (LoopbackTransport.h) passes them between two
+//			sessions in one process.
+//////////////////////////////////////////////////////////////////////////
+#pragma once
+
+// Largest packet either transport carries
+#define NET_MAX_PACKET 512
+
+class CNetTransport
+{
+public:
+	virtual ~CNetTransport(void) {}
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Send
+	// Parameters:	const void* data - Packet to send
+	//				int size - Bytes, at most NET_MAX_PACKET
+	// Return:		bool - false if it could not be sent at all, a packet
+	//				lost on the way still returns true
+	// Description:	Never blocks.
+	//////////////////////////////////////////////////////////////////////////
+	virtual bool Send(const void* data, int size) = 0;
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Receive
+	// Parameters:	void* buffer - Receives the next packet
+	//				int size - Size of buffer
+	// Return:		int - Bytes received, 0 when no packet is waiting
+	// Description:	Never blocks, call until it returns 0.
+	//////////////////////////////////////////////////////////////////////////
+	virtual int Receive(void* buffer, int size) = 0;
+};
+
+class CUdpTransport : public CNetTransport
+{
+	// A SOCKET on Windows, a file descriptor elsewhere
+	long long			m_Socket;
+	unsigned char		m_PeerAddress[16];	// sockaddr_in of the peer
+	bool				m_bStarted;			// Winsock started by Open()
+
+	CUdpTransport(const CUdpTransport&);
+	CUdpTransport& operator=(const CUdpTransport&);
+
+public:
+	CUdpTransport(void);
+	~CUdpTransport(void);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Open
+	// Parameters:	int localPort - Port to receive on
+	//				const char* peerHost - Name or IPv4 address of the peer
+	//				int peerPort - Port the peer receives on
+	// Return:		bool - false if the socket could not be bound or the
+	//				peer's name did not resolve
+	// Description:	Packets from anyone but the peer are dropped.
+	//////////////////////////////////////////////////////////////////////////
+	bool Open(int localPort, const char* peerHost, int peerPort);
+	void Close();
+
+	bool IsOpen() const;
+
+	virtual bool Send(const void* data, int size);
+	virtual int Receive(void* buffer, int size);
+};
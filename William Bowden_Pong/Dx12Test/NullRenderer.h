@@ -0,0 +1,114 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	NullRenderer.h
+// Date:	October 19th, 2026
+// Purpose: Renderer backend that draws nothing.  Used for simulation
+//			benchmarks and headless runs, it only counts the work it was
+//			asked to do.  With a capture set each frame is the clear
+//			colour, so capture can be timed without a rasteriser.
+//			See Renderer.h for the backend interface.
+//////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "RenderTypes.h"
+#include "ImageFile.h"
+#include "FrameCapture.h"
+#include <stdlib.h>
+#include <vector>
+
+class CNullRenderer
+{
+	int					m_nTextures;
+	int					m_nFrames;
+	int					m_nSprites;
+	int					m_nBatches;		// DrawSprites() calls
+	int					m_nText;
+	unsigned int		m_ClearColor;
+	CFrameCapture*		m_pCapture;
+	std::vector<unsigned int>	m_CaptureRow;	// One row of the clear colour
+
+public:
+	CNullRenderer(void)
+		: m_nTextures(0), m_nFrames(0), m_nSprites(0), m_nBatches(0), m_nText(0), m_ClearColor(0),
+		  m_pCapture(0)
+	{
+	}
+
+	bool Init(const RendererDesc& desc)
+	{
+		(void)desc;
+		return true;
+	}
+
+	void Shutdown()
+	{
+		m_pCapture = 0;
+	}
+
+	// Only the header is read, so sprite sizes match the other backends
+	bool LoadTexture(const wchar_t* fileName, SpriteTexture& texture)
+	{
+		char path[260];
+		wcstombs(path, fileName, sizeof(path));
+		path[sizeof(path) - 1] = 0;
+
+		texture.id = m_nTextures++;
+		if(!ReadImageSize(path, texture.width, texture.height))
+		{
+			texture.width = texture.height = 0;
+			return false;
+		}
+		return true;
+	}
+
+	bool UpdateTexture(SpriteImage& image, SpriteTexture& texture)
+	{
+		texture.width	= image.width;
+		texture.height	= image.height;
+		return true;
+	}
+
+	void BeginFrame(unsigned int clearColor)
+	{
+		m_ClearColor = clearColor;
+	}
+
+	void DrawSprite(const SpriteTexture& texture, float x, float y, float scale, unsigned int color)
+	{
+		(void)texture; (void)x; (void)y; (void)scale; (void)color;
+		++m_nSprites;
+	}
+
+	void DrawSprites(const SpriteTexture& texture, const SpriteBatch& batch)
+	{
+		(void)texture;
+		m_nSprites += batch.count;
+		++m_nBatches;
+	}
+
+	void DrawString(const wchar_t* text, int x, int y, unsigned int color)
+	{
+		(void)text; (void)x; (void)y; (void)color;
+		++m_nText;
+	}
+
+	void EndFrame()
+	{
+		if(m_pCapture)
+		{
+			// Every row is the same row, a pitch of 0 repeats it
+			m_CaptureRow.assign(m_pCapture->GetWidth(), m_ClearColor);
+			m_pCapture->Capture(&m_CaptureRow[0], 0, m_nFrames);
+		}
+		++m_nFrames;
+	}
+
+	bool SetCapture(CFrameCapture* capture)
+	{
+		m_pCapture = capture;
+		return true;
+	}
+
+	int GetFrameCount() const	{ return m_nFrames; }
+	int GetSpriteCount() const	{ return m_nSprites; }
+	int GetBatchCount() const	{ return m_nBatches; }
+	int GetTextCount() const	{ return m_nText; }
+};
@@ -0,0 +1,162 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	ObjectPool.h
+// Date:	October 19th, 2026
+// Purpose: Fixed capacity storage for long lived game objects such as
+//			balls, sounds and effects.  The objects live inside the pool,
+//			so creating and destroying them never touches the heap, and
+//			a full pool fails the create instead of growing.
+//////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <new>
+#include <type_traits>
+#include "PongPlatform.h"
+
+struct ObjectPoolStats
+{
+	int					capacity;
+	int					live;			// Objects alive now
+	int					peak;			// Most objects alive at once
+	int					failed;			// Creates refused because the pool was full
+};
+
+template<class T, int N>
+class CObjectPool
+{
+	typedef typename std::aligned_storage<sizeof(T), __alignof(T)>::type Storage;
+
+	Storage				m_Objects[N];
+	int					m_Next[N];		// Free list links, -1 ends the list
+	bool				m_bAlive[N];
+	int					m_nFree;		// First free slot, -1 when full
+	int					m_nLive;
+
+#ifdef PONG_MEMORY_STATS
+	int					m_nPeak;
+	int					m_nFailed;
+#endif
+
+	// Not copyable, the objects are constructed in place
+	CObjectPool(const CObjectPool&);
+	CObjectPool& operator=(const CObjectPool&);
+
+	// Slot for a new object, -1 if the pool is full
+	int TakeSlot()
+	{
+		int slot = m_nFree;
+		if(slot < 0)
+		{
+#ifdef PONG_MEMORY_STATS
+			++m_nFailed;
+#endif
+			return -1;
+		}
+		m_nFree = m_Next[slot];
+		m_bAlive[slot] = true;
+		++m_nLive;
+#ifdef PONG_MEMORY_STATS
+		if(m_nLive > m_nPeak)
+			m_nPeak = m_nLive;
+#endif
+		return slot;
+	}
+
+public:
+	CObjectPool(void)
+	{
+		for(int i = 0; i < N; ++i)
+		{
+			m_Next[i] = i + 1 < N ? i + 1 : -1;
+			m_bAlive[i] = false;
+		}
+		m_nFree = 0;
+		m_nLive = 0;
+#ifdef PONG_MEMORY_STATS
+		m_nPeak = 0;
+		m_nFailed = 0;
+#endif
+	}
+
+	~CObjectPool(void)
+	{
+		Clear();
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Create
+	// Parameters:	const T& value - Object to copy, or none to default
+	//					construct
+	// Return:		T* - The new object, NULL if the pool is full
+	// Description:	Constructs an object in a free slot.
+	//////////////////////////////////////////////////////////////////////////
+	T* Create()
+	{
+		int slot = TakeSlot();
+		return slot < 0 ? 0 : new(&m_Objects[slot]) T();
+	}
+
+	T* Create(const T& value)
+	{
+		int slot = TakeSlot();
+		return slot < 0 ? 0 : new(&m_Objects[slot]) T(value);
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Destroy
+	// Parameters:	T* object - Object returned by Create
+	// Return:		void
+	// Description:	Destructs the object and frees its slot.  Pointers from
+	//				other pools and NULL are ignored.
+	//////////////////////////////////////////////////////////////////////////
+	void Destroy(T* object)
+	{
+		int slot = IndexOf(object);
+		if(slot < 0 || !m_bAlive[slot])
+			return;
+		object->~T();
+		m_bAlive[slot] = false;
+		m_Next[slot] = m_nFree;
+		m_nFree = slot;
+		--m_nLive;
+	}
+
+	// Destroys every live object
+	void Clear()
+	{
+		for(int i = 0; i < N; ++i)
+		{
+			if(m_bAlive[i])
+				Destroy(Get(i));
+		}
+	}
+
+	// Slot index of an object, -1 if it is not from this pool
+	int IndexOf(const T* object) const
+	{
+		const Storage* storage = (const Storage*)object;
+		if(storage < m_Objects || storage >= m_Objects + N)
+			return -1;
+		return (int)(storage - m_Objects);
+	}
+
+	// Slots are visited with for(i = 0; i < GetCapacity(); ++i) if(IsAlive(i))
+	bool IsAlive(int index) const	{ return m_bAlive[index]; }
+	T* Get(int index)				{ return (T*)&m_Objects[index]; }
+	const T* Get(int index) const	{ return (const T*)&m_Objects[index]; }
+	int GetCount() const			{ return m_nLive; }
+	int GetCapacity() const			{ return N; }
+	bool IsFull() const				{ return m_nFree < 0; }
+
+	// peak and failed are only counted with PONG_MEMORY_STATS
+	void GetStats(ObjectPoolStats& stats) const
+	{
+		stats.capacity	= N;
+		stats.live		= m_nLive;
+#ifdef PONG_MEMORY_STATS
+		stats.peak		= m_nPeak;
+		stats.failed	= m_nFailed;
+#else
+		stats.peak		= 0;
+		stats.failed	= 0;
+#endif
+	}
+};
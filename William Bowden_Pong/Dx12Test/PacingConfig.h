@@ -0,0 +1,42 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	PacingConfig.h
+// Date:	October 19th, 2026
+// Purpose: Fills a FramePacingDesc from the [Video] section of the
+//			settings file (PONG_CONFIG_FILE):
+//				Pacing			Uncapped, VSync, Capped or Adaptive.  When
+//								missing, VSync = 1 picks VSync.
+//				MaxFPS			Frames a second for Capped
+//				IdleFPS			Frames a second on the menus, 0 for the
+//								mode's own rate
+//				RefreshRate		Display refreshes a second, for a display
+//								that reports its own wrongly
+//				TickRate		Match ticks a second, 0 for one a frame
+//			Missing keys keep the value already in the FramePacingDesc.
+//////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "ConfigFile.h"
+#include "FramePacer.h"
+
+// A stall longer than this many seconds is skipped rather than ticked
+#define PACING_MAX_CATCH_UP 0.25
+
+inline void ReadPacingConfig(const CConfigFile& config, FramePacingDesc& desc)
+{
+	const char* mode = config.GetString("Video", "Pacing", "");
+	if(*mode)
+		desc.mode = ParsePacingMode(mode, desc.mode);
+	else if(config.GetBool("Video", "VSync", false))
+		desc.mode = PACING_VSYNC;
+
+	desc.maxFps			= config.GetFloat("Video", "MaxFPS", (float)desc.maxFps);
+	desc.idleFps		= config.GetFloat("Video", "IdleFPS", (float)desc.idleFps);
+	desc.refreshRate	= config.GetFloat("Video", "RefreshRate", (float)desc.refreshRate);
+	desc.tickRate		= config.GetFloat("Video", "TickRate", (float)desc.tickRate);
+
+	if(desc.maxFps < 1.0)		desc.maxFps = 1.0;
+	if(desc.refreshRate < 1.0)	desc.refreshRate = 60.0;
+	if(desc.idleFps < 0.0)		desc.idleFps = 0.0;
+	if(desc.tickRate < 0.0)		desc.tickRate = 0.0;
+	desc.maxTicks = (int)(desc.tickRate * PACING_MAX_CATCH_UP);
+	if(desc.maxTicks < 1)		desc.maxTicks = 1;
+}
@@ -0,0 +1,224 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	PaddleAI.cpp
+// Date:	October 19th, 2026
+// Purpose: Computer player, see PaddleAI.h.
+//////////////////////////////////////////////////////////////////////////
+#include "PaddleAI.h"
+#include "PongPhysics.h"
+#include <math.h>
+#include <ctype.h>
+
+AISettings GetAISettings(AIDifficulty difficulty)
+{
+	// The ball takes about 12000 ticks to cross the playfield and the
+	// paddle moves as fast as the ball does vertically, so a late or
+	// wrong plan can be too late to recover from
+	AISettings settings;
+	switch(difficulty)
+	{
+	case AI_EASY:
+		settings.reactionTicks	= 3000;
+		settings.error			= 70.0f;
+		settings.deadZone		= 20.0f;
+		settings.anticipate		= false;
+		break;
+	case AI_NORMAL:
+		settings.reactionTicks	= 1200;
+		settings.error			= 35.0f;
+		settings.deadZone		= 10.0f;
+		settings.anticipate		= false;
+		break;
+	default:
+		settings.reactionTicks	= 0;
+		settings.error			= 0.0f;
+		settings.deadZone		= 2.0f;
+		settings.anticipate		= true;
+		break;
+	}
+	return settings;
+}
+
+AIDifficulty ParseAIDifficulty(const char* name, AIDifficulty def)
+{
+	static const char* names[] = { "easy", "normal", "hard" };
+	for(int i = 0; i < 3; ++i)
+	{
+		const char* a = name;
+		const char* b = names[i];
+		while(*a && tolower((unsigned char)*a) == *b)
+		{
+			++a;
+			++b;
+		}
+		if(*a == 0 && *b == 0)
+			return (AIDifficulty)i;
+	}
+	return def;
+}
+
+float FoldIntoRange(float y, float top, float bottom)
+{
+	float span = bottom - top;
+	if(span <= 0.0f)
+		return top;
+
+	// One period is down and back up again
+	float period = 2.0f * span;
+	float u = fmodf(y - top, period);
+	if(u < 0.0f)
+		u += period;
+	return u <= span ? top + u : top + period - u;
+}
+
+float PredictBallY(float x, float y, float dx, float dy, float targetX, float top, float bottom)
+{
+	if(dx == 0.0f)
+		return y;
+
+	float ticks = (targetX - x) / dx;
+	if(ticks < 0.0f)
+		ticks = 0.0f;
+	return FoldIntoRange(y + dy * ticks, top, bottom);
+}
+
+CPaddleAI::CPaddleAI(void)
+{
+	Init(1, GetAISettings(AI_NORMAL), 1);
+}
+
+void CPaddleAI::Init(int paddle, const AISettings& settings, unsigned int seed)
+{
+	m_nPaddle		= paddle;
+	m_Settings		= settings;
+	m_nSeed			= seed ? seed : 1;
+	m_fLastDx		= 0.0f;
+	m_nLastPoints	= -1;
+	m_nDelay		= 0;
+	m_bPlanned		= false;
+	m_fTarget		= PLAYFIELD_HEIGHT * 0.5f;
+}
+
+float CPaddleAI::Random()
+{
+	// -1 to 1, from a small LCG so every AI has its own repeatable stream
+	m_nSeed = m_nSeed * 1664525u + 1013904223u;
+	return (float)(m_nSeed >> 8) / (float)(1 << 23) - 1.0f;
+}
+
+// Most ball steps PlanInArena() takes, several crossings of the playfield
+#define AI_ARENA_STEPS 200000
+
+//////////////////////////////////////////////////////////////////////////
+// Name:		PlanInArena
+// Parameters:	const CPongGame& game - Match with an arena
+//				float nearX, farX - Lines the ball turns at in front of
+//					this paddle and the other
+//				float& y - Receives the height the ball reaches nearX at
+// Return:		bool - false if it never gets there, trapped among the
+//				obstacles
+// Description:	Steps a copy of the ball as StepBall() does, with the
+//				paddles out of the way.  Reaching farX the other player
+//				is assumed to return it.
+//////////////////////////////////////////////////////////////////////////
+bool CPaddleAI::PlanInArena(const CPongGame& game, float nearX, float farX, float& y) const
+{
+	PongState match;
+	game.SaveState(match);
+	match.Paddle[0].yp = -(float)PLAYFIELD_HEIGHT;
+	match.Paddle[1].yp = -(float)PLAYFIELD_HEIGHT;
+	const PongTuning& tuning = game.GetTuning();
+	int toward = m_nPaddle == 0 ? -1 : 1;
+	for(int step = 0; step < AI_ARENA_STEPS; ++step)
+	{
+		StepBall(match, tuning.ballSpeedX, tuning.ballSpeedY, (CGameEventBuffer*)0, game.GetArena());
+
+		int signX, signY;
+		GetBallDirection(match.Ball, signX, signY);
+		if(signX == toward && (match.Ball.xp - nearX) * toward >= 0.0f)
+		{
+			y = match.Ball.yp;
+			return true;
+		}
+		if(signX != toward && (farX - match.Ball.xp) * toward >= 0.0f)
+			SetBallDirection(match.Ball, -signX, signY);
+	}
+	return false;
+}
+
+float CPaddleAI::Plan(const CPongGame& game, float dx, float dy)
+{
+	const float top		= (float)BALL_WALL_MARGIN;
+	const float bottom	= (float)(PLAYFIELD_HEIGHT - BALL_WALL_MARGIN);
+
+	// Lines the ball turns at, in front of each paddle
+	float nearX	= m_nPaddle == 0 ? game.Paddle[0].xp + PADDLE_REACH : game.Paddle[1].xp - PADDLE_REACH;
+	float farX	= m_nPaddle == 0 ? game.Paddle[1].xp - PADDLE_REACH : game.Paddle[0].xp + PADDLE_REACH;
+
+	bool approaching = m_nPaddle == 0 ? dx < 0.0f : dx > 0.0f;
+	float y;
+	const CArena* arena = game.GetArena();
+	if(arena && !arena->IsEmpty() && (approaching || m_Settings.anticipate)
+		&& PlanInArena(game, nearX, farX, y))
+	{
+		return y + m_Settings.error * Random();
+	}
+
+	if(approaching)
+	{
+		y = PredictBallY(game.Ball.xp, game.Ball.yp, dx, dy, nearX, top, bottom);
+	}
+	else if(m_Settings.anticipate)
+	{
+		// Unfold the far paddle too: going on to farX and back to nearX is
+		// the same distance as going straight on to nearX mirrored in farX.
+		// Assumes the other player returns it.
+		y = PredictBallY(game.Ball.xp, game.Ball.yp, dx, dy, 2.0f * farX - nearX, top, bottom);
+	}
+	else
+	{
+		return PLAYFIELD_HEIGHT * 0.5f;
+	}
+
+	return y + m_Settings.error * Random();
+}
+
+int CPaddleAI::Think(const CPongGame& game)
+{
+	if(!game.Menu.onGAME)
+		return 0;
+
+	float dx, dy;
+	game.GetBallVelocity(dx, dy);
+
+	// Wall bounces are already part of the prediction, only a paddle hit
+	// or a point (the ball is served again) needs a new plan
+	int points = game.Player1Point + game.Player2Point;
+	if(dx != m_fLastDx || points != m_nLastPoints)
+	{
+		m_fLastDx		= dx;
+		m_nLastPoints	= points;
+		m_nDelay		= m_Settings.reactionTicks;
+		m_bPlanned		= false;
+	}
+
+	if(!m_bPlanned)
+	{
+		if(m_nDelay > 0)
+		{
+			--m_nDelay;
+		}
+		else
+		{
+			m_fTarget	= Plan(game, dx, dy);
+			m_bPlanned	= true;
+		}
+	}
+
+	// Steer towards the plan, still heading for the old one while reacting
+	float paddleY = game.Paddle[m_nPaddle].yp;
+	if(m_fTarget > paddleY + m_Settings.deadZone)
+		return m_nPaddle == 0 ? S_DOWN : ARROW_DOWN;
+	if(m_fTarget < paddleY - m_Settings.deadZone)
+		return m_nPaddle == 0 ? W_UP : ARROW_UP;
+	return 0;
+}
@@ -0,0 +1,110 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	PaddleAI.h
+// Date:	October 19th, 2026
+// Purpose: Computer player for either paddle.  Where the ball will cross
+//			the paddle is solved in closed form by unfolding the bounces:
+//			the ball travels in a straight line through mirrored copies of
+//			the playfield, and the crossing point is folded back into the
+//			real one.  One prediction is a divide and an fmod, not a
+//			stepped simulation.  Arena obstacles (Arena.h) cannot be
+//			unfolded, with an arena the ball is stepped through it
+//			instead.  The AI answers with the same key flags a player
+//			would press, so the game cannot tell them apart.
+//////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "PongGame.h"
+
+enum AIDifficulty
+{
+	AI_EASY,
+	AI_NORMAL,
+	AI_HARD
+};
+
+struct AISettings
+{
+	int					reactionTicks;	// Ticks before the AI notices the ball turned
+	float				error;			// Largest aiming error either side, pixels
+	float				deadZone;		// Close enough to the target to stop moving
+	bool				anticipate;		// Also predict the return while the ball
+										// moves away, instead of centring
+};
+
+//////////////////////////////////////////////////////////////////////////
+// Name:		GetAISettings
+// Parameters:	AIDifficulty difficulty - Preset to return
+// Return:		AISettings - Reaction delay and error for the preset
+// Description:	The presets, tuned against the game's speeds.
+//////////////////////////////////////////////////////////////////////////
+AISettings GetAISettings(AIDifficulty difficulty);
+
+// "Easy", "Normal" or "Hard" in any case, def for anything else
+AIDifficulty ParseAIDifficulty(const char* name, AIDifficulty def);
+
+//////////////////////////////////////////////////////////////////////////
+// Name:		FoldIntoRange
+// Parameters:	float y - Position along an unfolded path
+//				float top, bottom - Walls the path reflects off
+// Return:		float - The same point in the real playfield
+// Description:	Maps a straight path through mirrored copies of [top,
+//				bottom] back into it.
+//////////////////////////////////////////////////////////////////////////
+float FoldIntoRange(float y, float top, float bottom);
+
+//////////////////////////////////////////////////////////////////////////
+// Name:		PredictBallY
+// Parameters:	float x, y - Ball position
+//				float dx, dy - Ball velocity
+//				float targetX - Line to predict the crossing of
+//				float top, bottom - Walls the ball reflects off
+// Return:		float - Height the ball crosses targetX at, y if the ball
+//				is not moving across
+// Description:	Closed form, the cost does not depend on the number of
+//				wall bounces.
+//////////////////////////////////////////////////////////////////////////
+float PredictBallY(float x, float y, float dx, float dy, float targetX, float top, float bottom);
+
+class CPaddleAI
+{
+	int					m_nPaddle;		// 0 left (W/S), 1 right (arrows)
+	AISettings			m_Settings;
+	unsigned int		m_nSeed;		// Aiming error random state
+	float				m_fLastDx;		// Ball direction and score the plan was
+	int					m_nLastPoints;	// made for, a change means re-plan
+	int					m_nDelay;		// Reaction ticks left before re-planning
+	bool				m_bPlanned;
+	float				m_fTarget;		// Height the paddle is heading for
+
+	float Plan(const CPongGame& game, float dx, float dy);
+	bool PlanInArena(const CPongGame& game, float nearX, float farX, float& y) const;
+	float Random();
+
+public:
+	CPaddleAI(void);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Init
+	// Parameters:	int paddle - 0 for the left paddle, 1 for the right
+	//				const AISettings& settings - Difficulty
+	//				unsigned int seed - Aiming error seed, the same seed
+	//					gives the same game
+	// Return:		void
+	// Description:	Forgets any plan, call when a match starts.
+	//////////////////////////////////////////////////////////////////////////
+	void Init(int paddle, const AISettings& settings, unsigned int seed);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Think
+	// Parameters:	const CPongGame& game - Current state
+	// Return:		int - Key flags to hold this tick for this paddle
+	// Description:	Re-plans after the reaction delay when the ball turns
+	//				or a point is scored, then steers towards the plan.
+	//////////////////////////////////////////////////////////////////////////
+	int Think(const CPongGame& game);
+
+	int GetPaddle() const		{ return m_nPaddle; }
+	float GetTarget() const		{ return m_fTarget; }
+
+	// Key flags the paddle is moved with
+	static int GetPaddleKeys(int paddle)	{ return paddle == 0 ? (W_UP | S_DOWN) : (ARROW_UP | ARROW_DOWN); }
+};
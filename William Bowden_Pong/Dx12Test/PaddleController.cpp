@@ -0,0 +1,228 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	PaddleController.cpp
+// Date:	October 19th, 2026
+// Purpose: Paddle controllers, see PaddleController.h.
+//////////////////////////////////////////////////////////////////////////
+#include "PaddleController.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+namespace
+{
+	bool SameText(const std::string& a, const char* b)
+	{
+		size_t i = 0;
+		for(; i < a.size() && b[i]; ++i)
+			if(tolower((unsigned char)a[i]) != tolower((unsigned char)b[i]))
+				return false;
+		return i == a.size() && b[i] == 0;
+	}
+
+	bool StartsWith(const char* text, const char* prefix, const char*& rest)
+	{
+		size_t length = strlen(prefix);
+		for(size_t i = 0; i < length; ++i)
+			if(tolower((unsigned char)text[i]) != prefix[i])
+				return false;
+		rest = text + length;
+		return true;
+	}
+
+	// A preset name, or false for anything ParseAIDifficulty() does not know
+	bool ParsePreset(const std::string& name, AISettings& settings)
+	{
+		AIDifficulty difficulty = ParseAIDifficulty(name.c_str(), AI_EASY);
+		if(difficulty != ParseAIDifficulty(name.c_str(), AI_HARD))
+			return false;
+		settings = GetAISettings(difficulty);
+		return true;
+	}
+
+	// Comma separated presets and key=value overrides, applied in order
+	bool ParseAISettings(const char* text, AISettings& settings)
+	{
+		settings = GetAISettings(AI_NORMAL);
+		std::string list(text);
+		size_t start = 0;
+		while(start <= list.size())
+		{
+			size_t end = list.find(',', start);
+			if(end == std::string::npos)
+				end = list.size();
+			std::string item = list.substr(start, end - start);
+			start = end + 1;
+			if(item.empty())
+				continue;
+
+			size_t equals = item.find('=');
+			if(equals == std::string::npos)
+			{
+				if(!ParsePreset(item, settings))
+					return false;
+				continue;
+			}
+
+			std::string key = item.substr(0, equals);
+			const char* value = item.c_str() + equals + 1;
+			if(SameText(key, "reaction"))			settings.reactionTicks	= atoi(value);
+			else if(SameText(key, "error"))			settings.error			= (float)atof(value);
+			else if(SameText(key, "deadzone"))		settings.deadZone		= (float)atof(value);
+			else if(SameText(key, "anticipate"))	settings.anticipate		= atoi(value) != 0;
+			else
+				return false;
+		}
+		return true;
+	}
+}
+
+bool ParseController(const char* spec, ControllerDesc& desc)
+{
+	desc.name = spec;
+	desc.runs.clear();
+	desc.ai = GetAISettings(AI_NORMAL);
+
+	const char* rest;
+	if(StartsWith(spec, "script:", rest))
+	{
+		desc.type = CONTROLLER_INPUTS;
+		return ParseInputRuns(rest, desc.runs);
+	}
+	if(StartsWith(spec, "replay:", rest))
+	{
+		desc.type = CONTROLLER_INPUTS;
+		return LoadInputRuns(rest, desc.runs);
+	}
+
+	desc.type = CONTROLLER_AI;
+	if(StartsWith(spec, "ai:", rest))
+		return ParseAISettings(rest, desc.ai);
+	return ParsePreset(spec, desc.ai);
+}
+
+bool ParseInputRuns(const char* text, std::vector<InputRun>& runs)
+{
+	runs.clear();
+	const char* p = text;
+	for(;;)
+	{
+		while(isspace((unsigned char)*p))
+			++p;
+		if(*p == 0)
+			break;
+
+		InputRun run;
+		switch(toupper((unsigned char)*p))
+		{
+		case 'U':	run.inputs = INPUT_UP;					break;
+		case 'D':	run.inputs = INPUT_DOWN;				break;
+		case 'B':	run.inputs = INPUT_UP | INPUT_DOWN;		break;
+		case '-':	run.inputs = 0;							break;
+		default:	return false;
+		}
+
+		char* end;
+		long ticks = strtol(p + 1, &end, 10);
+		if(end == p + 1 || ticks <= 0)
+			return false;
+		run.ticks = (int)ticks;
+		runs.push_back(run);
+		p = end;
+	}
+	return !runs.empty();
+}
+
+bool LoadInputRuns(const char* fileName, std::vector<InputRun>& runs)
+{
+	FILE* file = fopen(fileName, "r");
+	if(!file)
+		return false;
+
+	std::string text;
+	char buffer[1024];
+	size_t read;
+	while((read = fread(buffer, 1, sizeof(buffer), file)) > 0)
+		text.append(buffer, read);
+	fclose(file);
+
+	return ParseInputRuns(text.c_str(), runs);
+}
+
+bool SaveInputRuns(const char* fileName, const std::vector<InputRun>& runs)
+{
+	FILE* file = fopen(fileName, "w");
+	if(!file)
+		return false;
+
+	static const char letters[] = { '-', 'U', 'D', 'B' };
+	for(size_t i = 0; i < runs.size(); ++i)
+		fprintf(file, "%c%d\n", letters[runs[i].inputs & 3], runs[i].ticks);
+
+	return fclose(file) == 0;
+}
+
+void AppendInput(std::vector<InputRun>& runs, int inputs)
+{
+	if(!runs.empty() && runs.back().inputs == inputs)
+	{
+		++runs.back().ticks;
+		return;
+	}
+	InputRun run;
+	run.ticks	= 1;
+	run.inputs	= inputs;
+	runs.push_back(run);
+}
+
+int GetPaddleInputs(int paddle, int keys)
+{
+	int up		= paddle == 0 ? W_UP : ARROW_UP;
+	int down	= paddle == 0 ? S_DOWN : ARROW_DOWN;
+	return ((keys & up) ? INPUT_UP : 0) | ((keys & down) ? INPUT_DOWN : 0);
+}
+
+int GetInputKeys(int paddle, int inputs)
+{
+	int keys = 0;
+	if(inputs & INPUT_UP)	keys |= paddle == 0 ? W_UP : ARROW_UP;
+	if(inputs & INPUT_DOWN)	keys |= paddle == 0 ? S_DOWN : ARROW_DOWN;
+	return keys;
+}
+
+CPaddleController::CPaddleController(void)
+{
+	m_pDesc		= 0;
+	m_nPaddle	= 0;
+	m_nRun		= 0;
+	m_nRunTick	= 0;
+}
+
+void CPaddleController::Init(const ControllerDesc& desc, int paddle, unsigned int seed)
+{
+	m_pDesc		= &desc;
+	m_nPaddle	= paddle;
+	m_nRun		= 0;
+	m_nRunTick	= 0;
+	m_AI.Init(paddle, desc.ai, seed);
+}
+
+int CPaddleController::Think(const CPongGame& game)
+{
+	if(!m_pDesc)
+		return 0;
+	if(m_pDesc->type == CONTROLLER_AI)
+		return m_AI.Think(game);
+
+	const std::vector<InputRun>& runs = m_pDesc->runs;
+	if(runs.empty())
+		return 0;
+
+	int inputs = runs[m_nRun].inputs;
+	if(++m_nRunTick >= runs[m_nRun].ticks)
+	{
+		m_nRunTick = 0;
+		m_nRun = (m_nRun + 1) % runs.size();
+	}
+	return GetInputKeys(m_nPaddle, inputs);
+}
@@ -0,0 +1,105 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	PaddleController.h
+// Date:	October 19th, 2026
+// Purpose: Anything that can hold a paddle's keys: the AI with a preset
+//			or hand tuned settings, or a fixed list of inputs that loops,
+//			written inline as a script or recorded to a replay file.
+//			Controllers are described by a short spec string so tools can
+//			take them on the command line:
+//				hard						AI preset
+//				ai:normal,error=10			preset with settings changed
+//				script:U2000 D2000 -500		held up, down, then nothing
+//				replay:left.txt				inputs saved by SaveInputRuns()
+//////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <string>
+#include <vector>
+#include "PaddleAI.h"
+
+//Paddle independent inputs, turned into W/S or arrow keys for the paddle
+#define INPUT_UP 0x01
+#define INPUT_DOWN 0x02
+
+// Inputs held for a number of ticks
+struct InputRun
+{
+	int					ticks;
+	int					inputs;			// INPUT_UP / INPUT_DOWN
+};
+
+enum ControllerType
+{
+	CONTROLLER_AI,
+	CONTROLLER_INPUTS
+};
+
+struct ControllerDesc
+{
+	std::string				name;		// The spec it was parsed from
+	ControllerType			type;
+	AISettings				ai;			// CONTROLLER_AI
+	std::vector<InputRun>	runs;		// CONTROLLER_INPUTS, played in a loop
+};
+
+//////////////////////////////////////////////////////////////////////////
+// Name:		ParseController
+// Parameters:	const char* spec - See the top of this file
+//				ControllerDesc& desc - Receives the controller
+// Return:		bool - false if the spec is not understood or the replay
+//				file could not be read
+// Description:	Replay files are read here, not when matches start.
+//////////////////////////////////////////////////////////////////////////
+bool ParseController(const char* spec, ControllerDesc& desc);
+
+//////////////////////////////////////////////////////////////////////////
+// Name:		ParseInputRuns
+// Parameters:	const char* text - Runs separated by spaces or new lines,
+//					each U (up), D (down), B (both) or - (none) followed
+//					by a tick count
+//				std::vector<InputRun>& runs - Receives the runs
+// Return:		bool - false on a malformed run or if there are none
+// Description:	The text format used by scripts and replay files.
+//////////////////////////////////////////////////////////////////////////
+bool ParseInputRuns(const char* text, std::vector<InputRun>& runs);
+
+// Reads and writes replay files, one run per line
+bool LoadInputRuns(const char* fileName, std::vector<InputRun>& runs);
+bool SaveInputRuns(const char* fileName, const std::vector<InputRun>& runs);
+
+// Adds one tick of inputs, extending the last run when they are the same
+void AppendInput(std::vector<InputRun>& runs, int inputs);
+
+// Converts between key flags and paddle independent inputs
+int GetPaddleInputs(int paddle, int keys);
+int GetInputKeys(int paddle, int inputs);
+
+class CPaddleController
+{
+	const ControllerDesc*	m_pDesc;
+	int						m_nPaddle;
+	CPaddleAI				m_AI;
+	size_t					m_nRun;			// Input run being played
+	int						m_nRunTick;		// Ticks of it played so far
+
+public:
+	CPaddleController(void);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Init
+	// Parameters:	const ControllerDesc& desc - Controller to play, kept by
+	//					pointer so it must outlive this object
+	//				int paddle - 0 for the left paddle, 1 for the right
+	//				unsigned int seed - Passed on to the AI
+	// Return:		void
+	// Description:	Call when a match starts, inputs play from the top.
+	//////////////////////////////////////////////////////////////////////////
+	void Init(const ControllerDesc& desc, int paddle, unsigned int seed);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Think
+	// Parameters:	const CPongGame& game - Current state
+	// Return:		int - Key flags to hold this tick for this paddle
+	// Description:	Call once per tick.
+	//////////////////////////////////////////////////////////////////////////
+	int Think(const CPongGame& game);
+};
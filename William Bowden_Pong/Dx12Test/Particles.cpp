@@ -0,0 +1,362 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	Particles.cpp
+// Date:	October 19th, 2026
+// Purpose: CPU particle effects, see Particles.h.
+//////////////////////////////////////////////////////////////////////////
+#include "Particles.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__SSE2__)
+	#define PARTICLES_SSE2
+	#include <emmintrin.h>
+#endif
+
+// Fraction of its speed a particle loses per second
+#define PARTICLE_DRAG 2.0f
+
+// Most trail particles laid down in one tick, after a long stall
+#define PARTICLE_MAX_TRAIL 8
+
+static const float PI = 3.14159265f;
+
+static const EmitterDesc s_Emitters[PARTICLE_EFFECTS] =
+{
+	//	count	spread	speed			life			size	colour
+	{	32,		1.0f,	120.0f, 360.0f,	0.25f, 0.6f,	0.45f,	0xFFE080 },	// Paddle hit
+	{	12,		1.2f,	60.0f,  180.0f,	0.15f, 0.35f,	0.3f,	0x80C0FF },	// Wall hit
+	{	160,	1.4f,	80.0f,  420.0f,	0.5f,  1.2f,	0.5f,	0xFF6030 },	// Point
+	{	1,		PI,		0.0f,   10.0f,	0.25f, 0.35f,	0.55f,	0xFFFFFF },	// Trail
+};
+
+const EmitterDesc& GetEmitterDesc(ParticleEffect effect)
+{
+	return s_Emitters[effect];
+}
+
+CParticleSystem::CParticleSystem(void)
+{
+	m_pMemory		= 0;
+	m_nCapacity		= 0;
+	m_nCount		= 0;
+	m_nSeed			= 1;
+	m_bScalar		= false;
+	m_pX			= 0;
+	m_pY			= 0;
+	m_pVX			= 0;
+	m_pVY			= 0;
+	m_pLife			= 0;
+	m_pInvLifetime	= 0;
+	m_pSize			= 0;
+	m_pRGB			= 0;
+	m_pDrawX		= 0;
+	m_pDrawY		= 0;
+	m_pDrawScale	= 0;
+	m_pDrawColor	= 0;
+	m_bTrail		= false;
+}
+
+CParticleSystem::~CParticleSystem(void)
+{
+	Shutdown();
+}
+
+bool CParticleSystem::Init(int capacity)
+{
+	Shutdown();
+	if(capacity <= 0)
+		return false;
+
+	// Twelve arrays, each padded to a multiple of four so every one starts
+	// 16 byte aligned and the SSE2 loops can run past the last particle
+	size_t stride = ((size_t)capacity + 3) & ~(size_t)3;
+	size_t bytes = stride * 12 * sizeof(float);
+	m_pMemory = malloc(bytes + 15);
+	if(!m_pMemory)
+		return false;
+
+	float* base = (float*)(((size_t)m_pMemory + 15) & ~(size_t)15);
+	memset(base, 0, bytes);
+	m_pX			= base;
+	m_pY			= base + stride;
+	m_pVX			= base + stride * 2;
+	m_pVY			= base + stride * 3;
+	m_pLife			= base + stride * 4;
+	m_pInvLifetime	= base + stride * 5;
+	m_pSize			= base + stride * 6;
+	m_pRGB			= (unsigned int*)(base + stride * 7);
+	m_pDrawX		= base + stride * 8;
+	m_pDrawY		= base + stride * 9;
+	m_pDrawScale	= base + stride * 10;
+	m_pDrawColor	= (unsigned int*)(base + stride * 11);
+
+	m_nCapacity = capacity;
+	Clear();
+	return true;
+}
+
+void CParticleSystem::Shutdown()
+{
+	free(m_pMemory);
+	m_pMemory	= 0;
+	m_nCapacity	= 0;
+	m_nCount	= 0;
+}
+
+void CParticleSystem::Clear()
+{
+	m_nCount	= 0;
+	m_nSeed		= 1;
+	m_bTrail	= false;
+}
+
+bool CParticleSystem::IsVectorised() const
+{
+#ifdef PARTICLES_SSE2
+	return !m_bScalar;
+#else
+	return false;
+#endif
+}
+
+float CParticleSystem::Random()
+{
+	// 0 to 1, the same LCG the paddle AI uses
+	m_nSeed = m_nSeed * 1664525u + 1013904223u;
+	return (float)(m_nSeed >> 8) / (float)(1 << 24);
+}
+
+int CParticleSystem::Emit(ParticleEffect effect, float x, float y, float dirX, float dirY)
+{
+	const EmitterDesc& desc = s_Emitters[effect];
+	int count = desc.count;
+	if(count > m_nCapacity - m_nCount)
+		count = m_nCapacity - m_nCount;
+
+	// No direction sprays every way
+	float heading = 0.0f;
+	float spread = PI;
+	if(dirX != 0.0f || dirY != 0.0f)
+	{
+		heading = atan2f(dirY, dirX);
+		spread = desc.spread;
+	}
+
+	for(int i = 0; i < count; ++i)
+	{
+		float angle	= heading + (Random() * 2.0f - 1.0f) * spread;
+		float speed	= desc.speedMin + (desc.speedMax - desc.speedMin) * Random();
+		float life	= desc.lifeMin + (desc.lifeMax - desc.lifeMin) * Random();
+
+		int n = m_nCount++;
+		m_pX[n]				= x;
+		m_pY[n]				= y;
+		m_pVX[n]			= cosf(angle) * speed;
+		m_pVY[n]			= sinf(angle) * speed;
+		m_pLife[n]			= life;
+		m_pInvLifetime[n]	= 1.0f / life;
+		m_pSize[n]			= desc.size;
+		m_pRGB[n]			= desc.color & 0x00FFFFFF;
+	}
+	return count;
+}
+
+void CParticleSystem::EmitForEvents(const CGameEventBuffer& events)
+{
+	for(int i = 0; i < events.GetCount(); ++i)
+	{
+		const GameEvent& event = events.Get(i);
+		switch(event.type)
+		{
+		case GAME_EVENT_PADDLE_HIT:
+			// Sprays back off the paddle
+			Emit(PARTICLES_PADDLE_HIT, event.paddleHit.x, event.paddleHit.y,
+				event.paddleHit.paddle == 0 ? 1.0f : -1.0f, 0.0f);
+			break;
+
+		case GAME_EVENT_WALL_BOUNCE:
+			Emit(PARTICLES_WALL_HIT, event.wallBounce.x, event.wallBounce.y,
+				0.0f, event.wallBounce.wall == 0 ? 1.0f : -1.0f);
+			break;
+
+		case GAME_EVENT_OBSTACLE_HIT:
+			// Off the side hit, bumpers flash like a paddle
+			Emit(event.obstacleHit.bumper ? PARTICLES_PADDLE_HIT : PARTICLES_WALL_HIT, event.obstacleHit.x,
+				event.obstacleHit.y, event.obstacleHit.normalX, event.obstacleHit.normalY);
+			break;
+
+		case GAME_EVENT_POINT_SCORED:
+		{
+			// At the edge the ball went out of, player 1 scores on the right
+			bool right = event.pointScored.player == 0;
+			Emit(PARTICLES_POINT, right ? (float)PLAYFIELD_WIDTH : 0.0f, event.pointScored.y,
+				right ? -1.0f : 1.0f, 0.0f);
+
+			// The ball is back in the middle, no trail across the field
+			m_bTrail = false;
+			break;
+		}
+
+		default:
+			break;
+		}
+	}
+}
+
+void CParticleSystem::EmitTrail(const CPongGame& game)
+{
+	if(!game.Menu.onGAME)
+	{
+		m_bTrail = false;
+		return;
+	}
+
+	const myBall& ball = game.Ball;
+	if(!m_bTrail)
+	{
+		m_fTrailX	= ball.xp;
+		m_fTrailY	= ball.yp;
+		m_bTrail	= true;
+		return;
+	}
+
+	// One particle every PARTICLE_TRAIL_SPACING pixels along the path,
+	// however many ticks that took
+	float dx = ball.xp - m_fTrailX;
+	float dy = ball.yp - m_fTrailY;
+	float distance = sqrtf(dx * dx + dy * dy);
+	if(distance < PARTICLE_TRAIL_SPACING)
+		return;
+
+	int steps = (int)(distance / PARTICLE_TRAIL_SPACING);
+	float stepX = dx / distance * PARTICLE_TRAIL_SPACING;
+	float stepY = dy / distance * PARTICLE_TRAIL_SPACING;
+	for(int i = 0; i < steps; ++i)
+	{
+		m_fTrailX += stepX;
+		m_fTrailY += stepY;
+		if(i >= steps - PARTICLE_MAX_TRAIL)
+			Emit(PARTICLES_TRAIL, m_fTrailX, m_fTrailY, 0.0f, 0.0f);
+	}
+}
+
+void CParticleSystem::Update(float dt)
+{
+	if(m_nCount == 0)
+		return;
+
+	float drag = 1.0f - PARTICLE_DRAG * dt;
+	if(drag < 0.0f)
+		drag = 0.0f;
+
+	int begin = 0;
+#ifdef PARTICLES_SSE2
+	if(!m_bScalar)
+	{
+		// Four at a time, past the end into the padding
+		__m128 vdt		= _mm_set1_ps(dt);
+		__m128 vdrag	= _mm_set1_ps(drag);
+		for(; begin < m_nCount; begin += 4)
+		{
+			__m128 vx = _mm_load_ps(m_pVX + begin);
+			__m128 vy = _mm_load_ps(m_pVY + begin);
+			_mm_store_ps(m_pX + begin, _mm_add_ps(_mm_load_ps(m_pX + begin), _mm_mul_ps(vx, vdt)));
+			_mm_store_ps(m_pY + begin, _mm_add_ps(_mm_load_ps(m_pY + begin), _mm_mul_ps(vy, vdt)));
+			_mm_store_ps(m_pVX + begin, _mm_mul_ps(vx, vdrag));
+			_mm_store_ps(m_pVY + begin, _mm_mul_ps(vy, vdrag));
+			_mm_store_ps(m_pLife + begin, _mm_sub_ps(_mm_load_ps(m_pLife + begin), vdt));
+		}
+	}
+#endif
+	UpdateScalar(begin, dt, drag);
+	Compact();
+}
+
+void CParticleSystem::UpdateScalar(int begin, float dt, float drag)
+{
+	for(int i = begin; i < m_nCount; ++i)
+	{
+		m_pX[i] = m_pX[i] + m_pVX[i] * dt;
+		m_pY[i] = m_pY[i] + m_pVY[i] * dt;
+		m_pVX[i] = m_pVX[i] * drag;
+		m_pVY[i] = m_pVY[i] * drag;
+		m_pLife[i] = m_pLife[i] - dt;
+	}
+}
+
+void CParticleSystem::Compact()
+{
+	// Swap remove, the order of the live particles does not matter
+	int i = 0;
+	while(i < m_nCount)
+	{
+		if(m_pLife[i] > 0.0f)
+		{
+			++i;
+			continue;
+		}
+
+		int last = --m_nCount;
+		m_pX[i]				= m_pX[last];
+		m_pY[i]				= m_pY[last];
+		m_pVX[i]			= m_pVX[last];
+		m_pVY[i]			= m_pVY[last];
+		m_pLife[i]			= m_pLife[last];
+		m_pInvLifetime[i]	= m_pInvLifetime[last];
+		m_pSize[i]			= m_pSize[last];
+		m_pRGB[i]			= m_pRGB[last];
+	}
+}
+
+void CParticleSystem::GetBatch(const Viewport& view, SpriteBatch& batch)
+{
+	int begin = 0;
+#ifdef PARTICLES_SSE2
+	if(!m_bScalar)
+	{
+		__m128 originX	= _mm_set1_ps((float)view.x);
+		__m128 originY	= _mm_set1_ps((float)view.y);
+		__m128 scale	= _mm_set1_ps(view.scale);
+		__m128 zero		= _mm_setzero_ps();
+		__m128 one		= _mm_set1_ps(1.0f);
+		__m128 full		= _mm_set1_ps(255.0f);
+		for(; begin < m_nCount; begin += 4)
+		{
+			__m128 t = _mm_mul_ps(_mm_load_ps(m_pLife + begin), _mm_load_ps(m_pInvLifetime + begin));
+			t = _mm_min_ps(_mm_max_ps(t, zero), one);
+
+			_mm_store_ps(m_pDrawX + begin, _mm_add_ps(originX, _mm_mul_ps(_mm_load_ps(m_pX + begin), scale)));
+			_mm_store_ps(m_pDrawY + begin, _mm_add_ps(originY, _mm_mul_ps(_mm_load_ps(m_pY + begin), scale)));
+			_mm_store_ps(m_pDrawScale + begin, _mm_mul_ps(_mm_mul_ps(_mm_load_ps(m_pSize + begin), t), scale));
+
+			__m128i alpha = _mm_slli_epi32(_mm_cvttps_epi32(_mm_mul_ps(t, full)), 24);
+			__m128i rgb = _mm_load_si128((const __m128i*)(m_pRGB + begin));
+			_mm_store_si128((__m128i*)(m_pDrawColor + begin), _mm_or_si128(rgb, alpha));
+		}
+	}
+#endif
+	BatchScalar(begin, view);
+
+	batch.x		= m_pDrawX;
+	batch.y		= m_pDrawY;
+	batch.scale	= m_pDrawScale;
+	batch.color	= m_pDrawColor;
+	batch.count	= m_nCount;
+}
+
+void CParticleSystem::BatchScalar(int begin, const Viewport& view)
+{
+	for(int i = begin; i < m_nCount; ++i)
+	{
+		// Fades out and shrinks over its life
+		float t = m_pLife[i] * m_pInvLifetime[i];
+		if(t < 0.0f)	t = 0.0f;
+		if(t > 1.0f)	t = 1.0f;
+
+		m_pDrawX[i]		= (float)view.x + m_pX[i] * view.scale;
+		m_pDrawY[i]		= (float)view.y + m_pY[i] * view.scale;
+		m_pDrawScale[i]	= m_pSize[i] * t * view.scale;
+		m_pDrawColor[i]	= m_pRGB[i] | ((unsigned int)(int)(t * 255.0f) << 24);
+	}
+}
@@ -0,0 +1,159 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	Particles.h
+// Date:	October 19th, 2026
+// Purpose: Particle effects for paddle hits, wall bounces, points and a
+//			trail behind the ball, all on the CPU.  Particles live in a
+//			fixed capacity pool with one array per field (structure of
+//			arrays), so SSE2 moves, ages and fades four at a time.  Dead
+//			particles are removed by moving the last live one into their
+//			slot, so the live ones are always the first GetCount()
+//			entries and the pool never allocates after Init().  The
+//			whole pool is drawn with a single DrawSprites() call.
+//////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "PongGame.h"
+#include "GameEvents.h"
+#include "RenderTypes.h"
+#include "Viewport.h"
+
+// Particles a pool holds unless Init() is told otherwise
+#define PARTICLE_DEFAULT_CAPACITY 4096
+
+// Playfield pixels the ball travels between trail particles
+#define PARTICLE_TRAIL_SPACING 6.0f
+
+enum ParticleEffect
+{
+	PARTICLES_PADDLE_HIT,
+	PARTICLES_WALL_HIT,
+	PARTICLES_POINT,
+	PARTICLES_TRAIL,
+	PARTICLE_EFFECTS
+};
+
+struct EmitterDesc
+{
+	int					count;			// Particles per burst
+	float				spread;			// Radians either side of the direction
+	float				speedMin;		// Playfield pixels a second
+	float				speedMax;
+	float				lifeMin;		// Seconds
+	float				lifeMax;
+	float				size;			// Sprite scale when born, shrinks to 0
+	unsigned int		color;			// RGB, alpha fades from 255 to 0
+};
+
+// The tuning of each effect
+const EmitterDesc& GetEmitterDesc(ParticleEffect effect);
+
+class CParticleSystem
+{
+	void*				m_pMemory;		// Every array below, 16 byte aligned
+	int					m_nCapacity;
+	int					m_nCount;
+	unsigned int		m_nSeed;
+	bool				m_bScalar;
+
+	// Simulation, playfield pixels and seconds
+	float*				m_pX;
+	float*				m_pY;
+	float*				m_pVX;
+	float*				m_pVY;
+	float*				m_pLife;		// Seconds left
+	float*				m_pInvLifetime;	// 1 / seconds it was born with
+	float*				m_pSize;
+	unsigned int*		m_pRGB;
+
+	// What GetBatch() hands the renderer, screen pixels
+	float*				m_pDrawX;
+	float*				m_pDrawY;
+	float*				m_pDrawScale;
+	unsigned int*		m_pDrawColor;
+
+	float				m_fTrailX;		// Where the last trail particle was left
+	float				m_fTrailY;
+	bool				m_bTrail;		// m_fTrailX / Y are set
+
+	CParticleSystem(const CParticleSystem&);
+	CParticleSystem& operator=(const CParticleSystem&);
+
+	float Random();
+	void UpdateScalar(int begin, float dt, float drag);
+	void BatchScalar(int begin, const Viewport& view);
+	void Compact();
+
+public:
+	CParticleSystem(void);
+	~CParticleSystem(void);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Init
+	// Parameters:	int capacity - Most particles alive at once
+	// Return:		bool - false if the memory could not be allocated
+	// Description:	Allocates the pool, the only allocation it makes.
+	//				Bursts that do not fit are cut short.
+	//////////////////////////////////////////////////////////////////////////
+	bool Init(int capacity = PARTICLE_DEFAULT_CAPACITY);
+	void Shutdown();
+
+	// Removes every particle and forgets the trail
+	void Clear();
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Emit
+	// Parameters:	ParticleEffect effect - What to emit
+	//				float x, y - Where, playfield pixels
+	//				float dirX, dirY - Direction the burst heads in, need
+	//					not be normalised, 0, 0 for every direction
+	// Return:		int - Particles emitted
+	// Description:	Adds one burst of the effect.
+	//////////////////////////////////////////////////////////////////////////
+	int Emit(ParticleEffect effect, float x, float y, float dirX, float dirY);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		EmitForEvents
+	// Parameters:	const CGameEventBuffer& events - What the ticks did
+	// Return:		void
+	// Description:	Bursts for the paddle hits, wall bounces and points.
+	//////////////////////////////////////////////////////////////////////////
+	void EmitForEvents(const CGameEventBuffer& events);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		EmitTrail
+	// Parameters:	const CPongGame& game - State after the tick
+	// Return:		void
+	// Description:	Lays the ball's trail up to where it is now.  Nothing
+	//				outside a match.
+	//////////////////////////////////////////////////////////////////////////
+	void EmitTrail(const CPongGame& game);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Update
+	// Parameters:	float dt - Seconds since the last update
+	// Return:		void
+	// Description:	Moves and ages every particle and removes the dead.
+	//////////////////////////////////////////////////////////////////////////
+	void Update(float dt);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		GetBatch
+	// Parameters:	const Viewport& view - Playfield to back buffer mapping
+	//				SpriteBatch& batch - Receives the particles to draw
+	// Return:		void
+	// Description:	Maps the particles to the screen and fades them by
+	//				the life they have left.  The batch stays valid until
+	//				the next call that changes the pool.
+	//////////////////////////////////////////////////////////////////////////
+	void GetBatch(const Viewport& view, SpriteBatch& batch);
+
+	int GetCount() const				{ return m_nCount; }
+	int GetCapacity() const				{ return m_nCapacity; }
+	const float* GetX() const			{ return m_pX; }
+	const float* GetY() const			{ return m_pY; }
+	const float* GetLife() const		{ return m_pLife; }
+
+	// Runs with plain C++ even where SSE2 is available, for comparing
+	// the two
+	void SetScalar(bool scalar)			{ m_bScalar = scalar; }
+	bool IsVectorised() const;
+};
@@ -0,0 +1,383 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	PongBatch.cpp
+// Date:	October 19th, 2026
+// Purpose: Batched matches, see PongBatch.h.
+//////////////////////////////////////////////////////////////////////////
+#include "PongBatch.h"
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__SSE2__)
+	#define BATCH_SSE2
+	#include <emmintrin.h>
+#endif
+
+// Where CPongGame::Init() puts the paddles and serves the ball from
+static const float LEFT_PADDLE_X	= -12.0f;
+static const float RIGHT_PADDLE_X	= (float)PLAYFIELD_WIDTH;
+static const float SERVE_X			= 400.0f;
+static const float SERVE_Y			= 300.0f;
+
+CPongBatch::CPongBatch(void)
+{
+	m_pMemory		= 0;
+	m_nMatches		= 0;
+	m_pBallX		= 0;
+	m_pBallY		= 0;
+	m_pDirX			= 0;
+	m_pDirY			= 0;
+	m_pPaddleY[0]	= 0;
+	m_pPaddleY[1]	= 0;
+	m_pPoints[0]	= 0;
+	m_pPoints[1]	= 0;
+	m_pEvents		= 0;
+	m_pActions		= 0;
+	m_nTicks		= 0;
+	m_bScalar		= false;
+}
+
+CPongBatch::~CPongBatch(void)
+{
+	Shutdown();
+}
+
+bool CPongBatch::Init(int matches, int threads)
+{
+	Shutdown();
+	if(matches <= 0)
+		return false;
+
+	// Nine arrays, each padded to a multiple of four so every one starts
+	// 16 byte aligned
+	size_t stride = ((size_t)matches + 3) & ~(size_t)3;
+	m_pMemory = malloc(stride * 9 * sizeof(float) + 15);
+	if(!m_pMemory)
+		return false;
+
+	float* base = (float*)(((size_t)m_pMemory + 15) & ~(size_t)15);
+	m_pBallX		= base;
+	m_pBallY		= base + stride;
+	m_pDirX			= base + stride * 2;
+	m_pDirY			= base + stride * 3;
+	m_pPaddleY[0]	= base + stride * 4;
+	m_pPaddleY[1]	= base + stride * 5;
+	m_pPoints[0]	= (int*)(base + stride * 6);
+	m_pPoints[1]	= (int*)(base + stride * 7);
+	m_pEvents		= (int*)(base + stride * 8);
+	m_nMatches		= matches;
+
+	m_Pool.Init(threads);
+	Reset();
+	return true;
+}
+
+void CPongBatch::Shutdown()
+{
+	m_Pool.Shutdown();
+
+	free(m_pMemory);
+	m_pMemory	= 0;
+	m_nMatches	= 0;
+}
+
+void CPongBatch::Reset()
+{
+	for(int i = 0; i < m_nMatches; ++i)
+		Reset(i);
+}
+
+void CPongBatch::Reset(int match)
+{
+	m_pBallX[match]			= SERVE_X;
+	m_pBallY[match]			= SERVE_Y;
+	m_pDirX[match]			= 1.0f;
+	m_pDirY[match]			= -1.0f;
+	m_pPaddleY[0][match]	= 300.0f;
+	m_pPaddleY[1][match]	= 300.0f;
+	m_pPoints[0][match]		= 0;
+	m_pPoints[1][match]		= 0;
+	m_pEvents[match]		= 0;
+}
+
+void CPongBatch::Step(const unsigned char* actions, int ticks)
+{
+	if(m_nMatches == 0 || ticks <= 0)
+		return;
+
+	m_pActions	= actions;
+	m_nTicks	= ticks;
+	m_Pool.Run((m_nMatches + BATCH_CHUNK_MATCHES - 1) / BATCH_CHUNK_MATCHES, StepChunkTask, this);
+}
+
+void CPongBatch::Observe(float* out) const
+{
+	for(int i = 0; i < m_nMatches; ++i)
+	{
+		float* match = out + i * BATCH_OBSERVATION_SIZE;
+		match[0] = m_pBallX[i];
+		match[1] = m_pBallY[i];
+		match[2] = m_pDirX[i] * BALL_SPEED_X * 2.0f;
+		match[3] = m_pDirY[i] * BALL_SPEED_Y * 2.0f;
+		match[4] = m_pPaddleY[0][i];
+		match[5] = m_pPaddleY[1][i];
+		match[6] = (float)m_pPoints[0][i];
+		match[7] = (float)m_pPoints[1][i];
+	}
+}
+
+bool CPongBatch::IsVectorised() const
+{
+#ifdef BATCH_SSE2
+	return !m_bScalar;
+#else
+	return false;
+#endif
+}
+
+void CPongBatch::StepChunkTask(void* context, int index, int)
+{
+	CPongBatch* batch = (CPongBatch*)context;
+	int begin = index * BATCH_CHUNK_MATCHES;
+	int end = begin + BATCH_CHUNK_MATCHES;
+	if(end > batch->m_nMatches)
+		end = batch->m_nMatches;
+
+	if(batch->IsVectorised())
+	{
+		// Whole groups of four, the last few matches one at a time
+		int vectorEnd = begin + ((end - begin) & ~3);
+		batch->StepVector(begin, vectorEnd);
+		batch->StepScalar(vectorEnd, end);
+	}
+	else
+	{
+		batch->StepScalar(begin, end);
+	}
+}
+
+void CPongBatch::StepScalar(int begin, int end)
+{
+	// CPongGame::MovePaddle() and MoveBall() with the direction flags as
+	// signs.  A flip only happens when the ball moves towards what it hit,
+	// which is what the flags' if / else if chains come down to.
+	for(int m = begin; m < end; ++m)
+	{
+		float x			= m_pBallX[m];
+		float y			= m_pBallY[m];
+		float dirX		= m_pDirX[m];
+		float dirY		= m_pDirY[m];
+		float paddle[2]	= { m_pPaddleY[0][m], m_pPaddleY[1][m] };
+		int points[2]	= { m_pPoints[0][m], m_pPoints[1][m] };
+		int keys[2]		= { m_pActions ? m_pActions[m * 2] : 0, m_pActions ? m_pActions[m * 2 + 1] : 0 };
+		int events		= 0;
+
+		for(int tick = 0; tick < m_nTicks; ++tick)
+		{
+			for(int i = 0; i < 2; ++i)
+			{
+				if(keys[i] & BATCH_DOWN)
+					paddle[i] = paddle[i] + PADDLE_SPEED;
+				if(keys[i] & BATCH_UP)
+					paddle[i] = paddle[i] - PADDLE_SPEED;
+				if(paddle[i] - PADDLE_HALF_HEIGHT <= 0)
+					paddle[i] = PADDLE_HALF_HEIGHT;
+				if(paddle[i] + PADDLE_HALF_HEIGHT >= PLAYFIELD_HEIGHT)
+					paddle[i] = PLAYFIELD_HEIGHT - PADDLE_HALF_HEIGHT;
+
+				if(y - BALL_WALL_MARGIN <= 0 && dirY < 0.0f)
+				{
+					dirY = 1.0f;
+					events |= BATCH_EVENT_WALL;
+				}
+				if(y + BALL_WALL_MARGIN >= PLAYFIELD_HEIGHT && dirY > 0.0f)
+				{
+					dirY = -1.0f;
+					events |= BATCH_EVENT_WALL;
+				}
+
+				if(x >= PLAYFIELD_WIDTH)
+				{
+					++points[0];
+					x = SERVE_X;
+					y = SERVE_Y;
+					dirX = 1.0f;
+					dirY = -1.0f;
+					events |= BATCH_EVENT_POINT1;
+				}
+				if(x <= 0)
+				{
+					++points[1];
+					x = SERVE_X;
+					y = SERVE_Y;
+					dirX = -1.0f;
+					dirY = -1.0f;
+					events |= BATCH_EVENT_POINT2;
+				}
+
+				if(x >= RIGHT_PADDLE_X - PADDLE_REACH
+					&& y >= paddle[1] - PADDLE_HALF_HEIGHT
+					&& y <= paddle[1] + PADDLE_HALF_HEIGHT
+					&& dirX > 0.0f)
+				{
+					dirX = -1.0f;
+					events |= BATCH_EVENT_HIT;
+				}
+				if(x <= LEFT_PADDLE_X + PADDLE_REACH
+					&& y >= paddle[0] - PADDLE_HALF_HEIGHT
+					&& y <= paddle[0] + PADDLE_HALF_HEIGHT
+					&& dirX < 0.0f)
+				{
+					dirX = 1.0f;
+					events |= BATCH_EVENT_HIT;
+				}
+
+				// A direction of +-1 times the speed is exactly +-speed
+				x = x + dirX * BALL_SPEED_X;
+				y = y + dirY * BALL_SPEED_Y;
+			}
+		}
+
+		m_pBallX[m]			= x;
+		m_pBallY[m]			= y;
+		m_pDirX[m]			= dirX;
+		m_pDirY[m]			= dirY;
+		m_pPaddleY[0][m]	= paddle[0];
+		m_pPaddleY[1][m]	= paddle[1];
+		m_pPoints[0][m]		= points[0];
+		m_pPoints[1][m]		= points[1];
+		m_pEvents[m]		= events;
+	}
+}
+
+#ifdef BATCH_SSE2
+static inline __m128 Select(__m128 mask, __m128 a, __m128 b)
+{
+	return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+static inline __m128i AddEvent(__m128i events, __m128 mask, int flag)
+{
+	return _mm_or_si128(events, _mm_and_si128(_mm_castps_si128(mask), _mm_set1_epi32(flag)));
+}
+
+// Lanes of four matches' keys for one paddle, all bits set where flag is held
+static inline __m128 KeyMask(const unsigned char* actions, int m, int paddle, int flag)
+{
+	if(!actions)
+		return _mm_setzero_ps();
+	__m128i keys = _mm_set_epi32(actions[(m + 3) * 2 + paddle], actions[(m + 2) * 2 + paddle],
+		actions[(m + 1) * 2 + paddle], actions[m * 2 + paddle]);
+	__m128i bit = _mm_set1_epi32(flag);
+	return _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(keys, bit), bit));
+}
+#endif
+
+void CPongBatch::StepVector(int begin, int end)
+{
+#ifdef BATCH_SSE2
+	// StepScalar() four matches at a time.  Each if becomes a mask and a
+	// select, and a paddle without the key held moves by 0, which leaves
+	// it exactly where it was.
+	const __m128 zero		= _mm_setzero_ps();
+	const __m128 one		= _mm_set1_ps(1.0f);
+	const __m128 minusOne	= _mm_set1_ps(-1.0f);
+	const __m128 halfHeight	= _mm_set1_ps((float)PADDLE_HALF_HEIGHT);
+	const __m128 top		= _mm_set1_ps((float)PADDLE_HALF_HEIGHT);
+	const __m128 bottom		= _mm_set1_ps((float)(PLAYFIELD_HEIGHT - PADDLE_HALF_HEIGHT));
+	const __m128 height		= _mm_set1_ps((float)PLAYFIELD_HEIGHT);
+	const __m128 width		= _mm_set1_ps((float)PLAYFIELD_WIDTH);
+	const __m128 margin		= _mm_set1_ps((float)BALL_WALL_MARGIN);
+	const __m128 serveX		= _mm_set1_ps(SERVE_X);
+	const __m128 serveY		= _mm_set1_ps(SERVE_Y);
+	const __m128 rightLine	= _mm_set1_ps(RIGHT_PADDLE_X - PADDLE_REACH);
+	const __m128 leftLine	= _mm_set1_ps(LEFT_PADDLE_X + PADDLE_REACH);
+	const __m128 paddleStep	= _mm_set1_ps(PADDLE_SPEED);
+	const __m128 speedX		= _mm_set1_ps(BALL_SPEED_X);
+	const __m128 speedY		= _mm_set1_ps(BALL_SPEED_Y);
+
+	for(int m = begin; m < end; m += 4)
+	{
+		__m128 x			= _mm_load_ps(m_pBallX + m);
+		__m128 y			= _mm_load_ps(m_pBallY + m);
+		__m128 dirX			= _mm_load_ps(m_pDirX + m);
+		__m128 dirY			= _mm_load_ps(m_pDirY + m);
+		__m128 paddle[2]	= { _mm_load_ps(m_pPaddleY[0] + m), _mm_load_ps(m_pPaddleY[1] + m) };
+		__m128i points1		= _mm_load_si128((const __m128i*)(m_pPoints[0] + m));
+		__m128i points2		= _mm_load_si128((const __m128i*)(m_pPoints[1] + m));
+		__m128i events		= _mm_setzero_si128();
+
+		// The keys are held for the whole step
+		__m128 down[2], up[2];
+		for(int i = 0; i < 2; ++i)
+		{
+			down[i]	= _mm_and_ps(KeyMask(m_pActions, m, i, BATCH_DOWN), paddleStep);
+			up[i]	= _mm_and_ps(KeyMask(m_pActions, m, i, BATCH_UP), paddleStep);
+		}
+
+		for(int tick = 0; tick < m_nTicks; ++tick)
+		{
+			for(int i = 0; i < 2; ++i)
+			{
+				paddle[i] = _mm_add_ps(paddle[i], down[i]);
+				paddle[i] = _mm_sub_ps(paddle[i], up[i]);
+				paddle[i] = Select(_mm_cmple_ps(_mm_sub_ps(paddle[i], halfHeight), zero), top, paddle[i]);
+				paddle[i] = Select(_mm_cmpge_ps(_mm_add_ps(paddle[i], halfHeight), height), bottom, paddle[i]);
+
+				__m128 mask = _mm_and_ps(_mm_cmple_ps(_mm_sub_ps(y, margin), zero), _mm_cmplt_ps(dirY, zero));
+				dirY	= Select(mask, one, dirY);
+				events	= AddEvent(events, mask, BATCH_EVENT_WALL);
+
+				mask	= _mm_and_ps(_mm_cmpge_ps(_mm_add_ps(y, margin), height), _mm_cmpgt_ps(dirY, zero));
+				dirY	= Select(mask, minusOne, dirY);
+				events	= AddEvent(events, mask, BATCH_EVENT_WALL);
+
+				// All bits set is -1, so subtracting the mask counts the point
+				mask	= _mm_cmpge_ps(x, width);
+				points1	= _mm_sub_epi32(points1, _mm_castps_si128(mask));
+				x		= Select(mask, serveX, x);
+				y		= Select(mask, serveY, y);
+				dirX	= Select(mask, one, dirX);
+				dirY	= Select(mask, minusOne, dirY);
+				events	= AddEvent(events, mask, BATCH_EVENT_POINT1);
+
+				mask	= _mm_cmple_ps(x, zero);
+				points2	= _mm_sub_epi32(points2, _mm_castps_si128(mask));
+				x		= Select(mask, serveX, x);
+				y		= Select(mask, serveY, y);
+				dirX	= Select(mask, minusOne, dirX);
+				dirY	= Select(mask, minusOne, dirY);
+				events	= AddEvent(events, mask, BATCH_EVENT_POINT2);
+
+				mask	= _mm_and_ps(
+							_mm_and_ps(_mm_cmpge_ps(x, rightLine), _mm_cmpgt_ps(dirX, zero)),
+							_mm_and_ps(_mm_cmpge_ps(y, _mm_sub_ps(paddle[1], halfHeight)),
+								_mm_cmple_ps(y, _mm_add_ps(paddle[1], halfHeight))));
+				dirX	= Select(mask, minusOne, dirX);
+				events	= AddEvent(events, mask, BATCH_EVENT_HIT);
+
+				mask	= _mm_and_ps(
+							_mm_and_ps(_mm_cmple_ps(x, leftLine), _mm_cmplt_ps(dirX, zero)),
+							_mm_and_ps(_mm_cmpge_ps(y, _mm_sub_ps(paddle[0], halfHeight)),
+								_mm_cmple_ps(y, _mm_add_ps(paddle[0], halfHeight))));
+				dirX	= Select(mask, one, dirX);
+				events	= AddEvent(events, mask, BATCH_EVENT_HIT);
+
+				x = _mm_add_ps(x, _mm_mul_ps(dirX, speedX));
+				y = _mm_add_ps(y, _mm_mul_ps(dirY, speedY));
+			}
+		}
+
+		_mm_store_ps(m_pBallX + m, x);
+		_mm_store_ps(m_pBallY + m, y);
+		_mm_store_ps(m_pDirX + m, dirX);
+		_mm_store_ps(m_pDirY + m, dirY);
+		_mm_store_ps(m_pPaddleY[0] + m, paddle[0]);
+		_mm_store_ps(m_pPaddleY[1] + m, paddle[1]);
+		_mm_store_si128((__m128i*)(m_pPoints[0] + m), points1);
+		_mm_store_si128((__m128i*)(m_pPoints[1] + m), points2);
+		_mm_store_si128((__m128i*)(m_pEvents + m), events);
+	}
+#else
+	StepScalar(begin, end);
+#endif
+}
@@ -0,0 +1,134 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	PongBatch.h
+// Date:	October 19th, 2026
+// Purpose: Thousands of independent matches stepped together, for tuning
+//			the AI and training bots without a window.  Every field of the
+//			match state is its own array (structure of arrays), so SSE2
+//			steps four matches per instruction, and the matches are split
+//			into chunks that the CThreadPool shares out between cores.
+//			The rules are CPongGame's, in the same float operations, so a
+//			batched match and a CPongGame given the same keys stay bit
+//			for bit identical.  Only the match itself is simulated, there
+//			are no menus, and always at the default PongTuning.
+//////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "PongGame.h"
+#include "ThreadPool.h"
+
+//Action flags, one byte per paddle per match
+#define BATCH_UP 0x01
+#define BATCH_DOWN 0x02
+
+//Event flags, what happened in a match during the last Step()
+#define BATCH_EVENT_HIT 0x01		// A paddle returned the ball
+#define BATCH_EVENT_WALL 0x02		// The ball bounced off the top or bottom
+#define BATCH_EVENT_POINT1 0x04		// Player 1 (left) scored
+#define BATCH_EVENT_POINT2 0x08		// Player 2 (right) scored
+
+//Floats per match written by Observe(): ball x, y, dx, dy (per tick),
+//left and right paddle y, player 1 and player 2 points
+#define BATCH_OBSERVATION_SIZE 8
+
+//Matches per pool item, a multiple of the SSE2 width
+#define BATCH_CHUNK_MATCHES 256
+
+class CPongBatch
+{
+public:
+	CPongBatch(void);
+	~CPongBatch(void);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Init
+	// Parameters:	int matches - Number of matches to run side by side
+	//				int threads - Threads to step them on including the
+	//					caller, 0 for one per core
+	// Return:		bool - false if the state could not be allocated
+	// Description:	Allocates the state and starts the threads, then
+	//				resets every match.
+	//////////////////////////////////////////////////////////////////////////
+	bool Init(int matches, int threads);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Shutdown
+	// Parameters:	void
+	// Return:		void
+	// Description:	Stops the threads and frees the state.
+	//////////////////////////////////////////////////////////////////////////
+	void Shutdown();
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Reset
+	// Parameters:	int match - Match to restart, or none for every match
+	// Return:		void
+	// Description:	Puts the ball and paddles back in the middle, the ball
+	//				heading up and right as CPongGame serves it, and clears
+	//				the score and events.
+	//////////////////////////////////////////////////////////////////////////
+	void Reset();
+	void Reset(int match);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Step
+	// Parameters:	const unsigned char* actions - BATCH_UP / BATCH_DOWN for
+	//					match m's paddle p at [m * 2 + p], NULL for no keys
+	//				int ticks - Ticks to run, holding the same actions
+	// Return:		void
+	// Description:	Advances every match by the given number of ticks.  The
+	//				events are those of all the ticks run.
+	//////////////////////////////////////////////////////////////////////////
+	void Step(const unsigned char* actions, int ticks);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Observe
+	// Parameters:	float* out - Receives BATCH_OBSERVATION_SIZE floats per
+	//					match, match after match
+	// Return:		void
+	// Description:	Packs the state into one array, for handing to code
+	//				that wants a single tensor.  The arrays below can be
+	//				read directly instead.
+	//////////////////////////////////////////////////////////////////////////
+	void Observe(float* out) const;
+
+	int GetMatchCount() const					{ return m_nMatches; }
+	int GetThreadCount() const					{ return m_Pool.GetThreadCount(); }
+
+	// One entry per match.  Ball directions are +1 or -1, see Observe() for
+	// the velocity in pixels.  Points are player 1's and player 2's.
+	const float* GetBallX() const				{ return m_pBallX; }
+	const float* GetBallY() const				{ return m_pBallY; }
+	const float* GetBallDirX() const			{ return m_pDirX; }
+	const float* GetBallDirY() const			{ return m_pDirY; }
+	const float* GetPaddleY(int paddle) const	{ return m_pPaddleY[paddle]; }
+	const int* GetPoints(int player) const		{ return m_pPoints[player]; }
+	const int* GetEvents() const				{ return m_pEvents; }
+
+	// Steps with plain C++ even where SSE2 is available, for comparing
+	// the two
+	void SetScalar(bool scalar)					{ m_bScalar = scalar; }
+	bool IsVectorised() const;
+
+private:
+	CPongBatch(const CPongBatch&);
+	CPongBatch& operator=(const CPongBatch&);
+
+	static void StepChunkTask(void* context, int index, int thread);
+	void StepScalar(int begin, int end);
+	void StepVector(int begin, int end);
+
+	CThreadPool					m_Pool;
+	void*						m_pMemory;		// Every array below, 16 byte aligned
+	int							m_nMatches;
+
+	float*						m_pBallX;
+	float*						m_pBallY;
+	float*						m_pDirX;		// +1 right, -1 left
+	float*						m_pDirY;		// +1 down, -1 up
+	float*						m_pPaddleY[2];
+	int*						m_pPoints[2];
+	int*						m_pEvents;
+
+	const unsigned char*		m_pActions;		// Current Step()
+	int							m_nTicks;
+	bool						m_bScalar;
+};
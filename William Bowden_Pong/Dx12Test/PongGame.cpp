@@ -0,0 +1,305 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	PongGame.cpp
+// Date:	October 19th, 2026
+// Purpose: Platform independent Pong simulation, see PongGame.h.
+//////////////////////////////////////////////////////////////////////////
+#include "PongGame.h"
+#include "PongPhysics.h"
+#include <string.h>
+
+namespace
+{
+	// FNV-1a
+	unsigned int HashBytes(unsigned int hash, const void* data, size_t size)
+	{
+		const unsigned char* bytes = (const unsigned char*)data;
+		for(size_t i = 0; i < size; ++i)
+			hash = (hash ^ bytes[i]) * 16777619u;
+		return hash;
+	}
+
+	unsigned int HashSprite(unsigned int hash, const mySprite& sprite)
+	{
+		hash = HashBytes(hash, &sprite.xp, sizeof(sprite.xp));
+		hash = HashBytes(hash, &sprite.yp, sizeof(sprite.yp));
+		hash = HashBytes(hash, &sprite.rot, sizeof(sprite.rot));
+		return HashBytes(hash, &sprite.size, sizeof(sprite.size));
+	}
+
+	unsigned int HashMenu(unsigned int hash, const myStartMenu& menu)
+	{
+		hash = HashBytes(hash, &menu.xp, sizeof(menu.xp));
+		hash = HashBytes(hash, &menu.yp, sizeof(menu.yp));
+		bool flags[] = { menu.onSTART, menu.onCREDITS, menu.onCREDITS2, menu.onEXIT,
+			menu.onGAME, menu.onMovie, menu.onQuit };
+		return HashBytes(hash, flags, sizeof(flags));
+	}
+
+	unsigned int HashFixed(unsigned int hash, CFixed value)
+	{
+		int raw = value.GetRaw();
+		return HashBytes(hash, &raw, sizeof(raw));
+	}
+}
+
+MenuScreen GetMenuScreen(const myStartMenu& menu)
+{
+	if(menu.onQuit)		return MENU_SCREEN_QUIT;
+	if(menu.onGAME)		return MENU_SCREEN_GAME;
+	if(menu.onMovie)	return MENU_SCREEN_MOVIE;
+	if(menu.onCREDITS2)	return MENU_SCREEN_CREDITS2;
+	if(menu.onEXIT)		return MENU_SCREEN_EXIT;
+	if(menu.onCREDITS)	return MENU_SCREEN_CREDITS;
+	if(menu.onSTART)	return MENU_SCREEN_START;
+	return MENU_SCREEN_NONE;
+}
+
+unsigned int GetStateChecksum(const PongState& state)
+{
+	unsigned int hash = 2166136261u;
+	hash = HashSprite(hash, state.Paddle[0]);
+	hash = HashSprite(hash, state.Paddle[1]);
+
+	hash = HashBytes(hash, &state.Ball.xp, sizeof(state.Ball.xp));
+	hash = HashBytes(hash, &state.Ball.yp, sizeof(state.Ball.yp));
+	bool directions[] = { state.Ball.DIR_UP_RIGHT, state.Ball.DIR_DOWN_RIGHT,
+		state.Ball.DIR_DOWN_LEFT, state.Ball.DIR_UP_LEFT };
+	hash = HashBytes(hash, directions, sizeof(directions));
+
+	hash = HashMenu(hash, state.Wall);
+	hash = HashMenu(hash, state.Menu);
+	hash = HashBytes(hash, &state.Player1Point, sizeof(state.Player1Point));
+	hash = HashBytes(hash, &state.Player2Point, sizeof(state.Player2Point));
+
+	const PongFixedMatch& fixed = state.Fixed;
+	for(int i = 0; i < 2; ++i)
+	{
+		hash = HashFixed(hash, fixed.Paddle[i].xp);
+		hash = HashFixed(hash, fixed.Paddle[i].yp);
+	}
+	hash = HashFixed(hash, fixed.Ball.xp);
+	hash = HashFixed(hash, fixed.Ball.yp);
+	bool fixedDirections[] = { fixed.Ball.DIR_UP_RIGHT, fixed.Ball.DIR_DOWN_RIGHT,
+		fixed.Ball.DIR_DOWN_LEFT, fixed.Ball.DIR_UP_LEFT };
+	hash = HashBytes(hash, fixedDirections, sizeof(fixedDirections));
+	hash = HashBytes(hash, &fixed.Player1Point, sizeof(fixed.Player1Point));
+	return HashBytes(hash, &fixed.Player2Point, sizeof(fixed.Player2Point));
+}
+
+CPongGame::CPongGame(void) : m_pArena(0)
+{
+	SetTuning(m_Tuning);
+	Init();
+}
+
+void CPongGame::Init()
+{
+	memset(Paddle, 0, sizeof(Paddle));
+	memset(&Ball, 0, sizeof(Ball));
+	memset(&Wall, 0, sizeof(Wall));
+	memset(&Menu, 0, sizeof(Menu));
+	memset(&Fixed, 0, sizeof(Fixed));
+
+	//Paddle 1
+	Paddle[0].xp = -12;
+	Paddle[0].yp = 300;
+
+	//Paddle 2
+	Paddle[1].xp = PLAYFIELD_WIDTH;
+	Paddle[1].yp = 300;
+
+	//Ball
+	Ball.xp = 400;
+	Ball.yp = 300;
+
+	//	Wall / Background
+	Wall.xp = 400;
+	Wall.yp = 300;
+
+	//	Menu
+	Menu.xp = 200;
+	Menu.yp = 200;
+
+	//Initial Direction
+	Ball.DIR_UP_RIGHT = true;
+
+	//MENU
+	Menu.onGAME = false;
+	Menu.onSTART = true;
+
+	Player1Point = 0;
+	Player2Point = 0;
+
+	if(m_Tuning.fixedPoint)
+		LoadFixedMatch();
+}
+
+void CPongGame::SetTuning(const PongTuning& tuning)
+{
+	bool load = tuning.fixedPoint && !m_Tuning.fixedPoint;
+	m_Tuning = tuning;
+	m_FixedPaddleSpeed	= CFixed::FromFloat(tuning.paddleSpeed);
+	m_FixedBallSpeedX	= CFixed::FromFloat(tuning.ballSpeedX);
+	m_FixedBallSpeedY	= CFixed::FromFloat(tuning.ballSpeedY);
+	if(load)
+		LoadFixedMatch();
+}
+
+// The fixed point match from the floats, rounded
+void CPongGame::LoadFixedMatch()
+{
+	for(int i = 0; i < 2; ++i)
+	{
+		Fixed.Paddle[i].xp = CFixed::FromFloat(Paddle[i].xp);
+		Fixed.Paddle[i].yp = CFixed::FromFloat(Paddle[i].yp);
+	}
+	Fixed.Ball.xp				= CFixed::FromFloat(Ball.xp);
+	Fixed.Ball.yp				= CFixed::FromFloat(Ball.yp);
+	Fixed.Ball.DIR_UP_RIGHT		= Ball.DIR_UP_RIGHT;
+	Fixed.Ball.DIR_DOWN_RIGHT	= Ball.DIR_DOWN_RIGHT;
+	Fixed.Ball.DIR_DOWN_LEFT	= Ball.DIR_DOWN_LEFT;
+	Fixed.Ball.DIR_UP_LEFT		= Ball.DIR_UP_LEFT;
+	Fixed.Player1Point			= Player1Point;
+	Fixed.Player2Point			= Player2Point;
+}
+
+// The floats from the fixed point match, for drawing and the AI
+void CPongGame::StoreFixedMatch()
+{
+	for(int i = 0; i < 2; ++i)
+	{
+		Paddle[i].xp = Fixed.Paddle[i].xp.ToFloat();
+		Paddle[i].yp = Fixed.Paddle[i].yp.ToFloat();
+	}
+	Ball.xp				= Fixed.Ball.xp.ToFloat();
+	Ball.yp				= Fixed.Ball.yp.ToFloat();
+	Ball.DIR_UP_RIGHT	= Fixed.Ball.DIR_UP_RIGHT;
+	Ball.DIR_DOWN_RIGHT	= Fixed.Ball.DIR_DOWN_RIGHT;
+	Ball.DIR_DOWN_LEFT	= Fixed.Ball.DIR_DOWN_LEFT;
+	Ball.DIR_UP_LEFT	= Fixed.Ball.DIR_UP_LEFT;
+	Player1Point		= Fixed.Player1Point;
+	Player2Point		= Fixed.Player2Point;
+}
+
+int CPongGame::Tick(int controlActive, int controlDown, CGameEventBuffer* events)
+{
+	int sounds = 0;
+
+	MenuScreen screen = events ? GetMenuScreen(Menu) : MENU_SCREEN_NONE;
+	TickMenu(controlDown);
+	if(events && GetMenuScreen(Menu) != screen)
+	{
+		GameEvent* event = events->Push(GAME_EVENT_MENU_CHANGED);
+		if(event)
+		{
+			event->menuChanged.from	= screen;
+			event->menuChanged.to	= GetMenuScreen(Menu);
+		}
+	}
+
+	if(Menu.onGAME == true)
+	{
+		// The ball is stepped once per paddle, as it always has been
+		for(int i = 0; i < 2; ++i)
+		{
+			MovePaddle(i, controlActive);
+			sounds |= MoveBall(events);
+		}
+		if(m_Tuning.fixedPoint)
+			StoreFixedMatch();
+	}
+
+	return sounds;
+}
+
+void CPongGame::FinishMovie()
+{
+	Menu.onMovie = false;
+	Menu.onGAME = true;
+}
+
+void CPongGame::GetBallVelocity(float& dx, float& dy) const
+{
+	dx = 0.0f;
+	dy = 0.0f;
+	if(Ball.DIR_UP_RIGHT || Ball.DIR_DOWN_RIGHT)	dx = m_Tuning.ballSpeedX;
+	if(Ball.DIR_UP_LEFT || Ball.DIR_DOWN_LEFT)		dx = -m_Tuning.ballSpeedX;
+	if(Ball.DIR_UP_RIGHT || Ball.DIR_UP_LEFT)		dy = -m_Tuning.ballSpeedY;
+	if(Ball.DIR_DOWN_RIGHT || Ball.DIR_DOWN_LEFT)	dy = m_Tuning.ballSpeedY;
+
+	// Two MoveBall() steps per tick
+	dx *= 2.0f;
+	dy *= 2.0f;
+}
+
+void CPongGame::TickMenu(int controlDown)
+{
+	if(Menu.onSTART == true)
+	{
+		if(controlDown & ARROW_DOWN)
+		{
+			Menu.onSTART = false;
+			Menu.onCREDITS = true;
+		}
+		if(controlDown & ENTER_KEY)
+		{
+			Menu.onSTART = false;
+			Menu.onMovie = true;
+		}
+	}
+	else if(Menu.onCREDITS == true)
+	{
+		if(controlDown & ARROW_DOWN)
+		{
+			Menu.onEXIT = true;
+			Menu.onCREDITS = false;
+		}
+		if(controlDown & ENTER_KEY)
+		{
+			Menu.onCREDITS = false;
+			Menu.onCREDITS2 = true;
+		}
+		if(controlDown & ARROW_UP)
+		{
+			Menu.onCREDITS = false;
+			Menu.onSTART = true;
+		}
+	}
+	else if(Menu.onEXIT == true)
+	{
+		if(controlDown & ARROW_UP)
+		{
+			Menu.onEXIT = false;
+			Menu.onCREDITS = true;
+		}
+		if(controlDown & ENTER_KEY)
+		{
+			Menu.onCREDITS = false;
+			Menu.onCREDITS2 = true;
+			Menu.onQuit = true;
+		}
+	}
+	if(Menu.onCREDITS2 == true)
+	{
+		if(controlDown & ARROW_LEFT)
+		{
+			Menu.onCREDITS2 = false;
+			Menu.onCREDITS = true;
+		}
+	}
+}
+
+void CPongGame::MovePaddle(int i, int controlActive)
+{
+	if(m_Tuning.fixedPoint)
+		StepPaddle(Fixed, i, controlActive, m_FixedPaddleSpeed);
+	else
+		StepPaddle(static_cast<PongState&>(*this), i, controlActive, m_Tuning.paddleSpeed);
+}
+
+int CPongGame::MoveBall(CGameEventBuffer* events)
+{
+	if(m_Tuning.fixedPoint)
+		return StepBall(Fixed, m_FixedBallSpeedX, m_FixedBallSpeedY, events, m_pArena);
+	return StepBall(static_cast<PongState&>(*this), m_Tuning.ballSpeedX, m_Tuning.ballSpeedY, events, m_pArena);
+}
@@ -0,0 +1,244 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	PongGame.h
+// Date:	October 19th, 2026
+// Purpose: Platform independent Pong simulation.  Holds the paddles, ball,
+//			menu state and score that used to live inside
+//			CDirectXFramework::Render(), so the same game logic can be
+//			driven by the Direct3D framework or by the headless tools.
+//////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "FixedPoint.h"
+
+//Key Flags
+#define W_UP 0x000000001
+#define S_DOWN 0x000000002
+#define ARROW_UP 0x000000004
+#define ARROW_DOWN 0x00000008
+#define ARROW_LEFT 0x00000010
+#define ENTER_KEY 0x00000020
+#define DISPLAY_SPRITE 0x00000040
+
+//Sound Flags
+#define SOUND1 0x00000080
+#define SOUND2 0x00000100
+
+//Held to run the match backwards, handled by the framework
+#define REWIND_KEY 0x00000200
+
+//Returned by Tick() with the sound flags, no sound goes with it
+#define WALL_HIT 0x00000400
+
+//Pressed to show the memory held by textures, sounds and fonts, handled
+//by the framework
+#define RESOURCES_KEY 0x00000800
+
+//Playfield size, in virtual pixels.  Renderers scale it to the back
+//buffer, see Viewport.h
+#define PLAYFIELD_WIDTH 800
+#define PLAYFIELD_HEIGHT 600
+
+//Ball speed per MoveBall() step, MoveBall() runs twice per tick
+#define BALL_SPEED_X 0.03f
+#define BALL_SPEED_Y 0.05f
+
+//Paddle speed per MovePaddle() step, also twice per tick
+#define PADDLE_SPEED 0.1f
+
+//Match ticks a second the speeds above are tuned for, the [Video]
+//TickRate the game ships with.  Anything that runs a match in real time
+//has to tick it this often to play at the game's speed.
+#define PONG_TICK_RATE 4000
+
+//Half the paddle's height and the distance from a paddle's centre to the
+//line the ball bounces off
+#define PADDLE_HALF_HEIGHT 60
+#define PADDLE_REACH 30
+
+//The ball bounces off the top and bottom this far from the edge
+#define BALL_WALL_MARGIN 20
+
+struct mySprite
+{
+	float				xp, yp;
+	int					rot, size;
+};
+
+struct myBall
+{
+	float				xp, yp;
+
+	bool				DIR_UP_RIGHT;
+	bool				DIR_DOWN_RIGHT;
+	bool				DIR_DOWN_LEFT;
+	bool				DIR_UP_LEFT;
+
+};
+
+struct myStartMenu
+{
+	float				xp, yp;
+
+	bool				onSTART;
+	bool				onCREDITS;
+	bool				onCREDITS2;
+	bool				onEXIT;
+	bool				onGAME;
+	bool				onMovie;
+	bool				onQuit;
+};
+
+// The match in fixed point, for PongTuning::fixedPoint.  The same fields
+// as the float match, so PongPhysics.h steps either one.
+struct myFixedSprite
+{
+	CFixed				xp, yp;
+};
+
+struct myFixedBall
+{
+	CFixed				xp, yp;
+
+	bool				DIR_UP_RIGHT;
+	bool				DIR_DOWN_RIGHT;
+	bool				DIR_DOWN_LEFT;
+	bool				DIR_UP_LEFT;
+};
+
+struct PongFixedMatch
+{
+	myFixedSprite		Paddle[2];
+	myFixedBall			Ball;
+
+	int					Player1Point;
+	int					Player2Point;
+};
+
+// Everything the game needs to carry on from where it was.  Plain data, so
+// a snapshot is one memcpy, see StateHistory.h for keeping the last few
+// seconds of them.
+struct PongState
+{
+	mySprite			Paddle[2];
+	myBall				Ball;
+	myStartMenu			Wall, Menu;
+
+	int					Player1Point;
+	int					Player2Point;
+
+	// With PongTuning::fixedPoint the match is played here and the floats
+	// above are copies of it for drawing, all zero otherwise
+	PongFixedMatch		Fixed;
+};
+
+// Speeds the match runs at, read from the [Tuning] section of Pong.ini
+// (see TuningConfig.h).  Not part of PongState, so snapshots and rollback
+// keep whatever is set, and both sides of an online match must agree.
+struct PongTuning
+{
+	float				ballSpeedX;
+	float				ballSpeedY;
+	float				paddleSpeed;
+	bool				fixedPoint;		// Play the match in fixed point, see PongPhysics.h
+
+	PongTuning(void) : ballSpeedX(BALL_SPEED_X), ballSpeedY(BALL_SPEED_Y), paddleSpeed(PADDLE_SPEED),
+		fixedPoint(false)	{}
+};
+
+//////////////////////////////////////////////////////////////////////////
+// Name:		GetStateChecksum
+// Parameters:	const PongState& state - State to hash
+// Return:		unsigned int - Equal for equal states
+// Description:	Hashes the fields, not the bytes, so padding is ignored.
+//				For checking two copies of a match agree.
+//////////////////////////////////////////////////////////////////////////
+unsigned int GetStateChecksum(const PongState& state);
+
+class CGameEventBuffer;
+class CArena;
+
+class CPongGame : public PongState
+{
+public:
+	CPongGame(void);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Init
+	// Parameters:	void
+	// Return:		void
+	// Description:	Places the paddles, ball and menus at their starting
+	//				positions and resets the score.
+	//////////////////////////////////////////////////////////////////////////
+	void Init();
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Tick
+	// Parameters:	int controlActive - Key flags currently held
+	//				int controlDown - Key flags pressed since the last tick
+	//				CGameEventBuffer* events - Receives the tick's events,
+	//					appended, NULL when nobody listens
+	// Return:		int - SOUND1 for a paddle or bumper hit, SOUND2 for a
+	//				point, WALL_HIT for a bounce off the top, bottom or
+	//				an arena block
+	// Description:	Advances the menus or the match by one frame.  Entering
+	//				the game sets Menu.onMovie, call FinishMovie() once the
+	//				intro has played (or straight away when there is none).
+	//				See GameEvents.h for the events.
+	//////////////////////////////////////////////////////////////////////////
+	int Tick(int controlActive, int controlDown, CGameEventBuffer* events = 0);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		FinishMovie
+	// Parameters:	void
+	// Return:		void
+	// Description:	Leaves the intro movie and starts the match.
+	//////////////////////////////////////////////////////////////////////////
+	void FinishMovie();
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		GetBallVelocity
+	// Parameters:	float& dx, float& dy - Receive the ball's movement
+	// Return:		void
+	// Description:	Pixels the ball moves per tick, from its direction flags.
+	//////////////////////////////////////////////////////////////////////////
+	void GetBallVelocity(float& dx, float& dy) const;
+
+	// Copies the whole state out or back in
+	void SaveState(PongState& state) const		{ state = *this; }
+	void LoadState(const PongState& state)		{ static_cast<PongState&>(*this) = state; }
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		SetTuning
+	// Parameters:	const PongTuning& tuning - Speeds and physics mode
+	// Return:		void
+	// Description:	Takes effect from the next tick, Init() keeps it.
+	//				Turning fixedPoint on carries the match on from the
+	//				float positions, rounded to fixed point.
+	//////////////////////////////////////////////////////////////////////////
+	void SetTuning(const PongTuning& tuning);
+	const PongTuning& GetTuning() const			{ return m_Tuning; }
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		SetArena
+	// Parameters:	const CArena* arena - Obstacles the ball bounces off,
+	//					NULL for the open playfield.  Not copied, it must
+	//					outlive the game or be set again.
+	// Return:		void
+	// Description:	Like the tuning it is not part of PongState, both sides
+	//				of an online match must load the same arena.
+	//////////////////////////////////////////////////////////////////////////
+	void SetArena(const CArena* arena)			{ m_pArena = arena; }
+	const CArena* GetArena() const				{ return m_pArena; }
+
+private:
+	PongTuning			m_Tuning;
+	const CArena*		m_pArena;
+	CFixed				m_FixedPaddleSpeed;	// m_Tuning's speeds, for fixedPoint
+	CFixed				m_FixedBallSpeedX;
+	CFixed				m_FixedBallSpeedY;
+
+	void LoadFixedMatch();
+	void StoreFixedMatch();
+	void TickMenu(int controlDown);
+	void MovePaddle(int i, int controlActive);
+	int  MoveBall(CGameEventBuffer* events);
+};
@@ -0,0 +1,80 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	PongMetrics.h
+// Date:	October 19th, 2026
+// Purpose: The metrics the game and Tools/PongHeadless.cpp publish (see
+//			Metrics.h), registered under the same names in both so one
+//			reader works with either:
+//				game.frames, game.presented, game.ticks	Counters
+//				game.paddle_hits, game.wall_bounces,
+//				game.obstacle_hits, game.points			From the events
+//				input.dropped		Key presses merged into an earlier
+//									press of the same key before a tick
+//									saw them
+//				events.dropped		Events past GAME_EVENT_CAPACITY
+//				capture.dropped		Frames the recorder could not keep
+//				net.stalls			Online frames held up waiting for the peer
+//				audio.voices		Gauge, FMOD channels playing
+//				assets.bytes		Gauge, CResourceRegistry total
+//				frame.work			Histogram, BeginFrame() to Present
+//////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "Metrics.h"
+#include "GameEvents.h"
+
+struct PongMetricIds
+{
+	int					frames;
+	int					presented;
+	int					ticks;
+	int					paddleHits;
+	int					wallBounces;
+	int					obstacleHits;
+	int					points;
+	int					droppedInput;
+	int					droppedEvents;
+	int					droppedCapture;
+	int					netStalls;
+	int					voices;
+	int					assetBytes;
+	int					frameWork;
+};
+
+inline void RegisterPongMetrics(CMetricsRegistry& registry, PongMetricIds& ids)
+{
+	ids.frames			= registry.AddCounter("game.frames");
+	ids.presented		= registry.AddCounter("game.presented");
+	ids.ticks			= registry.AddCounter("game.ticks");
+	ids.paddleHits		= registry.AddCounter("game.paddle_hits");
+	ids.wallBounces		= registry.AddCounter("game.wall_bounces");
+	ids.obstacleHits	= registry.AddCounter("game.obstacle_hits");
+	ids.points			= registry.AddCounter("game.points");
+	ids.droppedInput	= registry.AddCounter("input.dropped");
+	ids.droppedEvents	= registry.AddCounter("events.dropped");
+	ids.droppedCapture	= registry.AddCounter("capture.dropped");
+	ids.netStalls		= registry.AddCounter("net.stalls");
+	ids.voices			= registry.AddGauge("audio.voices");
+	ids.assetBytes		= registry.AddGauge("assets.bytes");
+	ids.frameWork		= registry.AddHistogram("frame.work");
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Name:		CountPongEvents
+// Parameters:	CMetricsWriter& writer - The game thread's
+//				const PongMetricIds& ids - From RegisterPongMetrics()
+//				const CGameEventBuffer& events - A frame's ticks
+// Return:		void
+// Description:	One pass over the events, once a frame before they are
+//				cleared.
+//////////////////////////////////////////////////////////////////////////
+inline void CountPongEvents(CMetricsWriter& writer, const PongMetricIds& ids, const CGameEventBuffer& events)
+{
+	int counts[GAME_EVENT_TYPES] = { 0 };
+	for(int i = 0; i < events.GetCount(); ++i)
+		++counts[events.Get(i).type];
+
+	if(counts[GAME_EVENT_PADDLE_HIT])	writer.Add(ids.paddleHits, counts[GAME_EVENT_PADDLE_HIT]);
+	if(counts[GAME_EVENT_WALL_BOUNCE])	writer.Add(ids.wallBounces, counts[GAME_EVENT_WALL_BOUNCE]);
+	if(counts[GAME_EVENT_OBSTACLE_HIT])	writer.Add(ids.obstacleHits, counts[GAME_EVENT_OBSTACLE_HIT]);
+	if(counts[GAME_EVENT_POINT_SCORED])	writer.Add(ids.points, counts[GAME_EVENT_POINT_SCORED]);
+	if(events.GetDropped())				writer.Add(ids.droppedEvents, events.GetDropped());
+}
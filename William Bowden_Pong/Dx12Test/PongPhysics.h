@@ -0,0 +1,480 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	PongPhysics.h
+// Date:	October 19th, 2026
+// Purpose: The match rules, paddles, walls, scoring and paddle hits,
+//			written once as templates over the number type.  CPongGame
+//			steps its PongState with floats, the game as it always
+//			played, or its PongFixedMatch with CFixed (FixedPoint.h) when
+//			PongTuning::fixedPoint is set.  Floats can round differently
+//			with another compiler, other floating point flags or x87
+//			registers, so a replay recorded on one machine can drift on
+//			another; fixed point is integer maths and cannot.
+//
+//			TMatch is any type with the fields of PongFixedMatch, T is
+//			float or CFixed.
+//
+//			Arena obstacles (Arena.h) are found by sweeping the ball's
+//			step through the arena's hierarchy.  The hierarchy is walked
+//			in floats, but it only picks the obstacles worth testing; the
+//			test itself and the choice between two hits are in T, so
+//			fixed point stays exact.
+//////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "PongGame.h"
+#include "GameEvents.h"
+#include "Arena.h"
+
+// Events carry floats whichever type the match is played in
+inline float GetPhysicsFloat(float value)		{ return value; }
+inline float GetPhysicsFloat(CFixed value)		{ return value.ToFloat(); }
+
+// Whole numbers in the match's type, exact in both
+template<class T> T GetPhysicsInt(int value);
+template<> inline float GetPhysicsInt<float>(int value)		{ return (float)value; }
+template<> inline CFixed GetPhysicsInt<CFixed>(int value)	{ return CFixed::FromInt(value); }
+
+inline void PushPaddleHit(CGameEventBuffer* events, int paddle, float x, float y)
+{
+	GameEvent* event = events ? events->Push(GAME_EVENT_PADDLE_HIT) : 0;
+	if(event)
+	{
+		event->paddleHit.paddle	= paddle;
+		event->paddleHit.x		= x;
+		event->paddleHit.y		= y;
+	}
+}
+
+inline void PushWallBounce(CGameEventBuffer* events, int wall, float x, float y)
+{
+	GameEvent* event = events ? events->Push(GAME_EVENT_WALL_BOUNCE) : 0;
+	if(event)
+	{
+		event->wallBounce.wall	= wall;
+		event->wallBounce.x		= x;
+		event->wallBounce.y		= y;
+	}
+}
+
+inline void PushPointScored(CGameEventBuffer* events, int player, int points, float y)
+{
+	GameEvent* event = events ? events->Push(GAME_EVENT_POINT_SCORED) : 0;
+	if(event)
+	{
+		event->pointScored.player	= player;
+		event->pointScored.points	= points;
+		event->pointScored.y		= y;
+	}
+}
+
+inline void PushObstacleHit(CGameEventBuffer* events, const ArenaHitBox& box, float x, float y, int normalX,
+							int normalY)
+{
+	GameEvent* event = events ? events->Push(GAME_EVENT_OBSTACLE_HIT) : 0;
+	if(event)
+	{
+		event->obstacleHit.obstacle	= box.obstacle;
+		event->obstacleHit.bumper	= box.type == ARENA_BUMPER;
+		event->obstacleHit.x		= x;
+		event->obstacleHit.y		= y;
+		event->obstacleHit.normalX	= (float)normalX;
+		event->obstacleHit.normalY	= (float)normalY;
+	}
+}
+
+// Where the ball enters a hit box, as the fraction entry / speed of the step
+template<class T>
+struct ArenaSweepHit
+{
+	const ArenaHitBox*	box;
+	T					entry;			// Distance to the side hit
+	T					speed;			// Distance moved along that axis in the step
+	bool				sideX;			// Hit a left or right side
+	bool				sideY;			// Hit a top or bottom side, both for a corner
+};
+
+//////////////////////////////////////////////////////////////////////////
+// Name:		SweepArenaBox
+// Parameters:	const ArenaHitBox& box - Obstacle to test
+//				T x, T y - Ball position
+//				T dx, T dy - The step it is about to take
+//				ArenaSweepHit<T>& hit - Receives where it enters the box
+// Return:		bool - The step enters the box
+// Description:	A ball already inside or on its way out is not hit, so one
+//				that was bounced off a side is free to leave.  Times are
+//				compared by multiplying across rather than dividing.
+//////////////////////////////////////////////////////////////////////////
+template<class T>
+bool SweepArenaBox(const ArenaHitBox& box, T x, T y, T dx, T dy, ArenaSweepHit<T>& hit)
+{
+	T zero = GetPhysicsInt<T>(0);
+	T left, top, right, bottom;
+	GetArenaEdges(box, left, top, right, bottom);
+
+	bool moveX = dx != zero;
+	bool moveY = dy != zero;
+	if((!moveX && (x < left || x > right)) || (!moveY && (y < top || y > bottom)) || (!moveX && !moveY))
+		return false;
+
+	// Distances to the sides the ball enters and leaves by on each axis
+	T speedX	= dx < zero ? -dx : dx;
+	T speedY	= dy < zero ? -dy : dy;
+	T enterX	= dx > zero ? left - x : x - right;
+	T leaveX	= dx > zero ? right - x : x - left;
+	T enterY	= dy > zero ? top - y : y - bottom;
+	T leaveY	= dy > zero ? bottom - y : y - top;
+
+	// It enters when it is inside on both axes, the later of the two
+	hit.sideX = moveX;
+	hit.sideY = moveY;
+	if(moveX && moveY)
+	{
+		T timeX = enterX * speedY;
+		T timeY = enterY * speedX;
+		hit.sideX = timeX >= timeY;
+		hit.sideY = timeY >= timeX;
+	}
+	hit.entry = hit.sideX ? enterX : enterY;
+	hit.speed = hit.sideX ? speedX : speedY;
+	if(hit.entry < zero || hit.entry > hit.speed)
+		return false;
+
+	// And must still be inside on both when it gets there
+	if(moveX && leaveX * hit.speed < hit.entry * speedX)
+		return false;
+	if(moveY && leaveY * hit.speed < hit.entry * speedY)
+		return false;
+
+	hit.box = &box;
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Name:		SweepArena
+// Parameters:	const CArena& arena - Obstacles to test
+//				T x, T y - Ball position
+//				T dx, T dy - The step it is about to take
+//				ArenaSweepHit<T>& hit - Receives the first obstacle hit
+// Return:		bool - The step hits an obstacle
+// Description:	Walks the hierarchy's array front to back, skipping past
+//				every node the step's bounds miss.  Of two hits on the
+//				same step the earlier wins, then the one first in the
+//				arena file.
+//////////////////////////////////////////////////////////////////////////
+template<class T>
+bool SweepArena(const CArena& arena, T x, T y, T dx, T dy, ArenaSweepHit<T>& hit)
+{
+	float fromX	= GetPhysicsFloat(x);
+	float fromY	= GetPhysicsFloat(y);
+	float toX	= GetPhysicsFloat(x + dx);
+	float toY	= GetPhysicsFloat(y + dy);
+	float left	= fromX < toX ? fromX : toX;
+	float right	= fromX < toX ? toX : fromX;
+	float top	= fromY < toY ? fromY : toY;
+	float bottom = fromY < toY ? toY : fromY;
+
+	const ArenaNode* nodes = arena.GetNodes();
+	const ArenaHitBox* boxes = arena.GetHitBoxes();
+	int nodeCount = arena.GetNodeCount();
+	bool found = false;
+	int i = 0;
+	while(i < nodeCount)
+	{
+		const ArenaNode& node = nodes[i];
+		if(node.left > right || node.right < left || node.top > bottom || node.bottom < top)
+		{
+			i = node.skip;
+			continue;
+		}
+		for(int b = node.first; b < node.first + node.count; ++b)
+		{
+			ArenaSweepHit<T> test;
+			if(!SweepArenaBox(boxes[b], x, y, dx, dy, test))
+				continue;
+
+			if(found)
+			{
+				T earlier = test.entry * hit.speed;
+				T later = hit.entry * test.speed;
+				if(earlier > later || (earlier == later && test.box->obstacle > hit.box->obstacle))
+					continue;
+			}
+			hit = test;
+			found = true;
+		}
+		++i;
+	}
+	return found;
+}
+
+// The ball's direction flags as signs, -1 for left or up
+template<class TBall>
+void GetBallDirection(const TBall& ball, int& signX, int& signY)
+{
+	signX = (ball.DIR_UP_RIGHT || ball.DIR_DOWN_RIGHT) ? 1 : -1;
+	signY = (ball.DIR_UP_RIGHT || ball.DIR_UP_LEFT) ? -1 : 1;
+}
+
+template<class TBall>
+void SetBallDirection(TBall& ball, int signX, int signY)
+{
+	ball.DIR_UP_RIGHT	= signX > 0 && signY < 0;
+	ball.DIR_DOWN_RIGHT	= signX > 0 && signY > 0;
+	ball.DIR_DOWN_LEFT	= signX < 0 && signY > 0;
+	ball.DIR_UP_LEFT	= signX < 0 && signY < 0;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Name:		BounceOffArena
+// Parameters:	TMatch& match - Match to step
+//				const CArena& arena - Obstacles to bounce off
+//				T speedX, T speedY - PongTuning::ballSpeedX and Y
+//				CGameEventBuffer* events - Receives the bounce, NULL
+//					when nobody listens
+// Return:		int - WALL_HIT for a block, SOUND1 for a bumper
+// Description:	Turns the ball before a step that would take it into an
+//				obstacle: off the side hit for a block, away from the
+//				centre on both axes for a bumper.  Should the new
+//				direction run into another, in a corner between two, it
+//				goes back the way it came.
+//////////////////////////////////////////////////////////////////////////
+template<class TMatch, class T>
+int BounceOffArena(TMatch& match, const CArena& arena, T speedX, T speedY, CGameEventBuffer* events)
+{
+	if(!match.Ball.DIR_UP_RIGHT && !match.Ball.DIR_DOWN_RIGHT && !match.Ball.DIR_DOWN_LEFT && !match.Ball.DIR_UP_LEFT)
+		return 0;
+
+	int signX, signY;
+	GetBallDirection(match.Ball, signX, signY);
+	int sounds = 0;
+	for(int pass = 0; pass < 2; ++pass)
+	{
+		int turnX, turnY;
+		GetBallDirection(match.Ball, turnX, turnY);
+		ArenaSweepHit<T> hit;
+		if(!SweepArena(arena, match.Ball.xp, match.Ball.yp, turnX > 0 ? speedX : -speedX,
+			turnY > 0 ? speedY : -speedY, hit))
+		{
+			return sounds;
+		}
+
+		if(pass == 1)
+			break;
+
+		bool bumper = hit.box->type == ARENA_BUMPER;
+		if(bumper)
+		{
+			// Twice the ball's position against the sum of the edges, no
+			// halving needed.  Dead on the centre line it goes back.
+			T left, top, right, bottom;
+			GetArenaEdges(*hit.box, left, top, right, bottom);
+			T twiceX = match.Ball.xp + match.Ball.xp;
+			T twiceY = match.Ball.yp + match.Ball.yp;
+			turnX = twiceX < left + right ? -1 : (twiceX > left + right ? 1 : -turnX);
+			turnY = twiceY < top + bottom ? -1 : (twiceY > top + bottom ? 1 : -turnY);
+		}
+		else
+		{
+			if(hit.sideX)
+				turnX = -turnX;
+			if(hit.sideY)
+				turnY = -turnY;
+		}
+		SetBallDirection(match.Ball, turnX, turnY);
+		sounds |= bumper ? SOUND1 : WALL_HIT;
+		PushObstacleHit(events, *hit.box, GetPhysicsFloat(match.Ball.xp), GetPhysicsFloat(match.Ball.yp),
+			turnX != signX ? turnX : 0, turnY != signY ? turnY : 0);
+	}
+
+	SetBallDirection(match.Ball, -signX, -signY);
+	return sounds;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Name:		StepPaddle
+// Parameters:	TMatch& match - Match to step
+//				int i - Paddle, 0 left on W / S, 1 right on the arrows
+//				int controlActive - Key flags currently held
+//				T speed - PongTuning::paddleSpeed
+// Return:		void
+// Description:	Moves the paddle and keeps it on the playfield.
+//////////////////////////////////////////////////////////////////////////
+template<class TMatch, class T>
+void StepPaddle(TMatch& match, int i, int controlActive, T speed)
+{
+	int upKey	= (i == 0) ? W_UP : ARROW_UP;
+	int downKey	= (i == 0) ? S_DOWN : ARROW_DOWN;
+
+	if(controlActive & downKey)
+	{
+		match.Paddle[i].yp = match.Paddle[i].yp + speed;
+	}
+
+	if(controlActive & upKey)
+	{
+		match.Paddle[i].yp = match.Paddle[i].yp - speed;
+	}
+
+	//Out of Bounds
+	if(match.Paddle[i].yp - GetPhysicsInt<T>(PADDLE_HALF_HEIGHT) <= GetPhysicsInt<T>(0))
+	{
+		match.Paddle[i].yp = GetPhysicsInt<T>(PADDLE_HALF_HEIGHT);
+	}
+	if(match.Paddle[i].yp + GetPhysicsInt<T>(PADDLE_HALF_HEIGHT) >= GetPhysicsInt<T>(PLAYFIELD_HEIGHT))
+	{
+		match.Paddle[i].yp = GetPhysicsInt<T>(PLAYFIELD_HEIGHT - PADDLE_HALF_HEIGHT);
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Name:		StepBall
+// Parameters:	TMatch& match - Match to step
+//				T speedX, T speedY - PongTuning::ballSpeedX and Y
+//				CGameEventBuffer* events - Receives the step's events,
+//					NULL when nobody listens
+//				const CArena* arena - Obstacles, NULL for none
+// Return:		int - SOUND1, SOUND2 and WALL_HIT, as CPongGame::Tick()
+// Description:	Bounces the ball off the walls, paddles and obstacles,
+//				scores when it leaves the playfield, then moves it one
+//				step.
+//////////////////////////////////////////////////////////////////////////
+template<class TMatch, class T>
+int StepBall(TMatch& match, T speedX, T speedY, CGameEventBuffer* events, const CArena* arena = 0)
+{
+	int sounds = 0;
+
+//WALL COLLISION
+	if(match.Ball.yp - GetPhysicsInt<T>(BALL_WALL_MARGIN) <= GetPhysicsInt<T>(0))
+	{
+		if(match.Ball.DIR_UP_RIGHT == true)
+		{
+			match.Ball.DIR_UP_RIGHT		=false;
+			match.Ball.DIR_DOWN_RIGHT	=true;
+			sounds |= WALL_HIT;
+			PushWallBounce(events, 0, GetPhysicsFloat(match.Ball.xp), GetPhysicsFloat(match.Ball.yp));
+		}
+		else if(match.Ball.DIR_UP_LEFT == true)
+		{
+			match.Ball.DIR_UP_LEFT		=false;
+			match.Ball.DIR_DOWN_LEFT	=true;
+			sounds |= WALL_HIT;
+			PushWallBounce(events, 0, GetPhysicsFloat(match.Ball.xp), GetPhysicsFloat(match.Ball.yp));
+		}
+	}
+
+	if(match.Ball.yp + GetPhysicsInt<T>(BALL_WALL_MARGIN) >= GetPhysicsInt<T>(PLAYFIELD_HEIGHT))
+	{
+		if(match.Ball.DIR_DOWN_RIGHT == true)
+		{
+			match.Ball.DIR_DOWN_RIGHT	=false;
+			match.Ball.DIR_UP_RIGHT		=true;
+			sounds |= WALL_HIT;
+			PushWallBounce(events, 1, GetPhysicsFloat(match.Ball.xp), GetPhysicsFloat(match.Ball.yp));
+		}
+		else if(match.Ball.DIR_DOWN_LEFT == true)
+		{
+			match.Ball.DIR_DOWN_LEFT	=false;
+			match.Ball.DIR_UP_LEFT		=true;
+			sounds |= WALL_HIT;
+			PushWallBounce(events, 1, GetPhysicsFloat(match.Ball.xp), GetPhysicsFloat(match.Ball.yp));
+		}
+	}
+
+//BALL OUT OF BOUNDS
+	if(match.Ball.xp >= GetPhysicsInt<T>(PLAYFIELD_WIDTH))
+	{
+		sounds |= SOUND2;
+		match.Player1Point++;
+		PushPointScored(events, 0, match.Player1Point, GetPhysicsFloat(match.Ball.yp));
+
+		match.Ball.xp = GetPhysicsInt<T>(400);
+		match.Ball.yp = GetPhysicsInt<T>(300);
+
+		match.Ball.DIR_UP_RIGHT		=true;
+		match.Ball.DIR_DOWN_RIGHT	=false;
+		match.Ball.DIR_DOWN_LEFT	=false;
+		match.Ball.DIR_UP_LEFT		=false;
+	}
+	if(match.Ball.xp <= GetPhysicsInt<T>(0))
+	{
+		sounds |= SOUND2;
+		match.Player2Point++;
+		PushPointScored(events, 1, match.Player2Point, GetPhysicsFloat(match.Ball.yp));
+
+		match.Ball.xp = GetPhysicsInt<T>(400);
+		match.Ball.yp = GetPhysicsInt<T>(300);
+
+		match.Ball.DIR_UP_RIGHT		=false;
+		match.Ball.DIR_DOWN_RIGHT	=false;
+		match.Ball.DIR_DOWN_LEFT	=false;
+		match.Ball.DIR_UP_LEFT		=true;
+	}
+
+//PADDLE COLLISION
+	if(match.Ball.xp >= match.Paddle[1].xp - GetPhysicsInt<T>(PADDLE_REACH)
+		&& match.Ball.yp >= match.Paddle[1].yp - GetPhysicsInt<T>(PADDLE_HALF_HEIGHT)
+		&& match.Ball.yp <= match.Paddle[1].yp + GetPhysicsInt<T>(PADDLE_HALF_HEIGHT))
+	{
+		if(match.Ball.DIR_DOWN_RIGHT == true)
+		{
+			sounds |= SOUND1;
+			PushPaddleHit(events, 1, GetPhysicsFloat(match.Ball.xp), GetPhysicsFloat(match.Ball.yp));
+			match.Ball.DIR_DOWN_RIGHT	=false;
+			match.Ball.DIR_DOWN_LEFT	=true;
+		}
+		else if(match.Ball.DIR_UP_RIGHT == true)
+		{
+			sounds |= SOUND1;
+			PushPaddleHit(events, 1, GetPhysicsFloat(match.Ball.xp), GetPhysicsFloat(match.Ball.yp));
+			match.Ball.DIR_UP_RIGHT		=false;
+			match.Ball.DIR_UP_LEFT		=true;
+		}
+	}
+
+	if(match.Ball.xp <= match.Paddle[0].xp + GetPhysicsInt<T>(PADDLE_REACH)
+		&& match.Ball.yp >= match.Paddle[0].yp - GetPhysicsInt<T>(PADDLE_HALF_HEIGHT)
+		&& match.Ball.yp <= match.Paddle[0].yp + GetPhysicsInt<T>(PADDLE_HALF_HEIGHT))
+	{
+		if(match.Ball.DIR_DOWN_LEFT == true)
+		{
+			sounds |= SOUND1;
+			PushPaddleHit(events, 0, GetPhysicsFloat(match.Ball.xp), GetPhysicsFloat(match.Ball.yp));
+			match.Ball.DIR_DOWN_LEFT	=false;
+			match.Ball.DIR_DOWN_RIGHT	=true;
+		}
+		else if(match.Ball.DIR_UP_LEFT == true)
+		{
+			sounds |= SOUND1;
+			PushPaddleHit(events, 0, GetPhysicsFloat(match.Ball.xp), GetPhysicsFloat(match.Ball.yp));
+			match.Ball.DIR_UP_LEFT		=false;
+			match.Ball.DIR_UP_RIGHT		=true;
+		}
+	}
+
+//ARENA COLLISION
+	if(arena && !arena->IsEmpty())
+		sounds |= BounceOffArena(match, *arena, speedX, speedY, events);
+
+//BALL DIRECTION
+	if(match.Ball.DIR_UP_RIGHT == true)
+	{
+		match.Ball.xp = match.Ball.xp + speedX;
+		match.Ball.yp = match.Ball.yp - speedY;
+	}
+	if(match.Ball.DIR_DOWN_RIGHT == true)
+	{
+		match.Ball.xp = match.Ball.xp + speedX;
+		match.Ball.yp = match.Ball.yp + speedY;
+	}
+	if(match.Ball.DIR_DOWN_LEFT == true)
+	{
+		match.Ball.xp = match.Ball.xp - speedX;
+		match.Ball.yp = match.Ball.yp + speedY;
+	}
+	if(match.Ball.DIR_UP_LEFT == true)
+	{
+		match.Ball.xp = match.Ball.xp - speedX;
+		match.Ball.yp = match.Ball.yp - speedY;
+	}
+
+	return sounds;
+}
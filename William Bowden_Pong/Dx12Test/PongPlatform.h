@@ -0,0 +1,359 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	PongPlatform.h
+// Date:	October 19th, 2026
+// Purpose: The few operating system services the portable game code and
+//			headless tools need, for Windows and Linux.
+//////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <stdio.h>
+#include <string.h>
+#ifdef _WIN32
+	#include <windows.h>
+#else
+	#include <time.h>
+	#include <unistd.h>
+	#include <pthread.h>
+	#include <sched.h>
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+#endif
+
+// Arena and pool usage statistics, on in debug builds.  Define
+// PONG_MEMORY_STATS to get them in an optimised build.
+#if defined(_DEBUG) && !defined(PONG_MEMORY_STATS)
+	#define PONG_MEMORY_STATS
+#endif
+
+//////////////////////////////////////////////////////////////////////////
+// Name:		PlatformGetTime
+// Parameters:	void
+// Return:		double - Seconds from an arbitrary fixed point
+// Description:	High resolution monotonic clock for timing and benchmarks.
+//////////////////////////////////////////////////////////////////////////
+inline double PlatformGetTime()
+{
+#ifdef _WIN32
+	static LARGE_INTEGER frequency = { 0 };
+	if(frequency.QuadPart == 0)
+		QueryPerformanceFrequency(&frequency);
+	LARGE_INTEGER counter;
+	QueryPerformanceCounter(&counter);
+	return (double)counter.QuadPart / (double)frequency.QuadPart;
+#else
+	timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (double)now.tv_sec + (double)now.tv_nsec * 1e-9;
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Name:		PlatformSleep
+// Parameters:	double seconds - Longest to sleep
+// Return:		void
+// Description:	Gives the core up for at most about that long.  Windows
+//				sleeps in whole milliseconds, a millisecond less than
+//				asked so a frame is never late, and yields for anything
+//				shorter, so callers sleep again until the time comes.
+//				Call timeBeginPeriod(1) first or a Windows sleep can
+//				last 15 ms.
+//////////////////////////////////////////////////////////////////////////
+inline void PlatformSleep(double seconds)
+{
+	if(seconds <= 0.0)
+		return;
+#ifdef _WIN32
+	DWORD ms = (DWORD)(seconds * 1000.0);
+	Sleep(ms > 1 ? ms - 1 : 0);
+#else
+	timespec wait;
+	wait.tv_sec		= (time_t)seconds;
+	wait.tv_nsec	= (long)((seconds - (double)wait.tv_sec) * 1e9);
+	nanosleep(&wait, 0);
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Name:		PlatformGetCpuTime
+// Parameters:	void
+// Return:		double - Seconds of CPU the process has used on all of
+//				its threads, user and kernel
+// Description:	Against PlatformGetTime() gives the share of a core used.
+//////////////////////////////////////////////////////////////////////////
+inline double PlatformGetCpuTime()
+{
+#ifdef _WIN32
+	FILETIME created, exited, kernel, user;
+	if(!GetProcessTimes(GetCurrentProcess(), &created, &exited, &kernel, &user))
+		return 0.0;
+	ULARGE_INTEGER kernelTime, userTime;
+	kernelTime.LowPart	= kernel.dwLowDateTime;
+	kernelTime.HighPart	= kernel.dwHighDateTime;
+	userTime.LowPart	= user.dwLowDateTime;
+	userTime.HighPart	= user.dwHighDateTime;
+	return (kernelTime.QuadPart + userTime.QuadPart) * 1e-7;
+#else
+	timespec used;
+	clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &used);
+	return (double)used.tv_sec + (double)used.tv_nsec * 1e-9;
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Name:		PlatformLowerThreadPriority
+// Parameters:	void
+// Return:		void
+// Description:	Makes the calling thread give way to the game's threads,
+//				for background work that must not take time from a frame
+//				even when there are no spare cores.
+//////////////////////////////////////////////////////////////////////////
+inline void PlatformLowerThreadPriority()
+{
+#ifdef _WIN32
+	SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_BELOW_NORMAL);
+#elif defined(__linux__)
+	sched_param param;
+	param.sched_priority = 0;
+	pthread_setschedparam(pthread_self(), SCHED_IDLE, &param);
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Name:		PlatformGetReadBytes
+// Parameters:	void
+// Return:		unsigned long long - Bytes the process has read from
+//				files and devices so far, whether or not they came from
+//				the file cache.  0 if the system does not say.
+// Description:	GetProcessIoCounters() on Windows, /proc/self/io on
+//				Linux.  Counts reads made inside D3DX, FMOD and
+//				DirectShow as well as the game's own.
+//////////////////////////////////////////////////////////////////////////
+inline unsigned long long PlatformGetReadBytes()
+{
+#ifdef _WIN32
+	IO_COUNTERS counters;
+	if(!GetProcessIoCounters(GetCurrentProcess(), &counters))
+		return 0;
+	return counters.ReadTransferCount;
+#elif defined(__linux__)
+	unsigned long long bytes = 0;
+	FILE* file = fopen("/proc/self/io", "r");
+	if(file)
+	{
+		char line[128];
+		while(fgets(line, sizeof(line), file))
+		{
+			if(sscanf(line, "rchar: %llu", &bytes) == 1)
+				break;
+		}
+		fclose(file);
+	}
+	return bytes;
+#else
+	return 0;
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Name:		PlatformGetProcessAge
+// Parameters:	void
+// Return:		double - Seconds since the process was created, 0 if the
+//				system does not say
+// Description:	Includes loading the executable and its DLLs, which
+//				happens before main() can start a clock.  Linux only
+//				knows the start time to a clock tick, usually 10 ms.
+//////////////////////////////////////////////////////////////////////////
+inline double PlatformGetProcessAge()
+{
+#ifdef _WIN32
+	FILETIME created, exited, kernel, user, now;
+	if(!GetProcessTimes(GetCurrentProcess(), &created, &exited, &kernel, &user))
+		return 0.0;
+	GetSystemTimeAsFileTime(&now);
+	ULARGE_INTEGER start, end;
+	start.LowPart	= created.dwLowDateTime;
+	start.HighPart	= created.dwHighDateTime;
+	end.LowPart		= now.dwLowDateTime;
+	end.HighPart	= now.dwHighDateTime;
+	return end.QuadPart > start.QuadPart ? (end.QuadPart - start.QuadPart) * 1e-7 : 0.0;
+#elif defined(__linux__)
+	// Field 22 of /proc/self/stat is the start time in ticks since boot,
+	// after the command name, which may hold spaces, in brackets
+	char text[1024];
+	double uptime = 0.0;
+	unsigned long long started = 0;
+	FILE* file = fopen("/proc/self/stat", "r");
+	if(!file)
+		return 0.0;
+	size_t length = fread(text, 1, sizeof(text) - 1, file);
+	fclose(file);
+	text[length] = 0;
+	const char* fields = strrchr(text, ')');
+	if(!fields || sscanf(fields + 2, "%*c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %*u %*u %*d %*d %*d %*d %*d %*d %llu",
+		&started) != 1)
+	{
+		return 0.0;
+	}
+	file = fopen("/proc/uptime", "r");
+	if(!file)
+		return 0.0;
+	int scanned = fscanf(file, "%lf", &uptime);
+	fclose(file);
+	double age = uptime - (double)started / (double)sysconf(_SC_CLK_TCK);
+	return scanned == 1 && age > 0.0 ? age : 0.0;
+#else
+	return 0.0;
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Name:		PlatformGetProcessId
+// Parameters:	void
+// Return:		unsigned int - The operating system's id for this process
+// Description:	For tools that look at a running game from outside.
+//////////////////////////////////////////////////////////////////////////
+inline unsigned int PlatformGetProcessId()
+{
+#ifdef _WIN32
+	return (unsigned int)GetCurrentProcessId();
+#else
+	return (unsigned int)getpid();
+#endif
+}
+
+// Memory other processes on the machine can map by name
+struct PlatformSharedMemory
+{
+	void*				data;			// NULL when not open
+	size_t				size;
+#ifdef _WIN32
+	HANDLE				mapping;
+#else
+	char				name[64];		// Unlinked on close by the creator
+	bool				creator;
+#endif
+
+	PlatformSharedMemory(void) : data(0), size(0)
+	{
+#ifdef _WIN32
+		mapping = 0;
+#else
+		name[0] = 0;
+		creator = false;
+#endif
+	}
+};
+
+//////////////////////////////////////////////////////////////////////////
+// Name:		PlatformCreateSharedMemory
+// Parameters:	const char* name - Letters and digits, the same in every
+//					process that maps it
+//				size_t size - Bytes, zeroed when first created
+//				PlatformSharedMemory& memory - Receives the writable view
+// Return:		bool - false if it could not be created or mapped
+// Description:	A Local\ named file mapping on Windows, gone when the
+//				last process closes it.  A POSIX shared memory object on
+//				Linux, /dev/shm/<name>, unlinked by
+//				PlatformCloseSharedMemory() so readers see the game has
+//				stopped.
+//////////////////////////////////////////////////////////////////////////
+inline bool PlatformCreateSharedMemory(const char* name, size_t size, PlatformSharedMemory& memory)
+{
+	memory = PlatformSharedMemory();
+	char path[64];
+#ifdef _WIN32
+	sprintf(path, "Local\\%.50s", name);
+	memory.mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, 0, (DWORD)size, path);
+	if(!memory.mapping)
+		return false;
+	memory.data = MapViewOfFile(memory.mapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+	if(!memory.data)
+	{
+		CloseHandle(memory.mapping);
+		memory.mapping = 0;
+		return false;
+	}
+#else
+	sprintf(path, "/%.50s", name);
+	int file = shm_open(path, O_CREAT | O_RDWR, 0644);
+	if(file < 0)
+		return false;
+	// A game that crashed leaves its segment behind, it is reused
+	if(ftruncate(file, (off_t)size) != 0)
+	{
+		close(file);
+		return false;
+	}
+	void* data = mmap(0, size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+	close(file);
+	if(data == MAP_FAILED)
+		return false;
+	memory.data		= data;
+	memory.creator	= true;
+	strcpy(memory.name, path);
+#endif
+	memory.size = size;
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Name:		PlatformOpenSharedMemory
+// Parameters:	const char* name - As given to PlatformCreateSharedMemory()
+//				size_t size - Bytes to map, no more than were created
+//				PlatformSharedMemory& memory - Receives the read only view
+// Return:		bool - false if nothing of that name exists
+// Description:	For the reading side.
+//////////////////////////////////////////////////////////////////////////
+inline bool PlatformOpenSharedMemory(const char* name, size_t size, PlatformSharedMemory& memory)
+{
+	memory = PlatformSharedMemory();
+	char path[64];
+#ifdef _WIN32
+	sprintf(path, "Local\\%.50s", name);
+	memory.mapping = OpenFileMappingA(FILE_MAP_READ, FALSE, path);
+	if(!memory.mapping)
+		return false;
+	memory.data = MapViewOfFile(memory.mapping, FILE_MAP_READ, 0, 0, size);
+	if(!memory.data)
+	{
+		CloseHandle(memory.mapping);
+		memory.mapping = 0;
+		return false;
+	}
+#else
+	sprintf(path, "/%.50s", name);
+	int file = shm_open(path, O_RDONLY, 0);
+	if(file < 0)
+		return false;
+	struct stat status;
+	if(fstat(file, &status) != 0 || (size_t)status.st_size < size)
+	{
+		close(file);
+		return false;
+	}
+	void* data = mmap(0, size, PROT_READ, MAP_SHARED, file, 0);
+	close(file);
+	if(data == MAP_FAILED)
+		return false;
+	memory.data = data;
+#endif
+	memory.size = size;
+	return true;
+}
+
+// Unmaps either kind of view, and for the creator on Linux removes the name
+inline void PlatformCloseSharedMemory(PlatformSharedMemory& memory)
+{
+	if(!memory.data)
+		return;
+#ifdef _WIN32
+	UnmapViewOfFile(memory.data);
+	CloseHandle(memory.mapping);
+#else
+	munmap(memory.data, memory.size);
+	if(memory.creator)
+		shm_unlink(memory.name);
+#endif
+	memory = PlatformSharedMemory();
+}
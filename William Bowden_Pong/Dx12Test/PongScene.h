@@ -0,0 +1,156 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	PongScene.h
+// Date:	October 19th, 2026
+// Purpose: Draws the current CPongGame state through any renderer
+//			backend (see Renderer.h).  Templated so the calls bind to the
+//			backend at compile time.  Game positions are in the virtual
+//			800x600 playfield and are mapped to the back buffer through a
+//			Viewport.
+//////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "Renderer.h"
+#include "PongGame.h"
+#include "Viewport.h"
+#include "Particles.h"
+#include "Arena.h"
+#include "StartupTrace.h"
+#include <wchar.h>
+#include <stdlib.h>
+
+#define SPRITE_WHITE 0xFFFFFFFF
+
+struct PongTextures
+{
+	SpriteTexture		paddle;
+	SpriteTexture		ball;
+	SpriteTexture		wall;
+	SpriteTexture		start;
+	SpriteTexture		credits;
+	SpriteTexture		credits2;
+	SpriteTexture		exit;
+};
+
+// Sprite files, in PongTextures order, for loading and reloading
+#define PONG_TEXTURE_COUNT 7
+
+inline const char* GetPongTextureFile(int i)
+{
+	static const char* const files[PONG_TEXTURE_COUNT] =
+	{
+		"Paddle.tga", "Ball.tga", "wall.tga", "START.tga", "CREDITS.tga", "CREDIT2.tga", "EXIT.tga"
+	};
+	return files[i];
+}
+
+inline SpriteTexture& GetPongTexture(PongTextures& textures, int i)
+{
+	SpriteTexture* all[PONG_TEXTURE_COUNT] =
+	{
+		&textures.paddle, &textures.ball, &textures.wall, &textures.start,
+		&textures.credits, &textures.credits2, &textures.exit
+	};
+	return *all[i];
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Name:		LoadPongTextures
+// Parameters:	TRenderer& renderer - Backend to create the textures with
+//				PongTextures& textures - Receives the texture handles
+//				CStartupTrace* trace - Gets a span for each file, NULL
+//					for none
+// Return:		bool - false if any texture failed to load
+// Description:	Loads every sprite used by the game, relative to the
+//				working directory.
+//////////////////////////////////////////////////////////////////////////
+template<class TRenderer>
+bool LoadPongTextures(TRenderer& renderer, PongTextures& textures, CStartupTrace* trace = 0)
+{
+	bool ok = true;
+	for(int i = 0; i < PONG_TEXTURE_COUNT; ++i)
+	{
+		CTraceSpan span(trace, GetPongTextureFile(i));
+		wchar_t fileName[64];
+		mbstowcs(fileName, GetPongTextureFile(i), 64);
+		ok &= span.Check(renderer.LoadTexture(fileName, GetPongTexture(textures, i)));
+	}
+	return ok;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Name:		DrawPongScene
+// Parameters:	TRenderer& renderer - Backend to draw with
+//				const CPongGame& game - State to draw
+//				const PongTextures& textures - Loaded sprite textures
+//				const Viewport& view - Playfield to back buffer mapping
+//				CParticleSystem* particles - Effects to draw over the
+//					match, NULL for none
+//				const wchar_t* status - Line drawn in the bottom left
+//					corner over everything, NULL for none
+// Return:		void
+// Description:	Draws one complete frame: the menu screen, or the wall,
+//				arena, paddles, ball, particles and score while a match
+//				is running.
+//////////////////////////////////////////////////////////////////////////
+template<class TRenderer>
+void DrawPongScene(TRenderer& renderer, const CPongGame& game, const PongTextures& textures, const Viewport& view,
+				   CParticleSystem* particles = 0, const wchar_t* status = 0)
+{
+	const myStartMenu& Menu = game.Menu;
+	float scale = view.scale;
+
+	renderer.BeginFrame(0xFF000000);
+
+	// Menus are drawn at half size
+	float menuX = ViewportX(view, Menu.xp);
+	float menuY = ViewportY(view, Menu.yp);
+	if(Menu.onSTART == true)
+		renderer.DrawSprite(textures.start, menuX, menuY, 0.5f * scale, SPRITE_WHITE);
+	else if(Menu.onCREDITS == true)
+		renderer.DrawSprite(textures.credits, menuX, menuY, 0.5f * scale, SPRITE_WHITE);
+	else if(Menu.onEXIT == true)
+		renderer.DrawSprite(textures.exit, menuX, menuY, 0.5f * scale, SPRITE_WHITE);
+	if(Menu.onCREDITS2 == true)
+		renderer.DrawSprite(textures.credits2, menuX, menuY, 0.5f * scale, SPRITE_WHITE);
+
+	if(Menu.onGAME == true)
+	{
+		//BACKGROUND IMAGE
+		renderer.DrawSprite(textures.wall, ViewportX(view, game.Wall.xp), ViewportY(view, game.Wall.yp), scale, SPRITE_WHITE);
+
+		// The arena's obstacles, tiled with tinted copies of the ball
+		const CArena* arena = game.GetArena();
+		if(arena && arena->GetObstacleCount() > 0)
+		{
+			SpriteBatch batch;
+			arena->GetBatch(view, batch);
+			renderer.DrawSprites(textures.ball, batch);
+		}
+
+		for(int i = 0; i < 2; ++i)
+			renderer.DrawSprite(textures.paddle, ViewportX(view, game.Paddle[i].xp), ViewportY(view, game.Paddle[i].yp), scale, SPRITE_WHITE);
+
+		renderer.DrawSprite(textures.ball, ViewportX(view, game.Ball.xp), ViewportY(view, game.Ball.yp), scale, SPRITE_WHITE);
+
+		// Every particle in one call, tinted copies of the ball
+		if(particles && particles->GetCount() > 0)
+		{
+			SpriteBatch batch;
+			particles->GetBatch(view, batch);
+			renderer.DrawSprites(textures.ball, batch);
+		}
+
+		//SCORE
+		wchar_t Player1Text[256];
+		swprintf(Player1Text, 256, L"Point(s): %i", game.Player1Point);
+		renderer.DrawString(Player1Text, (int)ViewportX(view, 10), (int)ViewportY(view, 10), SPRITE_WHITE);
+
+		wchar_t Player2Text[256];
+		swprintf(Player2Text, 256, L"Point(s): %i", game.Player2Point);
+		renderer.DrawString(Player2Text, (int)ViewportX(view, 670), (int)ViewportY(view, 10), SPRITE_WHITE);
+	}
+
+	if(status)
+		renderer.DrawString(status, (int)ViewportX(view, 10), (int)ViewportY(view, 560), SPRITE_WHITE);
+
+	renderer.EndFrame();
+}
@@ -0,0 +1,65 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	RenderTypes.h
+// Date:	October 19th, 2026
+// Purpose: Types shared by every renderer backend, see Renderer.h.
+//////////////////////////////////////////////////////////////////////////
+#pragma once
+
+class CResourceRegistry;
+
+// Back buffer pixel formats a backend can be asked for.  The software
+// renderer always draws 32 bit ARGB.
+enum BackBufferFormat
+{
+	BACKBUFFER_X8R8G8B8,
+	BACKBUFFER_A8R8G8B8,
+	BACKBUFFER_R5G6B5
+};
+
+struct RendererDesc
+{
+	void*				window;			// HWND for the D3D9 backend, unused otherwise
+	bool				windowed;		// Windowed or full-screen
+	bool				vsync;			// Wait for vertical blank on Present
+	int					width;			// Back buffer / frame buffer width
+	int					height;			// Back buffer / frame buffer height
+	BackBufferFormat	format;			// Back buffer format, D3D9 only
+	int					multisample;	// Most MSAA samples wanted, 0 for off.  The
+										// D3D9 backend picks the best the adapter has.
+	float				textScale;		// Score text size, 1 at 800x600
+	int					threads;		// Software rasteriser threads, 0 for one per core
+	CResourceRegistry*	resources;		// Owns and accounts the D3D9 backend's device,
+										// font and textures, NULL for a private one
+
+	RendererDesc(void)
+	{
+		window		= 0;
+		windowed	= true;
+		vsync		= false;
+		width		= 800;
+		height		= 600;
+		format		= BACKBUFFER_X8R8G8B8;
+		multisample	= 0;
+		textScale	= 1.0f;
+		threads		= 0;
+		resources	= 0;
+	}
+};
+
+struct SpriteTexture
+{
+	int					id;				// Backend specific handle, -1 if not loaded
+	int					width;			// Size of the source image
+	int					height;
+};
+
+// Many sprites with one texture, one entry per sprite in each array.
+// Passed to DrawSprites() in one call, e.g. straight from a particle pool.
+struct SpriteBatch
+{
+	const float*		x;				// Centres, screen pixels
+	const float*		y;
+	const float*		scale;
+	const unsigned int*	color;			// ARGB
+	int					count;
+};
@@ -0,0 +1,56 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	Renderer.h
+// Date:	October 19th, 2026
+// Purpose: Compile time selection of the sprite renderer.  Every backend
+//			is a plain class with the same set of non-virtual methods, and
+//			the game draws through a template (see PongScene.h), so the
+//			chosen backend is inlined with no virtual dispatch per sprite.
+//
+//			Backends, selected with a preprocessor flag:
+//				(default on Windows)	CD3D9Renderer		- ID3DXSprite/ID3DXFont
+//				PONG_RENDERER_NULL		CNullRenderer		- Counts calls only
+//				PONG_RENDERER_SOFTWARE	CSoftwareRenderer	- Multithreaded CPU
+//															  rasteriser into memory
+//			Builds without _WIN32 fall back to the null renderer.
+//
+//			A backend provides:
+//				bool Init(const RendererDesc& desc);
+//				void Shutdown();
+//				bool LoadTexture(const wchar_t* fileName, SpriteTexture& texture);
+//				bool UpdateTexture(SpriteImage& image, SpriteTexture& texture);
+//				void BeginFrame(unsigned int clearColor);
+//				void DrawSprite(const SpriteTexture& texture, float x, float y,
+//								float scale, unsigned int color);
+//				void DrawSprites(const SpriteTexture& texture,
+//								 const SpriteBatch& batch);
+//				void DrawString(const wchar_t* text, int x, int y, unsigned int color);
+//				void EndFrame();
+//				bool SetCapture(CFrameCapture* capture);
+//
+//			Sprites are drawn centred on (x, y) like the ID3DXSprite::Draw
+//			calls in the original framework, and colours are ARGB the same
+//			as D3DCOLOR.  DrawSprites() draws a whole SpriteBatch in one
+//			call, the same as DrawSprite() for each entry in order.
+//			UpdateTexture() replaces a loaded texture's pixels with an
+//			image decoded elsewhere (see AssetReloader.h), keeping its id,
+//			and must be called between frames.  It may take the image's
+//			pixels instead of copying them.  SetCapture() hands every
+//			frame EndFrame() finishes to a CFrameCapture (FrameCapture.h)
+//			from then on, NULL stops; it returns false if the backend
+//			cannot read its frames back at the capture's size.
+//////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "RenderTypes.h"
+
+#if defined(PONG_RENDERER_SOFTWARE)
+	#include "SoftwareRenderer.h"
+	typedef CSoftwareRenderer	CRenderer;
+#elif defined(PONG_RENDERER_NULL) || !defined(_WIN32)
+	#include "NullRenderer.h"
+	typedef CNullRenderer		CRenderer;
+#else
+	#define PONG_RENDERER_D3D9
+	#include "D3D9Renderer.h"
+	typedef CD3D9Renderer		CRenderer;
+#endif
@@ -0,0 +1,191 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	ResourceRegistry.cpp
+// Date:	October 19th, 2026
+// Purpose: Handle table for the game's system objects, see
+//			ResourceRegistry.h.
+//////////////////////////////////////////////////////////////////////////
+#include "ResourceRegistry.h"
+#include <stdio.h>
+
+// Slots are 16 bits and generations 15, so handles stay positive
+#define MAX_GENERATION 0x7FFF
+
+static_assert(MAX_RESOURCES <= 0xFFFF, "Resource slots must fit 16 bits of a handle");
+
+CResourceRegistry::CResourceRegistry(void)
+{
+	m_nOrder	= 0;
+	for(int i = 0; i < MAX_RESOURCES; ++i)
+		m_Generation[i] = 0;
+	for(int i = 0; i < RESOURCE_TYPE_COUNT; ++i)
+	{
+		m_nCount[i] = 0;
+		m_nBytes[i] = 0;
+	}
+}
+
+CResourceRegistry::~CResourceRegistry(void)
+{
+	ReleaseAll();
+}
+
+ResourceHandle CResourceRegistry::Add(ResourceType type, const char* name, void* object, ResourceReleaseFunc release,
+									  size_t bytes, ResourceHandle parent)
+{
+	if(!object)
+		return INVALID_RESOURCE;
+
+	Entry* entry = m_Entries.Create();
+	if(!entry)
+	{
+		if(release)
+			release(object);
+		return INVALID_RESOURCE;
+	}
+
+	// A stale parent is not kept alive, there is nothing left to keep
+	if(!AddRef(parent))
+		parent = INVALID_RESOURCE;
+
+	int slot = m_Entries.IndexOf(entry);
+	int& generation = m_Generation[slot];
+	generation = generation < MAX_GENERATION ? generation + 1 : 1;
+
+	entry->object		= object;
+	entry->release		= release;
+	entry->name			= name ? name : "";
+	entry->bytes		= bytes;
+	entry->refs			= 1;
+	entry->parent		= parent;
+	entry->type			= type;
+	entry->order		= m_nOrder++;
+
+	++m_nCount[type];
+	m_nBytes[type] += bytes;
+	return (generation << 16) | slot;
+}
+
+bool CResourceRegistry::Replace(ResourceHandle handle, void* object, size_t bytes)
+{
+	int slot = FindSlot(handle);
+	if(slot < 0 || !object)
+		return false;
+
+	Entry& entry = *m_Entries.Get(slot);
+	void* old = entry.object;
+	m_nBytes[entry.type] += bytes;
+	m_nBytes[entry.type] -= entry.bytes;
+	entry.object	= object;
+	entry.bytes		= bytes;
+	if(old != object && entry.release)
+		entry.release(old);
+	return true;
+}
+
+bool CResourceRegistry::AddRef(ResourceHandle handle)
+{
+	int slot = FindSlot(handle);
+	if(slot < 0)
+		return false;
+	++m_Entries.Get(slot)->refs;
+	return true;
+}
+
+bool CResourceRegistry::Release(ResourceHandle handle)
+{
+	int slot = FindSlot(handle);
+	if(slot < 0)
+		return false;
+	if(--m_Entries.Get(slot)->refs <= 0)
+		Destroy(slot);
+	return true;
+}
+
+void CResourceRegistry::Destroy(int slot)
+{
+	// The slot is freed before the object is released, so the release
+	// function and the parent's release see a consistent table
+	Entry* entry = m_Entries.Get(slot);
+	void* object				= entry->object;
+	ResourceReleaseFunc release	= entry->release;
+	ResourceHandle parent		= entry->parent;
+
+	--m_nCount[entry->type];
+	m_nBytes[entry->type] -= entry->bytes;
+	m_Entries.Destroy(entry);
+
+	if(release)
+		release(object);
+	Release(parent);
+}
+
+int CResourceRegistry::ReleaseAll(std::string* report)
+{
+	int held = 0;
+	for(;;)
+	{
+		// Newest first, a child is always added after its parent
+		int newest = -1;
+		for(int i = 0; i < m_Entries.GetCapacity(); ++i)
+		{
+			if(m_Entries.IsAlive(i) && (newest < 0 || m_Entries.Get(i)->order > m_Entries.Get(newest)->order))
+				newest = i;
+		}
+		if(newest < 0)
+			break;
+
+		// A parent's only references may be the ones its children held,
+		// releasing them released it
+		const Entry& entry = *m_Entries.Get(newest);
+		if(entry.refs > 0)
+		{
+			++held;
+			if(report)
+			{
+				char line[256];
+				sprintf(line, "%s: %s, %lu bytes, %d reference%s\n", GetResourceTypeName(entry.type),
+					entry.name.c_str(), (unsigned long)entry.bytes, entry.refs, entry.refs == 1 ? "" : "s");
+				*report += line;
+			}
+		}
+		Destroy(newest);
+	}
+	return held;
+}
+
+int CResourceRegistry::GetRefCount(ResourceHandle handle) const
+{
+	int slot = FindSlot(handle);
+	return slot < 0 ? 0 : m_Entries.Get(slot)->refs;
+}
+
+void CResourceRegistry::FormatUsage(std::string& text) const
+{
+	text.clear();
+	for(int i = 0; i < RESOURCE_TYPE_COUNT; ++i)
+	{
+		char part[64];
+		// Short enough for one line of the score font at 800x600
+		if(i == RESOURCE_DEVICE)
+			sprintf(part, "%s %d", GetResourceTypeName((ResourceType)i), m_nCount[i]);
+		else
+			sprintf(part, "%s %.1f MB  ", GetResourceTypeName((ResourceType)i), m_nBytes[i] / (1024.0 * 1024.0));
+		text += part;
+	}
+}
+
+int CResourceRegistry::GetTotalCount() const
+{
+	int count = 0;
+	for(int i = 0; i < RESOURCE_TYPE_COUNT; ++i)
+		count += m_nCount[i];
+	return count;
+}
+
+size_t CResourceRegistry::GetTotalBytes() const
+{
+	size_t bytes = 0;
+	for(int i = 0; i < RESOURCE_TYPE_COUNT; ++i)
+		bytes += m_nBytes[i];
+	return bytes;
+}
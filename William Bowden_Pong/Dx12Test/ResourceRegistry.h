@@ -0,0 +1,242 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	ResourceRegistry.h
+// Date:	October 19th, 2026
+// Purpose: One table of everything the game gets from D3D9, FMOD,
+//			DirectInput and DirectShow.  Each object is added once with
+//			the function that releases it and the memory it holds, and is
+//			then reached through a generational handle: a handle to an
+//			object that has been released, and to whatever later reuses
+//			its slot, looks up as NULL instead of a dangling pointer.
+//			Objects are reference counted, CResourceRef holds one
+//			reference for as long as it lives, and an object made from
+//			another (a texture from a device, a sound from the FMOD
+//			system) holds a reference on it, so parents always outlive
+//			their children whatever order the owners let go in.
+//			Memory is totalled per ResourceType for the F3 overlay, and
+//			ReleaseAll() at shutdown reports anything still held.  Not
+//			thread safe, only the frame thread uses it.
+//
+//			The entries live in a CObjectPool, so adding and releasing
+//			objects, reloads included, never grows or moves the table.
+//////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <stddef.h>
+#include <string>
+#include "ObjectPool.h"
+
+enum ResourceType
+{
+	RESOURCE_TEXTURE,					// Sprite textures, bytes of every mip level
+	RESOURCE_SOUND,						// Decoded samples
+	RESOURCE_FONT,						// Glyph cache, estimated
+	RESOURCE_DEVICE,					// Devices, systems and interfaces, no size of their own
+	RESOURCE_TYPE_COUNT
+};
+
+// Bits 0-15 are the slot, bits 16-30 its generation, which is never 0.
+// A handle is always positive, so it fits SpriteTexture::id.
+typedef int ResourceHandle;
+#define INVALID_RESOURCE 0
+
+// Objects held at once, the game holds a few dozen
+#define MAX_RESOURCES 1024
+
+// Called once, when the last reference goes
+typedef void (*ResourceReleaseFunc)(void* object);
+
+// ResourceReleaseFunc for COM interfaces
+template<class T>
+void ReleaseComObject(void* object)
+{
+	((T*)object)->Release();
+}
+
+inline const char* GetResourceTypeName(ResourceType type)
+{
+	static const char* const names[RESOURCE_TYPE_COUNT] = { "Textures", "Sounds", "Fonts", "Devices" };
+	return type >= 0 && type < RESOURCE_TYPE_COUNT ? names[type] : "Unknown";
+}
+
+class CResourceRegistry
+{
+	struct Entry
+	{
+		void*				object;
+		ResourceReleaseFunc	release;
+		std::string			name;
+		size_t				bytes;
+		int					refs;
+		ResourceHandle		parent;
+		ResourceType		type;
+		unsigned int		order;			// Adds before this one, children are released first
+	};
+
+	CObjectPool<Entry, MAX_RESOURCES>	m_Entries;
+	int					m_Generation[MAX_RESOURCES];	// Of each slot, kept while it is free
+	unsigned int		m_nOrder;
+	int					m_nCount[RESOURCE_TYPE_COUNT];
+	size_t				m_nBytes[RESOURCE_TYPE_COUNT];
+
+	// Not copyable, it owns what was added
+	CResourceRegistry(const CResourceRegistry&);
+	CResourceRegistry& operator=(const CResourceRegistry&);
+
+	// Slot of a live handle, -1 if the handle is stale or invalid
+	int FindSlot(ResourceHandle handle) const
+	{
+		int slot = handle & 0xFFFF;
+		if(handle <= 0 || slot >= MAX_RESOURCES || !m_Entries.IsAlive(slot) || m_Generation[slot] != (handle >> 16))
+		{
+			return -1;
+		}
+		return slot;
+	}
+
+	void Destroy(int slot);
+
+public:
+	CResourceRegistry(void);
+	~CResourceRegistry(void);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Add
+	// Parameters:	ResourceType type - What to total its bytes under
+	//				const char* name - For the leak report, e.g. the file
+	//				void* object - Object to own, NULL if creating it
+	//					failed
+	//				ResourceReleaseFunc release - Frees it
+	//				size_t bytes - Memory it holds
+	//				ResourceHandle parent - Object it was made from, kept
+	//					alive until this one is released
+	// Return:		ResourceHandle - Holding one reference,
+	//				INVALID_RESOURCE if object is NULL
+	// Description:	Takes ownership of the object.  If the table is full
+	//				(MAX_RESOURCES objects) it is released straight away.
+	//////////////////////////////////////////////////////////////////////////
+	ResourceHandle Add(ResourceType type, const char* name, void* object, ResourceReleaseFunc release,
+					   size_t bytes, ResourceHandle parent = INVALID_RESOURCE);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Replace
+	// Parameters:	ResourceHandle handle - Live object to replace
+	//				void* object - New object, released by the same
+	//					function
+	//				size_t bytes - Memory the new object holds
+	// Return:		bool - false if the handle is stale, the caller then
+	//				still owns the new object
+	// Description:	Releases the old object and keeps the handle and its
+	//				references, for reloading a texture or sound in place.
+	//////////////////////////////////////////////////////////////////////////
+	bool Replace(ResourceHandle handle, void* object, size_t bytes);
+
+	// false if the handle is stale
+	bool AddRef(ResourceHandle handle);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Release
+	// Parameters:	ResourceHandle handle - Reference to drop
+	// Return:		bool - false if the handle is stale
+	// Description:	The last reference releases the object, frees its
+	//				slot for a later Add() with a new generation, and
+	//				then drops the reference it held on its parent.
+	//////////////////////////////////////////////////////////////////////////
+	bool Release(ResourceHandle handle);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		ReleaseAll
+	// Parameters:	std::string* report - Receives a line for each object
+	//					still held, NULL for none
+	// Return:		int - Objects that were still held, 0 when every owner
+	//				released what it added
+	// Description:	Releases everything left, newest first so children go
+	//				before their parents.  Handles to them go stale.
+	//////////////////////////////////////////////////////////////////////////
+	int ReleaseAll(std::string* report = 0);
+
+	// Object behind a handle, NULL if the handle is stale
+	void* Get(ResourceHandle handle) const
+	{
+		int slot = FindSlot(handle);
+		return slot < 0 ? 0 : m_Entries.Get(slot)->object;
+	}
+
+	bool IsValid(ResourceHandle handle) const	{ return FindSlot(handle) >= 0; }
+	int GetRefCount(ResourceHandle handle) const;
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		FormatUsage
+	// Parameters:	std::string& text - Receives one line, e.g.
+	//					"Textures 1.4 MB  Sounds 2.1 MB  Fonts 0.3 MB  Devices 12"
+	// Return:		void
+	// Description:	Resident memory per type and the number of devices,
+	//				for the overlay and logs.
+	//////////////////////////////////////////////////////////////////////////
+	void FormatUsage(std::string& text) const;
+
+	int GetCount(ResourceType type) const		{ return m_nCount[type]; }
+	size_t GetBytes(ResourceType type) const	{ return m_nBytes[type]; }
+	int GetTotalCount() const;
+	size_t GetTotalBytes() const;
+};
+
+//////////////////////////////////////////////////////////////////////////
+// One reference to a registry object, released when it is destroyed or
+// reset.  Copying takes another reference.  Get() is NULL once the
+// object has gone, e.g. after ReleaseAll().
+//////////////////////////////////////////////////////////////////////////
+template<class T>
+class CResourceRef
+{
+	CResourceRegistry*	m_pRegistry;
+	ResourceHandle		m_hResource;
+
+public:
+	CResourceRef(void)
+		: m_pRegistry(0), m_hResource(INVALID_RESOURCE)
+	{
+	}
+
+	CResourceRef(const CResourceRef& other)
+		: m_pRegistry(other.m_pRegistry), m_hResource(other.m_hResource)
+	{
+		if(m_pRegistry)
+			m_pRegistry->AddRef(m_hResource);
+	}
+
+	CResourceRef& operator=(const CResourceRef& other)
+	{
+		if(other.m_pRegistry)
+			other.m_pRegistry->AddRef(other.m_hResource);
+		Reset();
+		m_pRegistry	= other.m_pRegistry;
+		m_hResource	= other.m_hResource;
+		return *this;
+	}
+
+	~CResourceRef(void)
+	{
+		Reset();
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Reset
+	// Parameters:	CResourceRegistry* registry - Registry the handle is
+	//					from, NULL to hold nothing
+	//				ResourceHandle handle - Reference to take over, e.g.
+	//					the one Add() returned
+	// Return:		void
+	// Description:	Drops the reference held before.
+	//////////////////////////////////////////////////////////////////////////
+	void Reset(CResourceRegistry* registry = 0, ResourceHandle handle = INVALID_RESOURCE)
+	{
+		if(m_pRegistry)
+			m_pRegistry->Release(m_hResource);
+		m_pRegistry	= handle != INVALID_RESOURCE ? registry : 0;
+		m_hResource	= m_pRegistry ? handle : INVALID_RESOURCE;
+	}
+
+	T* Get() const					{ return m_pRegistry ? (T*)m_pRegistry->Get(m_hResource) : 0; }
+	T* operator->() const			{ return Get(); }
+	ResourceHandle GetHandle() const	{ return m_hResource; }
+	bool IsValid() const			{ return Get() != 0; }
+};
@@ -0,0 +1,242 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	Rollback.cpp
+// Date:	October 19th, 2026
+// Purpose: Rollback netcode, see Rollback.h.
+//////////////////////////////////////////////////////////////////////////
+#include "Rollback.h"
+#include "PaddleController.h"
+#include "PongPlatform.h"
+#include <stdio.h>
+#include <string.h>
+
+// Packet layout, all numbers little endian:
+//	u8	NET_PACKET_INPUTS
+//	u32	frames of the receiver's inputs the sender has, an acknowledgement
+//	u32	first frame of the inputs that follow
+//	u8	number of inputs
+//	u8	inputs, one per frame
+#define NET_PACKET_INPUTS 1
+#define NET_PACKET_HEADER 10
+
+// m_nFirstWrong when every frame ran on the right input
+#define NET_NO_ROLLBACK 0x7FFFFFFF
+
+namespace
+{
+	void WriteU32(unsigned char* p, unsigned int value)
+	{
+		p[0] = (unsigned char)value;
+		p[1] = (unsigned char)(value >> 8);
+		p[2] = (unsigned char)(value >> 16);
+		p[3] = (unsigned char)(value >> 24);
+	}
+
+	unsigned int ReadU32(const unsigned char* p)
+	{
+		return p[0] | (p[1] << 8) | (p[2] << 16) | ((unsigned int)p[3] << 24);
+	}
+}
+
+CRollbackSession::CRollbackSession(void)
+{
+	Init(0, 0, 0, 0);
+}
+
+void CRollbackSession::Init(CNetTransport* transport, int localPaddle, int inputDelay, int tickRate)
+{
+	if(tickRate < 0)
+		tickRate = 0;
+	if(inputDelay < 0)
+		inputDelay = 0;
+	if(inputDelay > NET_MAX_INPUT_DELAY)
+		inputDelay = NET_MAX_INPUT_DELAY;
+
+	m_pTransport	= transport;
+	m_nLocal		= localPaddle;
+	m_nDelay		= inputDelay;
+	m_nTickRate		= tickRate;
+	m_bStarted		= false;
+	m_nFrame		= 0;
+	m_nLocalFrames	= 0;
+	m_nRemoteFrames	= 0;
+	m_nRemoteAcked	= 0;
+	m_nFirstWrong	= NET_NO_ROLLBACK;
+	memset(m_LocalInputs, 0, sizeof(m_LocalInputs));
+	memset(m_RemoteInputs, 0, sizeof(m_RemoteInputs));
+	memset(m_UsedInputs, 0, sizeof(m_UsedInputs));
+	memset(&m_Stats, 0, sizeof(m_Stats));
+	m_History.Clear();
+}
+
+bool CRollbackSession::Advance(CPongGame& game, int localInputs, int& sounds, CGameEventBuffer* events)
+{
+	sounds = 0;
+	if(!m_bStarted)
+	{
+		// Nobody pressed anything during the delay at the start
+		m_nLocalFrames	= m_nDelay;
+		m_nRemoteFrames	= m_nDelay;
+		m_nRemoteAcked	= m_nDelay;
+		m_bStarted		= true;
+	}
+
+	ReceiveInputs();
+
+	// This frame's input, for the frame the delay puts it in.  While
+	// waiting for the peer it already has one.
+	if(m_nLocalFrames <= m_nFrame + m_nDelay)
+	{
+		m_LocalInputs[m_nLocalFrames % NET_HISTORY_FRAMES] = (unsigned char)localInputs;
+		++m_nLocalFrames;
+	}
+
+	// Sent every call, lost packets are covered by the next one
+	SendInputs();
+
+	if(m_nFirstWrong < m_nFrame)
+		Rollback(game);
+
+	if(m_nFrame - m_nRemoteFrames >= NET_MAX_PREDICTION)
+	{
+		++m_Stats.stalls;
+		return false;
+	}
+
+	sounds = RunFrame(game, events);
+	++m_Stats.frames;
+	return true;
+}
+
+int CRollbackSession::GetFrameTicks(int frame) const
+{
+	if(m_nTickRate <= 0 || frame < 0)
+		return 1;
+
+	// The ticks due by the end of the frame less those due by its start
+	long long end = (long long)(frame + 1) * m_nTickRate / NET_FRAME_RATE;
+	long long start = (long long)frame * m_nTickRate / NET_FRAME_RATE;
+	return (int)(end - start);
+}
+
+const PongState* CRollbackSession::GetSavedState(int frame) const
+{
+	if(frame < 0)
+		return 0;
+	return m_History.Find((unsigned int)frame);
+}
+
+void CRollbackSession::Format(std::string& text) const
+{
+	char line[256];
+	sprintf(line, "Online: %d frames at %d a second, %d rollbacks running %d frames again (longest %d), "
+		"%d stalls waiting for the peer, %d packets sent, %d received\n", m_Stats.frames, NET_FRAME_RATE,
+		m_Stats.rollbacks, m_Stats.resimulated, m_Stats.longestRollback, m_Stats.stalls, m_Stats.packetsSent,
+		m_Stats.packetsReceived);
+	text = line;
+}
+
+void CRollbackSession::ReceiveInputs()
+{
+	if(!m_pTransport)
+		return;
+
+	unsigned char packet[NET_MAX_PACKET];
+	int size;
+	while((size = m_pTransport->Receive(packet, sizeof(packet))) > 0)
+	{
+		if(size < NET_PACKET_HEADER || packet[0] != NET_PACKET_INPUTS)
+			continue;
+		int acked = (int)ReadU32(packet + 1);
+		int first = (int)ReadU32(packet + 5);
+		int count = packet[9];
+		if(size < NET_PACKET_HEADER + count)
+			continue;
+		++m_Stats.packetsReceived;
+
+		if(acked > m_nRemoteAcked)
+			m_nRemoteAcked = acked;
+
+		// Every packet starts at or before the first input still missing,
+		// so new inputs only ever extend the known run
+		for(int i = 0; i < count; ++i)
+		{
+			int frame = first + i;
+			if(frame != m_nRemoteFrames)
+				continue;
+
+			unsigned char input = packet[NET_PACKET_HEADER + i];
+			m_RemoteInputs[frame % NET_HISTORY_FRAMES] = input;
+			if(frame < m_nFrame && m_UsedInputs[frame % NET_HISTORY_FRAMES] != input && frame < m_nFirstWrong)
+				m_nFirstWrong = frame;
+			++m_nRemoteFrames;
+		}
+	}
+}
+
+void CRollbackSession::SendInputs()
+{
+	if(!m_pTransport)
+		return;
+
+	// Everything the peer has not acknowledged, oldest first
+	int first = m_nRemoteAcked < m_nLocalFrames ? m_nRemoteAcked : m_nLocalFrames;
+	if(first < m_nLocalFrames - NET_HISTORY_FRAMES)
+		first = m_nLocalFrames - NET_HISTORY_FRAMES;
+	int count = m_nLocalFrames - first;
+
+	unsigned char packet[NET_PACKET_HEADER + NET_HISTORY_FRAMES];
+	packet[0] = NET_PACKET_INPUTS;
+	WriteU32(packet + 1, (unsigned int)m_nRemoteFrames);
+	WriteU32(packet + 5, (unsigned int)first);
+	packet[9] = (unsigned char)count;
+	for(int i = 0; i < count; ++i)
+		packet[NET_PACKET_HEADER + i] = m_LocalInputs[(first + i) % NET_HISTORY_FRAMES];
+
+	if(m_pTransport->Send(packet, NET_PACKET_HEADER + count))
+		++m_Stats.packetsSent;
+}
+
+void CRollbackSession::Rollback(CPongGame& game)
+{
+	double start = PlatformGetTime();
+
+	int now = m_nFrame;
+	m_nFrame = m_nFirstWrong;
+
+	// Always held, the prediction window is well inside the history
+	game.LoadState(*m_History.Find((unsigned int)m_nFrame));
+	m_History.Truncate((unsigned int)m_nFrame);
+	while(m_nFrame < now)
+		RunFrame(game, 0);
+
+	int frames = now - m_nFirstWrong;
+	++m_Stats.rollbacks;
+	m_Stats.resimulated += frames;
+	if(frames > m_Stats.longestRollback)
+		m_Stats.longestRollback = frames;
+	m_Stats.rollbackSeconds += PlatformGetTime() - start;
+	m_nFirstWrong = NET_NO_ROLLBACK;
+}
+
+int CRollbackSession::RunFrame(CPongGame& game, CGameEventBuffer* events)
+{
+	int slot = m_nFrame % NET_HISTORY_FRAMES;
+	m_History.Record(game);
+
+	// The peer's input if it arrived, else a guess that it is still holding
+	// what it held last
+	unsigned char remote;
+	if(m_nFrame < m_nRemoteFrames)
+		remote = m_RemoteInputs[slot];
+	else
+		remote = m_nRemoteFrames > 0 ? m_RemoteInputs[(m_nRemoteFrames - 1) % NET_HISTORY_FRAMES] : 0;
+	m_UsedInputs[slot] = remote;
+
+	int keys = GetInputKeys(m_nLocal, m_LocalInputs[slot]) | GetInputKeys(1 - m_nLocal, remote);
+	int ticks = GetFrameTicks(m_nFrame);
+	int sounds = 0;
+	for(int i = 0; i < ticks; ++i)
+		sounds |= game.Tick(keys, 0, events);
+	++m_nFrame;
+	return sounds;
+}
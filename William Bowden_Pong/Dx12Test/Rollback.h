@@ -0,0 +1,166 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	Rollback.h
+// Date:	October 19th, 2026
+// Purpose: Online versus play with input delay and rollback.  Each peer
+//			owns one paddle and only the up / down inputs of the paddles
+//			cross the network.  Local inputs are applied a few frames
+//			late so they usually reach the peer in time.  When the
+//			peer's input for a frame has not arrived, its last known
+//			input is assumed and the frame runs anyway.  When the real
+//			input turns out different, the game is put back to the
+//			state saved before that frame and the frames since are run
+//			again.  A PongState is a few dozen bytes, so a state is kept
+//			for every frame.
+//
+//			Both peers have to start from the same state, so Advance()
+//			is only called once the match is under way and the first
+//			call starts the session.  A peer that is still in the menus
+//			holds the other one up after NET_MAX_PREDICTION frames.
+//
+//			A frame is not a match tick.  The match ticks thousands of
+//			times a second ([Video] TickRate), far too often to send an
+//			input or keep a state for each, so every frame runs the
+//			match ticks that fall in its 1 / NET_FRAME_RATE of a second
+//			on the inputs held for the frame.
+//////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <string>
+#include "PongGame.h"
+#include "StateHistory.h"
+#include "NetTransport.h"
+
+// Frames a second the session runs at.  Frames are what it counts,
+// sends an input for and rolls back by, so the limits below are set in
+// frames of this length and would need scaling with it.  The caller has
+// to call Advance() this often, however fast it ticks the match, see
+// GetFrameTicks().
+#define NET_FRAME_RATE 60
+
+// Most frames to run ahead of the peer's inputs before waiting for them,
+// half a second
+#define NET_MAX_PREDICTION (NET_FRAME_RATE / 2)
+
+// Most frames local input can be delayed by, an eighth of a second
+#define NET_MAX_INPUT_DELAY (NET_FRAME_RATE / 8)
+
+// States and inputs kept, a power of two that covers the prediction
+// window and input delay on both sides
+#define NET_HISTORY_FRAMES 128
+
+static_assert(NET_HISTORY_FRAMES >= 2 * (NET_MAX_PREDICTION + NET_MAX_INPUT_DELAY),
+	"NET_HISTORY_FRAMES must cover the prediction window and input delay on both sides");
+static_assert((NET_HISTORY_FRAMES & (NET_HISTORY_FRAMES - 1)) == 0 && NET_HISTORY_FRAMES < 256,
+	"NET_HISTORY_FRAMES must be a power of two that fits a packet's input count");
+
+struct RollbackStats
+{
+	int					frames;				// Frames run for the first time
+	int					rollbacks;			// Mispredictions corrected
+	int					resimulated;		// Frames run again by them
+	int					longestRollback;	// Most frames one rollback ran again
+	int					stalls;				// Advance() calls that waited for the peer
+	int					packetsSent;
+	int					packetsReceived;
+	double				rollbackSeconds;	// Time spent restoring and running again
+};
+
+class CRollbackSession
+{
+	CNetTransport*		m_pTransport;
+	int					m_nLocal;			// Paddle played here, 0 left or 1 right
+	int					m_nDelay;
+	int					m_nTickRate;		// Match ticks a second, 0 for one a frame
+	bool				m_bStarted;
+
+	int					m_nFrame;			// Next frame to run
+	int					m_nLocalFrames;		// Local inputs known for frames below this
+	int					m_nRemoteFrames;	// Peer inputs received for frames below this
+	int					m_nRemoteAcked;		// The peer has our inputs below this
+	int					m_nFirstWrong;		// Earliest frame run on a wrong guess
+
+	// Indexed by frame % NET_HISTORY_FRAMES
+	unsigned char		m_LocalInputs[NET_HISTORY_FRAMES];
+	unsigned char		m_RemoteInputs[NET_HISTORY_FRAMES];	// As received
+	unsigned char		m_UsedInputs[NET_HISTORY_FRAMES];	// Peer input the frame ran with
+
+	// State before each frame, tick numbers are frame numbers
+	CStateHistory<NET_HISTORY_FRAMES>	m_History;
+
+	RollbackStats		m_Stats;
+
+	CRollbackSession(const CRollbackSession&);
+	CRollbackSession& operator=(const CRollbackSession&);
+
+	void ReceiveInputs();
+	void SendInputs();
+	void Rollback(CPongGame& game);
+	int RunFrame(CPongGame& game, CGameEventBuffer* events);
+
+public:
+	CRollbackSession(void);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Init
+	// Parameters:	CNetTransport* transport - Connection to the peer, not
+	//					owned
+	//				int localPaddle - 0 for the left paddle, 1 for the
+	//					right, the peer must use the other one
+	//				int inputDelay - Frames local input is held back,
+	//					both peers should use the same delay
+	//				int tickRate - Match ticks a second, both peers must
+	//					use the same rate.  0 runs one tick a frame.
+	// Return:		void
+	// Description:	Forgets any previous session.
+	//////////////////////////////////////////////////////////////////////////
+	void Init(CNetTransport* transport, int localPaddle, int inputDelay, int tickRate);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Advance
+	// Parameters:	CPongGame& game - The match, the same object every call
+	//				int localInputs - INPUT_UP / INPUT_DOWN for the local
+	//					paddle this frame
+	//				int& sounds - Receives the frame's SOUND1 / SOUND2
+	//				CGameEventBuffer* events - Receives the frame's events,
+	//					may be NULL
+	// Return:		bool - false if the frame was not run because the peer
+	//				is too far behind
+	// Description:	Exchanges inputs, rolls back if a guess was wrong and
+	//				runs the next frame's GetFrameTicks() match ticks.
+	//				Sounds and events of frames that are run again are
+	//				not repeated.
+	//////////////////////////////////////////////////////////////////////////
+	bool Advance(CPongGame& game, int localInputs, int& sounds, CGameEventBuffer* events = 0);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		GetFrameTicks
+	// Parameters:	int frame - Frame to look up
+	// Return:		int - Match ticks the frame runs
+	// Description:	tickRate / NET_FRAME_RATE, 66 or 67 at 4000.  Worked out
+	//				from the frame number, so both peers and every run
+	//				again of a frame agree.
+	//////////////////////////////////////////////////////////////////////////
+	int GetFrameTicks(int frame) const;
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		GetSavedState
+	// Parameters:	int frame - Frame to look up
+	// Return:		const PongState* - State before the frame ran, NULL if
+	//				it has not run or is too old
+	// Description:	Frames below GetConfirmedFrame() will not change again,
+	//				so peers can compare them to check they agree.
+	//////////////////////////////////////////////////////////////////////////
+	const PongState* GetSavedState(int frame) const;
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Format
+	// Parameters:	std::string& text - Receives a line with the counts
+	// Return:		void
+	// Description:	For the log at shutdown.
+	//////////////////////////////////////////////////////////////////////////
+	void Format(std::string& text) const;
+
+	int GetFrame() const					{ return m_nFrame; }
+	int GetConfirmedFrame() const			{ return m_nRemoteFrames < m_nFrame ? m_nRemoteFrames : m_nFrame; }
+	int GetLocalPaddle() const				{ return m_nLocal; }
+	const RollbackStats& GetStats() const	{ return m_Stats; }
+};
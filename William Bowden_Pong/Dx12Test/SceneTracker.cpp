@@ -0,0 +1,57 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	SceneTracker.cpp
+// Date:	October 19th, 2026
+// Purpose: Visible scene change tracking, see SceneTracker.h.
+//////////////////////////////////////////////////////////////////////////
+#include "SceneTracker.h"
+#include <math.h>
+#include <string.h>
+
+CSceneTracker::CSceneTracker(void)
+{
+	memset(&m_Drawn, 0, sizeof(m_Drawn));
+	m_bValid	= false;
+	m_nDrawn	= 0;
+	m_nSkipped	= 0;
+}
+
+void CSceneTracker::MakeKey(const CPongGame& game, SceneKey& key)
+{
+	memset(&key, 0, sizeof(key));
+
+	const myStartMenu& Menu = game.Menu;
+	key.menu =	(Menu.onSTART		? 0x01 : 0) |
+				(Menu.onCREDITS		? 0x02 : 0) |
+				(Menu.onCREDITS2	? 0x04 : 0) |
+				(Menu.onEXIT		? 0x08 : 0) |
+				(Menu.onGAME		? 0x10 : 0) |
+				(Menu.onMovie		? 0x20 : 0);
+
+	// The match is only on screen while it is being played
+	if(Menu.onGAME)
+	{
+		key.points[0]	= game.Player1Point;
+		key.points[1]	= game.Player2Point;
+		key.paddle[0]	= (int)floor(game.Paddle[0].yp + 0.5f);
+		key.paddle[1]	= (int)floor(game.Paddle[1].yp + 0.5f);
+		key.ballX		= (int)floor(game.Ball.xp + 0.5f);
+		key.ballY		= (int)floor(game.Ball.yp + 0.5f);
+	}
+}
+
+bool CSceneTracker::NeedsRedraw(const CPongGame& game)
+{
+	SceneKey key;
+	MakeKey(game, key);
+
+	if(m_bValid && memcmp(&key, &m_Drawn, sizeof(key)) == 0)
+	{
+		++m_nSkipped;
+		return false;
+	}
+
+	m_Drawn = key;
+	m_bValid = true;
+	++m_nDrawn;
+	return true;
+}
@@ -0,0 +1,66 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	SceneTracker.h
+// Date:	October 19th, 2026
+// Purpose: Decides whether the visible scene changed since the last frame
+//			that was drawn.  The menus never move, and the ball and paddles
+//			move a fraction of a pixel per tick, so most frames look the
+//			same as the one already on screen and need no Clear, draw or
+//			Present at all.
+//////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "PongGame.h"
+
+class CSceneTracker
+{
+	// Everything that decides what the frame looks like, positions in
+	// whole pixels
+	struct SceneKey
+	{
+		int				menu;			// One bit per menu screen
+		int				points[2];
+		int				paddle[2];		// Paddle heights, x never changes
+		int				ballX;
+		int				ballY;
+	};
+
+	SceneKey			m_Drawn;		// Scene currently on screen
+	bool				m_bValid;		// m_Drawn is on screen
+	int					m_nDrawn;		// Frames drawn
+	int					m_nSkipped;		// Frames skipped as unchanged
+
+	static void MakeKey(const CPongGame& game, SceneKey& key);
+
+public:
+	CSceneTracker(void);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		NeedsRedraw
+	// Parameters:	const CPongGame& game - State about to be drawn
+	// Return:		bool - true if the frame must be drawn and presented
+	// Description:	Compares the game against the last drawn scene: a menu
+	//				change, a point or anything moving by a whole pixel.
+	//				Returning true records the game as drawn.
+	//////////////////////////////////////////////////////////////////////////
+	bool NeedsRedraw(const CPongGame& game);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		IsStatic
+	// Parameters:	const CPongGame& game - Current state
+	// Return:		bool - true if nothing on screen moves by itself
+	// Description:	Menus only change on input, so the loop can sleep until
+	//				input arrives.  During a match the ball keeps moving.
+	//////////////////////////////////////////////////////////////////////////
+	static bool IsStatic(const CPongGame& game)	{ return !game.Menu.onGAME && !game.Menu.onMovie; }
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Invalidate
+	// Parameters:	void
+	// Return:		void
+	// Description:	Forces the next frame to be drawn, for when the screen
+	//				contents were lost (window repaint, device reset).
+	//////////////////////////////////////////////////////////////////////////
+	void Invalidate()		{ m_bValid = false; }
+
+	int GetDrawnCount() const	{ return m_nDrawn; }
+	int GetSkippedCount() const	{ return m_nSkipped; }
+};
@@ -0,0 +1,547 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	SoftwareRenderer.cpp
+// Date:	October 19th, 2026
+// Purpose: CPU renderer backend, see SoftwareRenderer.h.
+//////////////////////////////////////////////////////////////////////////
+#include "SoftwareRenderer.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__SSE2__)
+	#define SOFTWARE_SSE2
+	#include <emmintrin.h>
+#endif
+
+namespace
+{
+	// 5x7 glyphs for the score text, bit 4 is the leftmost column
+	struct Glyph
+	{
+		wchar_t			character;
+		unsigned char	rows[7];
+	};
+
+	const Glyph GLYPHS[] =
+	{
+		{ L'0', { 0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E } },
+		{ L'1', { 0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E } },
+		{ L'2', { 0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F } },
+		{ L'3', { 0x1F, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0E } },
+		{ L'4', { 0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02 } },
+		{ L'5', { 0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E } },
+		{ L'6', { 0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E } },
+		{ L'7', { 0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08 } },
+		{ L'8', { 0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E } },
+		{ L'9', { 0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C } },
+		{ L'A', { 0x0E, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11 } },
+		{ L'B', { 0x1E, 0x11, 0x11, 0x1E, 0x11, 0x11, 0x1E } },
+		{ L'C', { 0x0E, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0E } },
+		{ L'D', { 0x1C, 0x12, 0x11, 0x11, 0x11, 0x12, 0x1C } },
+		{ L'E', { 0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x1F } },
+		{ L'F', { 0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x10 } },
+		{ L'G', { 0x0E, 0x11, 0x10, 0x17, 0x11, 0x11, 0x0F } },
+		{ L'H', { 0x11, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11 } },
+		{ L'I', { 0x0E, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E } },
+		{ L'J', { 0x07, 0x02, 0x02, 0x02, 0x02, 0x12, 0x0C } },
+		{ L'K', { 0x11, 0x12, 0x14, 0x18, 0x14, 0x12, 0x11 } },
+		{ L'L', { 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1F } },
+		{ L'M', { 0x11, 0x1B, 0x15, 0x15, 0x11, 0x11, 0x11 } },
+		{ L'N', { 0x11, 0x11, 0x19, 0x15, 0x13, 0x11, 0x11 } },
+		{ L'O', { 0x0E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E } },
+		{ L'P', { 0x1E, 0x11, 0x11, 0x1E, 0x10, 0x10, 0x10 } },
+		{ L'Q', { 0x0E, 0x11, 0x11, 0x11, 0x15, 0x12, 0x0D } },
+		{ L'R', { 0x1E, 0x11, 0x11, 0x1E, 0x14, 0x12, 0x11 } },
+		{ L'S', { 0x0F, 0x10, 0x10, 0x0E, 0x01, 0x01, 0x1E } },
+		{ L'T', { 0x1F, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04 } },
+		{ L'U', { 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E } },
+		{ L'V', { 0x11, 0x11, 0x11, 0x11, 0x11, 0x0A, 0x04 } },
+		{ L'W', { 0x11, 0x11, 0x11, 0x15, 0x15, 0x15, 0x0A } },
+		{ L'X', { 0x11, 0x11, 0x0A, 0x04, 0x0A, 0x11, 0x11 } },
+		{ L'Y', { 0x11, 0x11, 0x11, 0x0A, 0x04, 0x04, 0x04 } },
+		{ L'Z', { 0x1F, 0x01, 0x02, 0x04, 0x08, 0x10, 0x1F } },
+		{ L':', { 0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x0C, 0x00 } },
+		{ L'(', { 0x02, 0x04, 0x08, 0x08, 0x08, 0x04, 0x02 } },
+		{ L')', { 0x08, 0x04, 0x02, 0x02, 0x02, 0x04, 0x08 } },
+		{ L'.', { 0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C } },
+		{ L'-', { 0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00 } },
+		{ L'/', { 0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x00 } },
+		{ L'%', { 0x18, 0x19, 0x02, 0x04, 0x08, 0x13, 0x03 } },
+	};
+
+	const int GLYPH_SCALE	= 2;	// Screen pixels per glyph pixel at 800x600
+	const int GLYPH_ADVANCE	= 6;	// Glyph width plus spacing, in glyph pixels
+
+	const Glyph* FindGlyph(wchar_t c)
+	{
+		if(c >= L'a' && c <= L'z')
+			c = c - L'a' + L'A';
+		for(size_t i = 0; i < sizeof(GLYPHS) / sizeof(GLYPHS[0]); ++i)
+		{
+			if(GLYPHS[i].character == c)
+				return &GLYPHS[i];
+		}
+		return 0;
+	}
+
+	// x / 255 rounded to nearest, exact for 0 <= x <= 255 * 255.  The
+	// SSE2 path uses the same formula so both give identical pixels.
+	inline unsigned int Div255(unsigned int x)
+	{
+		x += 128;
+		return (x + (x >> 8)) >> 8;
+	}
+
+	inline unsigned int Modulate(unsigned int src, unsigned int color)
+	{
+		unsigned int a = Div255((src >> 24) * (color >> 24));
+		unsigned int r = Div255(((src >> 16) & 0xFF) * ((color >> 16) & 0xFF));
+		unsigned int g = Div255(((src >> 8) & 0xFF) * ((color >> 8) & 0xFF));
+		unsigned int b = Div255((src & 0xFF) * (color & 0xFF));
+		return (a << 24) | (r << 16) | (g << 8) | b;
+	}
+
+	// Source over destination, the destination stays opaque
+	inline unsigned int Blend(unsigned int src, unsigned int dst)
+	{
+		unsigned int a = src >> 24;
+		if(a == 0)
+			return dst;
+		if(a == 255)
+			return src;
+
+		unsigned int ia = 255 - a;
+		unsigned int r = Div255(((src >> 16) & 0xFF) * a + ((dst >> 16) & 0xFF) * ia);
+		unsigned int g = Div255(((src >> 8) & 0xFF) * a + ((dst >> 8) & 0xFF) * ia);
+		unsigned int b = Div255((src & 0xFF) * a + (dst & 0xFF) * ia);
+		return 0xFF000000 | (r << 16) | (g << 8) | b;
+	}
+
+#ifdef SOFTWARE_SSE2
+	// Blends two pixels held as 16 bit channels
+	inline __m128i Blend2(__m128i src, __m128i dst)
+	{
+		const __m128i c128 = _mm_set1_epi16(128);
+		const __m128i c255 = _mm_set1_epi16(255);
+
+		__m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(src, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+		__m128i x = _mm_add_epi16(_mm_mullo_epi16(src, alpha), _mm_mullo_epi16(dst, _mm_sub_epi16(c255, alpha)));
+		x = _mm_add_epi16(x, c128);
+		return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+	}
+#endif
+
+	// Blends a run of source pixels over the frame buffer
+	void BlendSpan(unsigned int* dst, const unsigned int* src, int count)
+	{
+		int i = 0;
+#ifdef SOFTWARE_SSE2
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i alphaMask = _mm_set1_epi32((int)0xFF000000);
+
+		for(; i + 4 <= count; i += 4)
+		{
+			__m128i s = _mm_loadu_si128((const __m128i*)(src + i));
+			__m128i a = _mm_and_si128(s, alphaMask);
+
+			// Colour keyed and fully opaque groups skip the arithmetic
+			if(_mm_movemask_epi8(_mm_cmpeq_epi32(a, zero)) == 0xFFFF)
+				continue;
+			if(_mm_movemask_epi8(_mm_cmpeq_epi32(a, alphaMask)) == 0xFFFF)
+			{
+				_mm_storeu_si128((__m128i*)(dst + i), s);
+				continue;
+			}
+
+			__m128i d = _mm_loadu_si128((const __m128i*)(dst + i));
+			__m128i lo = Blend2(_mm_unpacklo_epi8(s, zero), _mm_unpacklo_epi8(d, zero));
+			__m128i hi = Blend2(_mm_unpackhi_epi8(s, zero), _mm_unpackhi_epi8(d, zero));
+			__m128i out = _mm_or_si128(_mm_packus_epi16(lo, hi), alphaMask);
+			_mm_storeu_si128((__m128i*)(dst + i), out);
+		}
+#endif
+		for(; i < count; ++i)
+			dst[i] = Blend(src[i], dst[i]);
+	}
+}
+
+CSoftwareRenderer::CSoftwareRenderer(void)
+{
+	m_nWidth		= 0;
+	m_nHeight		= 0;
+	m_nTilesX		= 0;
+	m_nTilesY		= 0;
+	m_ClearColor	= 0xFF000000;
+	m_nGeneration	= 0;
+	m_nTilesDrawn	= 0;
+	m_nGlyphScale	= GLYPH_SCALE;
+	m_pTileStart	= 0;
+	m_pTileEntries	= 0;
+	m_pCapture		= 0;
+	m_nFrames		= 0;
+}
+
+bool CSoftwareRenderer::Init(const RendererDesc& desc)
+{
+	if(desc.width <= 0 || desc.height <= 0)
+		return false;
+
+	m_nWidth	= desc.width;
+	m_nHeight	= desc.height;
+	m_nTilesX	= (m_nWidth + SOFTWARE_TILE_SIZE - 1) / SOFTWARE_TILE_SIZE;
+	m_nTilesY	= (m_nHeight + SOFTWARE_TILE_SIZE - 1) / SOFTWARE_TILE_SIZE;
+
+	// Whole screen pixels per glyph pixel, so the text stays crisp
+	m_nGlyphScale = (int)(GLYPH_SCALE * desc.textScale + 0.5f);
+	if(m_nGlyphScale < 1)
+		m_nGlyphScale = 1;
+
+	m_FrameBuffer.assign((size_t)m_nWidth * m_nHeight, m_ClearColor);
+	m_Commands.reserve(256);
+	m_Arena.Init(SOFTWARE_ARENA_SIZE);
+	m_pTileStart	= 0;
+	m_pTileEntries	= 0;
+	m_TileHashes.assign((size_t)m_nTilesX * m_nTilesY, 0);
+	m_DirtyTiles.reserve((size_t)m_nTilesX * m_nTilesY);
+	++m_nGeneration;
+
+	m_Pool.Init(desc.threads);
+	return true;
+}
+
+void CSoftwareRenderer::Shutdown()
+{
+	m_Pool.Shutdown();
+	m_Images.clear();
+	m_Commands.clear();
+	m_Arena.Shutdown();
+	m_pTileStart	= 0;
+	m_pTileEntries	= 0;
+	m_TileHashes.clear();
+	m_DirtyTiles.clear();
+	m_FrameBuffer.clear();
+	m_pCapture = 0;
+}
+
+bool CSoftwareRenderer::LoadTexture(const wchar_t* fileName, SpriteTexture& texture)
+{
+	texture.id = -1;
+	texture.width = texture.height = 0;
+
+	char path[260];
+	wcstombs(path, fileName, sizeof(path));
+	path[sizeof(path) - 1] = 0;
+
+	SpriteImage image;
+	if(!LoadImageFile(path, image, IMAGE_COLORKEY_MAGENTA))
+		return false;
+
+	texture.id		= (int)m_Images.size();
+	texture.width	= image.width;
+	texture.height	= image.height;
+	m_Images.push_back(image);
+	++m_nGeneration;
+	return true;
+}
+
+bool CSoftwareRenderer::UpdateTexture(SpriteImage& image, SpriteTexture& texture)
+{
+	if(texture.id < 0 || texture.id >= (int)m_Images.size() || image.width <= 0 || image.height <= 0)
+		return false;
+
+	// Taken, not copied, the old pixels go back to the caller
+	SpriteImage& current = m_Images[texture.id];
+	std::swap(current.width, image.width);
+	std::swap(current.height, image.height);
+	current.pixels.swap(image.pixels);
+	texture.width	= current.width;
+	texture.height	= current.height;
+
+	// Tiles showing the old pixels hash the same as before
+	++m_nGeneration;
+	return true;
+}
+
+void CSoftwareRenderer::BeginFrame(unsigned int clearColor)
+{
+	m_ClearColor = clearColor | 0xFF000000;
+	m_Commands.clear();
+	m_Arena.Reset();
+	m_pTileStart	= 0;
+	m_pTileEntries	= 0;
+}
+
+void CSoftwareRenderer::DrawSprite(const SpriteTexture& texture, float x, float y, float scale, unsigned int color)
+{
+	if(texture.id < 0 || texture.id >= (int)m_Images.size() || scale <= 0.0f)
+		return;
+
+	DrawCommand command;
+	command.type		= COMMAND_SPRITE;
+	command.texture		= texture.id;
+	command.left		= x - texture.width * 0.5f * scale;
+	command.top			= y - texture.height * 0.5f * scale;
+	command.invScale	= 1.0f / scale;
+	command.color		= color;
+
+	// A pixel is covered when its centre falls inside the scaled sprite
+	command.x0 = (int)ceil(command.left - 0.5f);
+	command.y0 = (int)ceil(command.top - 0.5f);
+	command.x1 = (int)ceil(command.left + texture.width * scale - 0.5f);
+	command.y1 = (int)ceil(command.top + texture.height * scale - 0.5f);
+
+	if(command.x0 < 0)			command.x0 = 0;
+	if(command.y0 < 0)			command.y0 = 0;
+	if(command.x1 > m_nWidth)	command.x1 = m_nWidth;
+	if(command.y1 > m_nHeight)	command.y1 = m_nHeight;
+
+	if(command.x0 < command.x1 && command.y0 < command.y1)
+		m_Commands.push_back(command);
+}
+
+void CSoftwareRenderer::DrawSprites(const SpriteTexture& texture, const SpriteBatch& batch)
+{
+	// Binned per sprite like any other, one reserve for the lot
+	m_Commands.reserve(m_Commands.size() + batch.count);
+	for(int i = 0; i < batch.count; ++i)
+		DrawSprite(texture, batch.x[i], batch.y[i], batch.scale[i], batch.color[i]);
+}
+
+void CSoftwareRenderer::FillRect(int x, int y, int w, int h, unsigned int color)
+{
+	DrawCommand command;
+	command.type		= COMMAND_FILL;
+	command.texture		= -1;
+	command.left		= (float)x;
+	command.top			= (float)y;
+	command.invScale	= 1.0f;
+	command.color		= color;
+	command.x0			= x < 0 ? 0 : x;
+	command.y0			= y < 0 ? 0 : y;
+	command.x1			= x + w > m_nWidth ? m_nWidth : x + w;
+	command.y1			= y + h > m_nHeight ? m_nHeight : y + h;
+
+	if(command.x0 < command.x1 && command.y0 < command.y1)
+		m_Commands.push_back(command);
+}
+
+void CSoftwareRenderer::DrawString(const wchar_t* text, int x, int y, unsigned int color)
+{
+	int scale = m_nGlyphScale;
+	for(; *text; ++text, x += GLYPH_ADVANCE * scale)
+	{
+		const Glyph* glyph = FindGlyph(*text);
+		if(!glyph)
+			continue;
+
+		for(int row = 0; row < 7; ++row)
+		{
+			// One fill per horizontal run of lit glyph pixels
+			int bits = glyph->rows[row];
+			for(int col = 0; col < 5; ++col)
+			{
+				if(!(bits & (0x10 >> col)))
+					continue;
+				int run = 1;
+				while(col + run < 5 && (bits & (0x10 >> (col + run))))
+					++run;
+				FillRect(x + col * scale, y + row * scale, run * scale, scale, color);
+				col += run;
+			}
+		}
+	}
+}
+
+void CSoftwareRenderer::RasteriseTileTask(void* context, int index, int thread)
+{
+	(void)thread;
+	CSoftwareRenderer* renderer = (CSoftwareRenderer*)context;
+	renderer->RasteriseTile(renderer->m_DirtyTiles[index]);
+}
+
+unsigned long long CSoftwareRenderer::HashTile(int tile) const
+{
+	// FNV-1a over everything that decides the tile's pixels.  The
+	// generation changes whenever textures or the frame buffer do, so no
+	// hash from before then can match.
+	unsigned long long hash = 14695981039346656037ull;
+	unsigned int values[10];
+	values[0] = m_nGeneration;
+	values[1] = m_ClearColor;
+	for(int i = 0; i < 2; ++i)
+		hash = (hash ^ values[i]) * 1099511628211ull;
+
+	for(int i = m_pTileStart[tile]; i < m_pTileStart[tile + 1]; ++i)
+	{
+		const DrawCommand& command = m_Commands[m_pTileEntries[i]];
+		values[0] = (unsigned int)command.type;
+		values[1] = (unsigned int)command.texture;
+		values[2] = (unsigned int)command.x0;
+		values[3] = (unsigned int)command.y0;
+		values[4] = (unsigned int)command.x1;
+		values[5] = (unsigned int)command.y1;
+		memcpy(&values[6], &command.left, sizeof(float));
+		memcpy(&values[7], &command.top, sizeof(float));
+		memcpy(&values[8], &command.invScale, sizeof(float));
+		values[9] = command.color;
+		for(int v = 0; v < 10; ++v)
+			hash = (hash ^ values[v]) * 1099511628211ull;
+	}
+	return hash;
+}
+
+void CSoftwareRenderer::RasteriseTile(int tile)
+{
+	int tx0 = (tile % m_nTilesX) * SOFTWARE_TILE_SIZE;
+	int ty0 = (tile / m_nTilesX) * SOFTWARE_TILE_SIZE;
+	int tx1 = tx0 + SOFTWARE_TILE_SIZE < m_nWidth ? tx0 + SOFTWARE_TILE_SIZE : m_nWidth;
+	int ty1 = ty0 + SOFTWARE_TILE_SIZE < m_nHeight ? ty0 + SOFTWARE_TILE_SIZE : m_nHeight;
+
+	for(int y = ty0; y < ty1; ++y)
+	{
+		unsigned int* row = &m_FrameBuffer[(size_t)y * m_nWidth];
+		for(int x = tx0; x < tx1; ++x)
+			row[x] = m_ClearColor;
+	}
+
+	// Staging for scaled, tinted or filled spans before they are blended
+	unsigned int span[SOFTWARE_TILE_SIZE];
+
+	for(int i = m_pTileStart[tile]; i < m_pTileStart[tile + 1]; ++i)
+	{
+		const DrawCommand& command = m_Commands[m_pTileEntries[i]];
+		int x0 = command.x0 > tx0 ? command.x0 : tx0;
+		int x1 = command.x1 < tx1 ? command.x1 : tx1;
+		int y0 = command.y0 > ty0 ? command.y0 : ty0;
+		int y1 = command.y1 < ty1 ? command.y1 : ty1;
+		int count = x1 - x0;
+
+		if(command.type == COMMAND_FILL)
+		{
+			for(int x = 0; x < count; ++x)
+				span[x] = command.color;
+			for(int y = y0; y < y1; ++y)
+				BlendSpan(&m_FrameBuffer[(size_t)y * m_nWidth + x0], span, count);
+			continue;
+		}
+
+		const SpriteImage& image = m_Images[command.texture];
+		bool modulate = command.color != 0xFFFFFFFF;
+		bool unscaled = command.invScale == 1.0f;
+
+		for(int y = y0; y < y1; ++y)
+		{
+			unsigned int* dst = &m_FrameBuffer[(size_t)y * m_nWidth + x0];
+			int sy = (int)((y + 0.5f - command.top) * command.invScale);
+			if(sy >= image.height)
+				sy = image.height - 1;
+			const unsigned int* src = &image.pixels[(size_t)sy * image.width];
+
+			int sx0 = (int)((x0 + 0.5f - command.left) * command.invScale);
+			if(unscaled && !modulate && sx0 + count <= image.width)
+			{
+				// Straight copy of a texture row, blended in place
+				BlendSpan(dst, src + sx0, count);
+				continue;
+			}
+
+			for(int x = 0; x < count; ++x)
+			{
+				int sx = (int)((x0 + x + 0.5f - command.left) * command.invScale);
+				if(sx >= image.width)
+					sx = image.width - 1;
+				span[x] = modulate ? Modulate(src[sx], command.color) : src[sx];
+			}
+			BlendSpan(dst, span, count);
+		}
+	}
+}
+
+void CSoftwareRenderer::EndFrame()
+{
+	if(m_FrameBuffer.empty())
+		return;
+
+	// Bin every command into the tiles it touches, in submission order.
+	// The bins are one array in the frame arena: count the commands per
+	// tile, turn the counts into start offsets, then fill.
+	int tiles = m_nTilesX * m_nTilesY;
+	m_pTileStart = m_Arena.AllocateArray<int>(tiles + 1);
+	int* cursor = m_Arena.AllocateArray<int>(tiles);
+	if(!m_pTileStart || !cursor)
+		return;
+	for(int tile = 0; tile <= tiles; ++tile)
+		m_pTileStart[tile] = 0;
+
+	for(size_t i = 0; i < m_Commands.size(); ++i)
+	{
+		const DrawCommand& command = m_Commands[i];
+		for(int ty = command.y0 / SOFTWARE_TILE_SIZE; ty <= (command.y1 - 1) / SOFTWARE_TILE_SIZE; ++ty)
+		{
+			for(int tx = command.x0 / SOFTWARE_TILE_SIZE; tx <= (command.x1 - 1) / SOFTWARE_TILE_SIZE; ++tx)
+				++m_pTileStart[ty * m_nTilesX + tx + 1];
+		}
+	}
+
+	for(int tile = 0; tile < tiles; ++tile)
+	{
+		m_pTileStart[tile + 1] += m_pTileStart[tile];
+		cursor[tile] = m_pTileStart[tile];
+	}
+
+	m_pTileEntries = m_Arena.AllocateArray<int>(m_pTileStart[tiles] > 0 ? m_pTileStart[tiles] : 1);
+	if(!m_pTileEntries)
+		return;
+
+	for(size_t i = 0; i < m_Commands.size(); ++i)
+	{
+		const DrawCommand& command = m_Commands[i];
+		for(int ty = command.y0 / SOFTWARE_TILE_SIZE; ty <= (command.y1 - 1) / SOFTWARE_TILE_SIZE; ++ty)
+		{
+			for(int tx = command.x0 / SOFTWARE_TILE_SIZE; tx <= (command.x1 - 1) / SOFTWARE_TILE_SIZE; ++tx)
+				m_pTileEntries[cursor[ty * m_nTilesX + tx]++] = (int)i;
+		}
+	}
+
+	// Tiles whose command list matches the last frame already hold the
+	// right pixels, only the rest are cleared and redrawn
+	m_DirtyTiles.clear();
+	for(int tile = 0; tile < tiles; ++tile)
+	{
+		unsigned long long hash = HashTile(tile);
+		if(hash != m_TileHashes[tile])
+		{
+			m_TileHashes[tile] = hash;
+			m_DirtyTiles.push_back(tile);
+		}
+	}
+
+	m_nTilesDrawn = (int)m_DirtyTiles.size();
+	if(m_nTilesDrawn)
+		m_Pool.Run(m_nTilesDrawn, &CSoftwareRenderer::RasteriseTileTask, this);
+
+	if(m_pCapture)
+		m_pCapture->Capture(&m_FrameBuffer[0], m_nWidth, m_nFrames);
+	++m_nFrames;
+}
+
+bool CSoftwareRenderer::SetCapture(CFrameCapture* capture)
+{
+	if(capture && (capture->GetWidth() != m_nWidth || capture->GetHeight() != m_nHeight))
+		return false;
+	m_pCapture = capture;
+	return true;
+}
+
+void CSoftwareRenderer::Invalidate()
+{
+	++m_nGeneration;
+}
+
+bool CSoftwareRenderer::SaveFrame(const char* fileName) const
+{
+	if(m_FrameBuffer.empty())
+		return false;
+	return WritePNG(fileName, &m_FrameBuffer[0], m_nWidth, m_nHeight, m_nWidth);
+}
@@ -0,0 +1,110 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	SoftwareRenderer.h
+// Date:	October 19th, 2026
+// Purpose: CPU renderer backend.  Draw calls are recorded during the frame
+//			and binned into 64x64 pixel tiles.  EndFrame() rasterises the
+//			tiles on a thread pool, blending four pixels at a time with
+//			SSE2 where available.  Every tile runs its commands in
+//			submission order, so the image does not depend on the thread
+//			count.  Tiles with the same commands as the last frame are
+//			left alone, so static menus and the parts of the match that
+//			did not move cost nothing.  Frames can be read back or saved
+//			as PNG for golden image tests.  Always 32 bit ARGB without
+//			multi-sampling, the format and multisample settings are for
+//			the D3D9 backend.
+//			See Renderer.h for the backend interface.
+//////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <vector>
+#include "RenderTypes.h"
+#include "ImageFile.h"
+#include "ThreadPool.h"
+#include "FrameArena.h"
+#include "FrameCapture.h"
+
+#define SOFTWARE_TILE_SIZE 64
+#define SOFTWARE_ARENA_SIZE (64 * 1024)	// Starting size of the per-frame arena
+
+class CSoftwareRenderer
+{
+	enum CommandType
+	{
+		COMMAND_SPRITE,
+		COMMAND_FILL
+	};
+
+	struct DrawCommand
+	{
+		CommandType		type;
+		int				texture;		// Index into m_Images, sprites only
+		int				x0, y0;			// Destination rectangle, end exclusive
+		int				x1, y1;
+		float			left, top;		// Unclipped top left of the sprite
+		float			invScale;		// Destination to source pixel scale
+		unsigned int	color;			// Modulate colour, or fill colour
+	};
+
+	int							m_nWidth;
+	int							m_nHeight;
+	int							m_nTilesX;		// Tiles across and down the frame
+	int							m_nTilesY;
+	unsigned int				m_ClearColor;
+	std::vector<unsigned int>	m_FrameBuffer;
+	std::vector<SpriteImage>	m_Images;
+	std::vector<DrawCommand>	m_Commands;
+	CFrameArena					m_Arena;		// Per-frame data, reset in BeginFrame
+	int*						m_pTileStart;	// Per tile offset into m_pTileEntries, tiles + 1
+	int*						m_pTileEntries;	// Indices into m_Commands, grouped by tile
+	std::vector<unsigned long long>	m_TileHashes;	// Commands last drawn into each tile
+	std::vector<int>			m_DirtyTiles;	// Tiles to redraw this frame
+	unsigned int				m_nGeneration;	// Bumped when old tile hashes go stale
+	int							m_nTilesDrawn;	// Tiles redrawn by the last EndFrame
+	int							m_nGlyphScale;	// Screen pixels per score font pixel
+	CThreadPool					m_Pool;
+	CFrameCapture*				m_pCapture;
+	int							m_nFrames;		// Finished by EndFrame, numbers the captures
+
+	static void RasteriseTileTask(void* context, int index, int thread);
+	void RasteriseTile(int tile);
+	unsigned long long HashTile(int tile) const;
+	void FillRect(int x, int y, int w, int h, unsigned int color);
+
+public:
+	CSoftwareRenderer(void);
+
+	bool Init(const RendererDesc& desc);
+	void Shutdown();
+
+	bool LoadTexture(const wchar_t* fileName, SpriteTexture& texture);
+	bool UpdateTexture(SpriteImage& image, SpriteTexture& texture);
+	void BeginFrame(unsigned int clearColor);
+	void DrawSprite(const SpriteTexture& texture, float x, float y, float scale, unsigned int color);
+	void DrawSprites(const SpriteTexture& texture, const SpriteBatch& batch);
+	void DrawString(const wchar_t* text, int x, int y, unsigned int color);
+	void EndFrame();
+	bool SetCapture(CFrameCapture* capture);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		SaveFrame
+	// Parameters:	const char* fileName - PNG file to write
+	// Return:		bool - false if the file could not be written
+	// Description:	Writes the last completed frame.
+	//////////////////////////////////////////////////////////////////////////
+	bool SaveFrame(const char* fileName) const;
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Invalidate
+	// Parameters:	void
+	// Return:		void
+	// Description:	Redraws every tile on the next frame.
+	//////////////////////////////////////////////////////////////////////////
+	void Invalidate();
+
+	const unsigned int* GetFrameBuffer() const	{ return m_FrameBuffer.empty() ? 0 : &m_FrameBuffer[0]; }
+	int GetWidth() const						{ return m_nWidth; }
+	int GetHeight() const						{ return m_nHeight; }
+	int GetThreadCount() const					{ return m_Pool.GetThreadCount(); }
+	int GetTilesDrawn() const					{ return m_nTilesDrawn; }
+	int GetTileCount() const					{ return m_nTilesX * m_nTilesY; }
+	const CFrameArena& GetFrameArena() const	{ return m_Arena; }
+};
@@ -0,0 +1,127 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	StartupTrace.cpp
+// Date:	October 19th, 2026
+// Purpose: Startup phase spans, see StartupTrace.h.
+//////////////////////////////////////////////////////////////////////////
+#include "StartupTrace.h"
+#include "PongPlatform.h"
+#include <stdio.h>
+#include <string.h>
+
+CStartupTrace::CStartupTrace(void)
+{
+	m_nSpans	= 0;
+	m_nDepth	= 0;
+	m_nDropped	= 0;
+	m_fOrigin	= PlatformGetTime();
+}
+
+void CStartupTrace::Begin()
+{
+	m_nSpans	= 0;
+	m_nDepth	= 0;
+	m_nDropped	= 0;
+	m_fOrigin	= PlatformGetTime() - PlatformGetProcessAge();
+
+	// Everything before main(), the bytes are what loading read
+	StartupSpan& span = m_Spans[m_nSpans++];
+	span.name		= "Process start";
+	span.start		= 0.0;
+	span.end		= GetTime();
+	span.bytesRead	= PlatformGetReadBytes();
+	span.depth		= 0;
+	span.ok			= true;
+	span.open		= false;
+}
+
+double CStartupTrace::GetTime() const
+{
+	return PlatformGetTime() - m_fOrigin;
+}
+
+int CStartupTrace::Open(const char* name)
+{
+	if(m_nSpans >= STARTUP_TRACE_MAX_SPANS || m_nDepth >= STARTUP_TRACE_MAX_DEPTH)
+	{
+		++m_nDropped;
+		return -1;
+	}
+
+	int index = m_nSpans++;
+	StartupSpan& span = m_Spans[index];
+	span.name		= name;
+	span.depth		= m_nDepth;
+	span.ok			= true;
+	span.open		= true;
+	span.bytesRead	= 0;
+	m_nStartBytes[index] = PlatformGetReadBytes();
+	span.start		= GetTime();
+	span.end		= span.start;
+	m_Open[m_nDepth++] = index;
+	return index;
+}
+
+void CStartupTrace::Close(int span, bool ok)
+{
+	if(span < 0 || span >= m_nSpans || !m_Spans[span].open)
+		return;
+
+	double now = GetTime();
+	unsigned long long bytes = PlatformGetReadBytes();
+
+	// Spans left open inside this one end with it
+	while(m_nDepth > 0)
+	{
+		int index = m_Open[--m_nDepth];
+		StartupSpan& closing = m_Spans[index];
+		closing.end			= now;
+		closing.bytesRead	= bytes - m_nStartBytes[index];
+		closing.open		= false;
+		if(index == span)
+			break;
+	}
+	m_Spans[span].ok = ok;
+}
+
+const StartupSpan* CStartupTrace::Find(const char* name) const
+{
+	for(int i = 0; i < m_nSpans; ++i)
+	{
+		if(!strcmp(m_Spans[i].name, name))
+			return &m_Spans[i];
+	}
+	return 0;
+}
+
+bool CStartupTrace::WriteChromeTrace(const char* fileName) const
+{
+	FILE* file = fopen(fileName, "w");
+	if(!file)
+		return false;
+
+	double now = GetTime();
+	fprintf(file, "{\"traceEvents\":[\n");
+	for(int i = 0; i < m_nSpans; ++i)
+	{
+		const StartupSpan& span = m_Spans[i];
+
+		// File names may hold backslashes
+		char name[256];
+		size_t length = 0;
+		for(const char* c = span.name; *c && length + 2 < sizeof(name); ++c)
+		{
+			if(*c == '"' || *c == '\\')
+				name[length++] = '\\';
+			name[length++] = *c;
+		}
+		name[length] = 0;
+
+		double end = span.open ? now : span.end;
+		fprintf(file, "{\"name\":\"%s\",\"cat\":\"startup\",\"ph\":\"X\",\"pid\":1,\"tid\":1,"
+			"\"ts\":%.1f,\"dur\":%.1f,\"args\":{\"bytesRead\":%llu,\"ok\":%s}}%s\n",
+			name, span.start * 1e6, (end - span.start) * 1e6, span.bytesRead,
+			span.ok ? "true" : "false", i + 1 < m_nSpans ? "," : "");
+	}
+	fprintf(file, "],\"displayTimeUnit\":\"ms\"}\n");
+	return fclose(file) == 0;
+}
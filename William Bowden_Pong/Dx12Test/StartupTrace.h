@@ -0,0 +1,139 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	StartupTrace.h
+// Date:	October 19th, 2026
+// Purpose: Named, nested spans timing the phases of starting the game,
+//			each with the wall clock time and the bytes the process read
+//			while it was open (PlatformGetReadBytes), and whether the
+//			phase failed.  Time 0 is when the process was created, so the
+//			first span shows loading the executable and its DLLs.
+//			Written as a Chrome trace (chrome://tracing or Perfetto) for
+//			looking at one start, and read back by Tools/StartupBench.cpp
+//			to compare many.  Spans are fixed storage opened and closed
+//			on one thread; the cost is two clock and I/O counter reads.
+//////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <stddef.h>
+
+// Spans one trace holds, later ones are dropped
+#define STARTUP_TRACE_MAX_SPANS 64
+
+// Spans open at once
+#define STARTUP_TRACE_MAX_DEPTH 16
+
+struct StartupSpan
+{
+	const char*			name;			// Not copied, must outlive the trace
+	double				start;			// Seconds since the process was created
+	double				end;			// Same as start while open
+	unsigned long long	bytesRead;		// Read by the process while open
+	int					depth;			// 0 for a top level phase
+	bool				ok;				// false if the phase failed
+	bool				open;
+};
+
+class CStartupTrace
+{
+	StartupSpan			m_Spans[STARTUP_TRACE_MAX_SPANS];
+	unsigned long long	m_nStartBytes[STARTUP_TRACE_MAX_SPANS];
+	int					m_nSpans;
+	int					m_Open[STARTUP_TRACE_MAX_DEPTH];	// Open spans, innermost last
+	int					m_nDepth;
+	int					m_nDropped;
+	double				m_fOrigin;		// PlatformGetTime() when the process was created
+
+	// Not copyable, span indices refer into it
+	CStartupTrace(const CStartupTrace&);
+	CStartupTrace& operator=(const CStartupTrace&);
+
+public:
+	CStartupTrace(void);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Begin
+	// Parameters:	void
+	// Return:		void
+	// Description:	Clears the trace and adds a "Process start" span from
+	//				the process being created until now.  Called first
+	//				thing in main().
+	//////////////////////////////////////////////////////////////////////////
+	void Begin();
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Open
+	// Parameters:	const char* name - Phase name, e.g. a literal or a
+	//					file name that lives as long as the trace
+	// Return:		int - Span to pass to Close(), -1 if the trace is
+	//				full
+	// Description:	Starts a span inside the innermost open one.
+	//////////////////////////////////////////////////////////////////////////
+	int Open(const char* name);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Close
+	// Parameters:	int span - What Open() returned
+	//				bool ok - false if the phase failed
+	// Return:		void
+	// Description:	Ends the span and any still open inside it.
+	//////////////////////////////////////////////////////////////////////////
+	void Close(int span, bool ok = true);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		WriteChromeTrace
+	// Parameters:	const char* fileName - JSON file to write
+	// Return:		bool - false if it could not be written
+	// Description:	One complete ("X") event a line, microseconds from the
+	//				process being created, with bytesRead and ok as args.
+	//				Spans still open end now.
+	//////////////////////////////////////////////////////////////////////////
+	bool WriteChromeTrace(const char* fileName) const;
+
+	// Seconds since the process was created
+	double GetTime() const;
+
+	// Span by name, NULL if there is none
+	const StartupSpan* Find(const char* name) const;
+
+	int GetSpanCount() const						{ return m_nSpans; }
+	const StartupSpan& GetSpan(int i) const		{ return m_Spans[i]; }
+	int GetDroppedCount() const					{ return m_nDropped; }
+};
+
+//////////////////////////////////////////////////////////////////////////
+// Opens a span for the life of a scope.  A NULL trace does nothing, so
+// code can be traced only when asked.
+//////////////////////////////////////////////////////////////////////////
+class CTraceSpan
+{
+	CStartupTrace*		m_pTrace;
+	int					m_nSpan;
+	bool				m_bOk;
+
+	CTraceSpan(const CTraceSpan&);
+	CTraceSpan& operator=(const CTraceSpan&);
+
+public:
+	CTraceSpan(CStartupTrace* trace, const char* name)
+		: m_pTrace(trace), m_nSpan(trace ? trace->Open(name) : -1), m_bOk(true)
+	{
+	}
+
+	~CTraceSpan(void)
+	{
+		End();
+	}
+
+	// Closes the span before the scope ends, for phases in a row
+	void End()
+	{
+		if(m_pTrace)
+			m_pTrace->Close(m_nSpan, m_bOk);
+		m_pTrace = 0;
+	}
+
+	// Records the result of a step, the span fails if any step did
+	bool Check(bool ok)
+	{
+		m_bOk &= ok;
+		return ok;
+	}
+};
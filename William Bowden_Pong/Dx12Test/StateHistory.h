@@ -0,0 +1,117 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	StateHistory.h
+// Date:	October 19th, 2026
+// Purpose: The last N game states, one per tick, for rewinding, for
+//			looking at what happened a few seconds ago and for running
+//			ticks again from an earlier state.  Fixed capacity and inside
+//			the object, so recording a tick is a copy into the next slot
+//			and never allocates.  The oldest state is overwritten once
+//			the ring is full.
+//////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "PongGame.h"
+
+template<int N>
+class CStateHistory
+{
+	PongState			m_States[N];		// Tick t is in m_States[t % N]
+	unsigned int		m_nNext;			// Tick the next Record() stores
+	int					m_nCount;			// States held, at most N
+
+	// Not copyable, it is large and nothing needs two
+	CStateHistory(const CStateHistory&);
+	CStateHistory& operator=(const CStateHistory&);
+
+public:
+	CStateHistory(void)
+	{
+		Clear();
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Clear
+	// Parameters:	unsigned int firstTick - Number of the next tick recorded
+	// Return:		void
+	// Description:	Forgets every state.
+	//////////////////////////////////////////////////////////////////////////
+	void Clear(unsigned int firstTick = 0)
+	{
+		m_nNext = firstTick;
+		m_nCount = 0;
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Record
+	// Parameters:	const CPongGame& game - State to keep
+	// Return:		unsigned int - Tick number it was stored as
+	// Description:	Stores the state as the newest tick.
+	//////////////////////////////////////////////////////////////////////////
+	unsigned int Record(const CPongGame& game)
+	{
+		game.SaveState(m_States[m_nNext % N]);
+		if(m_nCount < N)
+			++m_nCount;
+		return m_nNext++;
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Find
+	// Parameters:	unsigned int tick - Tick to look up
+	// Return:		const PongState* - The state, NULL if it was never
+	//				recorded or has been overwritten
+	// Description:	Constant time.
+	//////////////////////////////////////////////////////////////////////////
+	const PongState* Find(unsigned int tick) const
+	{
+		if(tick >= m_nNext || m_nNext - tick > (unsigned int)m_nCount)
+			return 0;
+		return &m_States[tick % N];
+	}
+
+	// State recorded ticksAgo ticks before the newest, 0 for the newest
+	const PongState* GetAgo(int ticksAgo) const
+	{
+		if(ticksAgo < 0 || ticksAgo >= m_nCount)
+			return 0;
+		return &m_States[(m_nNext - 1 - ticksAgo) % N];
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Truncate
+	// Parameters:	unsigned int tick - First tick to forget
+	// Return:		void
+	// Description:	Drops tick and every tick after it, so they can be
+	//				recorded again, e.g. after restoring an earlier state.
+	//////////////////////////////////////////////////////////////////////////
+	void Truncate(unsigned int tick)
+	{
+		if(tick >= m_nNext)
+			return;
+		unsigned int dropped = m_nNext - tick;
+		m_nCount = dropped >= (unsigned int)m_nCount ? 0 : m_nCount - (int)dropped;
+		m_nNext = tick;
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Rewind
+	// Parameters:	CPongGame& game - Receives the earlier state
+	//				int ticks - Ticks to go back, 1 restores the newest
+	// Return:		bool - false if that far back is not held
+	// Description:	Restores a state and forgets it and the ones after it,
+	//				so going on records the same ticks again.  With a state
+	//				recorded before every tick this undoes that many ticks.
+	//////////////////////////////////////////////////////////////////////////
+	bool Rewind(CPongGame& game, int ticks)
+	{
+		const PongState* state = GetAgo(ticks - 1);
+		if(!state)
+			return false;
+		game.LoadState(*state);
+		Truncate(m_nNext - ticks);
+		return true;
+	}
+
+	unsigned int GetNextTick() const	{ return m_nNext; }
+	int GetCount() const				{ return m_nCount; }
+	int GetCapacity() const				{ return N; }
+};
@@ -0,0 +1,187 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	ThreadPool.cpp
+// Date:	October 19th, 2026
+// Purpose: Fixed set of worker threads, see ThreadPool.h.
+//////////////////////////////////////////////////////////////////////////
+#include "ThreadPool.h"
+
+namespace
+{
+	inline unsigned long long PackRange(int begin, int end)
+	{
+		return ((unsigned long long)(unsigned int)begin << 32) | (unsigned int)end;
+	}
+
+	inline int RangeBegin(unsigned long long range)	{ return (int)(range >> 32); }
+	inline int RangeEnd(unsigned long long range)	{ return (int)(range & 0xFFFFFFFFu); }
+}
+
+CThreadPool::CThreadPool(void)
+{
+	m_Function		= 0;
+	m_pContext		= 0;
+	m_nCount		= 0;
+	m_pRanges		= 0;
+	m_nBusy			= 0;
+	m_nGeneration	= 0;
+	m_bQuit			= false;
+}
+
+CThreadPool::~CThreadPool(void)
+{
+	Shutdown();
+}
+
+bool CThreadPool::Init(int threads)
+{
+	if(!m_Workers.empty())
+		return false;
+
+	if(threads <= 0)
+		threads = (int)std::thread::hardware_concurrency();
+	if(threads < 1)
+		threads = 1;
+
+	m_bQuit = false;
+	m_pRanges = new Range[threads];
+	for(int i = 0; i < threads; ++i)
+		m_pRanges[i].items = 0;
+	m_Workers.reserve(threads - 1);
+	for(int i = 1; i < threads; ++i)
+		m_Workers.push_back(std::thread(&CThreadPool::WorkerMain, this, i));
+	return true;
+}
+
+void CThreadPool::Shutdown()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_bQuit = true;
+	}
+	m_Wake.notify_all();
+
+	for(size_t i = 0; i < m_Workers.size(); ++i)
+		m_Workers[i].join();
+	m_Workers.clear();
+
+	delete[] m_pRanges;
+	m_pRanges = 0;
+}
+
+void CThreadPool::Run(int count, TaskFunction function, void* context)
+{
+	if(count <= 0)
+		return;
+
+	// Not worth waking anyone for a single item
+	if(m_Workers.empty() || count == 1)
+	{
+		for(int i = 0; i < count; ++i)
+			function(context, i, 0);
+		return;
+	}
+
+	// Even contiguous shares, the first count % threads get one extra
+	int threads = GetThreadCount();
+	int begin = 0;
+	for(int i = 0; i < threads; ++i)
+	{
+		int end = begin + count / threads + (i < count % threads ? 1 : 0);
+		m_pRanges[i].items = PackRange(begin, end);
+		begin = end;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Function	= function;
+		m_pContext	= context;
+		m_nCount	= count;
+		m_nBusy		= (int)m_Workers.size();
+		++m_nGeneration;
+	}
+	m_Wake.notify_all();
+
+	Work(0);
+
+	std::unique_lock<std::mutex> lock(m_Mutex);
+	while(m_nBusy > 0)
+		m_Done.wait(lock);
+}
+
+void CThreadPool::WorkerMain(CThreadPool* pool, int thread)
+{
+	unsigned int seen = 0;
+	std::unique_lock<std::mutex> lock(pool->m_Mutex);
+	for(;;)
+	{
+		while(!pool->m_bQuit && pool->m_nGeneration == seen)
+			pool->m_Wake.wait(lock);
+		if(pool->m_bQuit)
+			return;
+		seen = pool->m_nGeneration;
+
+		lock.unlock();
+		pool->Work(thread);
+		lock.lock();
+
+		if(--pool->m_nBusy == 0)
+			pool->m_Done.notify_one();
+	}
+}
+
+void CThreadPool::Work(int thread)
+{
+	int index;
+	while(PopItem(thread, index) || StealItem(thread, index))
+		m_Function(m_pContext, index, thread);
+}
+
+bool CThreadPool::PopItem(int thread, int& index)
+{
+	// Own items come off the front, thieves take from the back
+	std::atomic<unsigned long long>& items = m_pRanges[thread].items;
+	unsigned long long range = items.load();
+	for(;;)
+	{
+		int begin = RangeBegin(range);
+		int end = RangeEnd(range);
+		if(begin >= end)
+			return false;
+		if(items.compare_exchange_weak(range, PackRange(begin + 1, end)))
+		{
+			index = begin;
+			return true;
+		}
+	}
+}
+
+bool CThreadPool::StealItem(int thread, int& index)
+{
+	// Only called with an empty range, which no other thread writes to, so
+	// the stolen items can be stored into it without a compare-exchange.
+	// Items only ever move between ranges by compare-exchange on the range
+	// that holds them, so each one is run exactly once.
+	int threads = GetThreadCount();
+	for(int i = 1; i < threads; ++i)
+	{
+		std::atomic<unsigned long long>& victim = m_pRanges[(thread + i) % threads].items;
+		unsigned long long range = victim.load();
+		for(;;)
+		{
+			int begin = RangeBegin(range);
+			int end = RangeEnd(range);
+			if(begin >= end)
+				break;
+
+			// The back half, rounded up so a single item can be stolen
+			int take = (end - begin + 1) / 2;
+			if(victim.compare_exchange_weak(range, PackRange(begin, end - take)))
+			{
+				index = end - take;
+				m_pRanges[thread].items = PackRange(end - take + 1, end);
+				return true;
+			}
+		}
+	}
+	return false;
+}
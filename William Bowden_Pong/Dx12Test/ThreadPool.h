@@ -0,0 +1,91 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	ThreadPool.h
+// Date:	October 19th, 2026
+// Purpose: Fixed set of worker threads for data parallel jobs.  A job is
+//			a task function run once for every index in [0, count); the
+//			calling thread works on the job too and Run() returns when
+//			every index is done.  Threads are created once in Init(), so
+//			running a job costs a wake up, not a thread start.  Each
+//			thread starts on its own contiguous share of the indices and
+//			steals half of another thread's remaining share when it runs
+//			out, so neighbouring items mostly stay on one thread and
+//			uneven items still balance out.
+//////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+class CThreadPool
+{
+public:
+	// index - Item to process, thread - 0 for the caller, 1.. for workers
+	typedef void (*TaskFunction)(void* context, int index, int thread);
+
+	CThreadPool(void);
+	~CThreadPool(void);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Init
+	// Parameters:	int threads - Total threads including the caller,
+	//					0 for one per core
+	// Return:		bool - false if already initialised
+	// Description:	Starts threads - 1 worker threads.
+	//////////////////////////////////////////////////////////////////////////
+	bool Init(int threads);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Shutdown
+	// Parameters:	void
+	// Return:		void
+	// Description:	Stops and joins the worker threads.
+	//////////////////////////////////////////////////////////////////////////
+	void Shutdown();
+
+	//////////////////////////////////////////////////////////////////////////
+	// Name:		Run
+	// Parameters:	int count - Number of items
+	//				TaskFunction function - Called once per item
+	//				void* context - Passed through to function
+	// Return:		void
+	// Description:	Runs the job on every thread and waits for it to finish.
+	//				Items are shared out in even ranges and stolen between
+	//				threads as they run dry.
+	//////////////////////////////////////////////////////////////////////////
+	void Run(int count, TaskFunction function, void* context);
+
+	int GetThreadCount() const	{ return (int)m_Workers.size() + 1; }
+
+private:
+	CThreadPool(const CThreadPool&);
+	CThreadPool& operator=(const CThreadPool&);
+
+	// A thread's remaining items, begin in the high half and end in the
+	// low half so one compare-exchange moves both.  Padded to a cache line
+	// so threads popping their own range do not share one.
+	struct Range
+	{
+		std::atomic<unsigned long long>	items;
+		char							padding[64 - sizeof(std::atomic<unsigned long long>)];
+	};
+
+	static void WorkerMain(CThreadPool* pool, int thread);
+	void Work(int thread);
+	bool PopItem(int thread, int& index);
+	bool StealItem(int thread, int& index);
+
+	std::vector<std::thread>	m_Workers;
+	std::mutex					m_Mutex;
+	std::condition_variable		m_Wake;			// Signalled when a job starts or on shutdown
+	std::condition_variable		m_Done;			// Signalled when the last worker finishes a job
+
+	TaskFunction				m_Function;		// Current job
+	void*						m_pContext;
+	int							m_nCount;
+	Range*						m_pRanges;		// One per thread, the caller is 0
+	int							m_nBusy;		// Workers still inside the current job
+	unsigned int				m_nGeneration;	// Incremented for every job
+	bool						m_bQuit;
+};
@@ -0,0 +1,35 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	TuningConfig.h
+// Date:	October 19th, 2026
+// Purpose: Fills a PongTuning from the [Tuning] section of the settings
+//			file (PONG_CONFIG_FILE):
+//				BallSpeedX		Pixels across per MoveBall() step
+//				BallSpeedY		Pixels up or down per MoveBall() step
+//				PaddleSpeed		Pixels per MovePaddle() step
+//				FixedPoint		1 to play the match in fixed point, the
+//								same on every machine, see PongPhysics.h
+//			Missing keys keep the value already in the PongTuning.  The
+//			game reloads the section whenever the file is saved.
+//////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "ConfigFile.h"
+#include "PongGame.h"
+
+// Fastest a speed can be set to.  The ball is tested against the
+// paddles once per step, faster steps could jump over PADDLE_REACH.
+#define TUNING_MAX_SPEED 5.0f
+
+inline float ClampTuningSpeed(float speed)
+{
+	if(speed < 0.0f)				return 0.0f;
+	if(speed > TUNING_MAX_SPEED)	return TUNING_MAX_SPEED;
+	return speed;
+}
+
+inline void ReadTuningConfig(const CConfigFile& config, PongTuning& tuning)
+{
+	tuning.ballSpeedX	= ClampTuningSpeed(config.GetFloat("Tuning", "BallSpeedX", tuning.ballSpeedX));
+	tuning.ballSpeedY	= ClampTuningSpeed(config.GetFloat("Tuning", "BallSpeedY", tuning.ballSpeedY));
+	tuning.paddleSpeed	= ClampTuningSpeed(config.GetFloat("Tuning", "PaddleSpeed", tuning.paddleSpeed));
+	tuning.fixedPoint	= config.GetBool("Tuning", "FixedPoint", tuning.fixedPoint);
+}
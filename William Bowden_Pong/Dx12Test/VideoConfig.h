@@ -0,0 +1,35 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	VideoConfig.h
+// Date:	October 19th, 2026
+// Purpose: Fills a RendererDesc from the [Video] section of the settings
+//			file (PONG_CONFIG_FILE):
+//				Width, Height	Back buffer size, the window's client area
+//				Windowed		1 for a window, 0 for full-screen
+//				VSync			1 to wait for vertical blank
+//				Format			X8R8G8B8, A8R8G8B8 or R5G6B5
+//				MultiSample		Most MSAA samples wanted, 0 for off
+//			Missing keys keep the value already in the RendererDesc.
+//////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <string.h>
+#include "ConfigFile.h"
+#include "RenderTypes.h"
+
+inline void ReadVideoConfig(const CConfigFile& config, RendererDesc& desc)
+{
+	desc.width			= config.GetInt("Video", "Width", desc.width);
+	desc.height			= config.GetInt("Video", "Height", desc.height);
+	desc.windowed		= config.GetBool("Video", "Windowed", desc.windowed);
+	desc.vsync			= config.GetBool("Video", "VSync", desc.vsync);
+	desc.multisample	= config.GetInt("Video", "MultiSample", desc.multisample);
+
+	const char* format = config.GetString("Video", "Format", "");
+	if(!strcmp(format, "X8R8G8B8"))			desc.format = BACKBUFFER_X8R8G8B8;
+	else if(!strcmp(format, "A8R8G8B8"))	desc.format = BACKBUFFER_A8R8G8B8;
+	else if(!strcmp(format, "R5G6B5"))		desc.format = BACKBUFFER_R5G6B5;
+
+	// Anything smaller cannot show the menus
+	if(desc.width < 320)	desc.width = 320;
+	if(desc.height < 240)	desc.height = 240;
+	if(desc.multisample < 0)	desc.multisample = 0;
+}
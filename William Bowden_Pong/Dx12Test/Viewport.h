@@ -0,0 +1,54 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	Viewport.h
+// Date:	October 19th, 2026
+// Purpose: Maps the game's virtual 800x600 playfield onto a back buffer of
+//			any size.  The playfield keeps its aspect ratio and is centred,
+//			with black bars on the sides that do not fit.  Plain maths with
+//			no platform dependencies, so the headless tools use it too.
+//////////////////////////////////////////////////////////////////////////
+#pragma once
+
+struct Viewport
+{
+	int					x, y;			// Top left of the playfield on screen, pixels
+	int					width, height;	// Size of the playfield on screen, pixels
+	float				scale;			// Screen pixels per virtual pixel
+};
+
+//////////////////////////////////////////////////////////////////////////
+// Name:		MakeViewport
+// Parameters:	int screenWidth, screenHeight - Back buffer size
+//				int virtualWidth, virtualHeight - Playfield size
+// Return:		Viewport - Largest centred fit of the playfield
+// Description:	The scale is the same on both axes.  The offsets are
+//				whole pixels so unscaled sprites stay sharp.
+//////////////////////////////////////////////////////////////////////////
+inline Viewport MakeViewport(int screenWidth, int screenHeight, int virtualWidth, int virtualHeight)
+{
+	Viewport view;
+	if(screenWidth <= 0 || screenHeight <= 0 || virtualWidth <= 0 || virtualHeight <= 0)
+	{
+		view.x = view.y = view.width = view.height = 0;
+		view.scale = 0.0f;
+		return view;
+	}
+
+	float sx = (float)screenWidth / virtualWidth;
+	float sy = (float)screenHeight / virtualHeight;
+	view.scale	= sx < sy ? sx : sy;
+	view.width	= (int)(virtualWidth * view.scale + 0.5f);
+	view.height	= (int)(virtualHeight * view.scale + 0.5f);
+	if(view.width > screenWidth)	view.width = screenWidth;
+	if(view.height > screenHeight)	view.height = screenHeight;
+	view.x		= (screenWidth - view.width) / 2;
+	view.y		= (screenHeight - view.height) / 2;
+	return view;
+}
+
+// Virtual playfield position to screen position
+inline float ViewportX(const Viewport& view, float x)	{ return view.x + x * view.scale; }
+inline float ViewportY(const Viewport& view, float y)	{ return view.y + y * view.scale; }
+
+// Screen position back to the virtual playfield, e.g. for the mouse
+inline float VirtualX(const Viewport& view, float x)	{ return view.scale > 0.0f ? (x - view.x) / view.scale : 0.0f; }
+inline float VirtualY(const Viewport& view, float y)	{ return view.scale > 0.0f ? (y - view.y) / view.scale : 0.0f; }
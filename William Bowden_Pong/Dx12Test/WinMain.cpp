@@ -6,11 +6,11 @@
 //			use with the DirectXFramework developed for the GSP 381 course
 //			for DeVry University.
 // Disclaimer:	
-//			Copyright  2010 by DeVry Educational Development Corporation.
+//			Copyright © 2010 by DeVry Educational Development Corporation.
 //			All rights reserved.  No part of this work may be reproduced 
-//			or used in any form or by any means  graphic, electronic, or 
+//			or used in any form or by any means – graphic, electronic, or 
 //			mechanical, including photocopying, recording, Web distribution 
-//			or information storage and retrieval systems  without the 
+//			or information storage and retrieval systems – without the 
 //			prior consent of DeVry Educational Development Corporation.
 //////////////////////////////////////////////////////////////////////////
 #include <iostream>
@@ -19,17 +19,21 @@ using namespace std;
 #define VC_EXTRALEAN
 
 #include "DirectXFramework.h"
+#include "VideoConfig.h"
+#include "PacingConfig.h"
+#include "StartupTrace.h"
 
 //////////////////////////////////////////////////////////////////////////
 // Global Variables
 //////////////////////////////////////////////////////////////////////////
-#define SCREEN_WIDTH 800
-#define SCREEN_HEIGHT 600
 #define WINDOW_TITLE L"GSP 381 - DirectX Framework"
 
 HWND				g_hWnd;			// Handle to the window
 HINSTANCE			g_hInstance;	// Handle to the application instance
 bool				g_bWindowed;	// Boolean for windowed or full-screen
+RendererDesc		g_Video;		// Back buffer size and format, from Pong.ini
+FramePacingDesc		g_Pacing;		// Frame rate and match ticks a second, from Pong.ini
+CStartupTrace		g_Startup;		// Phases from the process starting to the first frame
 
 //*************************************************************************
 // This is where you declare the instance of your DirectXFramework Class
@@ -64,11 +68,18 @@ void InitWindow(void)
 	// register a new type of window
 	RegisterClassEx(&wndClass);
 
+	// Size the window so the client area, not the whole window, matches the
+	// back buffer and nothing is stretched
+	DWORD style = g_bWindowed ? WS_OVERLAPPEDWINDOW | WS_VISIBLE:(WS_POPUP | WS_VISIBLE);
+	RECT windowRect = { 0, 0, g_Video.width, g_Video.height };
+	AdjustWindowRect(&windowRect, style, FALSE);
+
 	g_hWnd = CreateWindow(
 		WINDOW_TITLE, WINDOW_TITLE, 							// window class name and title
-		g_bWindowed ? WS_OVERLAPPEDWINDOW | WS_VISIBLE:(WS_POPUP | WS_VISIBLE),// window style
+		style,													// window style
 		CW_USEDEFAULT, CW_USEDEFAULT,							// x and y coordinates
-		SCREEN_WIDTH, SCREEN_HEIGHT,							// width and height of window
+		windowRect.right - windowRect.left,						// width and height of window
+		windowRect.bottom - windowRect.top,
 		NULL, NULL,												// parent window and menu
 		g_hInstance,											// handle to application
 		NULL);
@@ -78,15 +89,66 @@ void InitWindow(void)
 	UpdateWindow(g_hWnd);
 }
 
+// Command line options for timing startup:
+//	-trace <file>	writes the startup phases as a Chrome trace
+//	-startupbench	quits once the first frame is presented, for
+//					Tools/StartupBench.cpp to run the game many times
+static void ReadStartupOptions(const wchar_t* cmdLine, char* traceFile, size_t traceSize, bool& bench)
+{
+	traceFile[0] = 0;
+	bench = cmdLine && wcsstr(cmdLine, L"-startupbench") != 0;
+
+	const wchar_t* trace = cmdLine ? wcsstr(cmdLine, L"-trace ") : 0;
+	if(trace)
+	{
+		trace += 7;
+		while(*trace == L' ')
+			++trace;
+		size_t length = 0;
+		while(trace[length] && trace[length] != L' ' && length + 1 < traceSize)
+		{
+			traceFile[length] = (char)trace[length];
+			++length;
+		}
+		traceFile[length] = 0;
+	}
+}
+
 int WINAPI wWinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPTSTR lpCmdLine, int nCmdShow )
 {
+	g_Startup.Begin();
 	g_hInstance = hInstance;	// Store application handle
-	g_bWindowed = true;			// Windowed mode or full-screen
+
+	char traceFile[MAX_PATH];
+	bool startupBench;
+	ReadStartupOptions(lpCmdLine, traceFile, sizeof(traceFile), startupBench);
+
+	// Back buffer size, format and MSAA, the defaults are an 800x600 window
+	CTraceSpan configSpan(&g_Startup, "Config");
+	CConfigFile config;
+	configSpan.Check(config.Load(PONG_CONFIG_FILE));
+	ReadVideoConfig(config, g_Video);
+	g_bWindowed = g_Video.windowed;	// Windowed mode or full-screen
+
+	// Frames are paced to the display unless Pong.ini says otherwise
+	DEVMODE display;
+	ZeroMemory(&display, sizeof(display));
+	display.dmSize = sizeof(display);
+	if(EnumDisplaySettings(NULL, ENUM_CURRENT_SETTINGS, &display) && display.dmDisplayFrequency > 1)
+		g_Pacing.refreshRate = display.dmDisplayFrequency;
+	ReadPacingConfig(config, g_Pacing);
+	configSpan.End();
 
 	// Init the window
+	CTraceSpan windowSpan(&g_Startup, "Window");
 	InitWindow();
+	windowSpan.Check(g_hWnd != NULL);
+	windowSpan.End();
 
-	g_dxFrame.Init(g_hWnd, g_hInstance, TRUE);
+	g_dxFrame.Init(g_hWnd, g_hInstance, g_Video, g_Pacing, &g_Startup);
+
+	// Until Render() presents the menu for the first time
+	int firstFrame = g_Startup.Open("First frame");
 
 	// Use this msg structure to catch window messages
 	MSG msg; 
@@ -101,17 +163,31 @@ int WINAPI wWinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPTSTR lpCmdLi
 	// Main Windows/Game Loop
 	while(msg.message != WM_QUIT)
 	{
-		if(PeekMessage(&msg, NULL, 0, 0, PM_REMOVE))
+		// Every message waiting, frames are paced and no longer come
+		// thousands of times a second
+		while(msg.message != WM_QUIT && PeekMessage(&msg, NULL, 0, 0, PM_REMOVE))
 		{
 			TranslateMessage(&msg);
 			DispatchMessage(&msg);
 		}
+		if(msg.message == WM_QUIT)
+			break;
 
 		//*************************************************************************
 		// This is where you call your DirectXFramework/Game render/update calls
 		g_dxFrame.Render();
 		g_dxFrame.Update();
 
+		if(firstFrame >= 0 && g_dxFrame.GetPresentedCount() > 0)
+		{
+			g_Startup.Close(firstFrame);
+			firstFrame = -1;
+			if(traceFile[0])
+				g_Startup.WriteChromeTrace(traceFile);
+			if(startupBench)
+				PostQuitMessage(0);
+		}
+
 		//*************************************************************************
 
 	}
@@ -137,6 +213,8 @@ LRESULT CALLBACK WndProc(HWND hWnd, UINT message, WPARAM wparam, LPARAM lparam)
 		case (WM_PAINT):
 		{
 			InvalidateRect(hWnd,NULL,TRUE);
+			// The last frame may have been erased, draw the next one
+			g_dxFrame.Invalidate();
 			break;
 		}		
 		case(WM_DESTROY):
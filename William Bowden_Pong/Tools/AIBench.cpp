@@ -0,0 +1,153 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	AIBench.cpp
+// Date:	October 19th, 2026
+// Purpose: Cost and accuracy of the paddle AI.  Checks the closed form
+//			prediction against stepping the ball the way CPongGame does,
+//			times millions of predictions of both kinds, then plays AI
+//			against AI at each difficulty and times Think() per tick.
+//
+//			Build (Linux):
+//				g++ -O2 -std=c++11 -I../Dx12Test AIBench.cpp
+//					../Dx12Test/PaddleAI.cpp ../Dx12Test/PongGame.cpp -o aibench
+//
+//			Usage: aibench [-predictions N] [-ticks N]
+//////////////////////////////////////////////////////////////////////////
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <vector>
+#include "PaddleAI.h"
+#include "PongPlatform.h"
+
+struct BallState
+{
+	float	x, y;
+	float	dx, dy;			// Per tick, as GetBallVelocity() returns
+	float	targetX;
+};
+
+static const float TOP		= (float)BALL_WALL_MARGIN;
+static const float BOTTOM	= (float)(PLAYFIELD_HEIGHT - BALL_WALL_MARGIN);
+
+// Steps the ball with CPongGame's wall rules until it reaches targetX
+static float StepBallY(const BallState& state)
+{
+	float x = state.x, y = state.y;
+	float sx = state.dx * 0.5f, sy = state.dy * 0.5f;
+	while(sx > 0.0f ? x < state.targetX : x > state.targetX)
+	{
+		if(y - BALL_WALL_MARGIN <= 0 && sy < 0.0f)					sy = -sy;
+		if(y + BALL_WALL_MARGIN >= PLAYFIELD_HEIGHT && sy > 0.0f)	sy = -sy;
+		x += sx;
+		y += sy;
+	}
+	return y;
+}
+
+static void RandomStates(std::vector<BallState>& states, int count)
+{
+	states.resize(count);
+	srand(2024);
+	for(int i = 0; i < count; ++i)
+	{
+		BallState& s = states[i];
+		bool right = (rand() & 1) != 0;
+		s.x			= 40.0f + (float)(rand() % 720);
+		s.y			= TOP + (float)(rand() % (int)(BOTTOM - TOP));
+		s.dx		= (right ? 2.0f : -2.0f) * BALL_SPEED_X;
+		s.dy		= ((rand() & 1) ? 2.0f : -2.0f) * BALL_SPEED_Y;
+		s.targetX	= right ? PLAYFIELD_WIDTH - PADDLE_REACH : -12.0f + PADDLE_REACH;
+	}
+}
+
+static void PlayMatch(AIDifficulty left, AIDifficulty right, int ticks)
+{
+	CPongGame game;
+	game.Init();
+	game.Menu.onSTART = false;
+	game.FinishMovie();
+
+	CPaddleAI ai[2];
+	ai[0].Init(0, GetAISettings(left), 11);
+	ai[1].Init(1, GetAISettings(right), 23);
+
+	double thinkTime = 0.0;
+	int hits = 0;
+	for(int tick = 0; tick < ticks; ++tick)
+	{
+		double start = PlatformGetTime();
+		int keys = ai[0].Think(game) | ai[1].Think(game);
+		thinkTime += PlatformGetTime() - start;
+
+		if(game.Tick(keys, 0) & SOUND1)
+			++hits;
+	}
+
+	static const char* names[] = { "easy", "normal", "hard" };
+	printf("  %-6s vs %-6s  score %3d - %-3d  %5d returns  Think %.1f ns per tick (both paddles)\n",
+		names[left], names[right], game.Player1Point, game.Player2Point, hits,
+		thinkTime * 1e9 / ticks);
+}
+
+int main(int argc, char** argv)
+{
+	int predictions = 5000000;
+	int ticks = 2000000;
+
+	for(int i = 1; i < argc; ++i)
+	{
+		if(!strcmp(argv[i], "-predictions") && i + 1 < argc)	predictions = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-ticks") && i + 1 < argc)		ticks = atoi(argv[++i]);
+		else
+		{
+			printf("Usage: %s [-predictions N] [-ticks N]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	// Accuracy against the stepped simulation.  Stepping works in whole
+	// steps, so it can overshoot the line and a wall by a step.
+	std::vector<BallState> states;
+	RandomStates(states, 20000);
+	float worst = 0.0f;
+	for(size_t i = 0; i < states.size(); ++i)
+	{
+		const BallState& s = states[i];
+		float predicted = PredictBallY(s.x, s.y, s.dx, s.dy, s.targetX, TOP, BOTTOM);
+		float error = fabsf(predicted - StepBallY(s));
+		if(error > worst)
+			worst = error;
+	}
+	printf("Largest difference from the stepped ball over %d paths: %.3f pixels\n", (int)states.size(), worst);
+
+	// Closed form cost
+	RandomStates(states, 4096);
+	float sum = 0.0f;
+	double start = PlatformGetTime();
+	for(int i = 0; i < predictions; ++i)
+	{
+		const BallState& s = states[i & 4095];
+		sum += PredictBallY(s.x, s.y, s.dx, s.dy, s.targetX, TOP, BOTTOM);
+	}
+	double closed = PlatformGetTime() - start;
+	printf("Closed form: %d predictions in %.3f s, %.2f ns each\n", predictions, closed, closed * 1e9 / predictions);
+
+	// Stepped cost, far fewer as each one walks thousands of steps
+	int stepped = predictions / 1000 > 100 ? predictions / 1000 : 100;
+	start = PlatformGetTime();
+	for(int i = 0; i < stepped; ++i)
+		sum += StepBallY(states[i & 4095]);
+	double step = PlatformGetTime() - start;
+	printf("Stepped:     %d predictions in %.3f s, %.2f ns each (%.0fx slower)\n",
+		stepped, step, step * 1e9 / stepped, (step / stepped) / (closed / predictions));
+
+	printf("AI against AI for %d ticks:\n", ticks);
+	PlayMatch(AI_HARD, AI_HARD, ticks);
+	PlayMatch(AI_HARD, AI_NORMAL, ticks);
+	PlayMatch(AI_NORMAL, AI_EASY, ticks);
+	PlayMatch(AI_EASY, AI_EASY, ticks);
+
+	// Keeps the predictions from being optimised away
+	return sum == 12345.0f ? 2 : 0;
+}
@@ -0,0 +1,325 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	ArenaBench.cpp
+// Date:	October 19th, 2026
+// Purpose: Times ball steps against arenas (Arena.h) of more and more
+//			obstacles, through the hierarchy and by testing every
+//			obstacle on every step.  Each arena is random blocks and
+//			bumpers, smaller as there are more so about the same share
+//			of the playfield is covered.  The paddles follow the ball so
+//			it bounces around the arena for the whole run.  For each
+//			count prints the nanoseconds a step takes both ways in float
+//			and in fixed point, the hierarchy's depth, and the nodes and
+//			obstacles a step visits through it.
+//
+//			Checks both ways play the match to the same bits in both
+//			number types, that the obstacles a step tests through the
+//			hierarchy stay under -most however many there are, and that
+//			a step never leaves the ball inside an obstacle it was
+//			outside of.  Exits with 1 if not.
+//
+//			Build (Linux):
+//				g++ -O2 -std=c++11 -I../Dx12Test ArenaBench.cpp
+//					../Dx12Test/Arena.cpp -o arenabench
+//
+//			Usage: arenabench [-steps N] [-max N] [-seed N] [-most N] [-arena file]
+//				-max		most obstacles, counts go up by 4 times to it
+//				-most		obstacles a step may test on average
+//				-arena		time an arena file too
+//////////////////////////////////////////////////////////////////////////
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <vector>
+#include "PongPhysics.h"
+#include "PongPlatform.h"
+
+// Share of the playfield the random obstacles cover, before the ball's
+// size is added
+#define COVERED 0.1f
+
+struct BenchSettings
+{
+	int					steps;
+	int					maxCount;
+	unsigned int		seed;
+	double				most;
+};
+
+struct RunResult
+{
+	double				seconds;
+	unsigned int		hash;
+	int					bounces;
+	bool				enteredBox;		// A step ended inside a box it started outside of
+};
+
+// Small repeatable random numbers, 0 to 1
+class CBenchRandom
+{
+	unsigned int		m_nSeed;
+
+public:
+	explicit CBenchRandom(unsigned int seed) : m_nSeed(seed)	{}
+
+	float Next()
+	{
+		m_nSeed = m_nSeed * 1664525u + 1013904223u;
+		return (m_nSeed >> 8) * (1.0f / 16777216.0f);
+	}
+};
+
+static void MakeObstacles(int count, unsigned int seed, std::vector<ArenaObstacle>& obstacles)
+{
+	CBenchRandom random(seed);
+	float size = sqrtf(COVERED * PLAYFIELD_WIDTH * PLAYFIELD_HEIGHT / (count > 0 ? count : 1));
+	obstacles.resize(count);
+	for(int i = 0; i < count; ++i)
+	{
+		ArenaObstacle& obstacle = obstacles[i];
+		obstacle.type	= random.Next() < 0.2f ? ARENA_BUMPER : ARENA_BLOCK;
+		obstacle.width	= size * (0.5f + random.Next());
+		obstacle.height	= size * (0.5f + random.Next());
+
+		// Clear of the paddles, so the ball always comes back
+		float left = 40.0f + obstacle.width * 0.5f;
+		float top = obstacle.height * 0.5f;
+		obstacle.x = left + random.Next() * (PLAYFIELD_WIDTH - 2.0f * left);
+		obstacle.y = top + random.Next() * (PLAYFIELD_HEIGHT - 2.0f * top);
+	}
+}
+
+template<class T>
+static bool IsInside(const ArenaHitBox& box, T x, T y)
+{
+	T left, top, right, bottom;
+	GetArenaEdges(box, left, top, right, bottom);
+	return x > left && x < right && y > top && y < bottom;
+}
+
+// A whole match of steps: the paddles sit level with the ball and the ball
+// steps once, as CPongGame::Tick() does twice a tick
+template<class TMatch, class T>
+static void PlaySteps(TMatch match, const CArena& arena, T speedX, T speedY, int steps, bool checkBoxes,
+					  RunResult& result)
+{
+	result.hash			= 2166136261u;
+	result.bounces		= 0;
+	result.enteredBox	= false;
+	const ArenaHitBox* boxes = arena.GetHitBoxes();
+	int boxCount = arena.GetObstacleCount();
+	std::vector<char> inside(checkBoxes ? boxCount : 0);
+
+	double start = PlatformGetTime();
+	for(int i = 0; i < steps; ++i)
+	{
+		match.Paddle[0].yp = match.Ball.yp;
+		match.Paddle[1].yp = match.Ball.yp;
+		if(checkBoxes)
+		{
+			for(int b = 0; b < boxCount; ++b)
+				inside[b] = IsInside(boxes[b], match.Ball.xp, match.Ball.yp);
+		}
+
+		int sounds = StepBall(match, speedX, speedY, (CGameEventBuffer*)0, &arena);
+		if(sounds & (WALL_HIT | SOUND1))
+			++result.bounces;
+
+		if(checkBoxes)
+		{
+			for(int b = 0; b < boxCount; ++b)
+				result.enteredBox |= !inside[b] && IsInside(boxes[b], match.Ball.xp, match.Ball.yp);
+		}
+		unsigned int flags = match.Ball.DIR_UP_RIGHT | match.Ball.DIR_DOWN_RIGHT << 1 | match.Ball.DIR_DOWN_LEFT << 2
+			| match.Ball.DIR_UP_LEFT << 3;
+		result.hash = (result.hash ^ flags) * 16777619u;
+	}
+	result.seconds = PlatformGetTime() - start;
+	result.hash = (result.hash ^ (unsigned int)(GetPhysicsFloat(match.Ball.xp) * 1024.0f)) * 16777619u;
+	result.hash = (result.hash ^ (unsigned int)(GetPhysicsFloat(match.Ball.yp) * 1024.0f)) * 16777619u;
+}
+
+// Nodes and obstacles SweepArena() looks at for each step of a float
+// match, walking the array as it does
+static void CountVisits(const CArena& arena, int steps, double& nodes, double& boxes)
+{
+	PongState match;
+	memset(&match, 0, sizeof(match));
+	match.Ball.xp = 400.0f;
+	match.Ball.yp = 300.0f;
+	match.Ball.DIR_UP_RIGHT = true;
+
+	long long nodeCount = 0;
+	long long boxCount = 0;
+	const ArenaNode* all = arena.GetNodes();
+	for(int s = 0; s < steps; ++s)
+	{
+		int signX, signY;
+		GetBallDirection(match.Ball, signX, signY);
+		float left	= match.Ball.xp + (signX < 0 ? -BALL_SPEED_X : 0.0f);
+		float right	= match.Ball.xp + (signX > 0 ? BALL_SPEED_X : 0.0f);
+		float top	= match.Ball.yp + (signY < 0 ? -BALL_SPEED_Y : 0.0f);
+		float bottom = match.Ball.yp + (signY > 0 ? BALL_SPEED_Y : 0.0f);
+		int i = 0;
+		while(i < arena.GetNodeCount())
+		{
+			++nodeCount;
+			const ArenaNode& node = all[i];
+			if(node.left > right || node.right < left || node.top > bottom || node.bottom < top)
+			{
+				i = node.skip;
+				continue;
+			}
+			boxCount += node.count;
+			++i;
+		}
+
+		match.Paddle[0].yp = match.Ball.yp;
+		match.Paddle[1].yp = match.Ball.yp;
+		StepBall(match, BALL_SPEED_X, BALL_SPEED_Y, (CGameEventBuffer*)0, &arena);
+	}
+	nodes = (double)nodeCount / steps;
+	boxes = (double)boxCount / steps;
+}
+
+static void StartMatch(PongState& floats, PongFixedMatch& fixed)
+{
+	memset(&floats, 0, sizeof(floats));
+	floats.Paddle[0].xp		= -12.0f;
+	floats.Paddle[1].xp		= PLAYFIELD_WIDTH;
+	floats.Ball.xp			= 400.0f;
+	floats.Ball.yp			= 300.0f;
+	floats.Ball.DIR_UP_RIGHT = true;
+
+	memset(&fixed, 0, sizeof(fixed));
+	fixed.Paddle[0].xp		= CFixed::FromInt(-12);
+	fixed.Paddle[1].xp		= CFixed::FromInt(PLAYFIELD_WIDTH);
+	fixed.Ball.xp			= CFixed::FromInt(400);
+	fixed.Ball.yp			= CFixed::FromInt(300);
+	fixed.Ball.DIR_UP_RIGHT	= true;
+}
+
+// One arena, both ways in both number types, returns false if a check failed
+static bool RunArena(const char* name, const std::vector<ArenaObstacle>& obstacles, const BenchSettings& settings,
+					 bool checkMost)
+{
+	const ArenaObstacle* first = obstacles.empty() ? 0 : &obstacles[0];
+	int count = (int)obstacles.size();
+	static CArena tree, flat;
+	tree.Create(first, count);
+	flat.Create(first, count, count);
+
+	PongState floats;
+	PongFixedMatch fixed;
+	StartMatch(floats, fixed);
+	CFixed fixedX = CFixed::FromFloat(BALL_SPEED_X);
+	CFixed fixedY = CFixed::FromFloat(BALL_SPEED_Y);
+
+	// Testing every box is slow with thousands, so fewer steps that way.
+	// Both ways are compared over those.
+	int flatSteps = count > 64 ? (int)((long long)settings.steps * 64 / count) : settings.steps;
+	RunResult treeFloat, flatFloat, treeFixed, flatFixed, shortFloat, shortFixed;
+	PlaySteps(floats, tree, BALL_SPEED_X, BALL_SPEED_Y, settings.steps, false, treeFloat);
+	PlaySteps(floats, flat, BALL_SPEED_X, BALL_SPEED_Y, flatSteps, false, flatFloat);
+	PlaySteps(floats, tree, BALL_SPEED_X, BALL_SPEED_Y, flatSteps, false, shortFloat);
+	PlaySteps(fixed, tree, fixedX, fixedY, settings.steps, false, treeFixed);
+	PlaySteps(fixed, flat, fixedX, fixedY, flatSteps, false, flatFixed);
+	PlaySteps(fixed, tree, fixedX, fixedY, flatSteps, false, shortFixed);
+
+	// The inside check tests every box every step too
+	RunResult checked;
+	PlaySteps(fixed, tree, fixedX, fixedY, flatSteps, true, checked);
+
+	double nodes, boxes;
+	CountVisits(tree, settings.steps, nodes, boxes);
+
+	double ns = 1e9 / settings.steps;
+	double flatNs = 1e9 / flatSteps;
+	printf("%-10s %6d %6d %5d %7.1f %7.1f %9.1f %9.1f %9.1f %9.1f %8d\n", name, tree.GetObstacleCount(),
+		tree.GetNodeCount(), tree.GetDepth(), nodes, boxes, treeFloat.seconds * ns, flatFloat.seconds * flatNs,
+		treeFixed.seconds * ns, flatFixed.seconds * flatNs, treeFixed.bounces);
+	fflush(stdout);
+
+	bool ok = true;
+	if(shortFloat.hash != flatFloat.hash || shortFixed.hash != flatFixed.hash)
+	{
+		printf("FAILED: %s played differently through the hierarchy\n", name);
+		ok = false;
+	}
+	if(checked.enteredBox)
+	{
+		printf("FAILED: %s let the ball into an obstacle\n", name);
+		ok = false;
+	}
+	if(checkMost && boxes > settings.most)
+	{
+		printf("FAILED: %s tested %.1f obstacles a step, most is %.1f\n", name, boxes, settings.most);
+		ok = false;
+	}
+	return ok;
+}
+
+int main(int argc, char** argv)
+{
+	BenchSettings settings;
+	settings.steps		= 2000000;
+	settings.maxCount	= 4096;
+	settings.seed		= 12345;
+	settings.most		= 2.0 * ARENA_LEAF_SIZE;
+	const char* arenaFile = 0;
+
+	for(int i = 1; i < argc; ++i)
+	{
+		if(!strcmp(argv[i], "-steps") && i + 1 < argc)			settings.steps = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-max") && i + 1 < argc)		settings.maxCount = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-seed") && i + 1 < argc)		settings.seed = (unsigned int)strtoul(argv[++i], 0, 10);
+		else if(!strcmp(argv[i], "-most") && i + 1 < argc)		settings.most = atof(argv[++i]);
+		else if(!strcmp(argv[i], "-arena") && i + 1 < argc)		arenaFile = argv[++i];
+		else
+		{
+			printf("Usage: %s [-steps N] [-max N] [-seed N] [-most N] [-arena file]\n", argv[0]);
+			return 1;
+		}
+	}
+	if(settings.steps < 1000)
+		settings.steps = 1000;
+	if(settings.maxCount < 1)
+		settings.maxCount = 1;
+
+	printf("%d steps of each, %.0f%% of the playfield covered\n", settings.steps, COVERED * 100.0f);
+	printf("%-10s %6s %6s %5s %7s %7s %9s %9s %9s %9s %8s\n", "Arena", "Boxes", "Nodes", "Depth", "Nodes", "Boxes",
+		"Float ns", "Float ns", "Fixed ns", "Fixed ns", "Bounces");
+	printf("%-10s %6s %6s %5s %7s %7s %9s %9s %9s %9s %8s\n", "", "", "", "", "a step", "a step", "tree", "every",
+		"tree", "every", "");
+
+	int result = 0;
+	std::vector<ArenaObstacle> obstacles;
+	for(int count = 0; ; count = count ? count * 4 : 4)
+	{
+		if(count > settings.maxCount)
+			count = settings.maxCount;
+		MakeObstacles(count, settings.seed, obstacles);
+		if(!RunArena("Random", obstacles, settings, true))
+			result = 1;
+		if(count == settings.maxCount)
+			break;
+	}
+
+	if(arenaFile)
+	{
+		CArena loaded;
+		if(!loaded.Load(arenaFile))
+		{
+			printf("FAILED: could not read %s\n", arenaFile);
+			return 1;
+		}
+		obstacles.resize(loaded.GetObstacleCount());
+		for(int i = 0; i < loaded.GetObstacleCount(); ++i)
+			obstacles[i] = loaded.GetObstacle(i);
+		printf("%s: %d obstacles, %d lines skipped\n", loaded.GetName(), loaded.GetObstacleCount(),
+			loaded.GetSkippedCount());
+		if(!RunArena(loaded.GetName(), obstacles, settings, false))
+			result = 1;
+	}
+	return result;
+}
@@ -0,0 +1,199 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	BatchBench.cpp
+// Date:	October 19th, 2026
+// Purpose: Checks and times CPongBatch.  First plays the same random keys
+//			through a batch, with and without SSE2, and through one
+//			CPongGame per match, and exits with 1 unless all three end up
+//			bit for bit the same.  Then steps a large batch with a ball
+//			tracking bot on 1, 2, 4 ... threads and prints match ticks
+//			per second and the speed up over one thread.
+//
+//			Build (Linux):
+//				g++ -O2 -std=c++11 -pthread -I../Dx12Test BatchBench.cpp
+//					../Dx12Test/PongBatch.cpp ../Dx12Test/PongGame.cpp
+//					../Dx12Test/ThreadPool.cpp -o batchbench
+//
+//			Usage: batchbench [-matches N] [-steps N] [-ticks N] [-threads N]
+//////////////////////////////////////////////////////////////////////////
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include <thread>
+#include "PongBatch.h"
+#include "PongPlatform.h"
+
+static bool SameFloat(float a, float b)
+{
+	return memcmp(&a, &b, sizeof(float)) == 0;
+}
+
+// Random keys through CPongGame, scalar and SSE2 batches, compared at the end
+static bool CheckExact(int matches, int steps, int ticks)
+{
+	CPongBatch scalar, vector;
+	scalar.Init(matches, 1);
+	scalar.SetScalar(true);
+	vector.Init(matches, 0);
+
+	std::vector<CPongGame> games(matches);
+	for(int i = 0; i < matches; ++i)
+	{
+		games[i].Menu.onSTART = false;
+		games[i].FinishMovie();
+	}
+
+	std::vector<unsigned char> actions(matches * 2);
+	srand(1234);
+	for(int step = 0; step < steps; ++step)
+	{
+		for(size_t i = 0; i < actions.size(); ++i)
+			actions[i] = (unsigned char)(rand() & (BATCH_UP | BATCH_DOWN));
+
+		scalar.Step(&actions[0], ticks);
+		vector.Step(&actions[0], ticks);
+
+		for(int i = 0; i < matches; ++i)
+		{
+			int keys = 0;
+			if(actions[i * 2] & BATCH_UP)			keys |= W_UP;
+			if(actions[i * 2] & BATCH_DOWN)			keys |= S_DOWN;
+			if(actions[i * 2 + 1] & BATCH_UP)		keys |= ARROW_UP;
+			if(actions[i * 2 + 1] & BATCH_DOWN)		keys |= ARROW_DOWN;
+			for(int tick = 0; tick < ticks; ++tick)
+				games[i].Tick(keys, 0);
+		}
+	}
+
+	std::vector<float> observed[2];
+	observed[0].resize(matches * BATCH_OBSERVATION_SIZE);
+	observed[1].resize(matches * BATCH_OBSERVATION_SIZE);
+	scalar.Observe(&observed[0][0]);
+	vector.Observe(&observed[1][0]);
+
+	int mismatches = 0;
+	int points = 0;
+	for(int i = 0; i < matches; ++i)
+	{
+		const CPongGame& game = games[i];
+		float expected[BATCH_OBSERVATION_SIZE];
+		expected[0] = game.Ball.xp;
+		expected[1] = game.Ball.yp;
+		game.GetBallVelocity(expected[2], expected[3]);
+		expected[4] = game.Paddle[0].yp;
+		expected[5] = game.Paddle[1].yp;
+		expected[6] = (float)game.Player1Point;
+		expected[7] = (float)game.Player2Point;
+		points += game.Player1Point + game.Player2Point;
+
+		for(int b = 0; b < 2; ++b)
+		{
+			for(int j = 0; j < BATCH_OBSERVATION_SIZE; ++j)
+			{
+				if(!SameFloat(expected[j], observed[b][i * BATCH_OBSERVATION_SIZE + j]))
+				{
+					if(mismatches < 10)
+						printf("  match %d, %s value %d: %.9g, CPongGame %.9g\n", i, b ? "SSE2" : "scalar",
+							j, observed[b][i * BATCH_OBSERVATION_SIZE + j], expected[j]);
+					++mismatches;
+				}
+			}
+		}
+	}
+
+	printf("Exactness: %d matches, %d ticks each, %d points scored, %d values differ from CPongGame%s\n",
+		matches, steps * ticks, points, mismatches, vector.IsVectorised() ? "" : " (no SSE2 in this build)");
+	return mismatches == 0;
+}
+
+// Up or down towards the ball, from the batch's own arrays
+static void TrackBall(const CPongBatch& batch, std::vector<unsigned char>& actions)
+{
+	const float* ballY = batch.GetBallY();
+	for(int p = 0; p < 2; ++p)
+	{
+		const float* paddleY = batch.GetPaddleY(p);
+		for(int i = 0; i < batch.GetMatchCount(); ++i)
+		{
+			float dy = ballY[i] - paddleY[i];
+			actions[i * 2 + p] = (unsigned char)(dy > 10.0f ? BATCH_DOWN : (dy < -10.0f ? BATCH_UP : 0));
+		}
+	}
+}
+
+static double TimeBatch(int matches, int threads, bool scalar, int steps, int ticks, int& hits)
+{
+	CPongBatch batch;
+	if(!batch.Init(matches, threads))
+		return 0.0;
+	batch.SetScalar(scalar);
+
+	std::vector<unsigned char> actions(matches * 2);
+	hits = 0;
+	double start = PlatformGetTime();
+	for(int step = 0; step < steps; ++step)
+	{
+		TrackBall(batch, actions);
+		batch.Step(&actions[0], ticks);
+
+		const int* events = batch.GetEvents();
+		for(int i = 0; i < matches; ++i)
+			hits += (events[i] & BATCH_EVENT_HIT) ? 1 : 0;
+	}
+	double elapsed = PlatformGetTime() - start;
+	return (double)matches * steps * ticks / (elapsed > 0.0 ? elapsed : 1e-9);
+}
+
+int main(int argc, char** argv)
+{
+	int matches = 65536;
+	int steps = 200;
+	int ticks = 50;
+	int maxThreads = (int)std::thread::hardware_concurrency();
+
+	for(int i = 1; i < argc; ++i)
+	{
+		if(!strcmp(argv[i], "-matches") && i + 1 < argc)		matches = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-steps") && i + 1 < argc)		steps = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-ticks") && i + 1 < argc)		ticks = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-threads") && i + 1 < argc)	maxThreads = atoi(argv[++i]);
+		else
+		{
+			printf("Usage: %s [-matches N] [-steps N] [-ticks N] [-threads N]\n", argv[0]);
+			return 1;
+		}
+	}
+	if(matches < 1)
+		matches = 1;
+	if(maxThreads < 1)
+		maxThreads = 1;
+
+	// An odd count so the scalar tail after the last group of four is checked
+	bool exact = CheckExact(1027, 400, 500);
+
+	printf("%d matches, %d steps of %d ticks, ball tracking bots:\n", matches, steps, ticks);
+	int hits;
+	double scalar = TimeBatch(matches, 1, true, steps, ticks, hits);
+	printf("  scalar   1 thread   %8.1f M match ticks/s\n", scalar / 1e6);
+
+	double single = 0.0;
+	for(int threads = 1; ; threads *= 2)
+	{
+		if(threads > maxThreads)
+			threads = maxThreads;
+		double rate = TimeBatch(matches, threads, false, steps, ticks, hits);
+		if(threads == 1)
+			single = rate;
+		printf("  batch  %3d threads  %8.1f M match ticks/s  %5.2fx one thread  (%d returns)\n",
+			threads, rate / 1e6, single > 0.0 ? rate / single : 0.0, hits);
+		if(threads == maxThreads)
+			break;
+	}
+
+	if(!exact)
+	{
+		printf("FAILED: batched matches differ from CPongGame\n");
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,261 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	CaptureBench.cpp
+// Date:	October 19th, 2026
+// Purpose: Times frame recording (FrameCapture.h) the way the game uses
+//			it: frames arrive at a steady rate and each one is handed to
+//			the capture on the frame's own thread.  For each format and
+//			encoder thread count prints how long that hand over takes,
+//			how many frames were written or dropped, and how fast the
+//			encoders went.  Also times writing each frame on the frame's
+//			thread instead, the hitch the capture is there to avoid.
+//			Checks every frame offered was either written or dropped,
+//			that none failed, that a raw file holds exactly the frames
+//			written, and that handing a frame over stays under -budget.
+//			Exits with 1 if not.  The files are deleted as it goes.
+//
+//			Build (Linux):
+//				g++ -O2 -std=c++11 -pthread -I../Dx12Test CaptureBench.cpp
+//					../Dx12Test/FrameCapture.cpp ../Dx12Test/ImageFile.cpp
+//					-o capturebench
+//
+//			Usage: capturebench [-frames N] [-fps N] [-width W] [-height H]
+//				[-buffers N] [-out prefix] [-budget ms]
+//				-out		where the frames go, default /tmp/capturebench
+//				-budget		longest a hand over may take, default 4 ms
+//////////////////////////////////////////////////////////////////////////
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include "FrameCapture.h"
+#include "ImageFile.h"
+#include "LatencyHistogram.h"
+#include "PongPlatform.h"
+
+// Distinct frames cycled through, so each write is a different image
+#define SOURCE_FRAMES 8
+
+struct BenchSettings
+{
+	int					frames;
+	int					fps;
+	int					width;
+	int					height;
+	int					buffers;
+	std::string			prefix;
+	double				budget;			// Seconds
+};
+
+// Frame i of SOURCE_FRAMES: a gradient with a square moving across it
+static void MakeFrames(int width, int height, std::vector<std::vector<unsigned int> >& frames)
+{
+	frames.resize(SOURCE_FRAMES);
+	for(int f = 0; f < SOURCE_FRAMES; ++f)
+	{
+		frames[f].resize((size_t)width * height);
+		int left = f * (width - 64) / SOURCE_FRAMES;
+		for(int y = 0; y < height; ++y)
+		{
+			for(int x = 0; x < width; ++x)
+			{
+				bool square = x >= left && x < left + 64 && y >= height / 2 - 32 && y < height / 2 + 32;
+				frames[f][(size_t)y * width + x] = square ? 0xFFFFFFFF :
+					0xFF000000 | ((x * 255 / width) << 16) | ((y * 255 / height) << 8) | (f * 32);
+			}
+		}
+	}
+}
+
+// Waits for the frame's turn, as vsync would
+static void WaitForFrame(double start, int frame, int fps)
+{
+	double due = start + (double)frame / fps;
+	double now = PlatformGetTime();
+	if(due > now)
+		std::this_thread::sleep_for(std::chrono::microseconds((long long)((due - now) * 1e6)));
+}
+
+static void DeleteFrames(const BenchSettings& settings, CaptureFormat format, const char* path)
+{
+	if(format == CAPTURE_RAW)
+	{
+		remove(path);
+		return;
+	}
+	for(int i = 0; i < settings.frames; ++i)
+	{
+		char fileName[512];
+		sprintf(fileName, "%s_%06d.png", path, i);
+		remove(fileName);
+	}
+}
+
+// One format and thread count, returns false if a check failed
+static bool RunCapture(const BenchSettings& settings, const std::vector<std::vector<unsigned int> >& frames,
+					   CaptureFormat format, int threads)
+{
+	std::string path = settings.prefix + (format == CAPTURE_RAW ? ".raw" : "");
+	FrameCaptureDesc desc;
+	desc.width		= settings.width;
+	desc.height		= settings.height;
+	desc.format		= format;
+	desc.path		= path.c_str();
+	desc.buffers	= settings.buffers;
+	desc.threads	= threads;
+
+	CFrameCapture capture;
+	if(!capture.Init(desc))
+	{
+		printf("FAILED: could not start capturing to %s\n", path.c_str());
+		return false;
+	}
+
+	CLatencyHistogram handOver;
+	double start = PlatformGetTime();
+	for(int i = 0; i < settings.frames; ++i)
+	{
+		WaitForFrame(start, i, settings.fps);
+		double before = PlatformGetTime();
+		capture.Capture(&frames[i % SOURCE_FRAMES][0], settings.width, i);
+		handOver.Add(PlatformGetTime() - before);
+	}
+	capture.Shutdown();
+	double drained = PlatformGetTime() - start;
+
+	int written = capture.GetWrittenCount();
+	int dropped = capture.GetDroppedCount();
+	double encode = capture.GetEncodeSeconds();
+	printf("%-5s %7d %9.3f %9.3f %9.3f %8d %8d %8d %10.2f %9.1f\n", format == CAPTURE_RAW ? "Raw" : "PNG",
+		threads, handOver.GetPercentile(50.0) * 1e3, handOver.GetPercentile(99.0) * 1e3, handOver.GetMax() * 1e3,
+		written, dropped, capture.GetLongestDrop(), written ? encode * 1e3 / written : 0.0,
+		written / (drained > 0.0 ? drained : 1e-9));
+
+	bool ok = true;
+	if(written + dropped + capture.GetFailedCount() != settings.frames || capture.GetFailedCount() > 0)
+	{
+		printf("FAILED: %d frames offered, %d written, %d dropped, %d failed\n", settings.frames, written, dropped,
+			capture.GetFailedCount());
+		ok = false;
+	}
+	if(format == CAPTURE_RAW)
+	{
+		FILE* file = fopen(path.c_str(), "rb");
+		long size = -1;
+		if(file)
+		{
+			fseek(file, 0, SEEK_END);
+			size = ftell(file);
+			fclose(file);
+		}
+		long expected = (long)written * settings.width * settings.height * 4;
+		if(size != expected)
+		{
+			printf("FAILED: %s is %ld bytes, %d frames are %ld\n", path.c_str(), size, written, expected);
+			ok = false;
+		}
+	}
+	if(handOver.GetMax() > settings.budget)
+	{
+		printf("FAILED: handing a frame over took %.3f ms, the budget is %.3f ms\n", handOver.GetMax() * 1e3,
+			settings.budget * 1e3);
+		ok = false;
+	}
+	DeleteFrames(settings, format, path.c_str());
+	return ok;
+}
+
+// Writing on the frame's thread, what a frame costs without the capture
+static void RunInline(const BenchSettings& settings, const std::vector<std::vector<unsigned int> >& frames,
+					  CaptureFormat format)
+{
+	std::string path = settings.prefix + (format == CAPTURE_RAW ? ".raw" : "");
+	FILE* raw = format == CAPTURE_RAW ? fopen(path.c_str(), "wb") : 0;
+	CLatencyHistogram write;
+	int frameCount = settings.frames < 120 ? settings.frames : 120;
+	for(int i = 0; i < frameCount; ++i)
+	{
+		const unsigned int* pixels = &frames[i % SOURCE_FRAMES][0];
+		double before = PlatformGetTime();
+		if(raw)
+		{
+			fwrite(pixels, sizeof(unsigned int), (size_t)settings.width * settings.height, raw);
+		}
+		else
+		{
+			char fileName[512];
+			sprintf(fileName, "%s_%06d.png", path.c_str(), i);
+			WritePNG(fileName, pixels, settings.width, settings.height, settings.width);
+		}
+		write.Add(PlatformGetTime() - before);
+	}
+	if(raw)
+		fclose(raw);
+	printf("%-5s %7s %9.3f %9.3f %9.3f %8d\n", format == CAPTURE_RAW ? "Raw" : "PNG", "inline",
+		write.GetPercentile(50.0) * 1e3, write.GetPercentile(99.0) * 1e3, write.GetMax() * 1e3, frameCount);
+	DeleteFrames(settings, format, path.c_str());
+}
+
+int main(int argc, char** argv)
+{
+	BenchSettings settings;
+	settings.frames		= 300;
+	settings.fps		= 60;
+	settings.width		= 800;
+	settings.height		= 600;
+	settings.buffers	= 8;
+	settings.prefix		= "/tmp/capturebench";
+	settings.budget		= 0.004;
+
+	for(int i = 1; i < argc; ++i)
+	{
+		if(!strcmp(argv[i], "-frames") && i + 1 < argc)			settings.frames = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-fps") && i + 1 < argc)		settings.fps = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-width") && i + 1 < argc)		settings.width = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-height") && i + 1 < argc)	settings.height = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-buffers") && i + 1 < argc)	settings.buffers = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-out") && i + 1 < argc)		settings.prefix = argv[++i];
+		else if(!strcmp(argv[i], "-budget") && i + 1 < argc)	settings.budget = atof(argv[++i]) * 1e-3;
+		else
+		{
+			printf("Usage: %s [-frames N] [-fps N] [-width W] [-height H] [-buffers N] [-out prefix] [-budget ms]\n",
+				argv[0]);
+			return 1;
+		}
+	}
+	if(settings.frames < 1)
+		settings.frames = 1;
+	if(settings.fps < 1)
+		settings.fps = 1;
+	if(settings.width < 1 || settings.height < 1)
+	{
+		settings.width	= 800;
+		settings.height	= 600;
+	}
+
+	std::vector<std::vector<unsigned int> > frames;
+	MakeFrames(settings.width, settings.height, frames);
+
+	printf("%d frames of %dx%d at %d fps, %d buffers, %u cores\n", settings.frames, settings.width, settings.height,
+		settings.fps, settings.buffers, std::thread::hardware_concurrency());
+	printf("%-5s %7s %9s %9s %9s %8s %8s %8s %10s %9s\n", "", "Threads", "Frame ms", "Frame ms", "Frame ms", "Written",
+		"Dropped", "In a row", "Encode ms", "Written");
+	printf("%-5s %7s %9s %9s %9s %8s %8s %8s %10s %9s\n", "", "", "p50", "p99", "max", "", "", "", "per frame", "per s");
+
+	int result = 0;
+	static const int s_Threads[] = { 1, 2, 4 };
+	for(int t = 0; t < 3; ++t)
+	{
+		if(!RunCapture(settings, frames, CAPTURE_PNG, s_Threads[t]))
+			result = 1;
+	}
+	if(!RunCapture(settings, frames, CAPTURE_RAW, 1))
+		result = 1;
+
+	printf("\nWritten on the frame's thread:\n");
+	RunInline(settings, frames, CAPTURE_PNG);
+	RunInline(settings, frames, CAPTURE_RAW);
+	return result;
+}
@@ -0,0 +1,231 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	EventBench.cpp
+// Date:	October 19th, 2026
+// Purpose: Checks and times the game event bus (GameEvents.h).  Records
+//			the keys of two computer players, plays them back collecting
+//			every tick's events and exits with 1 unless they agree with
+//			the flags Tick() returns and with the score.  Then plays the same keys from the same state
+//			with and without a buffer and times what emitting costs a
+//			tick, and times handing a tick's events out the way the game
+//			does.  Exits with 1 if emitting costs more than the budget.
+//
+//			Build (Linux):
+//				g++ -O2 -std=c++11 -I../Dx12Test EventBench.cpp
+//					../Dx12Test/PongGame.cpp ../Dx12Test/PaddleAI.cpp
+//					-o eventbench
+//
+//			Usage: eventbench [-ticks N] [-loops N] [-budget ns]
+//////////////////////////////////////////////////////////////////////////
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include "GameEvents.h"
+#include "PaddleAI.h"
+#include "PongPlatform.h"
+
+static void StartMatch(CPongGame& game)
+{
+	game.Init();
+	game.Menu.onSTART = false;
+	game.FinishMovie();
+}
+
+// Keys two computer players press, random keys hardly ever hit the ball
+static void RecordKeys(std::vector<int>& keys)
+{
+	CPongGame game;
+	StartMatch(game);
+	CPaddleAI ai[2];
+	ai[0].Init(0, GetAISettings(AI_EASY), 4242);
+	ai[1].Init(1, GetAISettings(AI_NORMAL), 2424);
+	for(size_t i = 0; i < keys.size(); ++i)
+	{
+		keys[i] = ai[0].Think(game) | ai[1].Think(game);
+		game.Tick(keys[i], 0);
+	}
+}
+
+// Every flag Tick() returns has its event and the point events carry
+// the score
+static bool CheckEvents(const std::vector<int>& keys, int counts[GAME_EVENT_TYPES])
+{
+	CPongGame game;
+	StartMatch(game);
+	CGameEventBuffer events;
+	memset(counts, 0, sizeof(int) * GAME_EVENT_TYPES);
+
+	int wrong = 0;
+	int dropped = 0;
+	for(size_t i = 0; i < keys.size(); ++i)
+	{
+		events.Clear();
+		int flags = game.Tick(keys[i], 0, &events);
+		dropped += events.GetDropped();
+
+		int seen = 0;
+		for(int e = 0; e < events.GetCount(); ++e)
+		{
+			const GameEvent& event = events.Get(e);
+			++counts[event.type];
+			if(event.type == GAME_EVENT_PADDLE_HIT)		seen |= SOUND1;
+			if(event.type == GAME_EVENT_WALL_BOUNCE)	seen |= WALL_HIT;
+			if(event.type == GAME_EVENT_POINT_SCORED)
+			{
+				seen |= SOUND2;
+				int points = event.pointScored.player == 0 ? game.Player1Point : game.Player2Point;
+				wrong += event.pointScored.points != points;
+			}
+		}
+		wrong += seen != (flags & (SOUND1 | SOUND2 | WALL_HIT));
+	}
+
+	printf("%d ticks: %d paddle hits, %d wall bounces, %d points, %d menu changes, %s\n",
+		(int)keys.size(), counts[GAME_EVENT_PADDLE_HIT], counts[GAME_EVENT_WALL_BOUNCE],
+		counts[GAME_EVENT_POINT_SCORED], counts[GAME_EVENT_MENU_CHANGED],
+		wrong == 0 && dropped == 0 ? "agree with Tick()" : "DISAGREE");
+	return wrong == 0 && dropped == 0;
+}
+
+// Seconds to play every key loops times, collecting events when given a
+// buffer
+static double TimeTicks(const std::vector<int>& keys, int loops, CGameEventBuffer* events, int& total)
+{
+	CPongGame game;
+	StartMatch(game);
+	PongState start;
+	game.SaveState(start);
+
+	total = 0;
+	double begin = PlatformGetTime();
+	for(int loop = 0; loop < loops; ++loop)
+	{
+		game.LoadState(start);
+		for(size_t i = 0; i < keys.size(); ++i)
+		{
+			if(events)
+				events->Clear();
+			total += game.Tick(keys[i], 0, events);
+			if(events)
+				total += events->GetCount();
+		}
+	}
+	return PlatformGetTime() - begin;
+}
+
+// Seconds to hand every tick's events to consumers loops times, the
+// way the game gathers sounds and feeds the particles
+static double TimeDispatch(const std::vector<int>& keys, int loops, long long& handled)
+{
+	// Collected first, so only the dispatch is timed.  Most ticks have
+	// nothing to hand out, only the ones that do are kept.
+	CPongGame game;
+	StartMatch(game);
+	std::vector<CGameEventBuffer> ticks;
+	CGameEventBuffer events;
+	for(size_t i = 0; i < keys.size(); ++i)
+	{
+		events.Clear();
+		game.Tick(keys[i], 0, &events);
+		if(events.GetCount() > 0)
+			ticks.push_back(events);
+	}
+
+	handled = 0;
+	float sum = 0.0f;
+	int heard = 0;
+	double begin = PlatformGetTime();
+	for(int loop = 0; loop < loops; ++loop)
+	{
+		for(size_t i = 0; i < ticks.size(); ++i)
+		{
+			const CGameEventBuffer& events = ticks[i];
+			for(int e = 0; e < events.GetCount(); ++e)
+			{
+				const GameEvent& event = events.Get(e);
+				heard |= 1 << event.type;
+				switch(event.type)
+				{
+				case GAME_EVENT_PADDLE_HIT:		sum += event.paddleHit.y;		break;
+				case GAME_EVENT_WALL_BOUNCE:	sum += event.wallBounce.x;		break;
+				case GAME_EVENT_POINT_SCORED:	sum += event.pointScored.y;		break;
+				default:														break;
+				}
+			}
+			handled += events.GetCount();
+		}
+	}
+	double seconds = PlatformGetTime() - begin;
+
+	// Keeps the loop from being optimised away
+	if(sum == -1.0f && heard == -1)
+		printf("\n");
+	return seconds;
+}
+
+int main(int argc, char** argv)
+{
+	int ticks = 2000000;
+	int loops = 5;
+	double budget = 10.0;
+
+	for(int i = 1; i < argc; ++i)
+	{
+		if(!strcmp(argv[i], "-ticks") && i + 1 < argc)			ticks = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-loops") && i + 1 < argc)		loops = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-budget") && i + 1 < argc)	budget = atof(argv[++i]);
+		else
+		{
+			printf("Usage: %s [-ticks N] [-loops N] [-budget ns]\n", argv[0]);
+			return 1;
+		}
+	}
+	if(ticks < 1)
+		ticks = 1;
+	if(loops < 1)
+		loops = 1;
+
+	std::vector<int> keys(ticks);
+	RecordKeys(keys);
+
+	int counts[GAME_EVENT_TYPES];
+	bool agree = CheckEvents(keys, counts);
+	int perMatch = 0;
+	for(int i = 0; i < GAME_EVENT_TYPES; ++i)
+		perMatch += counts[i];
+
+	// Alternated so both see the same cache and clock
+	int total;
+	double without = 0.0, with = 0.0;
+	CGameEventBuffer events;
+	for(int pass = 0; pass < 3; ++pass)
+	{
+		without	+= TimeTicks(keys, loops, 0, total);
+		with	+= TimeTicks(keys, loops, &events, total);
+	}
+	double tickCount = (double)ticks * loops * 3;
+	double nsWithout = without * 1e9 / tickCount;
+	double nsWith = with * 1e9 / tickCount;
+	double overhead = nsWith - nsWithout;
+
+	long long handled;
+	double dispatch = TimeDispatch(keys, loops * 100, handled);
+
+	printf("Tick without events %7.2f ns, with %7.2f ns, %+.2f ns a tick to emit\n", nsWithout, nsWith, overhead);
+	printf("%.2f events per 1000 ticks, dispatched %.1f M events/s (%.2f ns each)\n",
+		perMatch * 1000.0 / ticks, handled / (dispatch > 0.0 ? dispatch : 1e-9) / 1e6,
+		handled > 0 ? dispatch * 1e9 / handled : 0.0);
+
+	int failed = 0;
+	if(!agree)
+	{
+		printf("FAILED: events and Tick() flags differ\n");
+		failed = 1;
+	}
+	if(overhead > budget)
+	{
+		printf("FAILED: emitting costs %.2f ns a tick, over the budget of %.2f ns\n", overhead, budget);
+		failed = 1;
+	}
+	return failed;
+}
@@ -0,0 +1,251 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	FrameAllocBench.cpp
+// Date:	October 19th, 2026
+// Purpose: Counts heap allocations per frame once the game is warmed up.
+//			Each frame ticks the match and draws it with the software
+//			renderer, then draws a second scene of short lived balls
+//			from a CObjectPool with their labels formatted into a
+//			CFrameArena.  Every allocation goes through the counters
+//			below, and steady state frames are expected to make none.
+//			Exits with 1 if any did.
+//
+//			Run from the Dx12Test directory so the sprites are found.
+//			Build (Linux):
+//				g++ -O2 -std=c++11 -pthread -DPONG_MEMORY_STATS
+//					-I../Dx12Test FrameAllocBench.cpp ../Dx12Test/PongGame.cpp
+//					../Dx12Test/SoftwareRenderer.cpp ../Dx12Test/ThreadPool.cpp
+//					../Dx12Test/ImageFile.cpp ../Dx12Test/FrameArena.cpp
+//					../Dx12Test/Particles.cpp ../Dx12Test/StartupTrace.cpp
+//					../Dx12Test/FrameCapture.cpp ../Dx12Test/Arena.cpp
+//					-o frameallocbench
+//
+//			Usage: frameallocbench [-warmup N] [-frames N] [-threads N]
+//////////////////////////////////////////////////////////////////////////
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <wchar.h>
+#include <new>
+#include <atomic>
+#include "SoftwareRenderer.h"
+#include "PongScene.h"
+#include "PongPlatform.h"
+#include "FrameArena.h"
+#include "ObjectPool.h"
+
+//////////////////////////////////////////////////////////////////////////
+// Allocation counters.  operator new catches the containers, and on
+// glibc malloc itself is replaced so C allocations are caught too.
+//////////////////////////////////////////////////////////////////////////
+static std::atomic<long long> g_nAllocations(0);
+
+#ifdef __GLIBC__
+extern "C"
+{
+	void* __libc_malloc(size_t size);
+	void* __libc_calloc(size_t count, size_t size);
+	void* __libc_realloc(void* pointer, size_t size);
+	void __libc_free(void* pointer);
+
+	void* malloc(size_t size)					{ ++g_nAllocations; return __libc_malloc(size); }
+	void* calloc(size_t count, size_t size)		{ ++g_nAllocations; return __libc_calloc(count, size); }
+	void* realloc(void* pointer, size_t size)	{ ++g_nAllocations; return __libc_realloc(pointer, size); }
+	void free(void* pointer)					{ __libc_free(pointer); }
+}
+
+void* operator new(size_t size)				{ void* p = malloc(size ? size : 1); if(!p) throw std::bad_alloc(); return p; }
+void* operator new[](size_t size)			{ void* p = malloc(size ? size : 1); if(!p) throw std::bad_alloc(); return p; }
+#else
+void* operator new(size_t size)				{ ++g_nAllocations; void* p = malloc(size ? size : 1); if(!p) throw std::bad_alloc(); return p; }
+void* operator new[](size_t size)			{ ++g_nAllocations; void* p = malloc(size ? size : 1); if(!p) throw std::bad_alloc(); return p; }
+#endif
+void operator delete(void* pointer) throw()		{ free(pointer); }
+void operator delete[](void* pointer) throw()	{ free(pointer); }
+
+//////////////////////////////////////////////////////////////////////////
+// Short lived balls, spawned and expired every frame
+//////////////////////////////////////////////////////////////////////////
+struct EffectBall
+{
+	float	xp, yp;
+	float	dx, dy;
+	int		life;			// Frames left
+	int		id;
+};
+
+#define MAX_EFFECT_BALLS 512
+
+typedef CObjectPool<EffectBall, MAX_EFFECT_BALLS> EffectPool;
+
+static void UpdateEffects(EffectPool& pool, int frame)
+{
+	// A burst every frame, bigger every 50th frame until the pool is full
+	int spawn = (frame % 50 == 0) ? 64 : 8;
+	for(int i = 0; i < spawn; ++i)
+	{
+		EffectBall* ball = pool.Create();
+		if(!ball)
+			break;
+		int seed = frame * 31 + i * 17;
+		ball->xp	= 100.0f + (float)(seed % 600);
+		ball->yp	= 100.0f + (float)((seed / 7) % 400);
+		ball->dx	= (float)((seed % 5) - 2);
+		ball->dy	= (float)(((seed / 3) % 5) - 2);
+		ball->life	= 20 + seed % 60;
+		ball->id	= frame * 100 + i;
+	}
+
+	for(int i = 0; i < pool.GetCapacity(); ++i)
+	{
+		if(!pool.IsAlive(i))
+			continue;
+		EffectBall* ball = pool.Get(i);
+		ball->xp += ball->dx;
+		ball->yp += ball->dy;
+		if(--ball->life <= 0)
+			pool.Destroy(ball);
+	}
+}
+
+static void DrawEffects(CSoftwareRenderer& renderer, CFrameArena& arena, const PongTextures& textures, const Viewport& view, const EffectPool& pool)
+{
+	arena.Reset();
+	renderer.BeginFrame(0xFF000000);
+	for(int i = 0; i < pool.GetCapacity(); ++i)
+	{
+		if(!pool.IsAlive(i))
+			continue;
+		const EffectBall* ball = pool.Get(i);
+		unsigned int alpha = (unsigned int)(ball->life > 15 ? 255 : ball->life * 17);
+		renderer.DrawSprite(textures.ball, ViewportX(view, ball->xp), ViewportY(view, ball->yp), view.scale, (alpha << 24) | 0xFFFFFF);
+
+		// Every eighth ball is labelled, the text only lives for the frame
+		if((ball->id & 7) == 0)
+		{
+			wchar_t* label = arena.AllocateArray<wchar_t>(16);
+			if(label)
+			{
+				swprintf(label, 16, L"%d", ball->id % 1000);
+				renderer.DrawString(label, (int)ViewportX(view, ball->xp + 12), (int)ViewportY(view, ball->yp - 6), SPRITE_WHITE);
+			}
+		}
+	}
+	renderer.EndFrame();
+}
+
+// Holds the key that moves a paddle towards the ball
+static int TrackBall(const CPongGame& game, int paddle, int upKey, int downKey)
+{
+	float dy = game.Ball.yp - game.Paddle[paddle].yp;
+	if(dy > 10.0f)
+		return downKey;
+	if(dy < -10.0f)
+		return upKey;
+	return 0;
+}
+
+int main(int argc, char** argv)
+{
+	int warmup = 200;
+	int frames = 2000;
+	int threads = 0;
+
+	for(int i = 1; i < argc; ++i)
+	{
+		if(!strcmp(argv[i], "-warmup") && i + 1 < argc)			warmup = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-frames") && i + 1 < argc)	frames = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-threads") && i + 1 < argc)	threads = atoi(argv[++i]);
+		else
+		{
+			printf("Usage: %s [-warmup N] [-frames N] [-threads N]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	RendererDesc desc;
+	desc.threads = threads;
+	Viewport view = MakeViewport(desc.width, desc.height, PLAYFIELD_WIDTH, PLAYFIELD_HEIGHT);
+
+	CSoftwareRenderer renderer;
+	if(!renderer.Init(desc))
+	{
+		printf("Renderer failed to initialise\n");
+		return 1;
+	}
+
+	PongTextures textures;
+	if(!LoadPongTextures(renderer, textures))
+		printf("Warning: some textures failed to load, run from the Dx12Test directory\n");
+
+	CPongGame game;
+	game.Init();
+
+	// Both live outside the frame loop, as they would in the game
+	static EffectPool effects;
+	CFrameArena textArena;
+	textArena.Init(256);		// Small on purpose, so warm up has to grow it
+
+	int controlPrevious = 0;
+	long long steadyAllocations = 0;
+	long long warmupAllocations = 0;
+	double start = 0.0;
+
+	for(int frame = 0; frame < warmup + frames; ++frame)
+	{
+		if(frame == warmup)
+		{
+			warmupAllocations = g_nAllocations;
+			start = PlatformGetTime();
+		}
+		long long before = g_nAllocations;
+
+		int controlCurrent = frame == 0 ? ENTER_KEY : 0;
+		if(game.Menu.onGAME)
+		{
+			controlCurrent |= TrackBall(game, 0, W_UP, S_DOWN);
+			controlCurrent |= TrackBall(game, 1, ARROW_UP, ARROW_DOWN);
+		}
+		int controlDown = (controlCurrent ^ controlPrevious) & controlCurrent;
+		controlPrevious = controlCurrent;
+
+		game.Tick(controlCurrent, controlDown);
+		if(game.Menu.onMovie)
+			game.FinishMovie();
+		DrawPongScene(renderer, game, textures, view);
+
+		UpdateEffects(effects, frame);
+		DrawEffects(renderer, textArena, textures, view, effects);
+
+		if(frame >= warmup)
+			steadyAllocations += g_nAllocations - before;
+	}
+	double elapsed = PlatformGetTime() - start;
+
+	FrameArenaStats rendererArena, labelArena;
+	renderer.GetFrameArena().GetStats(rendererArena);
+	textArena.GetStats(labelArena);
+	ObjectPoolStats pool;
+	effects.GetStats(pool);
+
+	printf("Warm up: %d frames, %lld heap allocations\n", warmup, warmupAllocations);
+	printf("Steady:  %d frames, %lld heap allocations (%.3f per frame), %.1f frames/s\n",
+		frames, steadyAllocations, frames > 0 ? (double)steadyAllocations / frames : 0.0,
+		frames / (elapsed > 0.0 ? elapsed : 1e-9));
+	printf("Renderer arena: %u bytes, peak %u, %u allocations, %u overflows, grown %u times\n",
+		(unsigned)rendererArena.capacity, (unsigned)rendererArena.peak, (unsigned)rendererArena.allocations,
+		(unsigned)rendererArena.overflows, (unsigned)rendererArena.grows);
+	printf("Label arena:    %u bytes, peak %u, %u allocations, %u overflows, grown %u times\n",
+		(unsigned)labelArena.capacity, (unsigned)labelArena.peak, (unsigned)labelArena.allocations,
+		(unsigned)labelArena.overflows, (unsigned)labelArena.grows);
+	printf("Effect pool:    %d of %d live, peak %d, %d creates refused\n",
+		pool.live, pool.capacity, pool.peak, pool.failed);
+
+	renderer.Shutdown();
+
+	if(steadyAllocations != 0)
+	{
+		printf("FAILED: steady state frames allocated from the heap\n");
+		return 1;
+	}
+	return 0;
+}
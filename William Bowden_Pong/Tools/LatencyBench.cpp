@@ -0,0 +1,293 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	LatencyBench.cpp
+// Date:	October 19th, 2026
+// Purpose: Checks and explores input latency measurement (InputLatency.h)
+//			on a simulated clock.  Runs the frame loop the way
+//			CDirectXFramework does, with made up costs for polling,
+//			ticking, drawing and the GPU, key presses at random times and
+//			a queue of frames between Present and the display, and feeds
+//			the tracker the simulated times.  Each press is then followed
+//			through the loop's own log, and the tracker must agree with
+//			it on how many presses were shown and on their latency.
+//			Compares the game's order, which ticks with the keys
+//			Getinput() read from the poll before last, with polling just
+//			before the tick, each with the queue the driver allows
+//			(-queue) and with one frame.  Also shows the parts the game
+//			cannot see: key down to the poll, and Present to the display.
+//			Exits with 1 if the tracker and the log disagree.
+//
+//			Build (Linux):
+//				g++ -O2 -std=c++11 -I../Dx12Test LatencyBench.cpp
+//					../Dx12Test/InputLatency.cpp -o latencybench
+//
+//			Usage: latencybench [-presses N] [-queue N] [-gpu ms] [-draw ms]
+//				[-skip percent] [-novsync]
+//				-queue		frames Present may run ahead, default 3
+//				-skip		frames not drawn because nothing changed
+//////////////////////////////////////////////////////////////////////////
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <string>
+#include <vector>
+#include "InputLatency.h"
+
+#define REFRESH_PERIOD (1.0 / 60.0)
+#define POLL_COST 0.0001
+#define TICK_COST 0.0005
+#define KEY_HELD 0.080					// Longer than any loop, so every press is polled
+
+struct LoopSettings
+{
+	int					presses;
+	int					queue;			// Frames presented but not yet shown before Present blocks
+	double				gpu;			// Seconds the GPU takes per frame
+	double				draw;			// Seconds the CPU takes to draw and submit
+	int					skip;			// Percent of frames not drawn
+	bool				vsync;
+	bool				pollFirst;		// Poll just before the tick instead of the game's order
+};
+
+struct LoopFrame
+{
+	double				tick;
+	int					poll;			// Poll the tick's keys were read from, -1 for none
+	bool				drawn;
+	double				present;		// When Present returned
+	double				display;		// When the frame reached the screen
+};
+
+struct LoopResult
+{
+	CLatencyHistogram	keyToPoll;		// Not seen by the tracker
+	CLatencyHistogram	presentToDisplay;
+	CLatencyHistogram	keyToDisplay;
+	CLatencyHistogram	logged;			// Poll to Present by the log, to check the tracker
+	int					missed;			// Presses no poll saw
+	std::string			report;
+	double				queuedP50;
+	double				totalP50;
+	double				totalP99;
+	bool				agrees;
+};
+
+static unsigned int s_nSeed = 12345;
+
+static double Random()
+{
+	s_nSeed = s_nSeed * 1103515245 + 12345;
+	return ((s_nSeed >> 8) & 0xFFFF) / 65536.0;
+}
+
+// Index of the press held at the time, -1 if none
+static int FindPress(const std::vector<double>& presses, double time)
+{
+	for(size_t i = 0; i < presses.size() && presses[i] <= time; ++i)
+	{
+		if(time < presses[i] + KEY_HELD)
+			return (int)i;
+	}
+	return -1;
+}
+
+static void RunLoop(const LoopSettings& settings, LoopResult& result)
+{
+	// Presses far enough apart that the key is up at some poll in between
+	std::vector<double> presses;
+	double pressed = 0.1;
+	for(int i = 0; i < settings.presses; ++i)
+	{
+		presses.push_back(pressed);
+		pressed += KEY_HELD * 2.0 + Random() * 0.2;
+	}
+
+	CInputLatency tracker;
+	std::vector<double> polls;
+	std::vector<int> pollPress;			// Press each poll saw down, -1 for none
+	std::vector<LoopFrame> frames;
+	double t = 0.0;
+	int bufferPoll = -1;				// Poll keyboardBuffer holds
+	int controlsPoll = -1;				// Poll controlDown was read from
+	int previousPress = -1;
+	double gpuFree = 0.0;
+	double lastDisplay = 0.0;
+
+	while(t < pressed + 1.0)
+	{
+		// Getinput(), then poll for the next one.  Polling first reads
+		// the keys straight away instead.
+		if(settings.pollFirst)
+		{
+			polls.push_back(t);
+			pollPress.push_back(FindPress(presses, t));
+			bufferPoll = (int)polls.size() - 1;
+			t += POLL_COST;
+		}
+		if(bufferPoll >= 0)
+		{
+			int press = pollPress[bufferPoll];
+			tracker.Capture(press >= 0 && press != previousPress ? 1 : 0, polls[bufferPoll]);
+			previousPress = press;
+			controlsPoll = bufferPoll;
+		}
+		if(!settings.pollFirst)
+		{
+			polls.push_back(t);
+			pollPress.push_back(FindPress(presses, t));
+			bufferPoll = (int)polls.size() - 1;
+			t += POLL_COST;
+		}
+
+		// Render(): tick, then draw and present unless nothing changed
+		LoopFrame frame;
+		frame.tick	= t;
+		frame.poll	= controlsPoll;
+		tracker.Tick(t);
+		t += TICK_COST;
+		frame.drawn	= (int)(Random() * 100.0) >= settings.skip;
+		frame.present = frame.display = 0.0;
+		if(frame.drawn)
+		{
+			tracker.Draw(t);
+			t += settings.draw;
+
+			// Present blocks until the frame queue settings.queue frames
+			// back has been shown
+			int drawn = 0;
+			for(int i = (int)frames.size() - 1; i >= 0; --i)
+			{
+				if(frames[i].drawn && ++drawn == settings.queue)
+				{
+					if(frames[i].display > t)
+						t = frames[i].display;
+					break;
+				}
+			}
+			double done = (t > gpuFree ? t : gpuFree) + settings.gpu;
+			gpuFree = done;
+			if(settings.vsync)
+			{
+				double earliest = done > lastDisplay + REFRESH_PERIOD ? done : lastDisplay + REFRESH_PERIOD;
+				frame.display = ceil(earliest / REFRESH_PERIOD - 1e-9) * REFRESH_PERIOD;
+			}
+			else
+			{
+				frame.display = done;
+			}
+			lastDisplay = frame.display;
+			frame.present = t;
+			tracker.Present(t);
+		}
+		frames.push_back(frame);
+	}
+
+	// Each press through the log: the first poll that saw it, the first
+	// tick with keys from that poll, and the first frame drawn from then
+	result.missed = 0;
+	size_t frame = 0;
+	for(size_t press = 0; press < presses.size(); ++press)
+	{
+		size_t poll = 0;
+		while(poll < polls.size() && pollPress[poll] != (int)press)
+			++poll;
+		if(poll == polls.size())
+		{
+			++result.missed;
+			continue;
+		}
+		while(frame < frames.size() && frames[frame].poll < (int)poll)
+			++frame;
+		size_t shown = frame;
+		while(shown < frames.size() && !frames[shown].drawn)
+			++shown;
+		if(shown == frames.size())
+			continue;
+
+		result.keyToPoll.Add(polls[poll] - presses[press]);
+		result.presentToDisplay.Add(frames[shown].display - frames[shown].present);
+		result.keyToDisplay.Add(frames[shown].display - presses[press]);
+		result.logged.Add(frames[shown].present - polls[poll]);
+	}
+
+	const CLatencyHistogram& total = tracker.GetStage(LATENCY_TOTAL);
+	tracker.Format(result.report);
+	result.queuedP50	= tracker.GetStage(LATENCY_QUEUED).GetPercentile(50.0);
+	result.totalP50		= total.GetPercentile(50.0);
+	result.totalP99		= total.GetPercentile(99.0);
+	result.agrees		= total.GetCount() == result.logged.GetCount() &&
+		fabs(total.GetMean() - result.logged.GetMean()) < 1e-9 && total.GetMax() == result.logged.GetMax() &&
+		tracker.GetDroppedCount() == 0 && tracker.GetTimedOutCount() == 0;
+}
+
+int main(int argc, char** argv)
+{
+	LoopSettings settings;
+	settings.presses	= 2000;
+	settings.queue		= 3;
+	settings.gpu		= 0.012;
+	settings.draw		= 0.002;
+	settings.skip		= 10;
+	settings.vsync		= true;
+	settings.pollFirst	= false;
+
+	for(int i = 1; i < argc; ++i)
+	{
+		if(!strcmp(argv[i], "-presses") && i + 1 < argc)		settings.presses = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-queue") && i + 1 < argc)		settings.queue = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-gpu") && i + 1 < argc)		settings.gpu = atof(argv[++i]) * 1e-3;
+		else if(!strcmp(argv[i], "-draw") && i + 1 < argc)		settings.draw = atof(argv[++i]) * 1e-3;
+		else if(!strcmp(argv[i], "-skip") && i + 1 < argc)		settings.skip = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-novsync"))					settings.vsync = false;
+		else
+		{
+			printf("Usage: %s [-presses N] [-queue N] [-gpu ms] [-draw ms] [-skip percent] [-novsync]\n", argv[0]);
+			return 1;
+		}
+	}
+	if(settings.presses < 1)
+		settings.presses = 1;
+	if(settings.queue < 1)
+		settings.queue = 1;
+	if(settings.skip < 0 || settings.skip > 90)
+		settings.skip = 10;
+
+	printf("%d presses, GPU %.1f ms, draw %.1f ms, %d%% of frames unchanged, %s\n", settings.presses,
+		settings.gpu * 1e3, settings.draw * 1e3, settings.skip, settings.vsync ? "vsync" : "no vsync");
+	printf("%-24s %9s %9s %9s %9s %9s %9s\n", "", "key-poll", "poll-tick", "poll-pres", "poll-pres",
+		"pres-disp", "key-disp");
+	printf("%-24s %9s %9s %9s %9s %9s %9s\n", "Order, frames queued", "p50", "p50", "p50", "p99", "p50", "p99");
+
+	int result = 0;
+	std::string gameReport;
+	for(int order = 0; order < 2; ++order)
+	{
+		for(int queue = 0; queue < 2; ++queue)
+		{
+			LoopSettings run = settings;
+			run.pollFirst	= order == 1;
+			run.queue		= queue == 0 ? settings.queue : 1;
+			s_nSeed = 12345;
+
+			LoopResult loop;
+			RunLoop(run, loop);
+			if(order == 0 && queue == 0)
+				gameReport = loop.report;
+
+			char name[64];
+			sprintf(name, "%s, %d", run.pollFirst ? "Poll first" : "Game", run.queue);
+			printf("%-24s %9.2f %9.2f %9.2f %9.2f %9.2f %9.2f\n", name, loop.keyToPoll.GetPercentile(50.0) * 1e3,
+				loop.queuedP50 * 1e3, loop.totalP50 * 1e3, loop.totalP99 * 1e3,
+				loop.presentToDisplay.GetPercentile(50.0) * 1e3, loop.keyToDisplay.GetPercentile(99.0) * 1e3);
+
+			if(!loop.agrees || loop.missed > 0)
+			{
+				printf("FAILED: the tracker counted %s, the loop's log %lld presses, %d missed\n%s",
+					name, loop.logged.GetCount(), loop.missed, loop.report.c_str());
+				result = 1;
+			}
+		}
+	}
+	printf("\nThe game's order, as InputLatency.txt reports it:\n%s", gameReport.c_str());
+	return result;
+}
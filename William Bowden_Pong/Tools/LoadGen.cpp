@@ -0,0 +1,498 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	LoadGen.cpp
+// Date:	October 19th, 2026
+// Purpose: Load generator for PongServer.  Plays both paddles of many
+//			rooms at once from one thread, spread over a few sockets.
+//			Every player joins, then sends its inputs at a fixed rate,
+//			each on its own phase so the sends are not all in the same
+//			millisecond, and changes what it holds now and again.
+//
+//			Inputs carry their send time and the server echoes the
+//			newest one a tick used in that tick's state, so each new
+//			echo is an input's trip from sending, through the next tick
+//			on the server, to its result arriving back.  Prints the
+//			percentiles of that, states received against expected and
+//			the rooms that never started.
+//
+//			Also times the ball across the court from the states: how
+//			far it moves between consecutive steps, times the steps a
+//			second the server runs.  That has to be the speed a client
+//			plays at, [Tuning] BallSpeedX two steps a tick at [Video]
+//			TickRate from Pong.ini, or the run fails.  The joins say
+//			that tick rate, and a server at another rate rejects them,
+//			which fails the run too.  Linux only, run from the Dx12Test
+//			directory as the server is.
+//
+//			Build (Linux):
+//				g++ -O2 -std=c++11 -I../Dx12Test LoadGen.cpp
+//					../Dx12Test/MatchRoom.cpp ../Dx12Test/PaddleController.cpp
+//					../Dx12Test/PaddleAI.cpp ../Dx12Test/PongGame.cpp
+//					../Dx12Test/ConfigFile.cpp -o loadgen
+//
+//			Usage: loadgen [-host address] [-port N] [-loops N] [-rooms N]
+//					[-first N] [-hz N] [-seconds N] [-sockets N] [-tickrate N]
+//				-loops		the server's, to know which port a room is on
+//				-rooms		rooms to play, two players each
+//				-first		first room number, so several generators
+//						can share a server
+//				-hz		inputs each player sends a second
+//				-tickrate	the server's, default [Video] TickRate
+//////////////////////////////////////////////////////////////////////////
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include <algorithm>
+#include <thread>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/epoll.h>
+#include <netinet/in.h>
+#include <netdb.h>
+#include "MatchRoom.h"
+#include "TuningConfig.h"
+#include "PaddleController.h"
+#include "LatencyHistogram.h"
+#include "PongPlatform.h"
+
+#define LOADGEN_BATCH 64
+
+// Seconds between joins until the room starts
+#define LOADGEN_JOIN_RETRY 0.5
+
+// Ball moves between consecutive steps kept to find the ball's speed
+#define LOADGEN_MAX_MOVES (1 << 20)
+
+// How far the ball's speed may be from a client's
+#define LOADGEN_SPEED_TOLERANCE 0.05
+
+struct Player
+{
+	unsigned int		room;
+	int					paddle;
+	int					socket;			// Index into the sockets
+	double				nextSend;
+	int					inputs;
+	unsigned int		sequence;		// Last input sent
+	unsigned int		echoed;			// Last input seen in a state
+	unsigned int		lastTick;
+	unsigned int		firstTick;		// Of the first state
+	double				firstTime;		// When it arrived
+	double				lastTime;		// When the newest state arrived
+	float				ballX;			// In the newest state
+	long long			states;
+	bool				started;		// A state has arrived
+};
+
+class CLoadGen
+{
+	std::vector<int>		m_Sockets;
+	int						m_Epoll;
+	sockaddr_in				m_Server;
+	int						m_nLoops;
+	unsigned int			m_nFirst;
+	std::vector<Player>		m_Players;	// Room - first is players / 2
+	unsigned int			m_Seed;
+
+	// Inputs waiting to be sent, per socket
+	std::vector<mmsghdr>	m_Out;
+	std::vector<sockaddr_in>	m_OutAddress;
+	std::vector<iovec>		m_OutVec;
+	std::vector<unsigned char>	m_OutData;
+	std::vector<int>		m_OutCount;
+
+	CLoadGen(const CLoadGen&);
+	CLoadGen& operator=(const CLoadGen&);
+
+	void Queue(const Player& player, const RoomPacket& packet);
+	void Flush();
+	void Receive(int socket, double now);
+
+public:
+	CLatencyHistogram		m_Latency;
+	long long				m_nSent;
+	long long				m_nReceived;
+	long long				m_nSkippedTicks;	// Gaps in the tick numbers seen
+	unsigned int			m_nTickRate;		// Sent with the joins
+	long long				m_nRejected;		// Joins the server turned down
+	unsigned int			m_nServerTickRate;	// The rate it said it wants
+	std::vector<float>		m_BallMoves;		// Pixels across in one step
+
+	CLoadGen(void) : m_Epoll(-1), m_nSent(0), m_nReceived(0), m_nSkippedTicks(0), m_nTickRate(0),
+		m_nRejected(0), m_nServerTickRate(0)	{}
+	~CLoadGen(void);
+
+	bool Open(const char* host, int port, int loops, int rooms, unsigned int first, int sockets);
+	void Run(double seconds, double hz);
+	int GetStarted() const;
+	long long GetStates() const;
+
+	// Pixels a second, 0 if no moves were seen
+	double GetBallSpeed();
+};
+
+CLoadGen::~CLoadGen(void)
+{
+	for(size_t i = 0; i < m_Sockets.size(); ++i)
+		close(m_Sockets[i]);
+	if(m_Epoll >= 0)
+		close(m_Epoll);
+}
+
+bool CLoadGen::Open(const char* host, int port, int loops, int rooms, unsigned int first, int sockets)
+{
+	addrinfo hints;
+	memset(&hints, 0, sizeof(hints));
+	hints.ai_family		= AF_INET;
+	hints.ai_socktype	= SOCK_DGRAM;
+	addrinfo* found = 0;
+	if(getaddrinfo(host, 0, &hints, &found) != 0 || !found)
+		return false;
+	memcpy(&m_Server, found->ai_addr, sizeof(m_Server));
+	freeaddrinfo(found);
+	m_Server.sin_port = htons((unsigned short)port);
+
+	m_nLoops	= loops;
+	m_nFirst	= first;
+	m_Seed		= 1;
+	m_Epoll		= epoll_create1(0);
+	if(m_Epoll < 0)
+		return false;
+
+	for(int i = 0; i < sockets; ++i)
+	{
+		int s = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK, IPPROTO_UDP);
+		if(s < 0)
+			return false;
+		int buffer = 4 << 20;
+		setsockopt(s, SOL_SOCKET, SO_RCVBUF, &buffer, sizeof(buffer));
+		setsockopt(s, SOL_SOCKET, SO_SNDBUF, &buffer, sizeof(buffer));
+		m_Sockets.push_back(s);
+
+		epoll_event event;
+		memset(&event, 0, sizeof(event));
+		event.events = EPOLLIN;
+		event.data.u32 = (unsigned int)i;
+		epoll_ctl(m_Epoll, EPOLL_CTL_ADD, s, &event);
+	}
+
+	m_Out.resize(sockets * LOADGEN_BATCH);
+	m_OutAddress.resize(sockets * LOADGEN_BATCH);
+	m_OutVec.resize(sockets * LOADGEN_BATCH);
+	m_OutData.resize(sockets * LOADGEN_BATCH * ROOM_MAX_PACKET);
+	m_OutCount.assign(sockets, 0);
+	for(size_t i = 0; i < m_Out.size(); ++i)
+	{
+		memset(&m_Out[i], 0, sizeof(m_Out[i]));
+		m_OutVec[i].iov_base = &m_OutData[i * ROOM_MAX_PACKET];
+		m_Out[i].msg_hdr.msg_iov = &m_OutVec[i];
+		m_Out[i].msg_hdr.msg_iovlen = 1;
+		m_Out[i].msg_hdr.msg_name = &m_OutAddress[i];
+		m_Out[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+	}
+
+	m_Players.resize(rooms * 2);
+	for(int i = 0; i < rooms * 2; ++i)
+	{
+		Player& player = m_Players[i];
+		memset(&player, 0, sizeof(player));
+		player.room		= first + i / 2;
+		player.paddle	= i % 2;
+		player.socket	= i % sockets;
+	}
+	return true;
+}
+
+void CLoadGen::Queue(const Player& player, const RoomPacket& packet)
+{
+	int socket = player.socket;
+	if(m_OutCount[socket] == LOADGEN_BATCH)
+		Flush();
+
+	int slot = socket * LOADGEN_BATCH + m_OutCount[socket]++;
+	m_OutVec[slot].iov_len = WriteRoomPacket(packet, (unsigned char*)m_OutVec[slot].iov_base);
+	m_OutAddress[slot] = m_Server;
+	m_OutAddress[slot].sin_port = htons((unsigned short)(ntohs(m_Server.sin_port) + player.room % m_nLoops));
+}
+
+void CLoadGen::Flush()
+{
+	for(size_t s = 0; s < m_Sockets.size(); ++s)
+	{
+		int sent = 0;
+		while(sent < m_OutCount[s])
+		{
+			int count = sendmmsg(m_Sockets[s], &m_Out[s * LOADGEN_BATCH + sent], m_OutCount[s] - sent, 0);
+			if(count <= 0)
+				break;
+			sent += count;
+		}
+		m_nSent += sent;
+		m_OutCount[s] = 0;
+	}
+}
+
+void CLoadGen::Receive(int socket, double now)
+{
+	mmsghdr in[LOADGEN_BATCH];
+	iovec vec[LOADGEN_BATCH];
+	unsigned char data[LOADGEN_BATCH][ROOM_MAX_PACKET];
+	for(int i = 0; i < LOADGEN_BATCH; ++i)
+	{
+		vec[i].iov_base	= data[i];
+		vec[i].iov_len	= sizeof(data[i]);
+		memset(&in[i], 0, sizeof(in[i]));
+		in[i].msg_hdr.msg_iov		= &vec[i];
+		in[i].msg_hdr.msg_iovlen	= 1;
+	}
+
+	int count;
+	while((count = recvmmsg(m_Sockets[socket], in, LOADGEN_BATCH, 0, 0)) > 0)
+	{
+		for(int i = 0; i < count; ++i)
+		{
+			RoomPacket packet;
+			if(!ReadRoomPacket(data[i], (int)in[i].msg_len, packet))
+				continue;
+			if(packet.type == ROOM_PACKET_REJECT)
+			{
+				++m_nRejected;
+				m_nServerTickRate = packet.tickRate;
+				continue;
+			}
+			if(packet.type != ROOM_PACKET_STATE)
+				continue;
+			unsigned int index = (packet.room - m_nFirst) * 2 + packet.paddle;
+			if(index >= m_Players.size())
+				continue;
+
+			++m_nReceived;
+			Player& player = m_Players[index];
+			if(player.started && packet.tick > player.lastTick + 1)
+				m_nSkippedTicks += packet.tick - player.lastTick - 1;
+
+			// Only the left player's states, both players see the same ball
+			if(player.started && packet.tick == player.lastTick + 1 && player.paddle == 0
+				&& packet.ballX != player.ballX && m_BallMoves.size() < LOADGEN_MAX_MOVES)
+			{
+				float move = packet.ballX - player.ballX;
+				m_BallMoves.push_back(move < 0.0f ? -move : move);
+			}
+			if(!player.started)
+			{
+				player.firstTick = packet.tick;
+				player.firstTime = now;
+			}
+			if(packet.tick > player.lastTick || !player.started)
+			{
+				player.lastTick		= packet.tick;
+				player.lastTime		= now;
+				player.ballX		= packet.ballX;
+			}
+			player.started = true;
+			++player.states;
+
+			// First time this input is seen applied
+			if(packet.sequence != 0 && packet.sequence != player.echoed)
+			{
+				player.echoed = packet.sequence;
+				m_Latency.Add(now - packet.stamp * 1e-6);
+			}
+		}
+		if(count < LOADGEN_BATCH)
+			break;
+	}
+}
+
+void CLoadGen::Run(double seconds, double hz)
+{
+	double period = 1.0 / hz;
+	double start = PlatformGetTime();
+	for(size_t i = 0; i < m_Players.size(); ++i)
+		m_Players[i].nextSend = start + period * i / m_Players.size();
+
+	double end = start + seconds;
+	for(;;)
+	{
+		epoll_event events[16];
+		int count = epoll_wait(m_Epoll, events, 16, 1);
+		double now = PlatformGetTime();
+		for(int i = 0; i < count; ++i)
+			Receive((int)events[i].data.u32, now);
+		if(now >= end)
+			break;
+
+		for(size_t i = 0; i < m_Players.size(); ++i)
+		{
+			Player& player = m_Players[i];
+			if(player.nextSend > now)
+				continue;
+
+			RoomPacket packet;
+			memset(&packet, 0, sizeof(packet));
+			packet.room		= player.room;
+			packet.paddle	= player.paddle;
+			if(!player.started)
+			{
+				packet.type		= ROOM_PACKET_JOIN;
+				packet.tickRate	= m_nTickRate;
+				player.nextSend = now + LOADGEN_JOIN_RETRY;
+			}
+			else
+			{
+				// About twice a second, hold something else
+				m_Seed = m_Seed * 1664525u + 1013904223u;
+				if((m_Seed >> 16) % (unsigned int)(hz / 2.0 + 1.0) == 0)
+					player.inputs = (m_Seed >> 8) % 3 == 0 ? 0 : (m_Seed >> 8) % 3 == 1 ? INPUT_UP : INPUT_DOWN;
+
+				packet.type		= ROOM_PACKET_INPUT;
+				packet.sequence	= ++player.sequence;
+				packet.inputs	= player.inputs;
+				packet.stamp	= (unsigned long long)(now * 1e6);
+				player.nextSend += period;
+				if(player.nextSend < now)
+					player.nextSend = now + period;
+			}
+			Queue(player, packet);
+		}
+		Flush();
+	}
+
+	for(size_t i = 0; i < m_Players.size(); ++i)
+	{
+		RoomPacket packet;
+		memset(&packet, 0, sizeof(packet));
+		packet.type		= ROOM_PACKET_LEAVE;
+		packet.room		= m_Players[i].room;
+		packet.paddle	= m_Players[i].paddle;
+		Queue(m_Players[i], packet);
+	}
+	Flush();
+}
+
+int CLoadGen::GetStarted() const
+{
+	int started = 0;
+	for(size_t i = 0; i < m_Players.size(); i += 2)
+		if(m_Players[i].started && m_Players[i + 1].started)
+			++started;
+	return started;
+}
+
+long long CLoadGen::GetStates() const
+{
+	long long states = 0;
+	for(size_t i = 0; i < m_Players.size(); ++i)
+		states += m_Players[i].states;
+	return states;
+}
+
+double CLoadGen::GetBallSpeed()
+{
+	// Steps a second as the server ran them
+	double steps = 0.0;
+	double seconds = 0.0;
+	for(size_t i = 0; i < m_Players.size(); ++i)
+	{
+		const Player& player = m_Players[i];
+		if(player.started)
+		{
+			steps	+= player.lastTick - player.firstTick;
+			seconds	+= player.lastTime - player.firstTime;
+		}
+	}
+	if(m_BallMoves.empty() || seconds <= 0.0)
+		return 0.0;
+
+	// The median, a bounce or a point now and then makes a short or a
+	// long move
+	std::vector<float>::iterator middle = m_BallMoves.begin() + m_BallMoves.size() / 2;
+	std::nth_element(m_BallMoves.begin(), middle, m_BallMoves.end());
+	return *middle * steps / seconds;
+}
+
+int main(int argc, char** argv)
+{
+	const char* host = "127.0.0.1";
+	int port = 27100;
+	int loops = (int)std::thread::hardware_concurrency();
+	int rooms = 500;
+	int first = 0;
+	double hz = 60.0;
+	double seconds = 10.0;
+	int sockets = 8;
+
+	// The speed a client plays at
+	CConfigFile config;
+	config.Load(PONG_CONFIG_FILE);
+	PongTuning tuning;
+	ReadTuningConfig(config, tuning);
+	double tickRate = config.GetFloat("Video", "TickRate", PONG_TICK_RATE);
+
+	for(int i = 1; i < argc; ++i)
+	{
+		if(!strcmp(argv[i], "-host") && i + 1 < argc)			host = argv[++i];
+		else if(!strcmp(argv[i], "-port") && i + 1 < argc)		port = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-loops") && i + 1 < argc)		loops = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-rooms") && i + 1 < argc)		rooms = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-first") && i + 1 < argc)		first = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-hz") && i + 1 < argc)		hz = atof(argv[++i]);
+		else if(!strcmp(argv[i], "-seconds") && i + 1 < argc)	seconds = atof(argv[++i]);
+		else if(!strcmp(argv[i], "-sockets") && i + 1 < argc)	sockets = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-tickrate") && i + 1 < argc)	tickRate = atof(argv[++i]);
+		else
+		{
+			printf("Usage: %s [-host address] [-port N] [-loops N] [-rooms N] [-first N] [-hz N] [-seconds N] [-sockets N]"
+				" [-tickrate N]\n", argv[0]);
+			return 1;
+		}
+	}
+	if(loops < 1)
+		loops = 1;
+	if(rooms < 1)
+		rooms = 1;
+	if(sockets < 1)
+		sockets = 1;
+	if(hz <= 0.0)
+		hz = 60.0;
+
+	static CLoadGen load;
+	if(!load.Open(host, port, loops, rooms, (unsigned int)first, sockets))
+	{
+		printf("Could not reach %s\n", host);
+		return 1;
+	}
+	printf("%d players in %d rooms on %s:%d-%d, %.0f inputs a second each, %.0f s\n", rooms * 2, rooms,
+		host, port, port + loops - 1, hz, seconds);
+	load.m_nTickRate = tickRate > 0.0 ? (unsigned int)(tickRate + 0.5) : 0;
+	load.Run(seconds, hz);
+
+	const CLatencyHistogram& latency = load.m_Latency;
+	int started = load.GetStarted();
+	printf("%d of %d rooms started, %lld inputs and joins sent, %lld states received, %lld steps skipped\n",
+		started, rooms, load.m_nSent, load.m_nReceived, load.m_nSkippedTicks);
+	printf("%.0f states a second, %.0f per player\n", load.GetStates() / seconds,
+		load.GetStates() / seconds / (rooms * 2));
+	printf("input to step to state, %lld inputs: mean %.3f  p50 %.3f  p90 %.3f  p99 %.3f  p99.9 %.3f  max %.3f ms\n",
+		latency.GetCount(), latency.GetMean() * 1e3, latency.GetPercentile(50.0) * 1e3,
+		latency.GetPercentile(90.0) * 1e3, latency.GetPercentile(99.0) * 1e3,
+		latency.GetPercentile(99.9) * 1e3, latency.GetMax() * 1e3);
+
+	int result = started == rooms ? 0 : 1;
+	if(load.m_nRejected > 0)
+	{
+		printf("FAILED: %lld joins rejected, the server plays at %u match ticks a second, these players at %u\n",
+			load.m_nRejected, load.m_nServerTickRate, load.m_nTickRate);
+		result = 1;
+	}
+	double speed = load.GetBallSpeed();
+	double expected = tuning.ballSpeedX * 2.0 * tickRate;
+	printf("Ball %.1f pixels a second across, a client plays at %.1f\n", speed, expected);
+	if(tickRate > 0.0 && (speed < expected * (1.0 - LOADGEN_SPEED_TOLERANCE)
+		|| speed > expected * (1.0 + LOADGEN_SPEED_TOLERANCE)))
+	{
+		printf("FAILED: the server's ball does not move at the client's speed\n");
+		result = 1;
+	}
+	return result;
+}
@@ -0,0 +1,222 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	MetricsBench.cpp
+// Date:	October 19th, 2026
+// Purpose: Times counting into CMetricsRegistry (Metrics.h) from several
+//			threads at once, against one counter all the threads share
+//			with a locked add and against a counter behind a mutex, the
+//			usual ways to count from more than one thread.  Publishes to
+//			shared memory every 10 ms the whole time while a reader
+//			copies it as fast as it can.
+//
+//			Checks that the published totals come out exact once the
+//			threads stop, that the reader only ever saw whole publishes
+//			with counters that never went backwards, and that the
+//			segment is gone after Shutdown().  Exits with 1 if not.
+//
+//			Build (Linux):
+//				g++ -O2 -std=c++11 -pthread -I../Dx12Test MetricsBench.cpp
+//					../Dx12Test/Metrics.cpp -o metricsbench
+//
+//			Usage: metricsbench [-threads N] [-adds N]
+//				-threads	counting threads, default 4
+//				-adds		adds by each thread for each way
+//////////////////////////////////////////////////////////////////////////
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include "Metrics.h"
+
+#define BENCH_SEGMENT "PongMetricsBench"
+
+struct BenchShared
+{
+	CMetricsRegistry				registry;
+	int								counter;
+	int								histogram;
+	std::atomic<unsigned long long>	shared;
+	std::mutex						mutex;
+	unsigned long long				locked;
+	std::atomic<bool>				go;
+};
+
+enum CountWay
+{
+	COUNT_REGISTRY,						// Each thread's own slot
+	COUNT_SHARED,						// One atomic, fetch_add
+	COUNT_MUTEX,						// One integer behind a mutex
+	COUNT_WAYS
+};
+
+static const char* const s_WayNames[COUNT_WAYS] = { "Registry", "Shared atomic", "Mutex" };
+
+static void CountMain(BenchShared* shared, CountWay way, int adds, double* seconds)
+{
+	CMetricsWriter writer = way == COUNT_REGISTRY ? shared->registry.GetWriter() : CMetricsWriter();
+	while(!shared->go.load())
+		std::this_thread::yield();
+
+	double start = PlatformGetTime();
+	for(int i = 0; i < adds; ++i)
+	{
+		switch(way)
+		{
+		case COUNT_REGISTRY:
+			writer.Add(shared->counter);
+			if((i & 1023) == 0)
+				writer.Record(shared->histogram, 1e-6 * (i & 4095));
+			break;
+		case COUNT_SHARED:
+			shared->shared.fetch_add(1);
+			break;
+		default:
+			{
+				std::lock_guard<std::mutex> lock(shared->mutex);
+				++shared->locked;
+			}
+			break;
+		}
+	}
+	*seconds = PlatformGetTime() - start;
+}
+
+// Copies the segment until told to stop, counting torn or backwards reads
+static void ReaderMain(std::atomic<bool>* stop, long long* reads, long long* wrong)
+{
+	static MetricsSegment segment;
+	CMetricsReader reader;
+	unsigned long long last = 0;
+	unsigned long long lastPublish = 0;
+	while(!stop->load())
+	{
+		if(!reader.IsOpen() && !reader.Open(BENCH_SEGMENT))
+		{
+			std::this_thread::yield();
+			continue;
+		}
+		if(!reader.Read(segment))
+			continue;
+		++*reads;
+		const MetricsHeader& header = segment.header;
+		if(header.sequence % 2 != 0 || header.counterCount < 1 || header.publishCount < lastPublish
+			|| segment.counters[0].value < last)
+		{
+			++*wrong;
+		}
+		last = segment.counters[0].value;
+		lastPublish = header.publishCount;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	int threads = 4;
+	int adds = 10000000;
+	for(int i = 1; i < argc; ++i)
+	{
+		if(!strcmp(argv[i], "-threads") && i + 1 < argc)		threads = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-adds") && i + 1 < argc)		adds = atoi(argv[++i]);
+		else
+		{
+			printf("Usage: %s [-threads N] [-adds N]\n", argv[0]);
+			return 1;
+		}
+	}
+	if(threads < 1)
+		threads = 1;
+	if(threads > METRICS_MAX_WRITERS - 1)
+		threads = METRICS_MAX_WRITERS - 1;
+	if(adds < 1)
+		adds = 1;
+
+	static BenchShared shared;
+	shared.counter		= shared.registry.AddCounter("bench.adds");
+	shared.histogram	= shared.registry.AddHistogram("bench.times");
+	shared.shared		= 0;
+	shared.locked		= 0;
+
+	MetricsDesc desc;
+	desc.name		= BENCH_SEGMENT;
+	desc.interval	= 0.01;
+	CMetricsPublisher publisher;
+	if(!publisher.Start(shared.registry, desc))
+	{
+		printf("FAILED: could not create the shared memory segment\n");
+		return 1;
+	}
+	std::atomic<bool> stop(false);
+	long long reads = 0;
+	long long wrong = 0;
+	std::thread readerThread(ReaderMain, &stop, &reads, &wrong);
+
+	printf("%d threads, %d adds each\n", threads, adds);
+	printf("%-14s %10s %12s\n", "Way", "ns/add", "Adds/s");
+	int result = 0;
+	for(int way = 0; way < COUNT_WAYS; ++way)
+	{
+		shared.go = false;
+		std::vector<double> seconds(threads);
+		std::vector<std::thread> workers;
+		for(int i = 0; i < threads; ++i)
+			workers.push_back(std::thread(CountMain, &shared, (CountWay)way, adds, &seconds[i]));
+		shared.go = true;
+		double slowest = 0.0;
+		for(int i = 0; i < threads; ++i)
+		{
+			workers[i].join();
+			if(seconds[i] > slowest)
+				slowest = seconds[i];
+		}
+		printf("%-14s %10.2f %12.3g\n", s_WayNames[way], slowest * 1e9 / adds, (double)adds * threads / slowest);
+	}
+
+	stop = true;
+	readerThread.join();
+
+	// Everything counted is in the next publish
+	publisher.Publish();
+	static MetricsSegment segment;
+	CMetricsReader reader;
+	unsigned long long expected = (unsigned long long)adds * threads;
+	unsigned long long timed = (unsigned long long)((adds + 1023) / 1024) * threads;
+	if(!reader.Open(BENCH_SEGMENT) || !reader.Read(segment))
+	{
+		printf("FAILED: the segment could not be read\n");
+		result = 1;
+	}
+	else
+	{
+		printf("Published %llu times, %lld reads during the run, %.0f ns a publish at p50\n",
+			segment.header.publishCount, reads, GetMetricsPercentile(segment.histograms[1], 50.0) * 1e3);
+		if(segment.counters[0].value != expected || segment.histograms[0].count != timed)
+		{
+			printf("FAILED: published %llu adds and %llu times, counted %llu and %llu\n", segment.counters[0].value,
+				segment.histograms[0].count, expected, timed);
+			result = 1;
+		}
+		if(strcmp(segment.histograms[1].name, "metrics.publish") != 0 || segment.header.writerCount != (unsigned int)threads + 1)
+		{
+			printf("FAILED: the publisher's own time was not published\n");
+			result = 1;
+		}
+	}
+	reader.Close();
+	if(wrong > 0 || reads == 0)
+	{
+		printf("FAILED: %lld of %lld reads were torn or went backwards\n", wrong, reads);
+		result = 1;
+	}
+	if(shared.shared.load() != expected || shared.locked != expected)
+	{
+		printf("FAILED: the shared counters lost adds\n");
+		result = 1;
+	}
+
+	publisher.Shutdown();
+	if(reader.Open(BENCH_SEGMENT))
+	{
+		printf("FAILED: the segment was left behind\n");
+		result = 1;
+	}
+	return result;
+}
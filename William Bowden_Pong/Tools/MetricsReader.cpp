@@ -0,0 +1,125 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	MetricsReader.cpp
+// Date:	October 19th, 2026
+// Purpose: Prints the metrics a running game or PongHeadless publishes
+//			(Metrics.h, PongMetrics.h), for watching a kiosk from a
+//			shell on the same machine.  Counters are shown with their
+//			rate, over the last interval when watching and since the
+//			game started otherwise, gauges as they are, and times with
+//			their mean and percentiles.  Reading never holds the game
+//			up.  With -watch a game that stops publishing is reported
+//			as stale, and a restarted one is picked up again.
+//
+//			Build (Linux):
+//				g++ -O2 -std=c++11 -pthread -I../Dx12Test MetricsReader.cpp
+//					../Dx12Test/Metrics.cpp -o pong_metrics
+//
+//			Usage: pong_metrics [-name N] [-watch seconds] [-count N]
+//				-name		shared memory name, default PongMetrics
+//				-watch		print again every so many seconds
+//				-count		stop after this many prints, default 1,
+//						or forever with -watch
+//////////////////////////////////////////////////////////////////////////
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Metrics.h"
+
+// Publishes missed before a watched game is called stale
+#define STALE_INTERVALS 3
+
+static void PrintSegment(const MetricsSegment& segment, const MetricsSegment* previous)
+{
+	const MetricsHeader& header = segment.header;
+	double seconds = header.uptime;
+	if(previous)
+		seconds -= previous->header.uptime;
+
+	printf("Process %u, up %.1f s, published %llu times every %.2f s, %u threads counting\n", header.processId,
+		header.uptime, header.publishCount, header.interval, header.writerCount);
+	printf("%-32s %16s %12s\n", "Counter", "Value", "Per s");
+	for(unsigned int i = 0; i < header.counterCount; ++i)
+	{
+		const MetricsCounterEntry& counter = segment.counters[i];
+		if(counter.kind == METRIC_GAUGE)
+		{
+			printf("%-32s %16llu %12s\n", counter.name, counter.value, "-");
+			continue;
+		}
+		unsigned long long from = previous && i < previous->header.counterCount ? previous->counters[i].value : 0;
+		double rate = seconds > 0.0 && counter.value >= from ? (counter.value - from) / seconds : 0.0;
+		printf("%-32s %16llu %12.1f\n", counter.name, counter.value, rate);
+	}
+
+	if(header.histogramCount == 0)
+		return;
+	printf("%-32s %12s %10s %10s %10s %10s\n", "Time", "Count", "Mean us", "p50 us", "p99 us", "p99.9 us");
+	for(unsigned int i = 0; i < header.histogramCount; ++i)
+	{
+		const MetricsHistogramEntry& histogram = segment.histograms[i];
+		double mean = histogram.count ? (double)histogram.total / histogram.count : 0.0;
+		printf("%-32s %12llu %10.1f %10.0f %10.0f %10.0f\n", histogram.name, histogram.count, mean,
+			GetMetricsPercentile(histogram, 50.0), GetMetricsPercentile(histogram, 99.0),
+			GetMetricsPercentile(histogram, 99.9));
+	}
+}
+
+int main(int argc, char** argv)
+{
+	const char* name = METRICS_DEFAULT_NAME;
+	double watch = 0.0;
+	int count = 0;
+
+	for(int i = 1; i < argc; ++i)
+	{
+		if(!strcmp(argv[i], "-name") && i + 1 < argc)			name = argv[++i];
+		else if(!strcmp(argv[i], "-watch") && i + 1 < argc)		watch = atof(argv[++i]);
+		else if(!strcmp(argv[i], "-count") && i + 1 < argc)		count = atoi(argv[++i]);
+		else
+		{
+			printf("Usage: %s [-name N] [-watch seconds] [-count N]\n", argv[0]);
+			return 1;
+		}
+	}
+	if(watch <= 0.0 && count <= 0)
+		count = 1;
+
+	static MetricsSegment segments[2];
+	MetricsSegment* current = &segments[0];
+	MetricsSegment* previous = 0;
+	double lastChange = PlatformGetTime();
+	for(int printed = 0; count <= 0 || printed < count; ++printed)
+	{
+		if(printed > 0)
+			PlatformSleep(watch);
+
+		// Opened again each time, a game that restarted has a new segment
+		CMetricsReader reader;
+		if(!reader.Open(name) || !reader.Read(*current))
+		{
+			printf("No game is publishing metrics as %s\n", name);
+			if(watch <= 0.0)
+				return 1;
+			previous = 0;
+			continue;
+		}
+
+		if(previous && previous->header.processId != current->header.processId)
+			previous = 0;
+		double now = PlatformGetTime();
+		if(previous && previous->header.publishCount == current->header.publishCount)
+		{
+			if(now - lastChange > current->header.interval * STALE_INTERVALS)
+				printf("Stale: nothing published for %.1f s\n", now - lastChange);
+			continue;
+		}
+		lastChange = now;
+
+		if(printed > 0)
+			printf("\n");
+		PrintSegment(*current, previous);
+		previous = current;
+		current = current == &segments[0] ? &segments[1] : &segments[0];
+	}
+	return 0;
+}
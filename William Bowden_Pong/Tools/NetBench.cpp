@@ -0,0 +1,178 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	NetBench.cpp
+// Date:	October 19th, 2026
+// Purpose: Plays two CRollbackSessions against each other over a
+//			CLoopbackLink at a range of latencies, jitter and loss.  The
+//			paddles are played first by the AI, whose inputs change a few
+//			times per rally, then by scripts that change every few
+//			frames, the worst case for prediction.  Time is simulated,
+//			one frame per step at the chosen rate, by default the
+//			game's: NET_FRAME_RATE frames of PONG_TICK_RATE / 60 match
+//			ticks each.  Prints how often
+//			each side rolled back, how far and what running frames again
+//			cost, and checks every frame both sides have confirmed is the
+//			same on both.  Exits with 1 if the two ever disagree.
+//
+//			Build (Linux):
+//				g++ -O2 -std=c++11 -I../Dx12Test NetBench.cpp
+//					../Dx12Test/Rollback.cpp ../Dx12Test/LoopbackTransport.cpp
+//					../Dx12Test/PaddleController.cpp ../Dx12Test/PaddleAI.cpp
+//					../Dx12Test/PongGame.cpp -o netbench
+//
+//			Usage: netbench [-frames N] [-fps N] [-tickrate N] [-delay N]
+//					[-left spec] [-right spec]
+//				-fps		frames a second, Advance() calls
+//				-tickrate	match ticks a second, 0 for one a frame
+//				-left, -right	replace the script pass with these
+//						controllers, see PaddleController.h
+//////////////////////////////////////////////////////////////////////////
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Rollback.h"
+#include "LoopbackTransport.h"
+#include "PaddleController.h"
+
+struct Scenario
+{
+	double				latency;		// Milliseconds, one way
+	double				jitter;
+	float				loss;			// Percent
+};
+
+static bool RunScenario(const Scenario& scenario, int frames, double fps, int tickRate, int delay,
+	const ControllerDesc* controllers)
+{
+	LoopbackSettings settings;
+	settings.latency	= scenario.latency * 0.001;
+	settings.jitter		= scenario.jitter * 0.001;
+	settings.loss		= scenario.loss * 0.01f;
+	settings.seed		= 77;
+	CLoopbackLink link;
+	link.Init(settings);
+
+	CRollbackSession session[2];
+	CPongGame game[2];
+	CPaddleController controller[2];
+	for(int i = 0; i < 2; ++i)
+	{
+		session[i].Init(&link.GetEndpoint(i), i, delay, tickRate);
+		game[i].Menu.onSTART = false;
+		game[i].FinishMovie();
+		controller[i].Init(controllers[i], i, 100 + i);
+	}
+
+	int checked = 0;
+	int mismatched = -1;
+	for(int step = 0; step < frames; ++step)
+	{
+		link.SetTime(step / fps);
+		for(int i = 0; i < 2; ++i)
+		{
+			// Each side sees its own game, predictions and all
+			int inputs = GetPaddleInputs(i, controller[i].Think(game[i]));
+			int sounds;
+			session[i].Advance(game[i], inputs, sounds);
+		}
+
+		// The newest frame both have confirmed
+		int confirmed = session[0].GetConfirmedFrame();
+		if(session[1].GetConfirmedFrame() < confirmed)
+			confirmed = session[1].GetConfirmedFrame();
+		const PongState* a = session[0].GetSavedState(confirmed - 1);
+		const PongState* b = session[1].GetSavedState(confirmed - 1);
+		if(a && b)
+		{
+			++checked;
+			if(mismatched < 0 && GetStateChecksum(*a) != GetStateChecksum(*b))
+				mismatched = confirmed - 1;
+		}
+	}
+
+	const LoopbackStats& net = link.GetStats();
+	printf("%4.0f ms %3.0f ms %4.1f%%", scenario.latency, scenario.jitter, scenario.loss);
+	for(int i = 0; i < 2; ++i)
+	{
+		const RollbackStats& s = session[i].GetStats();
+		printf("  | %6d %5.2f %4.1f %3d %6.2f %5.0f %4d",
+			s.frames, 100.0 * s.rollbacks / (s.frames > 0 ? s.frames : 1),
+			s.rollbacks > 0 ? (double)s.resimulated / s.rollbacks : 0.0, s.longestRollback,
+			(double)s.resimulated / (s.frames > 0 ? s.frames : 1),
+			s.resimulated > 0 ? s.rollbackSeconds * 1e9 / s.resimulated : 0.0, s.stalls);
+	}
+	printf("  | %5.1f%% %5d %s\n", 100.0 * net.dropped / (net.sent > 0 ? net.sent : 1), checked,
+		mismatched < 0 ? "same" : "DIFFER");
+	if(mismatched >= 0)
+		printf("  first difference at frame %d\n", mismatched);
+
+	return mismatched < 0;
+}
+
+int main(int argc, char** argv)
+{
+	int frames = 20000;
+	double fps = NET_FRAME_RATE;
+	int tickRate = PONG_TICK_RATE;
+	int delay = 2;
+	const char* specs[2][2] = { { "hard", "hard" }, { "script:U5 D9 -4 U3 D7", "script:D6 U4 -2 D8 U5 -1" } };
+
+	for(int i = 1; i < argc; ++i)
+	{
+		if(!strcmp(argv[i], "-frames") && i + 1 < argc)		frames = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-fps") && i + 1 < argc)	fps = atof(argv[++i]);
+		else if(!strcmp(argv[i], "-tickrate") && i + 1 < argc)	tickRate = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-delay") && i + 1 < argc)	delay = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-left") && i + 1 < argc)	specs[1][0] = argv[++i];
+		else if(!strcmp(argv[i], "-right") && i + 1 < argc)	specs[1][1] = argv[++i];
+		else
+		{
+			printf("Usage: %s [-frames N] [-fps N] [-tickrate N] [-delay N] [-left spec] [-right spec]\n", argv[0]);
+			return 1;
+		}
+	}
+	if(fps <= 0.0)
+		fps = NET_FRAME_RATE;
+	if(tickRate < 0)
+		tickRate = 0;
+
+	static const Scenario scenarios[] =
+	{
+		{   0.0,  0.0,  0.0f },
+		{  15.0,  5.0,  0.0f },
+		{  40.0, 10.0,  1.0f },
+		{  80.0, 20.0,  2.0f },
+		{ 120.0, 40.0,  5.0f },
+		{ 200.0, 60.0, 10.0f },
+	};
+
+	printf("%d frames at %.0f fps of %d match ticks a second, input delay %d\n", frames, fps, tickRate, delay);
+	printf("Per side: frames run, rollbacks per 100 frames, mean and longest rollback in frames,\n");
+	printf("frames run again per frame, ns per frame run again, stalls.  Then packets lost,\n");
+	printf("confirmed frames compared and whether both sides agree.\n");
+
+	bool same = true;
+	for(int pass = 0; pass < 2; ++pass)
+	{
+		ControllerDesc controllers[2];
+		for(int i = 0; i < 2; ++i)
+		{
+			if(!ParseController(specs[pass][i], controllers[i]))
+			{
+				printf("Not a controller: %s\n", specs[pass][i]);
+				return 1;
+			}
+		}
+
+		printf("\n%s vs %s\n", specs[pass][0], specs[pass][1]);
+		printf("latency jitter loss |  left                                 |  right                                |\n");
+		for(size_t i = 0; i < sizeof(scenarios) / sizeof(scenarios[0]); ++i)
+			same = RunScenario(scenarios[i], frames, fps, tickRate, delay, controllers) && same;
+	}
+
+	if(!same)
+	{
+		printf("FAILED: the peers disagree on a confirmed frame\n");
+		return 1;
+	}
+	return 0;
+}
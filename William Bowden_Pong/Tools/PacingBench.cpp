@@ -0,0 +1,260 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	PacingBench.cpp
+// Date:	October 19th, 2026
+// Purpose: Runs CFramePacer (FramePacer.h) against a simulated clock and
+//			display, so every mode can be checked on any machine in a
+//			moment.  Each mode plays each workload: light frames, heavy
+//			frames longer than a refresh, light frames with a heavy one
+//			now and then, and the menus.  Sleeps come back a little late
+//			as real ones do, VSync's Present blocks until the next
+//			refresh, and CPU time is the frames' work alone.  Prints the
+//			frame rate, the mean and spread of the frame time, how much
+//			of a core was used and the match ticks a second for each.
+//
+//			Checks that every mode runs exactly tickRate ticks a second,
+//			that Capped never goes over its cap, that Adaptive holds the
+//			refresh while frames fit and runs heavy ones as fast as they
+//			go rather than at half the refresh as VSync does, that the
+//			menus run at the idle rate, and that a long stall is skipped
+//			instead of ticked.  Exits with 1 if not.
+//
+//			Build (Linux):
+//				g++ -O2 -std=c++11 -I../Dx12Test PacingBench.cpp
+//					../Dx12Test/FramePacer.cpp -o pacingbench
+//
+//			Usage: pacingbench [-seconds N] [-refresh N] [-tickrate N] [-jitter ms]
+//				-seconds	simulated time for each run
+//				-jitter		most a sleep comes back late, default 1 ms
+//////////////////////////////////////////////////////////////////////////
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "FramePacer.h"
+
+// Seconds of a heavy frame, over a 60 Hz refresh
+#define HEAVY_WORK 0.020
+
+enum Workload
+{
+	WORK_LIGHT,							// 2 to 3 ms, well inside a refresh
+	WORK_HEAVY,							// HEAVY_WORK
+	WORK_SPIKES,						// Light, with a 25 ms frame once a second
+	WORK_MENU,							// Light, on a menu
+	WORK_COUNT
+};
+
+static const char* const s_WorkloadNames[WORK_COUNT] = { "Light", "Heavy", "Spikes", "Menu" };
+
+struct BenchSettings
+{
+	double				seconds;
+	double				refreshRate;
+	double				tickRate;
+	double				jitter;			// Seconds
+};
+
+struct RunResult
+{
+	double				fps;
+	double				mean;			// Seconds between frames
+	double				deviation;
+	double				p99;
+	double				cpu;			// Share of a core
+	double				ticksPerSecond;
+	double				fitted;			// Share of frames whose work fitted in a refresh
+	bool				ticksExact;		// Ticks run and skipped add up to the time
+};
+
+// Small repeatable random numbers, 0 to 1
+class CBenchRandom
+{
+	unsigned int		m_nSeed;
+
+public:
+	explicit CBenchRandom(unsigned int seed) : m_nSeed(seed)	{}
+
+	double Next()
+	{
+		m_nSeed = m_nSeed * 1664525u + 1013904223u;
+		return (m_nSeed >> 8) * (1.0 / 16777216.0);
+	}
+};
+
+static double GetWork(Workload workload, int frame, CBenchRandom& random)
+{
+	switch(workload)
+	{
+	case WORK_HEAVY:	return HEAVY_WORK;
+	case WORK_SPIKES:	return frame % 60 == 59 ? 0.025 : 0.002 + random.Next() * 0.001;
+	default:			return 0.002 + random.Next() * 0.001;
+	}
+}
+
+static void RunPacer(const BenchSettings& settings, const FramePacingDesc& desc, Workload workload, RunResult& result)
+{
+	CBenchRandom random(12345);
+	double now = 1000.0;
+	double cpu = 0.0;
+	double start = now;
+	double refresh = 1.0 / settings.refreshRate;
+	bool idle = workload == WORK_MENU;
+
+	static CFramePacer pacer;
+	pacer.Init(desc, now, cpu);
+	double lastBegin = now;
+	for(int frame = 0; now - start < settings.seconds; ++frame)
+	{
+		for(;;)
+		{
+			double wait = pacer.GetWait(now, idle);
+			if(wait <= 0.0)
+				break;
+			now += wait + random.Next() * settings.jitter;
+		}
+
+		lastBegin = now;
+		pacer.BeginFrame(now);
+		double work = GetWork(workload, frame, random);
+		now += work;
+		cpu += work;
+
+		// Present waits for the next refresh
+		if(desc.mode == PACING_VSYNC && desc.presentWaits)
+			now = ceil(now / refresh) * refresh;
+		pacer.EndFrame(now, cpu, true);
+	}
+
+	result.fps			= pacer.GetFrameRate();
+	result.mean			= pacer.GetIntervals().GetMean();
+	result.deviation	= pacer.GetIntervalDeviation();
+	result.p99			= pacer.GetIntervals().GetPercentile(99.0);
+	result.cpu			= pacer.GetCpuUsage();
+	result.ticksPerSecond	= pacer.GetTicksRun() / (now - start);
+	result.fitted		= (double)pacer.GetFittedCount() / pacer.GetFrameCount();
+
+	double due = (lastBegin - start) * desc.tickRate;
+	result.ticksExact	= fabs((double)(pacer.GetTicksRun() + pacer.GetTicksSkipped()) - due) <= 1.0;
+}
+
+// A frame that takes seconds, as the intro movie does, must not be
+// ticked through afterwards
+static bool RunStall(const FramePacingDesc& desc)
+{
+	CFramePacer pacer;
+	double now = 0.0;
+	pacer.Init(desc, now, 0.0);
+	pacer.BeginFrame(now);
+	now += 2.0;
+	pacer.EndFrame(now, 0.0, true);
+	now += pacer.GetWait(now, false);
+	int ticks = pacer.BeginFrame(now);
+	printf("A 2 s stall: %d ticks run after it, %lld skipped\n", ticks, pacer.GetTicksSkipped());
+	return ticks == desc.maxTicks && pacer.GetTicksSkipped() > 0;
+}
+
+static bool Near(double value, double expected, double tolerance)
+{
+	return fabs(value - expected) <= expected * tolerance;
+}
+
+int main(int argc, char** argv)
+{
+	BenchSettings settings;
+	settings.seconds		= 60.0;
+	settings.refreshRate	= 60.0;
+	settings.tickRate		= 4000.0;
+	settings.jitter			= 0.001;
+
+	for(int i = 1; i < argc; ++i)
+	{
+		if(!strcmp(argv[i], "-seconds") && i + 1 < argc)			settings.seconds = atof(argv[++i]);
+		else if(!strcmp(argv[i], "-refresh") && i + 1 < argc)		settings.refreshRate = atof(argv[++i]);
+		else if(!strcmp(argv[i], "-tickrate") && i + 1 < argc)		settings.tickRate = atof(argv[++i]);
+		else if(!strcmp(argv[i], "-jitter") && i + 1 < argc)		settings.jitter = atof(argv[++i]) * 1e-3;
+		else
+		{
+			printf("Usage: %s [-seconds N] [-refresh N] [-tickrate N] [-jitter ms]\n", argv[0]);
+			return 1;
+		}
+	}
+	if(settings.seconds < 1.0)
+		settings.seconds = 1.0;
+	if(settings.refreshRate < 1.0)
+		settings.refreshRate = 60.0;
+	if(settings.tickRate < 1.0)
+		settings.tickRate = 1.0;
+	if(settings.jitter < 0.0)
+		settings.jitter = 0.0;
+
+	FramePacingDesc desc;
+	desc.refreshRate	= settings.refreshRate;
+	desc.maxFps			= settings.refreshRate;
+	desc.idleFps		= 10.0;
+	desc.tickRate		= settings.tickRate;
+	desc.maxTicks		= (int)(settings.tickRate * 0.25);
+	desc.presentWaits	= true;
+
+	printf("%.0f s of each, %.0f Hz refresh, %.0f ticks a second, sleeps up to %.1f ms late\n", settings.seconds,
+		settings.refreshRate, settings.tickRate, settings.jitter * 1e3);
+	printf("%-9s %-7s %8s %9s %9s %9s %7s %9s %7s\n", "Mode", "Frames", "Frames", "Mean ms", "Dev ms", "p99 ms", "CPU",
+		"Ticks", "Fitted");
+	printf("%-9s %-7s %8s %9s %9s %9s %7s %9s %7s\n", "", "", "per s", "", "", "", "", "per s", "");
+
+	static const PacingMode s_Modes[] = { PACING_UNCAPPED, PACING_VSYNC, PACING_CAPPED, PACING_ADAPTIVE };
+	RunResult results[4][WORK_COUNT];
+	int result = 0;
+	for(int m = 0; m < 4; ++m)
+	{
+		desc.mode = s_Modes[m];
+		for(int w = 0; w < WORK_COUNT; ++w)
+		{
+			RunResult& run = results[m][w];
+			RunPacer(settings, desc, (Workload)w, run);
+			printf("%-9s %-7s %8.1f %9.2f %9.2f %9.2f %6.1f%% %9.1f %6.1f%%\n", GetPacingModeName(desc.mode),
+				s_WorkloadNames[w], run.fps, run.mean * 1e3, run.deviation * 1e3, run.p99 * 1e3, run.cpu * 100.0,
+				run.ticksPerSecond, run.fitted * 100.0);
+			if(!run.ticksExact)
+			{
+				printf("FAILED: %s %s did not run one tick per 1/%.0f s\n", GetPacingModeName(desc.mode),
+					s_WorkloadNames[w], settings.tickRate);
+				result = 1;
+			}
+		}
+	}
+
+	const RunResult* capped = results[2];
+	const RunResult* adaptive = results[3];
+	const RunResult* vsync = results[1];
+	double interval = 1.0 / settings.refreshRate;
+	for(int w = 0; w < WORK_COUNT; ++w)
+	{
+		if(capped[w].mean < interval * 0.999)
+		{
+			printf("FAILED: Capped %s ran faster than %.0f a second\n", s_WorkloadNames[w], settings.refreshRate);
+			result = 1;
+		}
+	}
+	if(!Near(adaptive[WORK_LIGHT].mean, interval, 0.005) || adaptive[WORK_LIGHT].fitted < 0.99)
+	{
+		printf("FAILED: Adaptive light frames did not hold the refresh\n");
+		result = 1;
+	}
+	if(!Near(adaptive[WORK_HEAVY].fps, 1.0 / HEAVY_WORK, 0.02)
+		|| adaptive[WORK_HEAVY].fps < vsync[WORK_HEAVY].fps * 1.5)
+	{
+		printf("FAILED: Adaptive heavy frames did not run as fast as they go\n");
+		result = 1;
+	}
+	if(!Near(adaptive[WORK_MENU].fps, desc.idleFps, 0.02))
+	{
+		printf("FAILED: the menus did not run at %.0f a second\n", desc.idleFps);
+		result = 1;
+	}
+	if(!RunStall(desc))
+	{
+		printf("FAILED: a stall was ticked through\n");
+		result = 1;
+	}
+	return result;
+}
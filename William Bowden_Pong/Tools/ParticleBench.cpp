@@ -0,0 +1,196 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	ParticleBench.cpp
+// Date:	October 19th, 2026
+// Purpose: Checks and times CParticleSystem.  First runs the same bursts
+//			through the SSE2 and plain C++ paths and exits with 1 unless
+//			every particle ends up bit for bit the same.  Then keeps the
+//			pool topped up to a target count with point bursts and times
+//			each part of a 60 fps frame: emitting, updating, building the
+//			batch and submitting it to the null renderer in one call.
+//			Exits with 1 if a frame costs more than the budget.
+//
+//			Build (Linux):
+//				g++ -O2 -std=c++11 -pthread -I../Dx12Test ParticleBench.cpp
+//					../Dx12Test/Particles.cpp ../Dx12Test/PongGame.cpp
+//					../Dx12Test/ImageFile.cpp ../Dx12Test/FrameCapture.cpp
+//					-o particlebench
+//
+//			Usage: particlebench [-particles N] [-frames N] [-budget ms]
+//////////////////////////////////////////////////////////////////////////
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Particles.h"
+#include "NullRenderer.h"
+#include "PongPlatform.h"
+
+#define FRAME_TIME (1.0f / 60.0f)
+
+static unsigned int g_Seed = 99;
+
+static float RandomFloat()
+{
+	g_Seed = g_Seed * 1664525u + 1013904223u;
+	return (float)(g_Seed >> 8) / (float)(1 << 24);
+}
+
+// Bursts of every effect at random places until the pool holds target
+static void TopUp(CParticleSystem& particles, int target)
+{
+	while(particles.GetCount() < target)
+	{
+		ParticleEffect effect = (ParticleEffect)(g_Seed % PARTICLE_EFFECTS);
+		float x = RandomFloat() * PLAYFIELD_WIDTH;
+		float y = RandomFloat() * PLAYFIELD_HEIGHT;
+		if(particles.Emit(effect, x, y, RandomFloat() - 0.5f, RandomFloat() - 0.5f) == 0)
+			break;
+	}
+}
+
+static bool CheckExact(int frames)
+{
+	CParticleSystem vector, scalar;
+	vector.Init(8192);
+	scalar.Init(8192);
+	scalar.SetScalar(true);
+
+	Viewport view = MakeViewport(1280, 720, PLAYFIELD_WIDTH, PLAYFIELD_HEIGHT);
+	int differ = 0;
+	int most = 0;
+	for(int frame = 0; frame < frames && differ == 0; ++frame)
+	{
+		unsigned int seed = g_Seed;
+		TopUp(vector, 6000);
+		g_Seed = seed;
+		TopUp(scalar, 6000);
+
+		// Uneven frame times, so lives end in the middle of a group of four
+		float dt = FRAME_TIME * (0.5f + RandomFloat());
+		vector.Update(dt);
+		scalar.Update(dt);
+
+		SpriteBatch a, b;
+		vector.GetBatch(view, a);
+		scalar.GetBatch(view, b);
+		if(a.count != b.count)
+		{
+			differ = 1;
+			break;
+		}
+		if(a.count > most)
+			most = a.count;
+		size_t floats = a.count * sizeof(float);
+		differ += memcmp(a.x, b.x, floats) != 0;
+		differ += memcmp(a.y, b.y, floats) != 0;
+		differ += memcmp(a.scale, b.scale, floats) != 0;
+		differ += memcmp(a.color, b.color, floats) != 0;
+		differ += memcmp(vector.GetLife(), scalar.GetLife(), floats) != 0;
+	}
+
+	printf("Exactness: %d frames, up to %d particles, SSE2 %s, %s\n", frames, most,
+		vector.IsVectorised() ? "on" : "not available", differ == 0 ? "same" : "DIFFER");
+	return differ == 0;
+}
+
+struct FrameTimes
+{
+	double				emit;
+	double				update;
+	double				batch;
+	double				draw;
+	long long			particles;
+};
+
+static FrameTimes RunFrames(int target, int frames, bool scalar, CNullRenderer& renderer)
+{
+	static CParticleSystem particles;
+	particles.Init(target + target / 8);
+	particles.SetScalar(scalar);
+
+	SpriteTexture texture = { 0, 20, 23 };
+	Viewport view = MakeViewport(1920, 1080, PLAYFIELD_WIDTH, PLAYFIELD_HEIGHT);
+	FrameTimes times;
+	memset(&times, 0, sizeof(times));
+
+	// A second of frames to reach the steady state first
+	for(int frame = -60; frame < frames; ++frame)
+	{
+		double t0 = PlatformGetTime();
+		TopUp(particles, target);
+		double t1 = PlatformGetTime();
+		particles.Update(FRAME_TIME);
+		double t2 = PlatformGetTime();
+
+		SpriteBatch batch;
+		particles.GetBatch(view, batch);
+		double t3 = PlatformGetTime();
+		renderer.BeginFrame(0);
+		renderer.DrawSprites(texture, batch);
+		renderer.EndFrame();
+		double t4 = PlatformGetTime();
+
+		if(frame >= 0)
+		{
+			times.emit		+= t1 - t0;
+			times.update	+= t2 - t1;
+			times.batch		+= t3 - t2;
+			times.draw		+= t4 - t3;
+			times.particles	+= batch.count;
+		}
+	}
+	return times;
+}
+
+int main(int argc, char** argv)
+{
+	int target = 100000;
+	int frames = 600;
+	double budget = 4.0;
+
+	for(int i = 1; i < argc; ++i)
+	{
+		if(!strcmp(argv[i], "-particles") && i + 1 < argc)		target = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-frames") && i + 1 < argc)	frames = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-budget") && i + 1 < argc)	budget = atof(argv[++i]);
+		else
+		{
+			printf("Usage: %s [-particles N] [-frames N] [-budget ms]\n", argv[0]);
+			return 1;
+		}
+	}
+	if(target < 1)
+		target = 1;
+	if(frames < 1)
+		frames = 1;
+
+	bool same = CheckExact(300);
+
+	printf("%d particles, %d frames at 60 fps, ms per frame:\n", target, frames);
+	printf("            emit  update   batch  submit   total   ns/particle\n");
+	double vectorTotal = 0.0;
+	for(int pass = 0; pass < 2; ++pass)
+	{
+		CNullRenderer renderer;
+		FrameTimes t = RunFrames(target, frames, pass == 1, renderer);
+		double total = t.emit + t.update + t.batch + t.draw;
+		printf("%-8s %7.3f %7.3f %7.3f %7.3f %7.3f   %6.2f   (%d sprites in %d calls)\n", pass == 0 ? "SSE2" : "scalar",
+			t.emit * 1e3 / frames, t.update * 1e3 / frames, t.batch * 1e3 / frames, t.draw * 1e3 / frames,
+			total * 1e3 / frames, (t.update + t.batch) * 1e9 / (t.particles > 0 ? t.particles : 1),
+			renderer.GetSpriteCount(), renderer.GetBatchCount());
+		if(pass == 0)
+			vectorTotal = total * 1e3 / frames;
+	}
+
+	int failed = 0;
+	if(!same)
+	{
+		printf("FAILED: SSE2 and plain C++ particles differ\n");
+		failed = 1;
+	}
+	if(vectorTotal > budget)
+	{
+		printf("FAILED: %.3f ms a frame is over the budget of %.3f ms\n", vectorTotal, budget);
+		failed = 1;
+	}
+	return failed;
+}
@@ -0,0 +1,201 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	PhysicsBench.cpp
+// Date:	October 19th, 2026
+// Purpose: Checks that fixed point physics (PongPhysics.h) plays a
+//			match to the same bits however the bench is built, and times
+//			it against floats.  Plays the same match on scripted keys in
+//			each mode, hashing the state after every tick into one
+//			value.  The fixed point hash must equal PHYSICS_GOLDEN_HASH,
+//			what every build has produced so far, and exits with 1 if it
+//			does not; the float hash is printed for comparing builds by
+//			hand.  Build it more than one way, e.g. with each line below,
+//			and run each.  Then times the rules alone and whole ticks,
+//			in ticks per second for each mode.
+//
+//			Build (Linux):
+//				g++ -O2 -std=c++11 -I../Dx12Test PhysicsBench.cpp
+//					../Dx12Test/PongGame.cpp -o physicsbench
+//			and the same with -O0, -O3 -ffast-math -march=native,
+//			-m32 -mfpmath=387, or clang++ in place of g++.
+//
+//			Usage: physicsbench [-ticks N] [-seed N] [-expect hash] [-loops N]
+//				-ticks, -seed	the match to play, the golden hash is for
+//						the defaults
+//				-expect		fixed point hash to check for instead
+//				-loops		ticks to time in each mode
+//////////////////////////////////////////////////////////////////////////
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "PongPhysics.h"
+#include "PongPlatform.h"
+
+#define DEFAULT_TICKS 1000000
+#define DEFAULT_SEED 12345
+
+// Fixed point hash of the match at DEFAULT_TICKS and DEFAULT_SEED
+#define PHYSICS_GOLDEN_HASH 0x4e0fda13u
+
+// The keys for a tick: both paddles' keys change every few ticks, held
+// in between the way players hold them
+class CKeyScript
+{
+	unsigned int		m_nSeed;
+	int					m_nKeys;
+	int					m_nHeld;
+
+public:
+	explicit CKeyScript(unsigned int seed) : m_nSeed(seed), m_nKeys(0), m_nHeld(0)	{}
+
+	int Next()
+	{
+		if(m_nHeld-- <= 0)
+		{
+			m_nSeed = m_nSeed * 1664525u + 1013904223u;
+			m_nKeys = (m_nSeed >> 16) & (W_UP | S_DOWN | ARROW_UP | ARROW_DOWN);
+			m_nHeld = (m_nSeed >> 8) & 255;
+		}
+		return m_nKeys;
+	}
+};
+
+struct MatchResult
+{
+	unsigned int		hash;
+	int					points[2];
+	int					events;
+	float				ballX, ballY;
+};
+
+static void StartMatch(CPongGame& game, bool fixedPoint)
+{
+	PongTuning tuning;
+	tuning.fixedPoint = fixedPoint;
+	game.SetTuning(tuning);
+	game.Init();
+	game.Menu.onSTART = false;
+	game.FinishMovie();
+}
+
+static void PlayMatch(bool fixedPoint, int ticks, unsigned int seed, MatchResult& result)
+{
+	static CPongGame game;
+	StartMatch(game, fixedPoint);
+	CKeyScript keys(seed);
+	CGameEventBuffer events;
+
+	result.hash = 2166136261u;
+	result.events = 0;
+	for(int i = 0; i < ticks; ++i)
+	{
+		events.Clear();
+		game.Tick(keys.Next(), 0, &events);
+		result.hash = (result.hash ^ GetStateChecksum(game)) * 16777619u;
+		result.events += events.GetCount();
+	}
+	result.points[0]	= game.Player1Point;
+	result.points[1]	= game.Player2Point;
+	result.ballX		= game.Ball.xp;
+	result.ballY		= game.Ball.yp;
+}
+
+// The rules alone, two paddle and two ball steps a tick as CPongGame
+template<class TMatch, class T>
+static double TimeRules(TMatch& match, T paddleSpeed, T speedX, T speedY, int loops, int& sounds)
+{
+	CKeyScript keys(DEFAULT_SEED);
+	double start = PlatformGetTime();
+	for(int i = 0; i < loops; ++i)
+	{
+		int controlActive = keys.Next();
+		for(int p = 0; p < 2; ++p)
+		{
+			StepPaddle(match, p, controlActive, paddleSpeed);
+			sounds |= StepBall(match, speedX, speedY, (CGameEventBuffer*)0);
+		}
+	}
+	return PlatformGetTime() - start;
+}
+
+static double TimeTicks(bool fixedPoint, int loops, int& sounds)
+{
+	static CPongGame game;
+	StartMatch(game, fixedPoint);
+	CKeyScript keys(DEFAULT_SEED);
+	double start = PlatformGetTime();
+	for(int i = 0; i < loops; ++i)
+		sounds |= game.Tick(keys.Next(), 0);
+	return PlatformGetTime() - start;
+}
+
+int main(int argc, char** argv)
+{
+	int ticks = DEFAULT_TICKS;
+	unsigned int seed = DEFAULT_SEED;
+	unsigned int expect = PHYSICS_GOLDEN_HASH;
+	bool expectGiven = false;
+	int loops = 20000000;
+
+	for(int i = 1; i < argc; ++i)
+	{
+		if(!strcmp(argv[i], "-ticks") && i + 1 < argc)			ticks = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-seed") && i + 1 < argc)		seed = (unsigned int)strtoul(argv[++i], 0, 10);
+		else if(!strcmp(argv[i], "-expect") && i + 1 < argc)
+		{
+			expect = (unsigned int)strtoul(argv[++i], 0, 16);
+			expectGiven = true;
+		}
+		else if(!strcmp(argv[i], "-loops") && i + 1 < argc)		loops = atoi(argv[++i]);
+		else
+		{
+			printf("Usage: %s [-ticks N] [-seed N] [-expect hash] [-loops N]\n", argv[0]);
+			return 1;
+		}
+	}
+	if(ticks < 1)
+		ticks = 1;
+	if(loops < 1)
+		loops = 1;
+	bool check = expectGiven || (ticks == DEFAULT_TICKS && seed == DEFAULT_SEED);
+
+	int result = 0;
+	MatchResult floats, fixed;
+	PlayMatch(false, ticks, seed, floats);
+	PlayMatch(true, ticks, seed, fixed);
+
+	printf("%d ticks, seed %u\n", ticks, seed);
+	printf("%-8s %10s %8s %8s %8s %10s %10s\n", "Mode", "Hash", "Left", "Right", "Events", "Ball x", "Ball y");
+	printf("%-8s   %08x %8d %8d %8d %10.4f %10.4f\n", "Float", floats.hash, floats.points[0], floats.points[1],
+		floats.events, floats.ballX, floats.ballY);
+	printf("%-8s   %08x %8d %8d %8d %10.4f %10.4f\n", "Fixed", fixed.hash, fixed.points[0], fixed.points[1],
+		fixed.events, fixed.ballX, fixed.ballY);
+	if(check)
+	{
+		printf("Fixed point hash %08x, expected %08x: %s\n", fixed.hash, expect, fixed.hash == expect ? "same" : "DIFFER");
+		if(fixed.hash != expect)
+			result = 1;
+	}
+
+	// Throughput.  The sounds are printed so the loops are not optimised away.
+	int sounds = 0;
+	PongState floatMatch;
+	static CPongGame start;
+	StartMatch(start, false);
+	start.SaveState(floatMatch);
+	double floatRules = TimeRules(floatMatch, PADDLE_SPEED, BALL_SPEED_X, BALL_SPEED_Y, loops, sounds);
+
+	StartMatch(start, true);
+	PongFixedMatch fixedMatch = start.Fixed;
+	double fixedRules = TimeRules(fixedMatch, CFixed::FromFloat(PADDLE_SPEED), CFixed::FromFloat(BALL_SPEED_X),
+		CFixed::FromFloat(BALL_SPEED_Y), loops, sounds);
+
+	double floatTicks = TimeTicks(false, loops, sounds);
+	double fixedTicks = TimeTicks(true, loops, sounds);
+
+	printf("\n%d ticks each, sounds %x\n", loops, sounds);
+	printf("%-8s %14s %14s\n", "Mode", "Rules M/s", "Ticks M/s");
+	printf("%-8s %14.1f %14.1f\n", "Float", loops / floatRules * 1e-6, loops / floatTicks * 1e-6);
+	printf("%-8s %14.1f %14.1f\n", "Fixed", loops / fixedRules * 1e-6, loops / fixedTicks * 1e-6);
+	printf("Fixed against float: rules %.2fx, ticks %.2fx\n", floatRules / fixedRules, floatTicks / fixedTicks);
+	return result;
+}
@@ -0,0 +1,356 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	PongHeadless.cpp
+// Date:	October 19th, 2026
+// Purpose: Runs the game without a window, with both paddles played by
+//			the AI (PaddleAI.h).  With the null renderer it
+//			measures the simulation alone, with the software renderer it
+//			also rasterises every frame and can save them as PNG for
+//			golden image comparisons.
+//
+//			Run from the Dx12Test directory so the sprites are found.
+//			Build (Linux):
+//				g++ -O2 -std=c++11 -pthread -I../Dx12Test PongHeadless.cpp
+//					../Dx12Test/PongGame.cpp ../Dx12Test/ImageFile.cpp
+//					../Dx12Test/SceneTracker.cpp ../Dx12Test/ConfigFile.cpp
+//					../Dx12Test/PaddleAI.cpp ../Dx12Test/Particles.cpp
+//					../Dx12Test/StartupTrace.cpp ../Dx12Test/FrameCapture.cpp
+//					../Dx12Test/FramePacer.cpp ../Dx12Test/Arena.cpp
+//					../Dx12Test/Metrics.cpp -o pong_headless
+//			Add -DPONG_RENDERER_SOFTWARE, ../Dx12Test/SoftwareRenderer.cpp,
+//			../Dx12Test/ThreadPool.cpp and ../Dx12Test/FrameArena.cpp
+//			for the software rasteriser.
+//
+//			Usage: pong_headless [-frames N] [-threads N] [-capture K] [-out prefix]
+//					[-width W] [-height H] [-ai easy|normal|hard]
+//					[-trace file] [-startup] [-record png|raw] [-encoders N]
+//					[-buffers N] [-pacing mode] [-fps N] [-arena file]
+//					[-metrics name]
+//				-capture K	save every K'th frame (software renderer only)
+//				-width, -height	frame size, default from Pong.ini
+//				-ai		difficulty of both paddles, default hard
+//				-trace file	write the startup phases as a Chrome trace
+//				-startup	quit after the first frame is drawn, for
+//						Tools/StartupBench.cpp
+//				-record		record every frame drawn through a
+//						CFrameCapture (FrameCapture.h), as
+//						<prefix>_<frame>.png or <prefix>.raw.  The
+//						null renderer records blank frames.  Frames
+//						the encoders cannot keep up with are dropped.
+//				-encoders, -buffers	encoder threads and frames queued
+//				-pacing		uncapped, vsync, capped or adaptive, pace
+//						frames and tick the match as the game does
+//						(FramePacer.h) with the rest of the settings
+//						from Pong.ini, and report the frame times and
+//						CPU used.  Without it every frame runs one
+//						tick at once, so runs repeat exactly.
+//				-fps		refresh rate and cap for -pacing
+//				-arena		obstacles to play among (Arena.h), default
+//						[Game] Arena in Pong.ini
+//				-metrics	publish the game's counters (PongMetrics.h)
+//						to shared memory under this name while
+//						running, every [Metrics] Interval in
+//						Pong.ini, for Tools/MetricsReader.cpp.  With
+//						-pacing the run goes at the game's speed.
+//////////////////////////////////////////////////////////////////////////
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "PongScene.h"
+#include "PongPlatform.h"
+#include "SceneTracker.h"
+#include "VideoConfig.h"
+#include "PaddleAI.h"
+#include "FrameCapture.h"
+#include "PacingConfig.h"
+#include "MetricsConfig.h"
+#include "PongMetrics.h"
+#include <string>
+
+int main(int argc, char** argv)
+{
+	int frames = 10000;
+	int threads = 0;
+	int capture = 0;
+	const char* prefix = "frame";
+	AIDifficulty difficulty = AI_HARD;
+	const char* traceFile = 0;
+	bool startupOnly = false;
+	const char* record = 0;
+	FrameCaptureDesc captureDesc;
+	const char* pacingMode = 0;
+	double fps = 0.0;
+	const char* arenaFile = 0;
+	const char* metricsName = 0;
+
+	// Phases up to the first frame, the same ones the game records
+	CStartupTrace startup;
+	startup.Begin();
+
+	// Same frame size as the game unless the command line says otherwise
+	RendererDesc desc;
+	CTraceSpan configSpan(&startup, "Config");
+	CConfigFile config;
+	configSpan.Check(config.Load(PONG_CONFIG_FILE));
+	ReadVideoConfig(config, desc);
+	configSpan.End();
+
+	for(int i = 1; i < argc; ++i)
+	{
+		if(!strcmp(argv[i], "-frames") && i + 1 < argc)			frames = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-threads") && i + 1 < argc)	threads = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-capture") && i + 1 < argc)	capture = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-out") && i + 1 < argc)		prefix = argv[++i];
+		else if(!strcmp(argv[i], "-width") && i + 1 < argc)		desc.width = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-height") && i + 1 < argc)	desc.height = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-ai") && i + 1 < argc)		difficulty = ParseAIDifficulty(argv[++i], AI_HARD);
+		else if(!strcmp(argv[i], "-trace") && i + 1 < argc)		traceFile = argv[++i];
+		else if(!strcmp(argv[i], "-startup"))					startupOnly = true;
+		else if(!strcmp(argv[i], "-record") && i + 1 < argc)	record = argv[++i];
+		else if(!strcmp(argv[i], "-encoders") && i + 1 < argc)	captureDesc.threads = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-buffers") && i + 1 < argc)	captureDesc.buffers = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-pacing") && i + 1 < argc)	pacingMode = argv[++i];
+		else if(!strcmp(argv[i], "-fps") && i + 1 < argc)		fps = atof(argv[++i]);
+		else if(!strcmp(argv[i], "-arena") && i + 1 < argc)		arenaFile = argv[++i];
+		else if(!strcmp(argv[i], "-metrics") && i + 1 < argc)	metricsName = argv[++i];
+		else
+		{
+			printf("Usage: %s [-frames N] [-threads N] [-capture K] [-out prefix] [-width W] [-height H] [-ai easy|normal|hard]"
+				" [-trace file] [-startup] [-record png|raw] [-encoders N] [-buffers N] [-pacing mode] [-fps N]"
+				" [-arena file] [-metrics name]\n",
+				argv[0]);
+			return 1;
+		}
+	}
+
+#ifndef PONG_RENDERER_SOFTWARE
+	if(capture > 0)
+		printf("Frames can only be captured with the software renderer\n");
+	(void)prefix;
+#endif
+
+	Viewport view = MakeViewport(desc.width, desc.height, PLAYFIELD_WIDTH, PLAYFIELD_HEIGHT);
+	desc.textScale	= view.scale;
+	desc.threads	= threads;
+
+	CTraceSpan rendererSpan(&startup, "Renderer");
+	CRenderer renderer;
+	if(!rendererSpan.Check(renderer.Init(desc)))
+	{
+		printf("Renderer failed to initialise\n");
+		return 1;
+	}
+	rendererSpan.End();
+
+	CFrameCapture recorder;
+	std::string recordPath = prefix;
+	if(record)
+	{
+		captureDesc.width	= desc.width;
+		captureDesc.height	= desc.height;
+		captureDesc.format	= !strcmp(record, "raw") ? CAPTURE_RAW : CAPTURE_PNG;
+		if(captureDesc.format == CAPTURE_RAW)
+			recordPath += ".raw";
+		captureDesc.path	= recordPath.c_str();
+		if(!recorder.Init(captureDesc) || !renderer.SetCapture(&recorder))
+		{
+			printf("Could not record to %s\n", recordPath.c_str());
+			return 1;
+		}
+	}
+
+	CTraceSpan textureSpan(&startup, "Textures");
+	PongTextures textures;
+	if(!textureSpan.Check(LoadPongTextures(renderer, textures, &startup)))
+		printf("Warning: some textures failed to load, run from the Dx12Test directory\n");
+	textureSpan.End();
+
+	CTraceSpan gameSpan(&startup, "Game");
+	CPongGame game;
+	int controlPrevious = 0;
+
+	CArena arena;
+	if(!arenaFile)
+		arenaFile = config.GetString("Game", "Arena", "");
+	if(*arenaFile)
+	{
+		if(!gameSpan.Check(arena.Load(arenaFile)))
+		{
+			printf("Could not read %s\n", arenaFile);
+			return 1;
+		}
+		printf("Arena %s, %d obstacles, %d lines skipped\n", arena.GetName(), arena.GetObstacleCount(),
+			arena.GetSkippedCount());
+		game.SetArena(&arena);
+	}
+
+	CPaddleAI ai[2];
+	for(int i = 0; i < 2; ++i)
+		ai[i].Init(i, GetAISettings(difficulty), 1 + i);
+
+	// Only frames that look different are drawn, as in the game
+	CSceneTracker tracker;
+	long long tilesDrawn = 0;
+	gameSpan.End();
+
+	// Paced as the game is, with no display to wait for
+	CFramePacer pacer;
+	if(pacingMode)
+	{
+		FramePacingDesc pacing;
+		ReadPacingConfig(config, pacing);
+		pacing.mode = ParsePacingMode(pacingMode, PACING_UNCAPPED);
+		if(fps > 0.0)
+		{
+			pacing.refreshRate	= fps;
+			pacing.maxFps		= fps;
+		}
+		pacer.Init(pacing, PlatformGetTime(), PlatformGetCpuTime());
+	}
+	long long ticksRun = 0;
+
+	// The same counters the game publishes
+	CMetricsRegistry metrics;
+	CMetricsPublisher publisher;
+	CMetricsWriter metricsWriter;
+	PongMetricIds metricIds;
+	CGameEventBuffer events;
+	int captureDropped = 0;
+	if(metricsName)
+	{
+		MetricsDesc metricsDesc;
+		ReadMetricsConfig(config, metricsDesc);
+		metricsDesc.name = metricsName;
+		RegisterPongMetrics(metrics, metricIds);
+		metricsWriter = metrics.GetWriter();
+		if(!publisher.Start(metrics, metricsDesc))
+		{
+			printf("Could not publish metrics as %s\n", metricsName);
+			return 1;
+		}
+	}
+
+	// Until the first frame is drawn
+	int firstFrame = startup.Open("First frame");
+
+	double start = PlatformGetTime();
+	for(int frame = 0; frame < frames; ++frame)
+	{
+		int ticks = 1;
+		if(pacingMode)
+		{
+			for(;;)
+			{
+				double wait = pacer.GetWait(PlatformGetTime(), CSceneTracker::IsStatic(game));
+				if(wait <= 0.0)
+					break;
+				PlatformSleep(wait);
+			}
+			ticks = pacer.BeginFrame(PlatformGetTime());
+		}
+		double frameStart = PlatformGetTime();
+		events.Clear();
+
+		for(int tick = 0; tick < ticks; ++tick)
+		{
+			// Press ENTER on the first tick to leave the start menu
+			int controlCurrent = ticksRun++ == 0 ? ENTER_KEY : 0;
+			if(game.Menu.onGAME)
+			{
+				controlCurrent |= ai[0].Think(game);
+				controlCurrent |= ai[1].Think(game);
+			}
+			int controlDown = (controlCurrent ^ controlPrevious) & controlCurrent;
+			controlPrevious = controlCurrent;
+
+			game.Tick(controlCurrent, controlDown, metricsName ? &events : 0);
+			if(game.Menu.onMovie)
+				game.FinishMovie();
+		}
+
+		bool drawn = tracker.NeedsRedraw(game);
+		if(drawn)
+		{
+			DrawPongScene(renderer, game, textures, view);
+#ifdef PONG_RENDERER_SOFTWARE
+			tilesDrawn += renderer.GetTilesDrawn();
+#endif
+			if(firstFrame >= 0)
+			{
+				startup.Close(firstFrame);
+				firstFrame = -1;
+				if(traceFile && !startup.WriteChromeTrace(traceFile))
+					printf("Could not write %s\n", traceFile);
+				if(startupOnly)
+				{
+					printf("First frame %.1f ms after the process started\n", startup.GetTime() * 1e3);
+					renderer.Shutdown();
+					return 0;
+				}
+			}
+		}
+
+#ifdef PONG_RENDERER_SOFTWARE
+		if(capture > 0 && frame % capture == 0)
+		{
+			char fileName[512];
+			sprintf(fileName, "%s_%06d.png", prefix, frame);
+			if(!renderer.SaveFrame(fileName))
+				printf("Could not write %s\n", fileName);
+		}
+#endif
+		if(pacingMode)
+			pacer.EndFrame(PlatformGetTime(), PlatformGetCpuTime(), drawn);
+
+		if(metricsName)
+		{
+			metricsWriter.Record(metricIds.frameWork, PlatformGetTime() - frameStart);
+			metricsWriter.Add(metricIds.frames);
+			metricsWriter.Add(metricIds.ticks, ticks);
+			if(drawn)
+				metricsWriter.Add(metricIds.presented);
+			CountPongEvents(metricsWriter, metricIds, events);
+			metricsWriter.Add(metricIds.droppedCapture, recorder.GetDroppedCount() - captureDropped);
+			captureDropped = recorder.GetDroppedCount();
+		}
+	}
+	double elapsed = PlatformGetTime() - start;
+
+	if(metricsName)
+	{
+		publisher.Publish();
+		printf("Metrics published %llu times as %s\n", publisher.GetPublishCount(), metricsName);
+		publisher.Shutdown();
+	}
+
+	if(record)
+	{
+		renderer.SetCapture(0);
+		double drawn = PlatformGetTime();
+		recorder.Shutdown();
+		std::string report;
+		recorder.Format(report);
+		printf("%s%.3f s to write the frames still queued\n", report.c_str(), PlatformGetTime() - drawn);
+	}
+
+	printf("%d frames in %.3f s, %.1f frames/s\n", frames, elapsed, frames / (elapsed > 0.0 ? elapsed : 1e-9));
+	printf("Score %d - %d\n", game.Player1Point, game.Player2Point);
+	printf("%d frames drawn, %d unchanged frames skipped\n", tracker.GetDrawnCount(), tracker.GetSkippedCount());
+	if(pacingMode)
+	{
+		std::string report;
+		pacer.Format(report);
+		printf("%s", report.c_str());
+	}
+#ifdef PONG_RENDERER_SOFTWARE
+	if(tracker.GetDrawnCount() > 0)
+	{
+		printf("%.1f%% of tiles redrawn per drawn frame\n",
+			100.0 * tilesDrawn / ((double)tracker.GetDrawnCount() * renderer.GetTileCount()));
+	}
+#else
+	(void)tilesDrawn;
+#endif
+
+	renderer.Shutdown();
+	return 0;
+}
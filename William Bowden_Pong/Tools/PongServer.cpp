@@ -0,0 +1,580 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	PongServer.cpp
+// Date:	October 19th, 2026
+// Purpose: Headless server that hosts many matches at once, each a
+//			CMatchRoom.  There is one event loop per core, each on its own
+//			thread pinned to that core with its own UDP port and epoll
+//			set.  Room r lives on loop r % loops and players send to
+//			port + r % loops, so a room's packets, state and ticks all
+//			stay on one core and loops share nothing.
+//
+//			A loop sleeps in epoll until a packet arrives or the timer
+//			for the earliest due tick fires.  Due ticks are kept in a
+//			heap, so a wake only touches the rooms a packet is for or
+//			whose tick is due, never every room.  Packets are read and
+//			sent in batches with recvmmsg / sendmmsg.
+//
+//			A room steps -hz times a second and sends its state after
+//			each step, but runs the match at the game's own tick rate,
+//			[Video] TickRate in Pong.ini, so the ball crosses the court
+//			as fast as it does on a client.  The speeds are [Tuning]'s.
+//			Joins from clients at another tick rate are rejected, see
+//			MatchRoom.h.
+//
+//			Runs until Ctrl+C or -seconds, then prints how late steps
+//			ran against when they were due and what a step cost.
+//			Linux only, see LoadGen.cpp for the client.  Run from the
+//			Dx12Test directory so Pong.ini is found.
+//
+//			Build (Linux):
+//				g++ -O2 -std=c++11 -pthread -I../Dx12Test PongServer.cpp
+//					../Dx12Test/MatchRoom.cpp ../Dx12Test/PaddleController.cpp
+//					../Dx12Test/PaddleAI.cpp ../Dx12Test/PongGame.cpp
+//					../Dx12Test/ConfigFile.cpp -o pong_server
+//
+//			Usage: pong_server [-port N] [-loops N] [-rooms N] [-hz N]
+//					[-seconds N] [-nopin] [-tickrate N]
+//				-hz		steps and states a second for each room
+//				-tickrate	match ticks a second, default [Video]
+//						TickRate in Pong.ini
+//				-loops		event loops, default one per core
+//				-rooms		most rooms, room numbers run from 0 to this
+//				-nopin		leave the threads to the scheduler
+//////////////////////////////////////////////////////////////////////////
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <vector>
+#include <queue>
+#include <functional>
+#include <thread>
+#include <pthread.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <netinet/in.h>
+#include "MatchRoom.h"
+#include "TuningConfig.h"
+#include "LatencyHistogram.h"
+#include "PongPlatform.h"
+
+// Packets read or sent per system call
+#define SERVER_BATCH 64
+
+// Ticks a room may fall behind before it skips ahead instead
+#define SERVER_MAX_BEHIND 4
+
+static volatile sig_atomic_t g_Stop = 0;
+
+static void OnSignal(int)
+{
+	g_Stop = 1;
+}
+
+struct ServerRoom
+{
+	CMatchRoom			room;
+	sockaddr_in			players[2];
+	double				nextTick;		// When the next tick is due
+	bool				active;			// Someone has joined since it was empty
+	bool				scheduled;		// Has an entry in the due heap
+};
+
+struct DueTick
+{
+	double				time;
+	int					slot;
+
+	bool operator>(const DueTick& other) const	{ return time > other.time; }
+};
+
+struct LoopStats
+{
+	long long			packetsIn;
+	long long			packetsOut;
+	long long			badPackets;		// Not for a room on this loop
+	long long			rejected;		// Joins at another tick rate
+	long long			ticks;			// Room steps
+	long long			wakes;
+	int					matches;		// Rooms that started playing
+	int					mostRooms;		// Most playing at once
+	CLatencyHistogram	lateness;		// Tick run time - due time
+	CLatencyHistogram	tickCost;		// Stepping one room and queuing its states
+
+	LoopStats(void) : packetsIn(0), packetsOut(0), badPackets(0), rejected(0), ticks(0), wakes(0),
+		matches(0), mostRooms(0)	{}
+};
+
+class CServerLoop
+{
+	int					m_nIndex;
+	int					m_nLoops;
+	int					m_Socket;
+	int					m_Epoll;
+	int					m_Timer;
+	double				m_fPeriod;
+	int					m_nPlaying;
+
+	std::vector<ServerRoom>	m_Rooms;	// Room id is slot * loops + index
+	std::priority_queue<DueTick, std::vector<DueTick>, std::greater<DueTick> >	m_Due;
+
+	// States waiting to be sent
+	mmsghdr				m_Out[SERVER_BATCH];
+	iovec				m_OutVec[SERVER_BATCH];
+	unsigned char		m_OutData[SERVER_BATCH][ROOM_MAX_PACKET];
+	sockaddr_in			m_OutTo[SERVER_BATCH];	// For rejects, states go to the players
+	int					m_nOut;
+
+	LoopStats			m_Stats;
+
+	CServerLoop(const CServerLoop&);
+	CServerLoop& operator=(const CServerLoop&);
+
+	void Receive(double now);
+	void Handle(const RoomPacket& packet, const sockaddr_in& from, double now);
+	void Schedule(int slot, double time);
+	void StepDue(double now);
+	void Sweep(double now);
+	void QueueState(const ServerRoom& room, int paddle);
+	void QueueReject(const ServerRoom& room, const RoomPacket& join, const sockaddr_in& to);
+	void Flush();
+	void SetTimer();
+
+public:
+	CServerLoop(void) : m_Socket(-1), m_Epoll(-1), m_Timer(-1)	{}
+	~CServerLoop(void);
+
+	bool Open(int index, int loops, int port, int rooms, double hz, const PongTuning& tuning, double tickRate);
+	void Run();
+	const LoopStats& GetStats() const	{ return m_Stats; }
+};
+
+CServerLoop::~CServerLoop(void)
+{
+	if(m_Socket >= 0)
+		close(m_Socket);
+	if(m_Epoll >= 0)
+		close(m_Epoll);
+	if(m_Timer >= 0)
+		close(m_Timer);
+}
+
+bool CServerLoop::Open(int index, int loops, int port, int rooms, double hz, const PongTuning& tuning, double tickRate)
+{
+	m_nIndex	= index;
+	m_nLoops	= loops;
+	m_fPeriod	= 1.0 / hz;
+	m_nPlaying	= 0;
+	m_nOut		= 0;
+	m_Stats		= LoopStats();
+
+	m_Rooms.resize((rooms - index + loops - 1) / loops);
+	for(size_t i = 0; i < m_Rooms.size(); ++i)
+	{
+		m_Rooms[i].active = false;
+		m_Rooms[i].scheduled = false;
+		m_Rooms[i].room.Configure(tuning, tickRate, hz);
+	}
+
+	m_Socket = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK, IPPROTO_UDP);
+	if(m_Socket < 0)
+		return false;
+
+	// Room for a burst of inputs while the loop is busy ticking
+	int buffer = 4 << 20;
+	setsockopt(m_Socket, SOL_SOCKET, SO_RCVBUF, &buffer, sizeof(buffer));
+	setsockopt(m_Socket, SOL_SOCKET, SO_SNDBUF, &buffer, sizeof(buffer));
+
+	sockaddr_in local;
+	memset(&local, 0, sizeof(local));
+	local.sin_family		= AF_INET;
+	local.sin_addr.s_addr	= htonl(INADDR_ANY);
+	local.sin_port			= htons((unsigned short)(port + index));
+	if(bind(m_Socket, (sockaddr*)&local, sizeof(local)) != 0)
+		return false;
+
+	m_Timer = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK);
+	m_Epoll = epoll_create1(0);
+	if(m_Timer < 0 || m_Epoll < 0)
+		return false;
+
+	epoll_event event;
+	memset(&event, 0, sizeof(event));
+	event.events = EPOLLIN;
+	event.data.fd = m_Socket;
+	epoll_ctl(m_Epoll, EPOLL_CTL_ADD, m_Socket, &event);
+	event.data.fd = m_Timer;
+	epoll_ctl(m_Epoll, EPOLL_CTL_ADD, m_Timer, &event);
+
+	for(int i = 0; i < SERVER_BATCH; ++i)
+	{
+		memset(&m_Out[i], 0, sizeof(m_Out[i]));
+		m_OutVec[i].iov_base = m_OutData[i];
+		m_Out[i].msg_hdr.msg_iov = &m_OutVec[i];
+		m_Out[i].msg_hdr.msg_iovlen = 1;
+		m_Out[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+	}
+	return true;
+}
+
+void CServerLoop::Run()
+{
+	double lastSweep = PlatformGetTime();
+	while(!g_Stop)
+	{
+		// The timeout only matters for noticing g_Stop and sweeping
+		epoll_event events[2];
+		int count = epoll_wait(m_Epoll, events, 2, 100);
+		++m_Stats.wakes;
+
+		double now = PlatformGetTime();
+		for(int i = 0; i < count; ++i)
+		{
+			if(events[i].data.fd == m_Socket)
+			{
+				Receive(now);
+			}
+			else
+			{
+				unsigned long long expirations;
+				if(read(m_Timer, &expirations, sizeof(expirations)) < 0)
+					expirations = 0;
+			}
+		}
+
+		StepDue(PlatformGetTime());
+		if(now - lastSweep >= 1.0)
+		{
+			Sweep(now);
+			lastSweep = now;
+		}
+		Flush();
+		SetTimer();
+	}
+}
+
+void CServerLoop::Receive(double now)
+{
+	mmsghdr in[SERVER_BATCH];
+	iovec vec[SERVER_BATCH];
+	sockaddr_in from[SERVER_BATCH];
+	unsigned char data[SERVER_BATCH][ROOM_MAX_PACKET];
+	for(int i = 0; i < SERVER_BATCH; ++i)
+	{
+		vec[i].iov_base	= data[i];
+		vec[i].iov_len	= sizeof(data[i]);
+		memset(&in[i], 0, sizeof(in[i]));
+		in[i].msg_hdr.msg_iov		= &vec[i];
+		in[i].msg_hdr.msg_iovlen	= 1;
+		in[i].msg_hdr.msg_name		= &from[i];
+		in[i].msg_hdr.msg_namelen	= sizeof(from[i]);
+	}
+
+	// Until the socket is empty, a short batch means it is
+	int count;
+	while((count = recvmmsg(m_Socket, in, SERVER_BATCH, 0, 0)) > 0)
+	{
+		for(int i = 0; i < count; ++i)
+		{
+			RoomPacket packet;
+			++m_Stats.packetsIn;
+			if(ReadRoomPacket(data[i], (int)in[i].msg_len, packet))
+				Handle(packet, from[i], now);
+			else
+				++m_Stats.badPackets;
+			in[i].msg_hdr.msg_namelen = sizeof(from[i]);
+		}
+		if(count < SERVER_BATCH)
+			break;
+	}
+}
+
+void CServerLoop::Handle(const RoomPacket& packet, const sockaddr_in& from, double now)
+{
+	int slot = (int)(packet.room / m_nLoops);
+	if((int)(packet.room % m_nLoops) != m_nIndex || slot >= (int)m_Rooms.size())
+	{
+		++m_Stats.badPackets;
+		return;
+	}
+
+	ServerRoom& room = m_Rooms[slot];
+	int paddle = packet.paddle;
+	switch(packet.type)
+	{
+	case ROOM_PACKET_JOIN:
+		if(!room.room.AcceptsTickRate(packet.tickRate))
+		{
+			++m_Stats.rejected;
+			QueueReject(room, packet, from);
+			break;
+		}
+		if(!room.active)
+		{
+			room.room.Init(packet.room);
+			room.active = true;
+		}
+		room.players[paddle] = from;
+		if(room.room.Join(paddle, now))
+		{
+			++m_Stats.matches;
+			if(++m_nPlaying > m_Stats.mostRooms)
+				m_Stats.mostRooms = m_nPlaying;
+			Schedule(slot, now + m_fPeriod);
+		}
+		break;
+
+	case ROOM_PACKET_INPUT:
+		if(room.active && room.room.ApplyInput(packet, now))
+			room.players[paddle] = from;
+		break;
+
+	case ROOM_PACKET_LEAVE:
+		if(room.active && room.room.IsJoined(paddle))
+		{
+			bool wasPlaying = room.room.IsPlaying();
+			room.room.Leave(paddle);
+			if(wasPlaying)
+				--m_nPlaying;
+			room.active = !room.room.IsEmpty();
+		}
+		break;
+
+	default:
+		++m_Stats.badPackets;
+		break;
+	}
+}
+
+void CServerLoop::Schedule(int slot, double time)
+{
+	ServerRoom& room = m_Rooms[slot];
+	room.nextTick = time;
+	if(room.scheduled)
+		return;
+	DueTick due = { time, slot };
+	m_Due.push(due);
+	room.scheduled = true;
+}
+
+void CServerLoop::StepDue(double now)
+{
+	while(!m_Due.empty() && m_Due.top().time <= now)
+	{
+		int slot = m_Due.top().slot;
+		m_Due.pop();
+
+		ServerRoom& room = m_Rooms[slot];
+		room.scheduled = false;
+		if(!room.active || !room.room.IsPlaying())
+			continue;
+
+		double start = PlatformGetTime();
+		m_Stats.lateness.Add(start - room.nextTick);
+
+		room.room.Step();
+		++m_Stats.ticks;
+		QueueState(room, 0);
+		QueueState(room, 1);
+
+		// Catches up one tick per pop, unless it is so far behind that
+		// running the ticks back to back would only make it worse
+		double next = room.nextTick + m_fPeriod;
+		if(start - next > SERVER_MAX_BEHIND * m_fPeriod)
+			next = start + m_fPeriod;
+		Schedule(slot, next);
+
+		m_Stats.tickCost.Add(PlatformGetTime() - start);
+	}
+}
+
+void CServerLoop::Sweep(double now)
+{
+	for(size_t i = 0; i < m_Rooms.size(); ++i)
+	{
+		ServerRoom& room = m_Rooms[i];
+		if(!room.active)
+			continue;
+		bool wasPlaying = room.room.IsPlaying();
+		if(room.room.Expire(now))
+		{
+			if(wasPlaying)
+				--m_nPlaying;
+			room.active = !room.room.IsEmpty();
+		}
+	}
+}
+
+void CServerLoop::QueueState(const ServerRoom& room, int paddle)
+{
+	if(m_nOut == SERVER_BATCH)
+		Flush();
+
+	RoomPacket packet;
+	room.room.GetState(paddle, packet);
+	m_OutVec[m_nOut].iov_len = WriteRoomPacket(packet, m_OutData[m_nOut]);
+	m_Out[m_nOut].msg_hdr.msg_name = (void*)&room.players[paddle];
+	++m_nOut;
+}
+
+void CServerLoop::QueueReject(const ServerRoom& room, const RoomPacket& join, const sockaddr_in& to)
+{
+	if(m_nOut == SERVER_BATCH)
+		Flush();
+
+	RoomPacket packet;
+	room.room.GetReject(join, packet);
+	m_OutTo[m_nOut] = to;
+	m_OutVec[m_nOut].iov_len = WriteRoomPacket(packet, m_OutData[m_nOut]);
+	m_Out[m_nOut].msg_hdr.msg_name = &m_OutTo[m_nOut];
+	++m_nOut;
+}
+
+void CServerLoop::Flush()
+{
+	int sent = 0;
+	while(sent < m_nOut)
+	{
+		int count = sendmmsg(m_Socket, m_Out + sent, m_nOut - sent, 0);
+		if(count <= 0)
+			break;		// Send buffer full, states are sent every tick anyway
+		sent += count;
+	}
+	m_Stats.packetsOut += sent;
+	m_nOut = 0;
+}
+
+void CServerLoop::SetTimer()
+{
+	// Absolute, on the clock PlatformGetTime() reads.  All zero disarms it.
+	itimerspec timer;
+	memset(&timer, 0, sizeof(timer));
+	if(!m_Due.empty())
+	{
+		double due = m_Due.top().time;
+		timer.it_value.tv_sec = (time_t)due;
+		timer.it_value.tv_nsec = (long)((due - (double)timer.it_value.tv_sec) * 1e9);
+		if(timer.it_value.tv_sec == 0 && timer.it_value.tv_nsec == 0)
+			timer.it_value.tv_nsec = 1;
+	}
+	timerfd_settime(m_Timer, TFD_TIMER_ABSTIME, &timer, 0);
+}
+
+static void PrintLatency(const char* name, const CLatencyHistogram& histogram)
+{
+	printf("%-10s mean %7.3f  p50 %7.3f  p90 %7.3f  p99 %7.3f  p99.9 %7.3f  max %7.3f ms\n", name,
+		histogram.GetMean() * 1e3, histogram.GetPercentile(50.0) * 1e3, histogram.GetPercentile(90.0) * 1e3,
+		histogram.GetPercentile(99.0) * 1e3, histogram.GetPercentile(99.9) * 1e3, histogram.GetMax() * 1e3);
+}
+
+int main(int argc, char** argv)
+{
+	int port = 27100;
+	int loops = (int)std::thread::hardware_concurrency();
+	int rooms = 4096;
+	double hz = 60.0;
+	double seconds = 0.0;
+	bool pin = true;
+
+	// The clients' speeds and tick rate
+	CConfigFile config;
+	config.Load(PONG_CONFIG_FILE);
+	PongTuning tuning;
+	ReadTuningConfig(config, tuning);
+	double tickRate = config.GetFloat("Video", "TickRate", PONG_TICK_RATE);
+
+	for(int i = 1; i < argc; ++i)
+	{
+		if(!strcmp(argv[i], "-port") && i + 1 < argc)			port = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-loops") && i + 1 < argc)		loops = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-rooms") && i + 1 < argc)		rooms = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-hz") && i + 1 < argc)		hz = atof(argv[++i]);
+		else if(!strcmp(argv[i], "-seconds") && i + 1 < argc)	seconds = atof(argv[++i]);
+		else if(!strcmp(argv[i], "-nopin"))						pin = false;
+		else if(!strcmp(argv[i], "-tickrate") && i + 1 < argc)	tickRate = atof(argv[++i]);
+		else
+		{
+			printf("Usage: %s [-port N] [-loops N] [-rooms N] [-hz N] [-seconds N] [-nopin] [-tickrate N]\n", argv[0]);
+			return 1;
+		}
+	}
+	if(loops < 1)
+		loops = 1;
+	if(rooms < loops)
+		rooms = loops;
+	if(hz <= 0.0)
+		hz = 60.0;
+	if(tickRate < 0.0)
+		tickRate = 0.0;
+
+	signal(SIGINT, OnSignal);
+	signal(SIGTERM, OnSignal);
+
+	std::vector<CServerLoop*> server(loops);
+	for(int i = 0; i < loops; ++i)
+	{
+		server[i] = new CServerLoop;
+		if(!server[i]->Open(i, loops, port, rooms, hz, tuning, tickRate))
+		{
+			printf("Could not open loop %d on port %d\n", i, port + i);
+			return 1;
+		}
+	}
+	printf("%d loops on ports %d-%d, %d rooms, %.0f steps a second of %.0f match ticks a second%s\n", loops, port,
+		port + loops - 1, rooms, hz, tickRate > 0.0 ? tickRate : hz, pin ? ", pinned" : "");
+	fflush(stdout);
+
+	int cores = (int)std::thread::hardware_concurrency();
+	std::vector<std::thread> threads;
+	for(int i = 0; i < loops; ++i)
+	{
+		threads.push_back(std::thread(&CServerLoop::Run, server[i]));
+		if(pin && cores > 0)
+		{
+			cpu_set_t set;
+			CPU_ZERO(&set);
+			CPU_SET(i % cores, &set);
+			pthread_setaffinity_np(threads.back().native_handle(), sizeof(set), &set);
+		}
+	}
+
+	double start = PlatformGetTime();
+	while(!g_Stop && (seconds <= 0.0 || PlatformGetTime() - start < seconds))
+		usleep(50000);
+	g_Stop = 1;
+	for(int i = 0; i < loops; ++i)
+		threads[i].join();
+	double elapsed = PlatformGetTime() - start;
+
+	printf("\nloop  matches  most rooms       steps   packets in  packets out    bad rejected    wakes\n");
+	static LoopStats total;
+	for(int i = 0; i < loops; ++i)
+	{
+		const LoopStats& s = server[i]->GetStats();
+		printf("%4d %8d %11d %11lld %12lld %12lld %6lld %8lld %8lld\n", i, s.matches, s.mostRooms,
+			s.ticks, s.packetsIn, s.packetsOut, s.badPackets, s.rejected, s.wakes);
+		total.packetsIn += s.packetsIn;
+		total.packetsOut += s.packetsOut;
+		total.badPackets += s.badPackets;
+		total.rejected += s.rejected;
+		total.ticks += s.ticks;
+		total.wakes += s.wakes;
+		total.matches += s.matches;
+		total.mostRooms += s.mostRooms;
+		total.lateness.Merge(s.lateness);
+		total.tickCost.Merge(s.tickCost);
+	}
+	printf("%.1f s, %.0f room steps/s, %.0f packets in/s, %.0f out/s\n", elapsed,
+		total.ticks / elapsed, total.packetsIn / elapsed, total.packetsOut / elapsed);
+	if(total.rejected > 0)
+		printf("%lld joins rejected for not playing at %.0f match ticks a second\n", total.rejected, tickRate);
+	PrintLatency("late by", total.lateness);
+	PrintLatency("step cost", total.tickCost);
+
+	for(int i = 0; i < loops; ++i)
+		delete server[i];
+	return 0;
+}
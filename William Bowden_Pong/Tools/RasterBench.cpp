@@ -0,0 +1,171 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	RasterBench.cpp
+// Date:	October 19th, 2026
+// Purpose: Frames per second of the software renderer on the match scene
+//			(wall, paddles, score) with many balls in flight, at 800x600
+//			and at 4K.  Each size is run single threaded and on every
+//			core, and the frame checksums are compared so a threading bug
+//			shows up as a mismatch rather than a fast number.
+//
+//			Run from the Dx12Test directory so the sprites are found.
+//			Build (Linux):
+//				g++ -O2 -std=c++11 -pthread -I../Dx12Test RasterBench.cpp
+//					../Dx12Test/SoftwareRenderer.cpp ../Dx12Test/ThreadPool.cpp
+//					../Dx12Test/ImageFile.cpp ../Dx12Test/FrameArena.cpp
+//					../Dx12Test/StartupTrace.cpp ../Dx12Test/FrameCapture.cpp
+//					-o rasterbench
+//
+//			Usage: rasterbench [-balls N] [-frames N] [-threads N]
+//////////////////////////////////////////////////////////////////////////
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <wchar.h>
+#include <vector>
+#include <thread>
+#include "SoftwareRenderer.h"
+#include "PongScene.h"
+#include "PongPlatform.h"
+
+struct BenchBall
+{
+	float	xp, yp;
+	float	dx, dy;
+};
+
+// Moves the balls around the 800x600 playfield, bouncing off every edge
+static void MoveBalls(std::vector<BenchBall>& balls)
+{
+	for(size_t i = 0; i < balls.size(); ++i)
+	{
+		BenchBall& b = balls[i];
+		b.xp += b.dx;
+		b.yp += b.dy;
+		if(b.xp < 10.0f || b.xp > PLAYFIELD_WIDTH - 10.0f)		b.dx = -b.dx;
+		if(b.yp < 10.0f || b.yp > PLAYFIELD_HEIGHT - 10.0f)	b.dy = -b.dy;
+	}
+}
+
+// The match scene scaled from 800x600 to the frame buffer
+static void DrawBenchScene(CSoftwareRenderer& renderer, const PongTextures& textures, const Viewport& view, const std::vector<BenchBall>& balls, int frame)
+{
+	float scale = view.scale;
+
+	renderer.BeginFrame(0xFF000000);
+	renderer.DrawSprite(textures.wall, ViewportX(view, 400), ViewportY(view, 300), scale, SPRITE_WHITE);
+
+	float paddleY = 300.0f + 200.0f * (float)((frame % 200) - 100) / 100.0f;
+	renderer.DrawSprite(textures.paddle, ViewportX(view, 10), ViewportY(view, paddleY), scale, SPRITE_WHITE);
+	renderer.DrawSprite(textures.paddle, ViewportX(view, 790), ViewportY(view, 600.0f - paddleY), scale, SPRITE_WHITE);
+
+	// Every other ball is tinted and half transparent to exercise blending
+	for(size_t i = 0; i < balls.size(); ++i)
+	{
+		unsigned int color = (i & 1) ? 0x80FF8040 : SPRITE_WHITE;
+		renderer.DrawSprite(textures.ball, ViewportX(view, balls[i].xp), ViewportY(view, balls[i].yp), scale, color);
+	}
+
+	wchar_t text[64];
+	swprintf(text, 64, L"Point(s): %i", frame / 100);
+	renderer.DrawString(text, (int)ViewportX(view, 10), (int)ViewportY(view, 10), SPRITE_WHITE);
+	renderer.DrawString(text, (int)ViewportX(view, 670), (int)ViewportY(view, 10), SPRITE_WHITE);
+	renderer.EndFrame();
+}
+
+static unsigned int Checksum(const CSoftwareRenderer& renderer)
+{
+	// FNV-1a over the frame buffer
+	const unsigned int* pixels = renderer.GetFrameBuffer();
+	size_t count = (size_t)renderer.GetWidth() * renderer.GetHeight();
+	unsigned int hash = 2166136261u;
+	for(size_t i = 0; i < count; ++i)
+		hash = (hash ^ pixels[i]) * 16777619u;
+	return hash;
+}
+
+static unsigned int RunBench(int width, int height, int threads, int ballCount, int frames)
+{
+	Viewport view = MakeViewport(width, height, PLAYFIELD_WIDTH, PLAYFIELD_HEIGHT);
+
+	RendererDesc desc;
+	desc.width		= width;
+	desc.height		= height;
+	desc.textScale	= view.scale;
+	desc.threads	= threads;
+
+	CSoftwareRenderer renderer;
+	renderer.Init(desc);
+
+	PongTextures textures;
+	if(!LoadPongTextures(renderer, textures))
+		printf("Warning: some textures failed to load, run from the Dx12Test directory\n");
+
+	// Same ball paths for every run
+	std::vector<BenchBall> balls(ballCount);
+	srand(381);
+	for(int i = 0; i < ballCount; ++i)
+	{
+		balls[i].xp = 20.0f + (float)(rand() % 760);
+		balls[i].yp = 20.0f + (float)(rand() % 560);
+		balls[i].dx = ((rand() % 2) ? 1.0f : -1.0f) * (0.5f + (rand() % 100) / 50.0f);
+		balls[i].dy = ((rand() % 2) ? 1.0f : -1.0f) * (0.5f + (rand() % 100) / 50.0f);
+	}
+
+	// Warm up the pool and caches
+	DrawBenchScene(renderer, textures, view, balls, 0);
+
+	double start = PlatformGetTime();
+	for(int frame = 0; frame < frames; ++frame)
+	{
+		MoveBalls(balls);
+		DrawBenchScene(renderer, textures, view, balls, frame);
+	}
+	double elapsed = PlatformGetTime() - start;
+
+	unsigned int checksum = Checksum(renderer);
+	printf("%5dx%-5d %3d thread(s) %5d balls: %8.1f frames/s  (%.3f ms/frame)  checksum %08x\n",
+		width, height, renderer.GetThreadCount(), ballCount,
+		frames / elapsed, elapsed * 1000.0 / frames, checksum);
+
+	renderer.Shutdown();
+	return checksum;
+}
+
+int main(int argc, char** argv)
+{
+	int balls = 500;
+	int frames = 200;
+	int threads = (int)std::thread::hardware_concurrency();
+	if(threads < 1)
+		threads = 1;
+
+	for(int i = 1; i < argc; ++i)
+	{
+		if(!strcmp(argv[i], "-balls") && i + 1 < argc)			balls = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-frames") && i + 1 < argc)	frames = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-threads") && i + 1 < argc)	threads = atoi(argv[++i]);
+		else
+		{
+			printf("Usage: %s [-balls N] [-frames N] [-threads N]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	static const int sizes[2][2] = { { 800, 600 }, { 3840, 2160 } };
+	bool mismatch = false;
+	for(int s = 0; s < 2; ++s)
+	{
+		unsigned int single = RunBench(sizes[s][0], sizes[s][1], 1, balls, frames);
+		if(threads > 1)
+		{
+			unsigned int multi = RunBench(sizes[s][0], sizes[s][1], threads, balls, frames);
+			if(multi != single)
+			{
+				printf("  MISMATCH: %d threads produced a different frame\n", threads);
+				mismatch = true;
+			}
+		}
+	}
+
+	return mismatch ? 1 : 0;
+}
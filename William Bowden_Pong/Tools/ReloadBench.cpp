@@ -0,0 +1,283 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	ReloadBench.cpp
+// Date:	October 19th, 2026
+// Purpose: Checks and times live reloading (AssetReloader.h) the way the
+//			game uses it.  Copies the wall sprite and a settings file into
+//			a temporary directory, then runs a 60 fps frame loop that
+//			calls Update() and Pop() and swaps the results into the null
+//			renderer and a CPongGame, while another thread saves the
+//			files the way an editor does, in several writes.  The last
+//			save of each file must be what the game ends up with, and
+//			when saves are further apart than twice ASSET_SETTLE_SECONDS
+//			each must be reloaded exactly once; closer saves merge.
+//			Reports the time from save to swap and what the frame loop
+//			spent on reloading against what the worker spent reading,
+//			and exits with 1 if a check fails or the frame loop spent
+//			more than the budget on one frame.  Linux only, the watcher
+//			uses inotify.
+//
+//			Build (Linux):
+//				g++ -O2 -std=c++11 -pthread -I../Dx12Test ReloadBench.cpp
+//					../Dx12Test/AssetReloader.cpp ../Dx12Test/FileWatcher.cpp
+//					../Dx12Test/ImageFile.cpp ../Dx12Test/ConfigFile.cpp
+//					../Dx12Test/PongGame.cpp -o reloadbench
+//
+//			Usage: reloadbench [-saves N] [-gap ms] [-budget ms]
+//				[-assets dir]	where wall.tga is, default ../Dx12Test
+//////////////////////////////////////////////////////////////////////////
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include "AssetReloader.h"
+#include "TuningConfig.h"
+#include "NullRenderer.h"
+#include "LatencyHistogram.h"
+#include "PongPlatform.h"
+
+#define FRAME_TIME (1.0 / 60.0)
+
+enum
+{
+	SLOT_WALL,
+	SLOT_CONFIG
+};
+
+static bool ReadFile(const std::string& fileName, std::vector<char>& data)
+{
+	FILE* file = fopen(fileName.c_str(), "rb");
+	if(!file)
+		return false;
+	fseek(file, 0, SEEK_END);
+	data.resize((size_t)ftell(file));
+	fseek(file, 0, SEEK_SET);
+	bool ok = fread(data.empty() ? 0 : &data[0], 1, data.size(), file) == data.size();
+	fclose(file);
+	return ok;
+}
+
+// Four opens, writes and closes a few milliseconds apart, so the watcher
+// reports the file four times for one save
+static void SaveInPieces(const std::string& fileName, const std::vector<char>& data)
+{
+	size_t piece = (data.size() + 3) / 4;
+	for(size_t done = 0; done < data.size(); done += piece)
+	{
+		FILE* file = fopen(fileName.c_str(), done == 0 ? "wb" : "ab");
+		if(!file)
+			return;
+		size_t size = data.size() - done < piece ? data.size() - done : piece;
+		fwrite(&data[done], 1, size, file);
+		fclose(file);
+		std::this_thread::sleep_for(std::chrono::milliseconds(5));
+	}
+}
+
+static std::string MakeConfig(int save)
+{
+	char text[256];
+	sprintf(text, "[Tuning]\nBallSpeedX = %.4f\nBallSpeedY = 0.05\nPaddleSpeed = 0.1\n", 0.03 + save * 0.001);
+	return text;
+}
+
+struct Saver
+{
+	std::string			directory;
+	std::vector<char>	wall;
+	int					saves;
+	int					gapMs;
+	std::atomic<double>	savedAt[2];		// When each file was last closed
+	std::atomic<int>	saved[2];
+	std::atomic<bool>	done;
+};
+
+static void SaverMain(Saver* saver)
+{
+	for(int save = 1; save <= saver->saves; ++save)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(saver->gapMs));
+
+		// Alternates, so sometimes both files are in flight at once
+		int slot = save & 1 ? SLOT_WALL : SLOT_CONFIG;
+		if(slot == SLOT_WALL)
+		{
+			SaveInPieces(saver->directory + "/wall.tga", saver->wall);
+		}
+		else
+		{
+			std::string config = MakeConfig(save);
+			SaveInPieces(saver->directory + "/Pong.ini", std::vector<char>(config.begin(), config.end()));
+		}
+		saver->savedAt[slot] = PlatformGetTime();
+		++saver->saved[slot];
+	}
+	saver->done = true;
+}
+
+int main(int argc, char** argv)
+{
+	int saves = 10;
+	int gapMs = 300;
+	double budgetMs = 1.0;
+	std::string assets = "../Dx12Test";
+
+	for(int i = 1; i < argc; ++i)
+	{
+		if(!strcmp(argv[i], "-saves") && i + 1 < argc)			saves = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-gap") && i + 1 < argc)		gapMs = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-budget") && i + 1 < argc)	budgetMs = atof(argv[++i]);
+		else if(!strcmp(argv[i], "-assets") && i + 1 < argc)	assets = argv[++i];
+		else
+		{
+			printf("Usage: %s [-saves N] [-gap ms] [-budget ms] [-assets dir]\n", argv[0]);
+			return 1;
+		}
+	}
+	if(saves < 1)
+		saves = 1;
+	if(gapMs < 1)
+		gapMs = 1;
+
+	Saver saver;
+	if(!ReadFile(assets + "/wall.tga", saver.wall))
+	{
+		printf("Could not read %s/wall.tga\n", assets.c_str());
+		return 1;
+	}
+	char directory[] = "/tmp/reloadbenchXXXXXX";
+	if(!mkdtemp(directory))
+	{
+		printf("Could not create a temporary directory\n");
+		return 1;
+	}
+	saver.directory	= directory;
+	saver.saves		= saves;
+	saver.gapMs		= gapMs;
+	saver.done		= false;
+	for(int i = 0; i < 2; ++i)
+	{
+		saver.savedAt[i]	= 0.0;
+		saver.saved[i]		= 0;
+	}
+	SaveInPieces(saver.directory + "/wall.tga", saver.wall);
+	std::string config = MakeConfig(0);
+	SaveInPieces(saver.directory + "/Pong.ini", std::vector<char>(config.begin(), config.end()));
+
+	// What the game holds
+	CNullRenderer renderer;
+	SpriteTexture wall;
+	wall.id = 0;
+	wall.width = wall.height = 0;
+	CPongGame game;
+
+	CAssetReloader reloader;
+	if(!reloader.Init(directory))
+	{
+		printf("Could not watch %s\n", directory);
+		return 1;
+	}
+	reloader.Watch("wall.tga", ASSET_TEXTURE, SLOT_WALL);
+	reloader.Watch("Pong.ini", ASSET_CONFIG, SLOT_CONFIG);
+
+	std::thread thread(SaverMain, &saver);
+
+	CLatencyHistogram latency;
+	AssetReload reload;
+	int reloaded[2] = { 0, 0 };
+	bool lastOk[2] = { true, true };
+	int failed = 0;
+	double worst = 0.0;
+	double frameSpent = 0.0;
+	double workerSpent = 0.0;
+	int frames = 0;
+	double last = PlatformGetTime();
+	for(;;)
+	{
+		// Reloading, the part of the frame this measures
+		double start = PlatformGetTime();
+		reloader.Update(start);
+		bool popped = reloader.Pop(reload);
+		if(popped && reload.ok)
+		{
+			if(reload.kind == ASSET_TEXTURE)
+			{
+				renderer.UpdateTexture(reload.image, wall);
+			}
+			else
+			{
+				PongTuning tuning = game.GetTuning();
+				ReadTuningConfig(reload.config, tuning);
+				game.SetTuning(tuning);
+			}
+		}
+		double end = PlatformGetTime();
+
+		double spent = end - start;
+		frameSpent += spent;
+		if(spent > worst)
+			worst = spent;
+		if(popped)
+		{
+			++reloaded[reload.slot];
+			lastOk[reload.slot] = reload.ok;
+			failed += !reload.ok;
+			workerSpent += reload.readSeconds;
+			latency.Add(end - saver.savedAt[reload.slot]);
+		}
+		++frames;
+
+		if(saver.done && !reloader.IsBusy() && end - saver.savedAt[0] > 0.5 && end - saver.savedAt[1] > 0.5)
+			break;
+
+		// The rest of the frame
+		double next = last + FRAME_TIME;
+		double now = PlatformGetTime();
+		if(next > now)
+			std::this_thread::sleep_for(std::chrono::microseconds((long long)((next - now) * 1e6)));
+		last = next > now ? next : now;
+	}
+	thread.join();
+	reloader.Shutdown();
+
+	unlink((saver.directory + "/wall.tga").c_str());
+	unlink((saver.directory + "/Pong.ini").c_str());
+	rmdir(directory);
+
+	// The files written before Init() are not reloaded
+	int wallSaves = saver.saved[SLOT_WALL];
+	int configSaves = saver.saved[SLOT_CONFIG];
+	float expectedSpeed = (float)(0.03 + (configSaves > 0 ? saves - (saves & 1) : 0) * 0.001);
+	bool tuned = configSaves == 0 || game.GetTuning().ballSpeedX == expectedSpeed;
+	bool exact = gapMs >= ASSET_SETTLE_SECONDS * 2e3;
+
+	printf("%d saves of wall.tga (%dx%d) reloaded %d times, %d of Pong.ini reloaded %d times, %d failed\n",
+		wallSaves, wall.width, wall.height, reloaded[SLOT_WALL], configSaves, reloaded[SLOT_CONFIG], failed);
+	printf("Ball speed after the last save %.4f, %s\n", game.GetTuning().ballSpeedX, tuned ? "as saved" : "WRONG");
+	printf("Save to swap: p50 %.1f ms, p99 %.1f ms, max %.1f ms (%.0f ms of it settling)\n",
+		latency.GetPercentile(50.0) * 1e3, latency.GetPercentile(99.0) * 1e3, latency.GetMax() * 1e3,
+		ASSET_SETTLE_SECONDS * 1e3);
+	printf("Frame loop: %d frames, %.3f ms on reloading in all, worst frame %.3f ms\n", frames, frameSpent * 1e3, worst * 1e3);
+	printf("Worker: %.3f ms reading and decoding\n", workerSpent * 1e3);
+
+	int result = 0;
+	if(!lastOk[SLOT_WALL] || !lastOk[SLOT_CONFIG] || !tuned || (wallSaves > 0 && wall.width == 0))
+	{
+		printf("FAILED: the last save of a file was not reloaded\n");
+		result = 1;
+	}
+	if(exact && (reloaded[SLOT_WALL] != wallSaves || reloaded[SLOT_CONFIG] != configSaves || failed > 0))
+	{
+		printf("FAILED: every save should be reloaded once\n");
+		result = 1;
+	}
+	if(worst * 1e3 > budgetMs)
+	{
+		printf("FAILED: a frame spent %.3f ms on reloading, over the budget of %.3f ms\n", worst * 1e3, budgetMs);
+		result = 1;
+	}
+	return result;
+}
@@ -0,0 +1,324 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	ResourceBench.cpp
+// Date:	October 19th, 2026
+// Purpose: Checks and times the resource registry (ResourceRegistry.h)
+//			with stand-in objects shaped like the game's: a device with
+//			textures, a font and a sprite, an audio system with sounds,
+//			input devices and a video graph.  The owners let go parents
+//			first, which must still release every child before its
+//			parent and leave nothing behind; an owner that never lets go
+//			must be reported by ReleaseAll().  Then adds, copies, reloads
+//			and releases at random, checking that released handles stay
+//			stale after their slots are reused and that the per-type
+//			totals match the objects alive.  Finally times a handle
+//			lookup, what every sprite draw now does, against indexing a
+//			vector.  Exits with 1 if a check fails or a lookup costs more
+//			than the budget.
+//
+//			Build (Linux):
+//				g++ -O2 -std=c++11 -I../Dx12Test ResourceBench.cpp
+//					../Dx12Test/ResourceRegistry.cpp -o resourcebench
+//
+//			Usage: resourcebench [-ops N] [-lookups N] [-budget ns]
+//////////////////////////////////////////////////////////////////////////
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include <string>
+#include "ResourceRegistry.h"
+#include "PongPlatform.h"
+
+// Stands in for a COM or FMOD object.  Never deleted, so a child released
+// after its parent can still read the parent's flag
+struct FakeObject
+{
+	FakeObject*			parent;
+	bool				alive;
+};
+
+static int s_nLive = 0;
+static int s_nOrderErrors = 0;		// Released after its parent
+
+static void ReleaseFake(void* object)
+{
+	FakeObject* fake = (FakeObject*)object;
+	if(fake->parent && !fake->parent->alive)
+		++s_nOrderErrors;
+	fake->alive = false;
+	--s_nLive;
+}
+
+static FakeObject* NewFake(FakeObject* parent)
+{
+	FakeObject* fake = new FakeObject;
+	fake->parent	= parent;
+	fake->alive		= true;
+	++s_nLive;
+	return fake;
+}
+
+typedef CResourceRef<FakeObject> FakeRef;
+
+static void AddFake(CResourceRegistry& registry, FakeRef& ref, ResourceType type, const char* name, size_t bytes,
+					const FakeRef* parent = 0)
+{
+	ref.Reset(&registry, registry.Add(type, name, NewFake(parent ? parent->Get() : 0), ReleaseFake, bytes,
+		parent ? parent->GetHandle() : INVALID_RESOURCE));
+}
+
+// What CDirectXFramework and CD3D9Renderer hold after Init()
+struct GameResources
+{
+	FakeRef				d3d;
+	FakeRef				device;
+	FakeRef				textures[7];
+	FakeRef				font;
+	FakeRef				sprite;
+	FakeRef				audio;
+	FakeRef				sounds[3];
+	FakeRef				input;
+	FakeRef				keyboard;
+	FakeRef				mouse;
+	FakeRef				graph;
+	FakeRef				video[3];
+
+	void Load(CResourceRegistry& registry)
+	{
+		AddFake(registry, d3d, RESOURCE_DEVICE, "Direct3D", 0);
+		AddFake(registry, device, RESOURCE_DEVICE, "Device", 0, &d3d);
+		for(int i = 0; i < 7; ++i)
+			AddFake(registry, textures[i], RESOURCE_TEXTURE, "Sprite.tga", 256 * 256 * 4 * 4 / 3, &device);
+		AddFake(registry, font, RESOURCE_FONT, "Times New Roman", 30 * 30 * 4 * 95, &device);
+		AddFake(registry, sprite, RESOURCE_DEVICE, "Sprite", 0, &device);
+		AddFake(registry, audio, RESOURCE_DEVICE, "FMOD", 0);
+		for(int i = 0; i < 3; ++i)
+			AddFake(registry, sounds[i], RESOURCE_SOUND, "beep.ogg", 44100 * 4, &audio);
+		AddFake(registry, input, RESOURCE_DEVICE, "DirectInput", 0);
+		AddFake(registry, keyboard, RESOURCE_DEVICE, "Keyboard", 0, &input);
+		AddFake(registry, mouse, RESOURCE_DEVICE, "Mouse", 0, &input);
+		AddFake(registry, graph, RESOURCE_DEVICE, "Filter graph", 0);
+		for(int i = 0; i < 3; ++i)
+			AddFake(registry, video[i], RESOURCE_DEVICE, "Video", 0, &graph);
+	}
+
+	// Parents first, the order that used to crash or leak
+	void Unload()
+	{
+		d3d.Reset();
+		device.Reset();
+		audio.Reset();
+		input.Reset();
+		graph.Reset();
+		for(int i = 0; i < 7; ++i)
+			textures[i].Reset();
+		font.Reset();
+		sprite.Reset();
+		for(int i = 0; i < 3; ++i)
+			sounds[i].Reset();
+		keyboard.Reset();
+		mouse.Reset();
+		for(int i = 0; i < 3; ++i)
+			video[i].Reset();
+	}
+};
+
+static bool CheckShutdown()
+{
+	bool ok = true;
+	CResourceRegistry registry;
+	GameResources game;
+	game.Load(registry);
+
+	std::string usage;
+	registry.FormatUsage(usage);
+	printf("Loaded: %s\n", usage.c_str());
+
+	game.Unload();
+	std::string report;
+	int held = registry.ReleaseAll(&report);
+	printf("Shutdown: %d held, %d released out of order, %d alive\n", held, s_nOrderErrors, s_nLive);
+	if(held != 0 || s_nOrderErrors != 0 || s_nLive != 0 || registry.GetTotalBytes() != 0)
+	{
+		printf("FAILED: shutdown was not clean\n%s", report.c_str());
+		ok = false;
+	}
+
+	// One texture nobody releases
+	game.Load(registry);
+	ResourceHandle leaked = registry.Add(RESOURCE_TEXTURE, "Leaked.tga", NewFake(game.device.Get()), ReleaseFake,
+		1024, game.device.GetHandle());
+	game.Unload();
+	report.clear();
+	held = registry.ReleaseAll(&report);
+	printf("Leak: %d held, %d released out of order, %d alive, reported:\n%s", held, s_nOrderErrors, s_nLive,
+		report.c_str());
+	if(held != 1 || s_nOrderErrors != 0 || s_nLive != 0 || registry.IsValid(leaked) ||
+		report.find("Leaked.tga") == std::string::npos)
+	{
+		printf("FAILED: the leaked texture was not reported or not released\n");
+		ok = false;
+	}
+	return ok;
+}
+
+static bool CheckChurn(int ops)
+{
+	CResourceRegistry registry;
+	FakeRef device;
+	AddFake(registry, device, RESOURCE_DEVICE, "Device", 0);
+
+	// Owners, several may share an object
+	const int OWNERS = 64;
+	std::vector<FakeRef> refs(OWNERS);
+	std::vector<ResourceHandle> dead;
+	int staleHits = 0;
+	int badTotals = 0;
+	unsigned int seed = 12345;
+
+	for(int op = 0; op < ops; ++op)
+	{
+		seed = seed * 1103515245 + 12345;
+		int owner = (int)((seed >> 8) % OWNERS);
+		int action = (int)((seed >> 20) % 4);
+		FakeRef& ref = refs[owner];
+		ResourceHandle before = ref.GetHandle();
+		bool last = ref.IsValid() && registry.GetRefCount(before) == 1;
+
+		if(action == 0)
+		{
+			AddFake(registry, ref, RESOURCE_TEXTURE, "Churn.tga", 100 + op % 1000, &device);
+		}
+		else if(action == 1)
+		{
+			ref = refs[(owner + 1) % OWNERS];
+		}
+		else if(action == 2 && ref.IsValid())
+		{
+			// Reloaded in place, the handle stays live
+			registry.Replace(before, NewFake(device.Get()), 200 + op % 1000);
+			if(!registry.IsValid(before))
+				++badTotals;
+			last = false;
+		}
+		else
+		{
+			ref.Reset();
+		}
+
+		// The reference dropped was the last one, the handle must go stale
+		// and stay stale once its slot is reused
+		if(last && ref.GetHandle() != before)
+		{
+			if(registry.IsValid(before))
+				++staleHits;
+			else if(dead.size() < 4096)
+				dead.push_back(before);
+		}
+		for(size_t i = op % 16; i < dead.size(); i += 16)
+		{
+			if(registry.Get(dead[i]))
+				++staleHits;
+		}
+
+		// Totals against the objects that are alive
+		int textures = 0;
+		for(int i = 0; i < OWNERS; ++i)
+		{
+			bool counted = false;
+			for(int j = 0; j < i && !counted; ++j)
+				counted = refs[j].GetHandle() == refs[i].GetHandle();
+			if(refs[i].IsValid() && !counted)
+				++textures;
+		}
+		if(registry.GetCount(RESOURCE_TEXTURE) != textures || s_nLive != textures + 1)
+			++badTotals;
+	}
+
+	for(int i = 0; i < OWNERS; ++i)
+		refs[i].Reset();
+	device.Reset();
+	bool clean = registry.GetTotalCount() == 0 && registry.GetTotalBytes() == 0 && s_nLive == 0;
+
+	printf("Churn: %d operations, %d stale handles checked, %d looked up as live, %d bad totals, %s\n",
+		ops, (int)dead.size(), staleHits, badTotals, clean ? "empty after" : "NOT EMPTY after");
+	if(staleHits > 0 || badTotals > 0 || !clean || s_nOrderErrors != 0)
+	{
+		printf("FAILED: churn\n");
+		return false;
+	}
+	return true;
+}
+
+// Lookups the way DrawSprite() does them, ns each
+static double TimeLookups(int lookups, double& vectorNs)
+{
+	CResourceRegistry registry;
+	std::vector<FakeRef> refs(7);
+	std::vector<FakeObject*> objects;
+	for(int i = 0; i < 7; ++i)
+	{
+		AddFake(registry, refs[i], RESOURCE_TEXTURE, "Sprite.tga", 1024);
+		objects.push_back(refs[i].Get());
+	}
+
+	// Scattered ids, like the scene's sprites
+	int ids[16];
+	for(int i = 0; i < 16; ++i)
+		ids[i] = (i * 5) % 7;
+
+	volatile size_t sink = 0;
+	double begin = PlatformGetTime();
+	for(int i = 0; i < lookups; ++i)
+		sink += (size_t)registry.Get(refs[ids[i & 15]].GetHandle());
+	double handleSeconds = PlatformGetTime() - begin;
+
+	begin = PlatformGetTime();
+	for(int i = 0; i < lookups; ++i)
+		sink += (size_t)objects[ids[i & 15]];
+	double vectorSeconds = PlatformGetTime() - begin;
+
+	for(int i = 0; i < 7; ++i)
+		refs[i].Reset();
+	vectorNs = vectorSeconds * 1e9 / lookups;
+	return handleSeconds * 1e9 / lookups;
+}
+
+int main(int argc, char** argv)
+{
+	int ops = 20000;
+	int lookups = 50000000;
+	double budgetNs = 5.0;
+
+	for(int i = 1; i < argc; ++i)
+	{
+		if(!strcmp(argv[i], "-ops") && i + 1 < argc)				ops = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-lookups") && i + 1 < argc)	lookups = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-budget") && i + 1 < argc)	budgetNs = atof(argv[++i]);
+		else
+		{
+			printf("Usage: %s [-ops N] [-lookups N] [-budget ns]\n", argv[0]);
+			return 1;
+		}
+	}
+	if(ops < 1)
+		ops = 1;
+	if(lookups < 1)
+		lookups = 1;
+
+	int result = 0;
+	if(!CheckShutdown())
+		result = 1;
+	if(!CheckChurn(ops))
+		result = 1;
+
+	double vectorNs;
+	double handleNs = TimeLookups(lookups, vectorNs);
+	printf("Lookup: %.2f ns by handle, %.2f ns by vector index\n", handleNs, vectorNs);
+	if(handleNs > budgetNs)
+	{
+		printf("FAILED: a lookup took %.2f ns, over the budget of %.2f ns\n", handleNs, budgetNs);
+		result = 1;
+	}
+	return result;
+}
@@ -0,0 +1,165 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	SnapshotBench.cpp
+// Date:	October 19th, 2026
+// Purpose: Checks and times game state snapshots.  Plays a match on
+//			random keys, recording the state before every tick, then
+//			rewinds part of it, plays the same keys again and exits with
+//			1 unless it ends where it did the first time.  Then times
+//			taking a snapshot, restoring one, recording into the history
+//			and hashing a state, and exits with 1 if a snapshot or a
+//			restore costs more than the budget.
+//
+//			Build (Linux):
+//				g++ -O2 -std=c++11 -I../Dx12Test SnapshotBench.cpp
+//					../Dx12Test/PongGame.cpp -o snapshotbench
+//
+//			Usage: snapshotbench [-ticks N] [-rewind N] [-loops N] [-budget ns]
+//////////////////////////////////////////////////////////////////////////
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include "StateHistory.h"
+#include "PongPlatform.h"
+
+#define HISTORY_TICKS 1024
+
+static unsigned int g_Seed = 12345;
+
+static int RandomKeys()
+{
+	g_Seed = g_Seed * 1664525u + 1013904223u;
+	return (g_Seed >> 16) & (W_UP | S_DOWN | ARROW_UP | ARROW_DOWN);
+}
+
+static void StartMatch(CPongGame& game)
+{
+	game.Init();
+	game.Menu.onSTART = false;
+	game.FinishMovie();
+}
+
+// Rewinds and replays, the result has to match the first run
+static bool CheckRewind(int ticks, int rewind)
+{
+	std::vector<int> keys(ticks);
+	for(int i = 0; i < ticks; ++i)
+		keys[i] = RandomKeys();
+
+	static CStateHistory<HISTORY_TICKS> history;
+	history.Clear();
+	CPongGame game;
+	StartMatch(game);
+	for(int i = 0; i < ticks; ++i)
+	{
+		history.Record(game);
+		game.Tick(keys[i], 0);
+	}
+	unsigned int expected = GetStateChecksum(game);
+	int points = game.Player1Point + game.Player2Point;
+
+	if(!history.Rewind(game, rewind))
+	{
+		printf("Could not rewind %d ticks, %d are held\n", rewind, history.GetCount());
+		return false;
+	}
+	for(int i = ticks - rewind; i < ticks; ++i)
+	{
+		history.Record(game);
+		game.Tick(keys[i], 0);
+	}
+
+	unsigned int replayed = GetStateChecksum(game);
+	printf("%d ticks, %d points, rewound %d and replayed: %08x %08x %s\n", ticks, points,
+		rewind, expected, replayed, expected == replayed ? "same" : "DIFFER");
+	return expected == replayed && history.GetNextTick() == (unsigned int)ticks;
+}
+
+int main(int argc, char** argv)
+{
+	int ticks = 20000;
+	int rewind = 600;
+	int loops = 2000000;
+	double budget = 300.0;
+
+	for(int i = 1; i < argc; ++i)
+	{
+		if(!strcmp(argv[i], "-ticks") && i + 1 < argc)			ticks = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-rewind") && i + 1 < argc)	rewind = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-loops") && i + 1 < argc)		loops = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-budget") && i + 1 < argc)	budget = atof(argv[++i]);
+		else
+		{
+			printf("Usage: %s [-ticks N] [-rewind N] [-loops N] [-budget ns]\n", argv[0]);
+			return 1;
+		}
+	}
+	if(rewind > HISTORY_TICKS)
+		rewind = HISTORY_TICKS;
+	if(rewind > ticks)
+		rewind = ticks;
+	if(loops < 1)
+		loops = 1;
+
+	printf("PongState is %u bytes, a history of %d ticks is %u bytes\n", (unsigned int)sizeof(PongState),
+		HISTORY_TICKS, (unsigned int)sizeof(CStateHistory<HISTORY_TICKS>));
+	bool same = CheckRewind(ticks, rewind);
+
+	// A few states to cycle through so nothing is folded away
+	static CStateHistory<HISTORY_TICKS> history;
+	CPongGame game;
+	StartMatch(game);
+	PongState states[16];
+	for(int i = 0; i < 16; ++i)
+	{
+		game.Tick(RandomKeys(), 0);
+		game.SaveState(states[i]);
+	}
+
+	double start = PlatformGetTime();
+	for(int i = 0; i < loops; ++i)
+	{
+		game.LoadState(states[i & 15]);
+		game.SaveState(states[(i + 1) & 15]);
+	}
+	double roundTrip = (PlatformGetTime() - start) * 1e9 / loops;
+
+	start = PlatformGetTime();
+	for(int i = 0; i < loops; ++i)
+	{
+		game.Ball.xp = (float)(i & 255);
+		history.Record(game);
+	}
+	double record = (PlatformGetTime() - start) * 1e9 / loops;
+
+	unsigned int found = 0;
+	start = PlatformGetTime();
+	for(int i = 0; i < loops; ++i)
+	{
+		const PongState* state = history.GetAgo(i & (HISTORY_TICKS - 1));
+		found += state->Player1Point + 1;
+	}
+	double lookUp = (PlatformGetTime() - start) * 1e9 / loops;
+
+	unsigned int hash = 0;
+	start = PlatformGetTime();
+	for(int i = 0; i < loops; ++i)
+		hash += GetStateChecksum(states[i & 15]);
+	double checksum = (PlatformGetTime() - start) * 1e9 / loops;
+
+	printf("ns per operation: restore + snapshot %.1f, record %.1f, look up %.1f, checksum %.1f (%08x %u)\n",
+		roundTrip, record, lookUp, checksum, hash, found);
+
+	int failed = 0;
+	if(!same)
+	{
+		printf("FAILED: replaying after a rewind ended somewhere else\n");
+		failed = 1;
+	}
+	if(roundTrip > budget || record > budget)
+	{
+		printf("FAILED: over the budget of %.0f ns\n", budget);
+		failed = 1;
+	}
+	return failed;
+}
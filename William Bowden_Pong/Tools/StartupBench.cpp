@@ -0,0 +1,238 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	StartupBench.cpp
+// Date:	October 19th, 2026
+// Purpose: Starts the game many times and reports how long each phase
+//			of starting takes, from the traces it writes with -trace
+//			(StartupTrace.h).  Each run is a new process that quits once
+//			the first frame is drawn.  Cold runs first drop the
+//			executable and every file in the assets directory from the
+//			page cache (posix_fadvise), so they are read from the disk as
+//			after a reboot; warm runs follow straight after, with
+//			everything cached.  Prints the median and worst time of each
+//			phase, of the first frame and of the whole process, cold and
+//			warm, and exits with 1 if a run fails or the warm median to
+//			the first frame is over the budget.  Linux only.
+//
+//			Run from the Dx12Test directory so the sprites are found.
+//			Build (Linux):
+//				g++ -O2 -std=c++11 -I../Dx12Test StartupBench.cpp -o startupbench
+//
+//			Usage: startupbench [-exe path] [-runs N] [-budget ms] [-assets dir]
+//				-exe		program to start, default ../Tools/pong_headless,
+//						given -startup and -trace
+//				-runs		cold and warm runs each, default 10
+//				-assets		files to drop before cold runs, default .
+//////////////////////////////////////////////////////////////////////////
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/wait.h>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include "PongPlatform.h"
+
+// Milliseconds each phase took over the runs of one kind
+struct StartupTimes
+{
+	std::map<std::string, std::vector<double> >	phases;
+	std::vector<std::string>					order;		// Phases as the first trace listed them
+	std::vector<double>							firstFrame;	// End of "First frame"
+	std::vector<double>							exited;		// fork() to the process exiting
+	int											failed;
+};
+
+// Asks the kernel to forget the file's cached pages, there is nothing to
+// write back so the next read goes to the disk
+static void DropFromCache(const std::string& fileName)
+{
+	int file = open(fileName.c_str(), O_RDONLY);
+	if(file < 0)
+		return;
+	fdatasync(file);
+	posix_fadvise(file, 0, 0, POSIX_FADV_DONTNEED);
+	close(file);
+}
+
+static void DropAssets(const std::string& exe, const std::string& assets)
+{
+	DropFromCache(exe);
+	DIR* dir = opendir(assets.c_str());
+	if(!dir)
+		return;
+	while(dirent* entry = readdir(dir))
+	{
+		if(entry->d_name[0] != '.')
+			DropFromCache(assets + "/" + entry->d_name);
+	}
+	closedir(dir);
+}
+
+// Reads the number after "key": on a trace line
+static bool ReadNumber(const char* line, const char* key, double& value)
+{
+	const char* found = strstr(line, key);
+	return found && sscanf(found + strlen(key), "%lf", &value) == 1;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Name:		ReadTrace
+// Parameters:	const char* fileName - What CStartupTrace::WriteChromeTrace()
+//					wrote, one event a line
+//				StartupTimes& times - Gets each phase's duration
+// Return:		bool - false if the trace is missing, has no first frame
+//				or a phase failed
+// Description:	Phases with the same name in one trace are added up.
+//////////////////////////////////////////////////////////////////////////
+static bool ReadTrace(const char* fileName, StartupTimes& times)
+{
+	FILE* file = fopen(fileName, "r");
+	if(!file)
+		return false;
+
+	std::map<std::string, double> phases;
+	double firstFrame = -1.0;
+	bool ok = true;
+	char line[1024];
+	while(fgets(line, sizeof(line), file))
+	{
+		char name[256];
+		double start, duration;
+		if(sscanf(line, "{\"name\":\"%255[^\"]\"", name) != 1 || !ReadNumber(line, "\"ts\":", start) ||
+			!ReadNumber(line, "\"dur\":", duration))
+		{
+			continue;
+		}
+		if(strstr(line, "\"ok\":false"))
+			ok = false;
+
+		// Microseconds in the trace
+		if(phases.find(name) == phases.end() &&
+			std::find(times.order.begin(), times.order.end(), name) == times.order.end())
+		{
+			times.order.push_back(name);
+		}
+		phases[name] += duration * 1e-3;
+		if(!strcmp(name, "First frame"))
+			firstFrame = (start + duration) * 1e-3;
+	}
+	fclose(file);
+
+	if(firstFrame < 0.0)
+		return false;
+	for(std::map<std::string, double>::const_iterator i = phases.begin(); i != phases.end(); ++i)
+		times.phases[i->first].push_back(i->second);
+	times.firstFrame.push_back(firstFrame);
+	return ok;
+}
+
+// Runs the program once, false if it failed
+static bool Run(const std::string& exe, const char* traceFile, StartupTimes& times)
+{
+	unlink(traceFile);
+	double start = PlatformGetTime();
+	pid_t child = fork();
+	if(child < 0)
+		return false;
+	if(child == 0)
+	{
+		int null = open("/dev/null", O_WRONLY);
+		if(null >= 0)
+			dup2(null, STDOUT_FILENO);
+		execl(exe.c_str(), exe.c_str(), "-startup", "-trace", traceFile, (char*)0);
+		_exit(127);
+	}
+
+	int status = 0;
+	waitpid(child, &status, 0);
+	times.exited.push_back((PlatformGetTime() - start) * 1e3);
+	return WIFEXITED(status) && WEXITSTATUS(status) == 0 && ReadTrace(traceFile, times);
+}
+
+static double Percentile(std::vector<double> values, double percent)
+{
+	if(values.empty())
+		return 0.0;
+	std::sort(values.begin(), values.end());
+	size_t index = (size_t)(percent / 100.0 * (values.size() - 1) + 0.5);
+	return values[index];
+}
+
+static double Max(const std::vector<double>& values)
+{
+	return values.empty() ? 0.0 : *std::max_element(values.begin(), values.end());
+}
+
+static void PrintRow(const char* name, const std::vector<double>& cold, const std::vector<double>& warm)
+{
+	printf("%-20s %9.2f %9.2f %9.2f %9.2f\n", name, Percentile(cold, 50.0), Max(cold), Percentile(warm, 50.0),
+		Max(warm));
+}
+
+int main(int argc, char** argv)
+{
+	std::string exe = "../Tools/pong_headless";
+	std::string assets = ".";
+	int runs = 10;
+	double budgetMs = 100.0;
+
+	for(int i = 1; i < argc; ++i)
+	{
+		if(!strcmp(argv[i], "-exe") && i + 1 < argc)				exe = argv[++i];
+		else if(!strcmp(argv[i], "-runs") && i + 1 < argc)		runs = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-budget") && i + 1 < argc)	budgetMs = atof(argv[++i]);
+		else if(!strcmp(argv[i], "-assets") && i + 1 < argc)	assets = argv[++i];
+		else
+		{
+			printf("Usage: %s [-exe path] [-runs N] [-budget ms] [-assets dir]\n", argv[0]);
+			return 1;
+		}
+	}
+	if(runs < 1)
+		runs = 1;
+	if(access(exe.c_str(), X_OK) != 0)
+	{
+		printf("Could not run %s\n", exe.c_str());
+		return 1;
+	}
+
+	char traceFile[64];
+	sprintf(traceFile, "/tmp/startupbench%d.json", (int)getpid());
+
+	StartupTimes cold, warm;
+	cold.failed = warm.failed = 0;
+	for(int i = 0; i < runs; ++i)
+	{
+		DropAssets(exe, assets);
+		cold.failed += !Run(exe, traceFile, cold);
+	}
+	for(int i = 0; i < runs; ++i)
+		warm.failed += !Run(exe, traceFile, warm);
+	unlink(traceFile);
+
+	printf("%d cold and %d warm starts of %s, ms\n", runs, runs, exe.c_str());
+	printf("%-20s %9s %9s %9s %9s\n", "Phase", "cold p50", "cold max", "warm p50", "warm max");
+	std::vector<std::string>& order = cold.order.size() >= warm.order.size() ? cold.order : warm.order;
+	for(size_t i = 0; i < order.size(); ++i)
+		PrintRow(order[i].c_str(), cold.phases[order[i]], warm.phases[order[i]]);
+	PrintRow("To first frame", cold.firstFrame, warm.firstFrame);
+	PrintRow("To exit", cold.exited, warm.exited);
+
+	int result = 0;
+	if(cold.failed > 0 || warm.failed > 0)
+	{
+		printf("FAILED: %d cold and %d warm runs failed or had a failed phase\n", cold.failed, warm.failed);
+		result = 1;
+	}
+	double warmMs = Percentile(warm.firstFrame, 50.0);
+	if(warmMs > budgetMs)
+	{
+		printf("FAILED: the warm median to the first frame was %.2f ms, over the budget of %.2f ms\n", warmMs, budgetMs);
+		result = 1;
+	}
+	return result;
+}
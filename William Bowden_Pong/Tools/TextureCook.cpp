@@ -0,0 +1,225 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	TextureCook.cpp
+// Date:	October 19th, 2026
+// Purpose: Cooks sprite images into .ptx files (CookedTexture.h): block
+//			compressed, colour keyed, with every mip level built, ready
+//			for the D3D9 backend to copy straight into a texture.  Each
+//			.ptx is written next to its source.  The encoder runs over
+//			rows of blocks on a CThreadPool.  Every file is read back and
+//			checked against what was cooked, and level 0 is decoded and
+//			compared with the source: transparent texels must stay
+//			transparent and the colour must be within -psnr dB.  Prints
+//			the sizes, the quality, the cooking time on the pool and on
+//			one thread, and how long decoding the source takes against
+//			reading the cooked file.  Exits with 1 if a file fails.
+//
+//			Run from the Dx12Test directory to cook the game's sprites.
+//			Build (Linux):
+//				g++ -O2 -std=c++11 -pthread -I../Dx12Test TextureCook.cpp
+//					../Dx12Test/CookedTexture.cpp ../Dx12Test/ImageFile.cpp
+//					../Dx12Test/ThreadPool.cpp -o texturecook
+//
+//			Usage: texturecook [-threads N] [-format auto|bc1|bc3] [-psnr dB]
+//				[files...]	default the game's sprites
+//				-format		auto picks BC1 unless a sprite has partial alpha
+//////////////////////////////////////////////////////////////////////////
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <vector>
+#include "CookedTexture.h"
+#include "ThreadPool.h"
+#include "PongPlatform.h"
+
+// What LoadPongTextures() loads
+static const char* const s_PongTextures[] =
+{
+	"Paddle.tga", "Ball.tga", "wall.tga", "START.tga", "CREDITS.tga", "CREDIT2.tga", "EXIT.tga"
+};
+
+// Bytes the same image takes as A8R8G8B8 with a full mip chain, what
+// D3DX creates from the source
+static size_t GetUncompressedBytes(int width, int height)
+{
+	size_t bytes = 0;
+	for(;;)
+	{
+		bytes += (size_t)width * height * 4;
+		if(width == 1 && height == 1)
+			return bytes;
+		width = width > 1 ? width / 2 : 1;
+		height = height > 1 ? height / 2 : 1;
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Name:		CompareWithSource
+// Parameters:	const SpriteImage& source - Colour keyed source
+//				const SpriteImage& decoded - Cooked level 0, decoded
+//				int& alphaErrors - Receives texels whose transparency
+//					changed, for BC1 opaque against transparent
+// Return:		double - PSNR of the colour of visible texels, dB
+// Description:	Alpha is compared exactly for BC1 and counted into the
+//				PSNR for BC3.
+//////////////////////////////////////////////////////////////////////////
+static double CompareWithSource(const SpriteImage& source, const SpriteImage& decoded, CookedFormat format,
+								int& alphaErrors)
+{
+	double squared = 0.0;
+	long long samples = 0;
+	alphaErrors = 0;
+	for(int y = 0; y < source.height; ++y)
+	{
+		for(int x = 0; x < source.width; ++x)
+		{
+			unsigned int a = source.pixels[(size_t)y * source.width + x];
+			unsigned int b = decoded.pixels[(size_t)y * decoded.width + x];
+			int alphaA = (int)(a >> 24), alphaB = (int)(b >> 24);
+			if(format == COOKED_BC1)
+			{
+				if((alphaA >= 128) != (alphaB >= 128))
+					++alphaErrors;
+				if(alphaA < 128)
+					continue;
+			}
+			else
+			{
+				squared += (double)(alphaA - alphaB) * (alphaA - alphaB);
+				++samples;
+				if(alphaA == 0)
+					continue;
+			}
+			for(int shift = 0; shift < 24; shift += 8)
+			{
+				int d = (int)((a >> shift) & 0xFF) - (int)((b >> shift) & 0xFF);
+				squared += (double)d * d;
+				++samples;
+			}
+		}
+	}
+	if(samples == 0 || squared == 0.0)
+		return 99.0;
+	return 10.0 * log10(255.0 * 255.0 * samples / squared);
+}
+
+int main(int argc, char** argv)
+{
+	int threads = 0;
+	const char* formatName = "auto";
+	double minPsnr = 30.0;
+	std::vector<const char*> files;
+
+	for(int i = 1; i < argc; ++i)
+	{
+		if(!strcmp(argv[i], "-threads") && i + 1 < argc)		threads = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-format") && i + 1 < argc)	formatName = argv[++i];
+		else if(!strcmp(argv[i], "-psnr") && i + 1 < argc)		minPsnr = atof(argv[++i]);
+		else if(argv[i][0] != '-')								files.push_back(argv[i]);
+		else
+		{
+			printf("Usage: %s [-threads N] [-format auto|bc1|bc3] [-psnr dB] [files...]\n", argv[0]);
+			return 1;
+		}
+	}
+	if(files.empty())
+		files.assign(s_PongTextures, s_PongTextures + sizeof(s_PongTextures) / sizeof(s_PongTextures[0]));
+
+	CThreadPool pool;
+	pool.Init(threads);
+
+	printf("%-14s %10s %4s %6s %10s %10s %7s %9s %9s %9s %9s\n", "File", "Size", "Fmt", "Levels", "Raw mips",
+		"Cooked", "PSNR", "Cook ms", "1 thr ms", "Decode ms", "Read ms");
+
+	int result = 0;
+	double cookTotal = 0.0, serialTotal = 0.0, decodeTotal = 0.0, readTotal = 0.0;
+	size_t rawTotal = 0, cookedTotal = 0;
+	for(size_t f = 0; f < files.size(); ++f)
+	{
+		const char* fileName = files[f];
+
+		// What the game does at startup without a cooked file, less the
+		// mip filtering D3DX adds
+		double start = PlatformGetTime();
+		SpriteImage image;
+		bool loaded = LoadImageFile(fileName, image, IMAGE_COLORKEY_MAGENTA);
+		double decodeSeconds = PlatformGetTime() - start;
+		if(!loaded)
+		{
+			printf("FAILED: could not load %s\n", fileName);
+			result = 1;
+			continue;
+		}
+
+		CookedFormat format = !strcmp(formatName, "bc1") ? COOKED_BC1 :
+			(!strcmp(formatName, "bc3") ? COOKED_BC3 : ChooseCookedFormat(image));
+
+		start = PlatformGetTime();
+		CookedTexture cooked;
+		CookTexture(image, format, cooked, &pool);
+		double cookSeconds = PlatformGetTime() - start;
+
+		start = PlatformGetTime();
+		CookedTexture serial;
+		CookTexture(image, format, serial, 0);
+		double serialSeconds = PlatformGetTime() - start;
+
+		char cookedName[512];
+		if(!GetCookedFileName(fileName, cookedName, sizeof(cookedName)) || !WriteCookedTexture(cookedName, cooked))
+		{
+			printf("FAILED: could not write the cooked %s\n", fileName);
+			result = 1;
+			continue;
+		}
+
+		// Read back the way the game does
+		start = PlatformGetTime();
+		CookedTexture loadedBack;
+		bool read = ReadCookedTexture(cookedName, loadedBack);
+		double readSeconds = PlatformGetTime() - start;
+
+		SpriteImage decoded;
+		DecodeCookedLevel(cooked, 0, decoded);
+		int alphaErrors = 0;
+		double psnr = CompareWithSource(image, decoded, format, alphaErrors);
+
+		size_t rawBytes = GetUncompressedBytes(image.width, image.height);
+		char size[32];
+		sprintf(size, "%dx%d", image.width, image.height);
+		printf("%-14s %10s %4s %6d %10lu %10lu %7.2f %9.2f %9.2f %9.2f %9.3f\n", fileName, size,
+			format == COOKED_BC1 ? "BC1" : "BC3", (int)cooked.levels.size(), (unsigned long)rawBytes,
+			(unsigned long)cooked.data.size(), psnr, cookSeconds * 1e3, serialSeconds * 1e3, decodeSeconds * 1e3,
+			readSeconds * 1e3);
+
+		if(!read || loadedBack.data != cooked.data || loadedBack.width != cooked.width ||
+			loadedBack.height != cooked.height || loadedBack.levels.size() != cooked.levels.size())
+		{
+			printf("FAILED: %s did not read back as it was written\n", cookedName);
+			result = 1;
+		}
+		if(serial.data != cooked.data)
+		{
+			printf("FAILED: %s cooked differently on one thread\n", fileName);
+			result = 1;
+		}
+		if(alphaErrors > 0 || psnr < minPsnr)
+		{
+			printf("FAILED: %s has %d texels with the wrong transparency, PSNR %.2f dB against %.2f dB\n", fileName,
+				alphaErrors, psnr, minPsnr);
+			result = 1;
+		}
+
+		cookTotal	+= cookSeconds;
+		serialTotal	+= serialSeconds;
+		decodeTotal	+= decodeSeconds;
+		readTotal	+= readSeconds;
+		rawTotal	+= rawBytes;
+		cookedTotal	+= cooked.data.size();
+	}
+
+	printf("%-14s %10s %4s %6s %10lu %10lu %7s %9.2f %9.2f %9.2f %9.3f\n", "Total", "", "", "", (unsigned long)rawTotal,
+		(unsigned long)cookedTotal, "", cookTotal * 1e3, serialTotal * 1e3, decodeTotal * 1e3, readTotal * 1e3);
+	printf("%d threads\n", pool.GetThreadCount());
+	pool.Shutdown();
+	return result;
+}
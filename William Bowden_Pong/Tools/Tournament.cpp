@@ -0,0 +1,328 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	Tournament.cpp
+// Date:	October 19th, 2026
+// Purpose: Plays paddle controllers (PaddleController.h) against each
+//			other, every pair for a number of seeded matches with the
+//			sides swapped every other match.  Matches are pool items, so
+//			the work stealing CThreadPool spreads them over every core.
+//			Each thread adds its results to its own statistics and they
+//			are merged once the matches are done, so no counter is
+//			shared while playing and the totals do not depend on the
+//			number of threads.
+//
+//			Build (Linux):
+//				g++ -O2 -std=c++11 -pthread -I../Dx12Test Tournament.cpp
+//					../Dx12Test/PaddleController.cpp ../Dx12Test/PaddleAI.cpp
+//					../Dx12Test/PongGame.cpp ../Dx12Test/ThreadPool.cpp
+//					-o tournament
+//
+//			Usage: tournament [-c spec]... [-matches N] [-points N]
+//					[-ticks N] [-seed N] [-threads N] [-record file]
+//				-c		a controller, see PaddleController.h, repeat for
+//						more.  Default easy, normal, hard and a script
+//				-matches	matches per pair, default 20
+//				-points		points to win a match, default 5
+//				-ticks		longest match, higher score wins after it
+//				-record		save the left paddle's inputs in the first
+//						match, to play back with -c replay:file
+//////////////////////////////////////////////////////////////////////////
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include "PaddleController.h"
+#include "GameEvents.h"
+#include "ThreadPool.h"
+#include "PongPlatform.h"
+
+// Rallies are bucketed by returns: 0, 1, 2-3, 4-7 ... 64 and over
+#define RALLY_BUCKETS 8
+
+// One pair's results.  Wins and points are by controller, not by side.
+struct PairingStats
+{
+	int				matches;
+	int				wins[2];
+	int				draws;
+	int				points[2];
+	int				longestRally;
+	long long		rallies;		// Points played
+	long long		returns;		// Paddle hits in all rallies
+	long long		ticks;
+	int				rallyBuckets[RALLY_BUCKETS];
+};
+
+// One thread's results, written by that thread only
+struct ThreadStats
+{
+	std::vector<PairingStats>	pairings;
+	char						padding[64];	// Keeps the vectors apart
+};
+
+struct Tournament
+{
+	std::vector<ControllerDesc>	controllers;
+	std::vector<int>			pairA, pairB;	// Controllers of each pair
+	int							matchesPerPair;
+	int							pointsToWin;
+	int							maxTicks;
+	unsigned int				seed;
+	bool						record;
+
+	std::vector<ThreadStats>	threads;
+	std::vector<InputRun>		recorded;		// Written by match 0 only
+};
+
+static int RallyBucket(int returns)
+{
+	int bucket = 0;
+	while(returns > 0 && bucket < RALLY_BUCKETS - 1)
+	{
+		returns >>= 1;
+		++bucket;
+	}
+	return bucket;
+}
+
+// Spreads consecutive match numbers over unrelated seeds
+static unsigned int MatchSeed(unsigned int seed, int match)
+{
+	unsigned int h = seed * 0x9E3779B9u ^ (unsigned int)match;
+	h ^= h >> 16;
+	h *= 0x85EBCA6Bu;
+	h ^= h >> 13;
+	return h ? h : 1;
+}
+
+static void PlayMatchTask(void* context, int index, int thread)
+{
+	Tournament& t = *(Tournament*)context;
+	int pair = index / t.matchesPerPair;
+	bool swapped = (index % t.matchesPerPair) & 1;
+
+	// side[0] is the left paddle, pair A plays on the left unless swapped
+	int side[2] = { swapped ? t.pairB[pair] : t.pairA[pair], swapped ? t.pairA[pair] : t.pairB[pair] };
+	unsigned int seed = MatchSeed(t.seed, index);
+
+	CPongGame game;
+	game.Menu.onSTART = false;
+	game.FinishMovie();
+
+	CPaddleController controller[2];
+	controller[0].Init(t.controllers[side[0]], 0, seed);
+	controller[1].Init(t.controllers[side[1]], 1, seed * 747796405u + 1);
+
+	PairingStats& stats = t.threads[thread].pairings[pair];
+	CGameEventBuffer events;
+	int rally = 0;
+	int tick = 0;
+	while(tick < t.maxTicks && game.Player1Point < t.pointsToWin && game.Player2Point < t.pointsToWin)
+	{
+		int keys = controller[0].Think(game) | controller[1].Think(game);
+		if(t.record && index == 0)
+			AppendInput(t.recorded, GetPaddleInputs(0, keys));
+
+		events.Clear();
+		game.Tick(keys, 0, &events);
+		++tick;
+		for(int i = 0; i < events.GetCount(); ++i)
+		{
+			GameEventType type = events.Get(i).type;
+			if(type == GAME_EVENT_PADDLE_HIT)
+				++rally;
+			else if(type == GAME_EVENT_POINT_SCORED)
+			{
+				++stats.rallies;
+				stats.returns += rally;
+				++stats.rallyBuckets[RallyBucket(rally)];
+				if(rally > stats.longestRally)
+					stats.longestRally = rally;
+				rally = 0;
+			}
+		}
+	}
+
+	// Player 1 is the left paddle
+	int a = swapped ? 1 : 0;
+	stats.points[a]		+= game.Player1Point;
+	stats.points[1 - a]	+= game.Player2Point;
+	if(game.Player1Point > game.Player2Point)		++stats.wins[a];
+	else if(game.Player2Point > game.Player1Point)	++stats.wins[1 - a];
+	else											++stats.draws;
+	++stats.matches;
+	stats.ticks += tick;
+}
+
+static void Merge(PairingStats& total, const PairingStats& part)
+{
+	total.matches	+= part.matches;
+	total.draws		+= part.draws;
+	total.rallies	+= part.rallies;
+	total.returns	+= part.returns;
+	total.ticks		+= part.ticks;
+	for(int i = 0; i < 2; ++i)
+	{
+		total.wins[i]	+= part.wins[i];
+		total.points[i]	+= part.points[i];
+	}
+	for(int i = 0; i < RALLY_BUCKETS; ++i)
+		total.rallyBuckets[i] += part.rallyBuckets[i];
+	if(part.longestRally > total.longestRally)
+		total.longestRally = part.longestRally;
+}
+
+static double Percent(long long part, long long whole)
+{
+	return whole > 0 ? 100.0 * (double)part / (double)whole : 0.0;
+}
+
+int main(int argc, char** argv)
+{
+	Tournament t;
+	t.matchesPerPair	= 20;
+	t.pointsToWin		= 5;
+	t.maxTicks			= 1000000;
+	t.seed				= 1;
+	t.record			= false;
+	int threads = 0;
+	const char* recordFile = 0;
+
+	std::vector<const char*> specs;
+	for(int i = 1; i < argc; ++i)
+	{
+		if(!strcmp(argv[i], "-c") && i + 1 < argc)				specs.push_back(argv[++i]);
+		else if(!strcmp(argv[i], "-matches") && i + 1 < argc)	t.matchesPerPair = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-points") && i + 1 < argc)	t.pointsToWin = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-ticks") && i + 1 < argc)		t.maxTicks = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-seed") && i + 1 < argc)		t.seed = (unsigned int)strtoul(argv[++i], 0, 10);
+		else if(!strcmp(argv[i], "-threads") && i + 1 < argc)	threads = atoi(argv[++i]);
+		else if(!strcmp(argv[i], "-record") && i + 1 < argc)	recordFile = argv[++i];
+		else
+		{
+			printf("Usage: %s [-c spec]... [-matches N] [-points N] [-ticks N] [-seed N] [-threads N] [-record file]\n", argv[0]);
+			return 1;
+		}
+	}
+	if(specs.empty())
+	{
+		specs.push_back("easy");
+		specs.push_back("normal");
+		specs.push_back("hard");
+		specs.push_back("script:U3000 D3000");
+	}
+	if(t.matchesPerPair < 1)
+		t.matchesPerPair = 1;
+	t.record = recordFile != 0;
+
+	t.controllers.resize(specs.size());
+	for(size_t i = 0; i < specs.size(); ++i)
+	{
+		if(!ParseController(specs[i], t.controllers[i]))
+		{
+			printf("Not a controller: %s\n", specs[i]);
+			return 1;
+		}
+	}
+
+	// Every pair once, or a lone controller against itself
+	int count = (int)t.controllers.size();
+	for(int a = 0; a < count; ++a)
+	{
+		for(int b = a + 1; b < count; ++b)
+		{
+			t.pairA.push_back(a);
+			t.pairB.push_back(b);
+		}
+	}
+	if(count == 1)
+	{
+		t.pairA.push_back(0);
+		t.pairB.push_back(0);
+	}
+	int pairs = (int)t.pairA.size();
+	int matches = pairs * t.matchesPerPair;
+
+	CThreadPool pool;
+	pool.Init(threads);
+
+	PairingStats empty;
+	memset(&empty, 0, sizeof(empty));
+	t.threads.resize(pool.GetThreadCount());
+	for(size_t i = 0; i < t.threads.size(); ++i)
+		t.threads[i].pairings.assign(pairs, empty);
+
+	double start = PlatformGetTime();
+	pool.Run(matches, PlayMatchTask, &t);
+	double elapsed = PlatformGetTime() - start;
+	pool.Shutdown();
+
+	std::vector<PairingStats> totals(pairs, empty);
+	for(size_t i = 0; i < t.threads.size(); ++i)
+		for(int p = 0; p < pairs; ++p)
+			Merge(totals[p], t.threads[i].pairings[p]);
+
+	long long ticks = 0;
+	printf("%d matches, first to %d points or %d ticks, seed %u\n\n", matches, t.pointsToWin, t.maxTicks, t.seed);
+	for(int p = 0; p < pairs; ++p)
+	{
+		const PairingStats& s = totals[p];
+		ticks += s.ticks;
+		printf("%s vs %s\n", t.controllers[t.pairA[p]].name.c_str(), t.controllers[t.pairB[p]].name.c_str());
+		printf("  wins %d - %d, %d drawn (%.1f%% - %.1f%%), points %d - %d\n",
+			s.wins[0], s.wins[1], s.draws, Percent(s.wins[0], s.matches), Percent(s.wins[1], s.matches),
+			s.points[0], s.points[1]);
+		printf("  %lld rallies, %.2f returns each, longest %d, %.0f ticks per match\n",
+			s.rallies, s.rallies > 0 ? (double)s.returns / s.rallies : 0.0, s.longestRally,
+			s.matches > 0 ? (double)s.ticks / s.matches : 0.0);
+		printf("  returns per rally:");
+		for(int b = 0; b < RALLY_BUCKETS; ++b)
+		{
+			int low = b == 0 ? 0 : 1 << (b - 1);
+			if(b == RALLY_BUCKETS - 1)
+				printf("  %d+: %d", low, s.rallyBuckets[b]);
+			else if(b < 2)
+				printf("  %d: %d", low, s.rallyBuckets[b]);
+			else
+				printf("  %d-%d: %d", low, (1 << b) - 1, s.rallyBuckets[b]);
+		}
+		printf("\n");
+	}
+
+	// Standings over every match each controller played
+	printf("\nStandings\n");
+	for(int c = 0; c < count; ++c)
+	{
+		long long played = 0, wins = 0, draws = 0, pointsFor = 0, pointsAgainst = 0;
+		for(int p = 0; p < pairs; ++p)
+		{
+			const PairingStats& s = totals[p];
+			for(int side = 0; side < 2; ++side)
+			{
+				if((side == 0 ? t.pairA[p] : t.pairB[p]) != c)
+					continue;
+				played			+= s.matches;
+				wins			+= s.wins[side];
+				draws			+= s.draws;
+				pointsFor		+= s.points[side];
+				pointsAgainst	+= s.points[1 - side];
+			}
+		}
+		printf("  %-28s %5.1f%% won  %lld won %lld drawn %lld lost  points %lld - %lld\n",
+			t.controllers[c].name.c_str(), Percent(wins, played), wins, draws, played - wins - draws,
+			pointsFor, pointsAgainst);
+	}
+
+	printf("\n%d threads, %.2f s, %.0f matches/s, %.1f M ticks/s\n", (int)t.threads.size(), elapsed,
+		matches / (elapsed > 0.0 ? elapsed : 1e-9), ticks / (elapsed > 0.0 ? elapsed : 1e-9) / 1e6);
+
+	if(recordFile)
+	{
+		if(!SaveInputRuns(recordFile, t.recorded))
+		{
+			printf("Could not write %s\n", recordFile);
+			return 1;
+		}
+		printf("Left paddle inputs of the first match saved to %s\n", recordFile);
+	}
+	return 0;
+}
@@ -0,0 +1,116 @@
+//////////////////////////////////////////////////////////////////////////
+// Name:	ViewportTest.cpp
+// Date:	October 19th, 2026
+// Purpose: Checks the playfield layout maths in Viewport.h against sizes
+//			worked out by hand: the playfield's own size, wide and tall
+//			screens that need bars, and screens too small to hold
+//			anything.  For each it checks the offsets, size and scale,
+//			that the bars are split evenly to the pixel, and that
+//			screen positions map back to the virtual positions they
+//			came from.  Prints every case and exits with 1 if any
+//			value is off.
+//
+//			Build (Linux):
+//				g++ -O2 -std=c++11 -I../Dx12Test ViewportTest.cpp -o viewporttest
+//
+//			Usage: viewporttest
+//////////////////////////////////////////////////////////////////////////
+#include <stdio.h>
+#include <math.h>
+#include "Viewport.h"
+
+#define VIRTUAL_WIDTH 800
+#define VIRTUAL_HEIGHT 600
+
+// How far a mapped back position may be from where it started, pixels
+#define ROUND_TRIP_TOLERANCE 1e-3f
+
+struct ViewportCase
+{
+	const char*			name;
+	int					screenWidth, screenHeight;
+	Viewport			expected;
+};
+
+static const ViewportCase s_Cases[] =
+{
+	{ "800x600 identity",		800,	600,	{   0,   0,  800,  600, 1.0f } },
+	{ "1920x1080 pillarbox",	1920,	1080,	{ 240,   0, 1440, 1080, 1.8f } },
+	{ "1024x768 same aspect",	1024,	768,	{   0,   0, 1024,  768, 1.28f } },
+	{ "600x800 letterbox",		600,	800,	{   0, 175,  600,  450, 0.75f } },
+	{ "1x1",					1,		1,		{   0,   0,    1,    1, 1.0f / 800.0f } },
+	{ "0x0",					0,		0,		{   0,   0,    0,    0, 0.0f } },
+};
+
+static bool SameScale(float a, float b)
+{
+	return fabsf(a - b) <= 1e-6f * (fabsf(b) > 1.0f ? fabsf(b) : 1.0f);
+}
+
+static bool CheckCase(const ViewportCase& test)
+{
+	Viewport view = MakeViewport(test.screenWidth, test.screenHeight, VIRTUAL_WIDTH, VIRTUAL_HEIGHT);
+	const Viewport& want = test.expected;
+	printf("%-22s at %4d,%4d size %4dx%-4d scale %.6f\n", test.name, view.x, view.y, view.width, view.height,
+		view.scale);
+
+	bool ok = true;
+	if(view.x != want.x || view.y != want.y || view.width != want.width || view.height != want.height
+		|| !SameScale(view.scale, want.scale))
+	{
+		printf("FAILED: %s expected at %d,%d size %dx%d scale %.6f\n", test.name, want.x, want.y, want.width,
+			want.height, want.scale);
+		ok = false;
+	}
+
+	// Centred, any odd pixel left over goes on the right or bottom
+	int spareX = test.screenWidth - view.width - 2 * view.x;
+	int spareY = test.screenHeight - view.height - 2 * view.y;
+	if(test.screenWidth > 0 && (spareX < 0 || spareX > 1 || spareY < 0 || spareY > 1))
+	{
+		printf("FAILED: %s bars are not split evenly, %d and %d pixels over\n", test.name, spareX, spareY);
+		ok = false;
+	}
+
+	// No scale maps everything back to the corner rather than dividing by 0
+	for(int i = 0; i <= VIRTUAL_WIDTH; ++i)
+	{
+		float x = (float)i;
+		float y = (float)(i * VIRTUAL_HEIGHT / VIRTUAL_WIDTH);
+		float backX = VirtualX(view, ViewportX(view, x));
+		float backY = VirtualY(view, ViewportY(view, y));
+		float wantX = view.scale > 0.0f ? x : 0.0f;
+		float wantY = view.scale > 0.0f ? y : 0.0f;
+		if(fabsf(backX - wantX) > ROUND_TRIP_TOLERANCE || fabsf(backY - wantY) > ROUND_TRIP_TOLERANCE)
+		{
+			printf("FAILED: %s maps %.1f,%.1f back to %.4f,%.4f\n", test.name, x, y, backX, backY);
+			ok = false;
+			break;
+		}
+	}
+	return ok;
+}
+
+int main(int argc, char** argv)
+{
+	if(argc > 1)
+	{
+		printf("Usage: %s\n", argv[0]);
+		return 1;
+	}
+
+	int failed = 0;
+	for(size_t i = 0; i < sizeof(s_Cases) / sizeof(s_Cases[0]); ++i)
+	{
+		if(!CheckCase(s_Cases[i]))
+			++failed;
+	}
+
+	if(failed > 0)
+	{
+		printf("FAILED: %d of %d layouts were wrong\n", failed, (int)(sizeof(s_Cases) / sizeof(s_Cases[0])));
+		return 1;
+	}
+	printf("All %d layouts right\n", (int)(sizeof(s_Cases) / sizeof(s_Cases[0])));
+	return 0;
+}